@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "clip/clip_event_codec.h"
+
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+namespace {
+// 'G' 'E', version, then the fields in the order of BINARY_V1
+constexpr uint8_t MAGIC_FIRST = 'G';
+constexpr uint8_t MAGIC_SECOND = 'E';
+constexpr size_t HEADER_SIZE = 3;
+constexpr uint32_t BITS_PER_BYTE = 8;
+constexpr uint8_t FLAG_DELAY = 1 << 0;
+constexpr uint8_t FLAG_NOT_NEED_LINK = 1 << 1;
+constexpr uint8_t FLAG_ACCEPT_FRAMES = 1 << 2;
+constexpr size_t MAX_LENGTH = std::numeric_limits<uint16_t>::max();
+// roughly a deviceId, an account and a handful of types, saves growing the buffer
+constexpr size_t RESERVE_SIZE = 256;
+
+class EventWriter {
+public:
+    explicit EventWriter(std::vector<uint8_t> &buffer) : buffer_(buffer) {}
+
+    template<typename T>
+    void Write(T value)
+    {
+        static_assert(std::is_integral_v<T>, "only integers are written as they are");
+        auto bits = static_cast<std::make_unsigned_t<T>>(value);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            buffer_.push_back(static_cast<uint8_t>(bits >> (i * BITS_PER_BYTE)));
+        }
+    }
+
+    bool Write(const std::string &value)
+    {
+        if (value.size() > MAX_LENGTH) {
+            return false;
+        }
+        Write(static_cast<uint16_t>(value.size()));
+        buffer_.insert(buffer_.end(), value.begin(), value.end());
+        return true;
+    }
+
+    bool Write(const std::vector<std::string> &values)
+    {
+        if (values.size() > MAX_LENGTH) {
+            return false;
+        }
+        Write(static_cast<uint16_t>(values.size()));
+        for (const auto &value : values) {
+            if (!Write(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<uint8_t> &buffer_;
+};
+
+class EventReader {
+public:
+    EventReader(const std::vector<uint8_t> &buffer, size_t pos) : buffer_(buffer), pos_(pos) {}
+
+    template<typename T>
+    bool Read(T &value)
+    {
+        static_assert(std::is_integral_v<T>, "only integers are read as they are");
+        if (buffer_.size() - pos_ < sizeof(T)) {
+            return false;
+        }
+        std::make_unsigned_t<T> bits = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            bits |= static_cast<std::make_unsigned_t<T>>(buffer_[pos_ + i]) << (i * BITS_PER_BYTE);
+        }
+        value = static_cast<T>(bits);
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool Read(std::string &value)
+    {
+        uint16_t length = 0;
+        if (!Read(length) || buffer_.size() - pos_ < length) {
+            return false;
+        }
+        value.assign(buffer_.begin() + pos_, buffer_.begin() + pos_ + length);
+        pos_ += length;
+        return true;
+    }
+
+    bool Read(std::vector<std::string> &values)
+    {
+        uint16_t count = 0;
+        if (!Read(count)) {
+            return false;
+        }
+        values.clear();
+        for (uint16_t i = 0; i < count; ++i) {
+            std::string value;
+            if (!Read(value)) {
+                return false;
+            }
+            values.push_back(std::move(value));
+        }
+        return true;
+    }
+
+private:
+    const std::vector<uint8_t> &buffer_;
+    size_t pos_;
+};
+
+bool IsBinary(const std::vector<uint8_t> &buffer)
+{
+    return buffer.size() >= HEADER_SIZE && buffer[0] == MAGIC_FIRST && buffer[1] == MAGIC_SECOND;
+}
+} // namespace
+
+std::vector<uint8_t> ClipEventCodec::Encode(const ClipPlugin::GlobalEvent &event, uint8_t peerVersion)
+{
+    std::vector<uint8_t> buffer;
+    if (peerVersion >= BINARY_V1 && EncodeBinary(event, buffer)) {
+        return buffer;
+    }
+    std::string json = event.Marshall();
+    return std::vector<uint8_t>(json.begin(), json.end());
+}
+
+bool ClipEventCodec::Decode(const std::vector<uint8_t> &buffer, ClipPlugin::GlobalEvent &event)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!buffer.empty(), false, PASTEBOARD_MODULE_SERVICE, "event is empty");
+    if (IsBinary(buffer)) {
+        return DecodeBinary(buffer, event);
+    }
+    return event.Unmarshall(std::string(buffer.begin(), buffer.end()));
+}
+
+bool ClipEventCodec::EncodeBinary(const ClipPlugin::GlobalEvent &event, std::vector<uint8_t> &buffer)
+{
+    buffer.clear();
+    buffer.reserve(RESERVE_SIZE);
+    buffer.insert(buffer.end(), { MAGIC_FIRST, MAGIC_SECOND, BINARY_V1 });
+    EventWriter writer(buffer);
+    writer.Write(event.version);
+    writer.Write(event.frameNum);
+    writer.Write(event.user);
+    writer.Write(event.seqId);
+    writer.Write(event.status);
+    writer.Write(event.syncTime);
+    writer.Write(event.dataId);
+    writer.Write(event.expiration);
+    uint8_t flags = (event.isDelay ? FLAG_DELAY : 0) | (event.notNeedLink ? FLAG_NOT_NEED_LINK : 0) |
+        (event.acceptFrames ? FLAG_ACCEPT_FRAMES : 0);
+    writer.Write(flags);
+    writer.Write(event.payloadVersion);
+    writer.Write(event.acceptPayloadVersion);
+    writer.Write(event.acceptEventVersion);
+    writer.Write(event.recordCount);
+    if (!writer.Write(event.deviceId) || !writer.Write(event.account) || !writer.Write(event.dataType) ||
+        !writer.Write(event.utdTypes)) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "event too large for binary, seqId=%{public}hu", event.seqId);
+        return false;
+    }
+    return true;
+}
+
+bool ClipEventCodec::DecodeBinary(const std::vector<uint8_t> &buffer, ClipPlugin::GlobalEvent &event)
+{
+    // later versions only append fields, the ones this version knows are read and the rest is skipped
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(buffer[HEADER_SIZE - 1] >= BINARY_V1, false, PASTEBOARD_MODULE_SERVICE,
+        "unknown event version=%{public}hhu", buffer[HEADER_SIZE - 1]);
+    ClipPlugin::GlobalEvent decoded;
+    EventReader reader(buffer, HEADER_SIZE);
+    uint8_t flags = 0;
+    bool ret = reader.Read(decoded.version) && reader.Read(decoded.frameNum) && reader.Read(decoded.user) &&
+        reader.Read(decoded.seqId) && reader.Read(decoded.status) && reader.Read(decoded.syncTime) &&
+        reader.Read(decoded.dataId) && reader.Read(decoded.expiration) && reader.Read(flags) &&
+        reader.Read(decoded.payloadVersion) && reader.Read(decoded.acceptPayloadVersion) &&
+        reader.Read(decoded.acceptEventVersion) && reader.Read(decoded.recordCount) &&
+        reader.Read(decoded.deviceId) && reader.Read(decoded.account) && reader.Read(decoded.dataType) &&
+        reader.Read(decoded.utdTypes);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_SERVICE, "event malformed, size=%{public}zu",
+        buffer.size());
+    decoded.isDelay = (flags & FLAG_DELAY) != 0;
+    decoded.notNeedLink = (flags & FLAG_NOT_NEED_LINK) != 0;
+    decoded.acceptFrames = (flags & FLAG_ACCEPT_FRAMES) != 0;
+    event = std::move(decoded);
+    return true;
+}
+} // namespace OHOS::MiscServices
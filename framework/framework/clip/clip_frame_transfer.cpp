@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "clip/clip_frame_transfer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+#include "clip/clip_payload_codec.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+std::vector<size_t> ClipFrameTransfer::PlanFrames(const std::vector<size_t> &recordSizes, size_t frameSize)
+{
+    size_t total = std::accumulate(recordSizes.begin(), recordSizes.end(), static_cast<size_t>(0));
+    // frameNum is a byte, a clip too large for MAX_FRAMES frames of frameSize gets larger frames
+    size_t budget = std::max({ frameSize, total / MAX_FRAMES + 1, static_cast<size_t>(1) });
+    while (true) {
+        std::vector<size_t> starts = { 0 };
+        size_t used = 0;
+        for (size_t i = 0; i < recordSizes.size(); ++i) {
+            if (i > starts.back() && used + recordSizes[i] > budget) {
+                starts.push_back(i);
+                used = 0;
+            }
+            used += recordSizes[i];
+        }
+        if (starts.size() <= MAX_FRAMES) {
+            return starts;
+        }
+        budget *= 2;
+    }
+}
+
+void ClipFrameTransfer::SealFrame(std::vector<uint8_t> &frame, uint8_t peerVersion)
+{
+    uint8_t version = ClipPayloadCodec::Encode(frame, peerVersion);
+    frame.push_back(version);
+}
+
+size_t ClipFrameTransfer::GetOpenedSize(const std::vector<uint8_t> &frame)
+{
+    if (frame.empty()) {
+        return 0;
+    }
+    uint8_t version = frame.back();
+    if (version == ClipPayloadCodec::RAW) {
+        return frame.size() - 1;
+    }
+    // the header of a compressed frame is at its start, the version byte does not get in the way
+    return ClipPayloadCodec::GetDecodedSize(version, frame);
+}
+
+bool ClipFrameTransfer::OpenFrame(std::vector<uint8_t> &frame)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!frame.empty(), false, PASTEBOARD_MODULE_SERVICE, "frame is empty");
+    uint8_t version = frame.back();
+    frame.pop_back();
+    return ClipPayloadCodec::Decode(version, frame);
+}
+
+ClipFrameReader::ClipFrameReader(uint8_t frameNum) : frameNum_(frameNum) {}
+
+int32_t ClipFrameReader::Read(const FetchFunc &fetch, const DecodeFunc &decode)
+{
+    if (IsComplete()) {
+        return 0;
+    }
+    std::vector<uint8_t> frame;
+    int32_t ret = fetch(ackedFrames_, frame);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == 0, ret, PASTEBOARD_MODULE_SERVICE,
+        "fetch frame %{public}hhu/%{public}hhu failed, ret=%{public}d", ackedFrames_, frameNum_, ret);
+    // one fetcher runs a frame ahead of the decoding, it waits for the slot before fetching the next one
+    PrefetchSlot slot;
+    std::thread fetcher;
+    uint8_t next = ackedFrames_ + 1;
+    if (next < frameNum_) {
+        fetcher = std::thread([this, &fetch, &slot, next]() {
+            Prefetch(fetch, slot, next);
+        });
+    }
+    while (true) {
+        uint8_t index = ackedFrames_;
+        ret = decode(index, frame);
+        if (ret != 0) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
+                "decode frame %{public}hhu/%{public}hhu failed, ret=%{public}d", index, frameNum_, ret);
+            break;
+        }
+        ++ackedFrames_;
+        if (IsComplete()) {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(slot.mutex);
+        slot.cv.wait(lock, [&slot]() { return slot.isFull; });
+        ret = slot.ret;
+        frame.swap(slot.frame);
+        slot.isFull = false;
+        slot.cv.notify_all();
+        if (ret != 0) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "fetch frame %{public}hhu/%{public}hhu failed, ret=%{public}d",
+                ackedFrames_, frameNum_, ret);
+            break;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        slot.isStopped = true;
+        slot.cv.notify_all();
+    }
+    if (fetcher.joinable()) {
+        fetcher.join();
+    }
+    return ret;
+}
+
+void ClipFrameReader::Prefetch(const FetchFunc &fetch, PrefetchSlot &slot, uint8_t first) const
+{
+    for (uint8_t index = first; index < frameNum_; ++index) {
+        std::vector<uint8_t> frame;
+        int32_t ret = fetch(index, frame);
+        std::unique_lock<std::mutex> lock(slot.mutex);
+        slot.cv.wait(lock, [&slot]() { return !slot.isFull || slot.isStopped; });
+        if (slot.isStopped) {
+            return;
+        }
+        slot.frame.swap(frame);
+        slot.ret = ret;
+        slot.isFull = true;
+        slot.cv.notify_all();
+        if (ret != 0) {
+            return;
+        }
+        slot.cv.wait(lock, [&slot]() { return !slot.isFull || slot.isStopped; });
+        if (slot.isStopped) {
+            return;
+        }
+    }
+}
+
+uint8_t ClipFrameReader::GetAckedFrames() const
+{
+    return ackedFrames_;
+}
+
+bool ClipFrameReader::IsComplete() const
+{
+    return ackedFrames_ >= frameNum_;
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "clip/clip_payload_codec.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+namespace {
+// 'P' 'Z', version, reserved, decoded size as little endian uint32
+constexpr uint8_t MAGIC_FIRST = 'P';
+constexpr uint8_t MAGIC_SECOND = 'Z';
+constexpr size_t VERSION_POS = 2;
+constexpr size_t SIZE_POS = 4;
+constexpr size_t HEADER_SIZE = 8;
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t MAX_OFFSET = 0xFFFF;
+constexpr size_t RUN_MASK = 0x0F;
+constexpr size_t LENGTH_BYTE_MAX = 0xFF;
+constexpr uint32_t LITERAL_SHIFT = 4;
+constexpr uint32_t HASH_BITS = 12;
+constexpr uint32_t HASH_MULTIPLIER = 2654435761U;
+constexpr uint32_t BITS_PER_BYTE = 8;
+// every 64 bytes without a match the scan steps one byte further, incompressible input is passed quickly
+constexpr uint32_t SKIP_SHIFT = 6;
+// compression that saves less than an eighth is not worth the decoding on the receiver
+constexpr size_t MIN_SAVING_RATIO = 8;
+
+uint32_t Read32(const std::vector<uint8_t> &buffer, size_t pos)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        value |= static_cast<uint32_t>(buffer[pos + i]) << (i * BITS_PER_BYTE);
+    }
+    return value;
+}
+
+uint32_t Hash(uint32_t sequence)
+{
+    return (sequence * HASH_MULTIPLIER) >> (sizeof(uint32_t) * BITS_PER_BYTE - HASH_BITS);
+}
+
+// lengths from RUN_MASK on continue in bytes, each 0xFF means more follows
+void WriteLength(std::vector<uint8_t> &dst, size_t length)
+{
+    for (; length >= LENGTH_BYTE_MAX; length -= LENGTH_BYTE_MAX) {
+        dst.push_back(static_cast<uint8_t>(LENGTH_BYTE_MAX));
+    }
+    dst.push_back(static_cast<uint8_t>(length));
+}
+
+bool ReadLength(const std::vector<uint8_t> &src, size_t &pos, size_t &length)
+{
+    uint8_t byte = 0;
+    do {
+        if (pos >= src.size()) {
+            return false;
+        }
+        byte = src[pos++];
+        length += byte;
+    } while (byte == LENGTH_BYTE_MAX);
+    return true;
+}
+
+// the last sequence carries literals only, it ends the input right after them
+void WriteSequence(std::vector<uint8_t> &dst, const std::vector<uint8_t> &src, size_t anchor, size_t literals,
+    size_t offset = 0, size_t matchLength = 0)
+{
+    size_t matchCode = matchLength == 0 ? 0 : matchLength - MIN_MATCH;
+    dst.push_back(static_cast<uint8_t>((std::min(literals, RUN_MASK) << LITERAL_SHIFT) |
+        std::min(matchCode, RUN_MASK)));
+    if (literals >= RUN_MASK) {
+        WriteLength(dst, literals - RUN_MASK);
+    }
+    dst.insert(dst.end(), src.begin() + anchor, src.begin() + anchor + literals);
+    if (matchLength == 0) {
+        return;
+    }
+    dst.push_back(static_cast<uint8_t>(offset & LENGTH_BYTE_MAX));
+    dst.push_back(static_cast<uint8_t>(offset >> BITS_PER_BYTE));
+    if (matchCode >= RUN_MASK) {
+        WriteLength(dst, matchCode - RUN_MASK);
+    }
+}
+} // namespace
+
+uint8_t ClipPayloadCodec::Encode(std::vector<uint8_t> &data, uint8_t peerVersion)
+{
+    if (peerVersion < LZ_V1 || data.size() < COMPRESS_THRESHOLD) {
+        return RAW;
+    }
+    std::vector<uint8_t> compressed;
+    if (!Compress(data, compressed) || compressed.size() >= data.size() - data.size() / MIN_SAVING_RATIO) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "payload barely compresses, sent raw, size=%{public}zu",
+            data.size());
+        return RAW;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "payload compressed, %{public}zu -> %{public}zu", data.size(),
+        compressed.size());
+    data.swap(compressed);
+    return LZ_V1;
+}
+
+size_t ClipPayloadCodec::GetDecodedSize(uint8_t version, const std::vector<uint8_t> &data)
+{
+    if (version == RAW) {
+        return data.size();
+    }
+    if (version != LZ_V1 || data.size() < HEADER_SIZE || data[0] != MAGIC_FIRST || data[1] != MAGIC_SECOND ||
+        data[VERSION_POS] != LZ_V1) {
+        return 0;
+    }
+    return Read32(data, SIZE_POS);
+}
+
+bool ClipPayloadCodec::Decode(uint8_t version, std::vector<uint8_t> &data)
+{
+    if (version == RAW) {
+        return true;
+    }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(version == LZ_V1, false, PASTEBOARD_MODULE_SERVICE,
+        "unknown payload version=%{public}hhu", version);
+    std::vector<uint8_t> decoded;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(Decompress(data, decoded), false, PASTEBOARD_MODULE_SERVICE,
+        "payload malformed, size=%{public}zu", data.size());
+    data.swap(decoded);
+    return true;
+}
+
+bool ClipPayloadCodec::Compress(const std::vector<uint8_t> &src, std::vector<uint8_t> &dst)
+{
+    size_t size = src.size();
+    if (size > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    dst.clear();
+    dst.reserve(HEADER_SIZE + size / 2);
+    dst.insert(dst.end(), { MAGIC_FIRST, MAGIC_SECOND, LZ_V1, 0 });
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        dst.push_back(static_cast<uint8_t>(size >> (i * BITS_PER_BYTE)));
+    }
+    // positions are stored plus one, zero marks an empty slot
+    std::vector<uint32_t> table(1U << HASH_BITS, 0);
+    size_t pos = 0;
+    size_t anchor = 0;
+    while (pos + MIN_MATCH <= size) {
+        uint32_t sequence = Read32(src, pos);
+        uint32_t &slot = table[Hash(sequence)];
+        size_t candidate = slot;
+        slot = static_cast<uint32_t>(pos + 1);
+        if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || Read32(src, candidate - 1) != sequence) {
+            pos += 1 + ((pos - anchor) >> SKIP_SHIFT);
+            continue;
+        }
+        size_t ref = candidate - 1;
+        size_t length = MIN_MATCH;
+        while (pos + length < size && src[ref + length] == src[pos + length]) {
+            ++length;
+        }
+        WriteSequence(dst, src, anchor, pos - anchor, pos - ref, length);
+        pos += length;
+        anchor = pos;
+    }
+    WriteSequence(dst, src, anchor, size - anchor);
+    return true;
+}
+
+bool ClipPayloadCodec::Decompress(const std::vector<uint8_t> &src, std::vector<uint8_t> &dst)
+{
+    // nothing below the threshold is compressed, an empty payload never comes with a header
+    size_t decodedSize = GetDecodedSize(LZ_V1, src);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(decodedSize != 0, false, PASTEBOARD_MODULE_SERVICE, "payload header invalid");
+    dst.clear();
+    dst.reserve(decodedSize);
+    size_t pos = HEADER_SIZE;
+    while (pos < src.size()) {
+        uint8_t token = src[pos++];
+        size_t literals = token >> LITERAL_SHIFT;
+        if (literals == RUN_MASK && !ReadLength(src, pos, literals)) {
+            return false;
+        }
+        if (literals > src.size() - pos || literals > decodedSize - dst.size()) {
+            return false;
+        }
+        dst.insert(dst.end(), src.begin() + pos, src.begin() + pos + literals);
+        pos += literals;
+        if (pos == src.size()) {
+            break;
+        }
+        if (src.size() - pos < sizeof(uint16_t)) {
+            return false;
+        }
+        size_t offset = src[pos] | (static_cast<size_t>(src[pos + 1]) << BITS_PER_BYTE);
+        pos += sizeof(uint16_t);
+        size_t length = token & RUN_MASK;
+        if (length == RUN_MASK && !ReadLength(src, pos, length)) {
+            return false;
+        }
+        length += MIN_MATCH;
+        if (offset == 0 || offset > dst.size() || length > decodedSize - dst.size()) {
+            return false;
+        }
+        // byte by byte, a match may overlap the bytes it produces
+        size_t from = dst.size() - offset;
+        size_t to = dst.size();
+        dst.resize(to + length);
+        for (size_t i = 0; i < length; ++i) {
+            dst[to + i] = dst[from + i];
+        }
+    }
+    return dst.size() == decodedSize;
+}
+} // namespace OHOS::MiscServices
@@ -13,7 +13,10 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #include "default_clip.h"
+#include "pasteboard_error.h"
 #include "pasteboard_event_dfx.h"
 #include "pasteboard_hilog.h"
 
@@ -153,6 +156,30 @@ bool ClipPlugin::IsWiFiEnable()
     return false;
 }
 
+bool ClipPlugin::IsFrameSupported()
+{
+    return false;
+}
+
+int32_t ClipPlugin::SetPasteDataFrames(const GlobalEvent &event, const std::vector<std::vector<uint8_t>> &frames,
+    uint32_t version, const std::vector<uint8_t> &mimeTypes)
+{
+    (void)event;
+    (void)frames;
+    (void)version;
+    (void)mimeTypes;
+    return static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR);
+}
+
+std::pair<int32_t, int32_t> ClipPlugin::GetPasteDataFrame(const GlobalEvent &event, uint8_t frameIndex,
+    std::vector<uint8_t> &frame)
+{
+    (void)event;
+    (void)frameIndex;
+    (void)frame;
+    return { static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR), 0 };
+}
+
 bool ClipPlugin::GlobalEvent::Marshal(Serializable::json &node) const
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(SetValue(node, version, GET_NAME(version)),
@@ -175,6 +202,18 @@ bool ClipPlugin::GlobalEvent::Marshal(Serializable::json &node) const
         false,  PASTEBOARD_MODULE_SERVICE, "Set dataType fail");
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(SetValue(node, syncTime, GET_NAME(syncTime)),
         false,  PASTEBOARD_MODULE_SERVICE, "Set syncTime fail");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(SetValue(node, utdTypes, GET_NAME(utdTypes)),
+        false,  PASTEBOARD_MODULE_SERVICE, "Set utdTypes fail");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(SetValue(node, recordCount, GET_NAME(recordCount)),
+        false,  PASTEBOARD_MODULE_SERVICE, "Set recordCount fail");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(SetValue(node, payloadVersion, GET_NAME(payloadVersion)),
+        false,  PASTEBOARD_MODULE_SERVICE, "Set payloadVersion fail");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(SetValue(node, acceptPayloadVersion, GET_NAME(acceptPayloadVersion)),
+        false,  PASTEBOARD_MODULE_SERVICE, "Set acceptPayloadVersion fail");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(SetValue(node, acceptFrames, GET_NAME(acceptFrames)),
+        false,  PASTEBOARD_MODULE_SERVICE, "Set acceptFrames fail");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(SetValue(node, acceptEventVersion, GET_NAME(acceptEventVersion)),
+        false,  PASTEBOARD_MODULE_SERVICE, "Set acceptEventVersion fail");
     return true;
 }
 
@@ -200,9 +239,35 @@ bool ClipPlugin::GlobalEvent::Unmarshal(const Serializable::json &node)
         false,  PASTEBOARD_MODULE_SERVICE, "Get dataType fail");
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(GetValue(node, GET_NAME(syncTime), syncTime),
         false,  PASTEBOARD_MODULE_SERVICE, "Get syncTime fail");
+    // optional, events of older senders do not carry them
+    if (!GetValue(node, GET_NAME(utdTypes), utdTypes) || !GetValue(node, GET_NAME(recordCount), recordCount)) {
+        utdTypes.clear();
+        recordCount = 0;
+    }
+    if (!GetValue(node, GET_NAME(payloadVersion), payloadVersion) ||
+        !GetValue(node, GET_NAME(acceptPayloadVersion), acceptPayloadVersion)) {
+        payloadVersion = 0;
+        acceptPayloadVersion = 0;
+    }
+    if (!GetValue(node, GET_NAME(acceptFrames), acceptFrames)) {
+        acceptFrames = false;
+    }
+    if (!GetValue(node, GET_NAME(acceptEventVersion), acceptEventVersion)) {
+        acceptEventVersion = 0;
+    }
     return true;
 }
 
+bool ClipPlugin::GlobalEvent::HasMimeType(const std::string &mimeType) const
+{
+    return std::find(dataType.begin(), dataType.end(), mimeType) != dataType.end();
+}
+
+bool ClipPlugin::GlobalEvent::HasUtdType(const std::string &utdType) const
+{
+    return std::find(utdTypes.begin(), utdTypes.end(), utdType) != utdTypes.end();
+}
+
 void ClipPlugin::ChangeStoreStatus(int32_t userId)
 {
     (void)userId;
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "clip/loopback_clip.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "clip/clip_event_codec.h"
+#include "pasteboard_error.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+using namespace std::chrono;
+
+struct LoopbackLink {
+    struct Clip {
+        ClipPlugin::GlobalEvent event;
+        // the event as the peer decoded it from the wire
+        ClipPlugin::GlobalEvent peerEvent;
+        std::vector<uint8_t> payload;
+        std::vector<std::vector<uint8_t>> frames;
+        std::vector<uint8_t> mimeTypes;
+    };
+
+    std::mutex mutex;
+    std::map<int32_t, Clip> clips;
+    ClipPlugin::DelayDataCallback dataCallback;
+    ClipPlugin::DelayEntryCallback entryCallback;
+    steady_clock::time_point busyUntil;
+    uint64_t transferredBytes = 0;
+};
+
+namespace {
+constexpr uint64_t NANOS_PER_SECOND = 1000000000;
+// a peer pasting a delayed clip asks for the primary entry of each record first
+constexpr uint8_t DELAY_DATA_PRIMARY = 1;
+
+bool IsSameClip(const ClipPlugin::GlobalEvent &lhs, const ClipPlugin::GlobalEvent &rhs)
+{
+    return lhs.seqId == rhs.seqId && lhs.dataId == rhs.dataId;
+}
+
+bool ToPeerEvent(const ClipPlugin::GlobalEvent &event, const LoopbackClip::LinkConfig &config,
+    ClipPlugin::GlobalEvent &peerEvent)
+{
+    if (!ClipEventCodec::Decode(ClipEventCodec::Encode(event, config.eventVersion), peerEvent)) {
+        return false;
+    }
+    peerEvent.deviceId = config.peerId;
+    return true;
+}
+} // namespace
+
+LoopbackClip::Factory::Factory() : Factory(LinkConfig()) {}
+
+LoopbackClip::Factory::Factory(const LinkConfig &config) : config_(config), link_(std::make_shared<LoopbackLink>()) {}
+
+ClipPlugin *LoopbackClip::Factory::Create()
+{
+    return new (std::nothrow) LoopbackClip(config_, link_);
+}
+
+bool LoopbackClip::Factory::Destroy(ClipPlugin *plugin)
+{
+    delete plugin;
+    return true;
+}
+
+LoopbackClip::LoopbackClip() : LoopbackClip(LinkConfig()) {}
+
+LoopbackClip::LoopbackClip(const LinkConfig &config) : LoopbackClip(config, std::make_shared<LoopbackLink>()) {}
+
+LoopbackClip::LoopbackClip(const LinkConfig &config, std::shared_ptr<LoopbackLink> link)
+    : config_(config), link_(std::move(link))
+{
+}
+
+int32_t LoopbackClip::SetPasteData(const GlobalEvent &event, const std::vector<uint8_t> &data, uint32_t version,
+    const std::vector<uint8_t> &mimeTypes)
+{
+    (void)version;
+    GlobalEvent peerEvent;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ToPeerEvent(event, config_, peerEvent),
+        static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR), PASTEBOARD_MODULE_SERVICE,
+        "loopback event lost, seqId=%{public}hu", event.seqId);
+    // only the event goes to the peer now, the payload waits on this side until it is fetched
+    std::this_thread::sleep_for(milliseconds(config_.latencyMs));
+    std::lock_guard<std::mutex> lock(link_->mutex);
+    link_->clips[event.user] = LoopbackLink::Clip{ event, peerEvent, data, {}, mimeTypes };
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "loopback clip set, seqId=%{public}hu, size=%{public}zu",
+        event.seqId, data.size());
+    return 0;
+}
+
+std::pair<int32_t, int32_t> LoopbackClip::GetPasteData(const GlobalEvent &event, std::vector<uint8_t> &data)
+{
+    GlobalEvent senderEvent;
+    DelayDataCallback dataCallback;
+    {
+        std::lock_guard<std::mutex> lock(link_->mutex);
+        auto it = link_->clips.find(event.user);
+        if (it == link_->clips.end() || !IsSameClip(it->second.peerEvent, event)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "no loopback clip, seqId=%{public}hu", event.seqId);
+            return std::make_pair(static_cast<int32_t>(PasteboardError::NO_DATA_ERROR), 0);
+        }
+        if (!it->second.frames.empty()) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "loopback clip is framed, seqId=%{public}hu", event.seqId);
+            return std::make_pair(static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR), 0);
+        }
+        senderEvent = it->second.event;
+        dataCallback = senderEvent.isDelay ? link_->dataCallback : nullptr;
+        if (dataCallback == nullptr) {
+            data = it->second.payload;
+        }
+    }
+    // like the distributed plugin, the payload of a delayed clip is asked from the sender when it is pasted
+    if (dataCallback != nullptr) {
+        int32_t ret = dataCallback(senderEvent, DELAY_DATA_PRIMARY, data);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK),
+            std::make_pair(ret, 0), PASTEBOARD_MODULE_SERVICE, "loopback delay data failed, ret=%{public}d", ret);
+    }
+    return std::make_pair(0, Transfer(data.size()));
+}
+
+std::vector<ClipPlugin::GlobalEvent> LoopbackClip::GetTopEvents(uint32_t topN, int32_t user)
+{
+    std::lock_guard<std::mutex> lock(link_->mutex);
+    auto it = link_->clips.find(user);
+    if (topN == 0 || it == link_->clips.end()) {
+        return std::vector<GlobalEvent>();
+    }
+    return { it->second.peerEvent };
+}
+
+void LoopbackClip::Clear(int32_t user)
+{
+    std::lock_guard<std::mutex> lock(link_->mutex);
+    link_->clips.erase(user);
+}
+
+int32_t LoopbackClip::ApplyAdvancedResource(const std::string &deviceId)
+{
+    (void)deviceId;
+    return 0;
+}
+
+int32_t LoopbackClip::PublishServiceState(const std::string &networkId, ServiceStatus status)
+{
+    (void)networkId;
+    (void)status;
+    return 0;
+}
+
+void LoopbackClip::RegisterDelayCallback(const DelayDataCallback &dataCallback,
+    const DelayEntryCallback &entryCallback)
+{
+    std::lock_guard<std::mutex> lock(link_->mutex);
+    link_->dataCallback = dataCallback;
+    link_->entryCallback = entryCallback;
+}
+
+int32_t LoopbackClip::GetPasteDataEntry(const GlobalEvent &event, uint32_t recordId, const std::string &utdId,
+    std::vector<uint8_t> &rawData)
+{
+    GlobalEvent senderEvent;
+    DelayEntryCallback entryCallback;
+    {
+        std::lock_guard<std::mutex> lock(link_->mutex);
+        auto it = link_->clips.find(event.user);
+        if (it == link_->clips.end() || !IsSameClip(it->second.peerEvent, event)) {
+            return static_cast<int32_t>(PasteboardError::NO_DATA_ERROR);
+        }
+        senderEvent = it->second.event;
+        entryCallback = link_->entryCallback;
+    }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(entryCallback != nullptr,
+        static_cast<int32_t>(PasteboardError::NO_DELAY_GETTER), PASTEBOARD_MODULE_SERVICE, "no entry callback");
+    // the sender answers with its own event, as it would on the other device
+    int32_t ret = entryCallback(senderEvent, recordId, utdId, rawData);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
+        PASTEBOARD_MODULE_SERVICE, "loopback entry failed, recordId=%{public}u, ret=%{public}d", recordId, ret);
+    Transfer(rawData.size());
+    return 0;
+}
+
+int32_t LoopbackClip::GetMimeTypes(std::vector<uint8_t> &mimeTypes, const GlobalEvent &event)
+{
+    {
+        std::lock_guard<std::mutex> lock(link_->mutex);
+        auto it = link_->clips.find(event.user);
+        if (it == link_->clips.end() || !IsSameClip(it->second.peerEvent, event)) {
+            return static_cast<int32_t>(PasteboardError::NO_DATA_ERROR);
+        }
+        mimeTypes = it->second.mimeTypes;
+    }
+    Transfer(mimeTypes.size());
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
+bool LoopbackClip::IsWiFiEnable()
+{
+    return true;
+}
+
+bool LoopbackClip::IsFrameSupported()
+{
+    return config_.frameSupported;
+}
+
+int32_t LoopbackClip::SetPasteDataFrames(const GlobalEvent &event, const std::vector<std::vector<uint8_t>> &frames,
+    uint32_t version, const std::vector<uint8_t> &mimeTypes)
+{
+    (void)version;
+    if (!config_.frameSupported) {
+        return static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR);
+    }
+    GlobalEvent peerEvent;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ToPeerEvent(event, config_, peerEvent),
+        static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR), PASTEBOARD_MODULE_SERVICE,
+        "loopback event lost, seqId=%{public}hu", event.seqId);
+    std::this_thread::sleep_for(milliseconds(config_.latencyMs));
+    std::lock_guard<std::mutex> lock(link_->mutex);
+    link_->clips[event.user] = LoopbackLink::Clip{ event, peerEvent, {}, frames, mimeTypes };
+    return 0;
+}
+
+std::pair<int32_t, int32_t> LoopbackClip::GetPasteDataFrame(const GlobalEvent &event, uint8_t frameIndex,
+    std::vector<uint8_t> &frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(link_->mutex);
+        auto it = link_->clips.find(event.user);
+        if (it == link_->clips.end() || !IsSameClip(it->second.peerEvent, event) ||
+            frameIndex >= it->second.frames.size()) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "no loopback frame %{public}hhu, seqId=%{public}hu",
+                frameIndex, event.seqId);
+            return std::make_pair(static_cast<int32_t>(PasteboardError::NO_DATA_ERROR), 0);
+        }
+        frame = it->second.frames[frameIndex];
+    }
+    return std::make_pair(0, Transfer(frame.size()));
+}
+
+uint64_t LoopbackClip::GetTransferredBytes() const
+{
+    std::lock_guard<std::mutex> lock(link_->mutex);
+    return link_->transferredBytes;
+}
+
+int32_t LoopbackClip::Transfer(size_t size)
+{
+    auto begin = steady_clock::now();
+    auto latency = milliseconds(config_.latencyMs);
+    auto wire = config_.bandwidth == 0 ? nanoseconds(0) :
+        nanoseconds(static_cast<uint64_t>(size) * NANOS_PER_SECOND / config_.bandwidth);
+    steady_clock::time_point done;
+    {
+        // the request takes one latency, then the answers of concurrent fetches queue on the wire
+        std::lock_guard<std::mutex> lock(link_->mutex);
+        auto start = std::max(begin + latency, link_->busyUntil);
+        link_->busyUntil = start + wire;
+        done = link_->busyUntil + latency;
+        link_->transferredBytes += size;
+    }
+    std::this_thread::sleep_until(done);
+    return static_cast<int32_t>(duration_cast<milliseconds>(steady_clock::now() - begin).count());
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_EVENT_CODEC_H
+#define OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_EVENT_CODEC_H
+
+#include <cstdint>
+#include <vector>
+
+#include "clip/clip_plugin.h"
+
+namespace OHOS::MiscServices {
+/*
+ * Wire format of the GlobalEvent a plugin exchanges with other devices. Every sender announces the
+ * highest version it decodes in GlobalEvent::acceptEventVersion; peers that did not announce one get
+ * the Marshall JSON, which Decode still takes.
+ */
+class API_EXPORT ClipEventCodec final {
+public:
+    enum Version : uint8_t {
+        JSON = 0,
+        // fixed width little endian fields, strings and lists prefixed with their length
+        BINARY_V1 = 1,
+        LATEST = BINARY_V1,
+    };
+
+    static std::vector<uint8_t> Encode(const ClipPlugin::GlobalEvent &event, uint8_t peerVersion);
+    static bool Decode(const std::vector<uint8_t> &buffer, ClipPlugin::GlobalEvent &event);
+
+private:
+    static bool EncodeBinary(const ClipPlugin::GlobalEvent &event, std::vector<uint8_t> &buffer);
+    static bool DecodeBinary(const std::vector<uint8_t> &buffer, ClipPlugin::GlobalEvent &event);
+};
+} // namespace OHOS::MiscServices
+#endif // OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_EVENT_CODEC_H
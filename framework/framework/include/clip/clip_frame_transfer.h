@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_FRAME_TRANSFER_H
+#define OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_FRAME_TRANSFER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "api/visibility.h"
+
+namespace OHOS::MiscServices {
+/*
+ * A large clip goes to other devices in frames of whole records, GlobalEvent::frameNum tells how many.
+ * Every frame is a PasteData encoding of its own, so the receiver decodes the records of a frame as soon
+ * as it arrives, and each one is compressed on its own with the ClipPayloadCodec version appended.
+ */
+class API_EXPORT ClipFrameTransfer final {
+public:
+    static constexpr size_t FRAME_SIZE = 512 * 1024;
+    static constexpr size_t MAX_FRAMES = UINT8_MAX;
+
+    // index of the first record of each frame, a single frame when the records fit in one
+    static std::vector<size_t> PlanFrames(const std::vector<size_t> &recordSizes, size_t frameSize = FRAME_SIZE);
+    // compresses frame when peerVersion allows it and appends the version used
+    static void SealFrame(std::vector<uint8_t> &frame, uint8_t peerVersion);
+    // size of a sealed frame once opened, 0 when it is malformed
+    static size_t GetOpenedSize(const std::vector<uint8_t> &frame);
+    static bool OpenFrame(std::vector<uint8_t> &frame);
+};
+
+/*
+ * Pulls the frames of one clip in order. Frame i + 1 is fetched while frame i is decoded, by one fetcher thread
+ * per Read, and a frame is acknowledged once it is decoded; after a failed fetch Read starts again at the first
+ * frame not acknowledged.
+ */
+class API_EXPORT ClipFrameReader final {
+public:
+    // both return 0 on success, like ClipPlugin::GetPasteData
+    using FetchFunc = std::function<int32_t(uint8_t frameIndex, std::vector<uint8_t> &frame)>;
+    using DecodeFunc = std::function<int32_t(uint8_t frameIndex, std::vector<uint8_t> &frame)>;
+
+    explicit ClipFrameReader(uint8_t frameNum);
+    int32_t Read(const FetchFunc &fetch, const DecodeFunc &decode);
+    uint8_t GetAckedFrames() const;
+    bool IsComplete() const;
+
+private:
+    // hands one fetched frame at a time from the fetcher thread to the decoding one
+    struct PrefetchSlot {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<uint8_t> frame;
+        int32_t ret = 0;
+        bool isFull = false;
+        bool isStopped = false;
+    };
+
+    void Prefetch(const FetchFunc &fetch, PrefetchSlot &slot, uint8_t first) const;
+
+    const uint8_t frameNum_;
+    uint8_t ackedFrames_ = 0;
+};
+} // namespace OHOS::MiscServices
+#endif // OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_FRAME_TRANSFER_H
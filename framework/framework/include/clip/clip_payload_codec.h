@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_PAYLOAD_CODEC_H
+#define OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_PAYLOAD_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "api/visibility.h"
+
+namespace OHOS::MiscServices {
+/*
+ * Compresses the clip sent to other devices. The version a payload is encoded with travels in
+ * GlobalEvent::payloadVersion, and every sender announces the highest version it decodes in
+ * GlobalEvent::acceptPayloadVersion; a payload is only compressed for peers that announced it.
+ */
+class API_EXPORT ClipPayloadCodec final {
+public:
+    enum Version : uint8_t {
+        RAW = 0,
+        // byte oriented LZ77 with a 64K window, literal runs and matches share one token byte
+        LZ_V1 = 1,
+        LATEST = LZ_V1,
+    };
+    static constexpr size_t COMPRESS_THRESHOLD = 2 * 1024;
+
+    // compresses data in place when peerVersion allows it and it pays off, returns the version used
+    static uint8_t Encode(std::vector<uint8_t> &data, uint8_t peerVersion);
+    // size of data once decoded, 0 for a malformed compressed payload
+    static size_t GetDecodedSize(uint8_t version, const std::vector<uint8_t> &data);
+    static bool Decode(uint8_t version, std::vector<uint8_t> &data);
+
+private:
+    static bool Compress(const std::vector<uint8_t> &src, std::vector<uint8_t> &dst);
+    static bool Decompress(const std::vector<uint8_t> &src, std::vector<uint8_t> &dst);
+};
+} // namespace OHOS::MiscServices
+#endif // OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_PAYLOAD_CODEC_H
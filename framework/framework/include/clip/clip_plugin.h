@@ -43,11 +43,28 @@ public:
         std::string deviceId;
         std::string account;
         std::vector<std::string> dataType;
+        // filled by senders that describe the clip in the event, older senders leave them empty
+        std::vector<std::string> utdTypes;
+        uint32_t recordCount = 0;
+        // ClipPayloadCodec version of the payload, and the highest one the sender decodes; older senders leave 0
+        uint8_t payloadVersion = 0;
+        uint8_t acceptPayloadVersion = 0;
+        // the sender takes clips in frames, see ClipFrameTransfer; older senders leave false
+        bool acceptFrames = false;
+        // highest ClipEventCodec version the sender decodes; older senders leave 0, they get JSON
+        uint8_t acceptEventVersion = 0;
 
         bool operator==(const GlobalEvent globalEvent)
         {
             return globalEvent.seqId == this->seqId && globalEvent.deviceId == this->deviceId;
         }
+        // type queries can be answered from the event alone, without fetching the payload
+        bool HasTypeInfo() const
+        {
+            return recordCount > 0;
+        }
+        bool HasMimeType(const std::string &mimeType) const;
+        bool HasUtdType(const std::string &utdType) const;
         bool Marshal(json &node) const override;
         bool Unmarshal(const json &node) override;
     };
@@ -90,6 +107,12 @@ public:
     virtual void SetMaxLocalCapacity(int64_t maxLocalCapacity);
     virtual int32_t GetMimeTypes(std::vector<uint8_t> &mimeTypes, const GlobalEvent &event);
     virtual bool IsWiFiEnable();
+    // a plugin that moves clips in frames overrides these three, by default a clip is one payload
+    virtual bool IsFrameSupported();
+    virtual int32_t SetPasteDataFrames(const GlobalEvent &event, const std::vector<std::vector<uint8_t>> &frames,
+        uint32_t version, const std::vector<uint8_t> &mimeTypes);
+    virtual std::pair<int32_t, int32_t> GetPasteDataFrame(const GlobalEvent &event, uint8_t frameIndex,
+        std::vector<uint8_t> &frame);
 
 private:
     static std::map<std::string, Factory *> factories_;
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_LOOPBACK_CLIP_H
+#define OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_LOOPBACK_CLIP_H
+
+#include <memory>
+#include <string>
+
+#include "clip/clip_event_codec.h"
+#include "clip/clip_plugin.h"
+
+namespace OHOS::MiscServices {
+struct LoopbackLink;
+
+/*
+ * An in-process ClipPlugin that plays the remote device, for tests and benchmarks on a single host.
+ * A clip set through it comes back from GetTopEvents as if peerId had copied it, and every fetch pays the
+ * configured latency both ways plus the time the bytes take on a link of the configured bandwidth.
+ * Plugins created by one Factory share a link, so two services in one process can copy and paste across it.
+ * The payload and the entries of a delayed clip are asked from the sender's delay callbacks when it is pasted.
+ */
+class API_EXPORT LoopbackClip : public ClipPlugin {
+public:
+    struct LinkConfig {
+        uint32_t latencyMs = 0;
+        // bytes per second, 0 for a link without a limit
+        uint64_t bandwidth = 0;
+        bool frameSupported = true;
+        std::string peerId = "loopback";
+        // ClipEventCodec version events cross the link in, JSON plays a peer of an older release
+        uint8_t eventVersion = ClipEventCodec::LATEST;
+    };
+
+    class Factory : public ClipPlugin::Factory {
+    public:
+        Factory();
+        explicit Factory(const LinkConfig &config);
+        ClipPlugin *Create() override;
+        bool Destroy(ClipPlugin *plugin) override;
+
+    private:
+        LinkConfig config_;
+        std::shared_ptr<LoopbackLink> link_;
+    };
+
+    LoopbackClip();
+    explicit LoopbackClip(const LinkConfig &config);
+
+    int32_t SetPasteData(const GlobalEvent &event, const std::vector<uint8_t> &data, uint32_t version,
+        const std::vector<uint8_t> &mimeTypes) override;
+    std::pair<int32_t, int32_t> GetPasteData(const GlobalEvent &event, std::vector<uint8_t> &data) override;
+    std::vector<GlobalEvent> GetTopEvents(uint32_t topN, int32_t user) override;
+    void Clear(int32_t user) override;
+    int32_t ApplyAdvancedResource(const std::string &deviceId) override;
+    int32_t PublishServiceState(const std::string &networkId, ServiceStatus status) override;
+    void RegisterDelayCallback(const DelayDataCallback &dataCallback, const DelayEntryCallback &entryCallback) override;
+    int32_t GetPasteDataEntry(const GlobalEvent &event, uint32_t recordId, const std::string &utdId,
+        std::vector<uint8_t> &rawData) override;
+    int32_t GetMimeTypes(std::vector<uint8_t> &mimeTypes, const GlobalEvent &event) override;
+    bool IsWiFiEnable() override;
+    bool IsFrameSupported() override;
+    int32_t SetPasteDataFrames(const GlobalEvent &event, const std::vector<std::vector<uint8_t>> &frames,
+        uint32_t version, const std::vector<uint8_t> &mimeTypes) override;
+    std::pair<int32_t, int32_t> GetPasteDataFrame(const GlobalEvent &event, uint8_t frameIndex,
+        std::vector<uint8_t> &frame) override;
+
+    // bytes that crossed the link so far, both ways
+    uint64_t GetTransferredBytes() const;
+
+private:
+    LoopbackClip(const LinkConfig &config, std::shared_ptr<LoopbackLink> link);
+    // blocks for the time a message of size bytes takes to cross the link, returns it in ms
+    int32_t Transfer(size_t size);
+
+    const LinkConfig config_;
+    std::shared_ptr<LoopbackLink> link_;
+};
+} // namespace OHOS::MiscServices
+#endif // OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_CLIPS_LOOPBACK_CLIP_H
@@ -15,6 +15,11 @@
 #ifndef PASTE_BOARD_DATA_H
 #define PASTE_BOARD_DATA_H
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
 #include "paste_data_record.h"
 #include "pasteboard_event_common.h"
 
@@ -45,6 +50,17 @@ struct API_EXPORT PasteDataProperty : public TLVWriteable, public TLVReadable {
     size_t CountTLV() const override;
 };
 
+// types of a clip collected once, answers the type queries of a stored clip without walking its records
+struct API_EXPORT PasteDataTypeIndex {
+    std::vector<std::string> mimeTypes; // sorted, same as PasteData::GetMimeTypes
+    std::unordered_set<std::string> mimeTypeSet;
+    std::unordered_set<std::string> utdTypes;
+
+    bool HasMimeType(const std::string &mimeType) const;
+    bool HasUtdType(const std::string &utdType) const;
+    bool HasAnyMimeType(const std::vector<std::string> &mimeTypes) const;
+};
+
 class API_EXPORT PasteData : public TLVWriteable, public TLVReadable, public Parcelable {
 public:
     static constexpr const std::uint32_t MAX_RECORD_NUM = 512;
@@ -53,6 +69,15 @@ public:
     PasteData(const PasteData &data);
     PasteData &operator=(const PasteData &data);
     explicit PasteData(std::vector<std::shared_ptr<PasteDataRecord>> records);
+    // like operator= but shares the records with data instead of cloning them, a shared record must be
+    // detached with DetachRecordAt before it is changed
+    void ShareFrom(const PasteData &data);
+    // copy-on-write: replace the record at index with a private clone and return the clone
+    std::shared_ptr<PasteDataRecord> DetachRecordAt(std::size_t index);
+    // like ShareFrom but only shares the records [begin, end), a frame of a clip sent in parts
+    void ShareRecords(const PasteData &data, std::size_t begin, std::size_t end);
+    // appends the records of a later frame, they keep their record ids
+    void AppendRecords(const PasteData &frame);
 
     void AddHtmlRecord(const std::string &html);
     void AddKvRecord(const std::string &mimeType, const std::vector<uint8_t> &arrayBuffer);
@@ -76,10 +101,13 @@ public:
     std::shared_ptr<PasteDataRecord> GetRecordById(uint32_t recordId) const;
     std::size_t GetRecordCount() const;
     bool RemoveRecordAt(std::size_t number);
+    // removes every record whose flag is set in one pass, returns the number of removed records
+    std::size_t RemoveRecords(const std::vector<bool> &removed);
     bool ReplaceRecordAt(std::size_t number, std::shared_ptr<PasteDataRecord> record);
     void RemoveEmptyEntry();
     bool HasMimeType(const std::string &mimeType);
     bool HasUtdType(const std::string &utdType);
+    std::shared_ptr<const PasteDataTypeIndex> BuildTypeIndex() const;
     PasteDataProperty GetProperty() const;
     void SetProperty(const PasteDataProperty &property);
     ShareOption GetShareOption();
@@ -118,6 +146,24 @@ public:
     bool EncodeTLV(WriteOnlyBuffer &buffer) const override;
     bool DecodeTLV(ReadOnlyBuffer &buffer) override;
     size_t CountTLV() const override;
+    // local TLV of the record list exactly as EncodeTLV writes it, nullptr on failure
+    std::shared_ptr<const std::vector<uint8_t>> EncodeRecordsTLV() const;
+    // the same record list written into a buffer of exactly CountRecordsTLV bytes
+    bool EncodeRecordsTLV(uint8_t *buffer, size_t size) const;
+    size_t CountRecordsTLV() const;
+    // splice records encoded earlier by EncodeRecordsTLV into local encodings instead of encoding records_ again,
+    // they must match records_ when set; dropped by every change to the record list, not carried over by copies
+    void SetEncodedRecords(std::shared_ptr<const std::vector<uint8_t>> encodedRecords);
+    // records read by a later Decode stay encoded until they are needed, GetRecordAt, GetPrimaryText and the other
+    // primary getters decode only the records they reach; const getters may run on several threads at once,
+    // a record that fails to decode then reads as nullptr
+    void SetLazyRecordDecode(bool lazy);
+    // records decoded so far that read as nullptr because their bytes were corrupted, nonzero means partial data
+    std::size_t GetUndecodedRecordCount() const;
+    using RecordFixup = std::function<void(PasteDataRecord &record)>;
+    // apply fixup to every record now, or to a record still encoded when it is decoded, so fixup must depend on
+    // nothing but the record it is given
+    void FixupRecords(const RecordFixup &fixup);
 
     bool IsValid() const;
     void SetInvalid();
@@ -172,11 +218,25 @@ private:
     uint32_t recordId_ = 0;
     size_t textSize_ = 0;
     PasteDataProperty props_;
-    std::vector<std::shared_ptr<PasteDataRecord>> records_;
+    // holds nullptr for each record lazyRecords_ still keeps encoded
+    mutable std::vector<std::shared_ptr<PasteDataRecord>> records_;
     std::pair<std::string, int32_t> originAuthority_;
     std::string pasteId_;
+    std::shared_ptr<const std::vector<uint8_t>> encodedRecords_;
+    bool lazyDecode_ = false;
+    // guards lazyRecords_, recordFixups_, undecodedRecords_ and the records_ slots they fill in
+    mutable std::mutex lazyMutex_;
+    mutable std::shared_ptr<TLVLazyList> lazyRecords_;
+    mutable std::vector<RecordFixup> recordFixups_;
+    mutable std::size_t undecodedRecords_ = 0;
  
+    bool ReadRecords(ReadOnlyBuffer &buffer, const TLVHead &head);
+    std::shared_ptr<const TLVLazyList> UntouchedLazyRecords() const;
+    void DecodeRecordAt(std::size_t index) const;
+    void DecodeRecordLocked(std::size_t index) const;
+    void DecodeRecords() const;
     void RefreshMimeProp();
+    void CopyEnvelope(const PasteData &data);
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -53,6 +53,7 @@ public:
     std::shared_ptr<MineCustomData> ConvertToCustomData() const;
 
     void SetValue(const EntryValue &value);
+    void SetValue(EntryValue &&value);
     EntryValue GetValue() const;
     void SetUtdId(const std::string &utdId);
     std::string GetUtdId() const;
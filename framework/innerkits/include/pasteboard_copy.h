@@ -16,6 +16,9 @@
 #ifndef PASTE_BOARD_COPY_H
 #define PASTE_BOARD_COPY_H
 
+#include <mutex>
+#include <set>
+
 #include "pasteboard_client.h"
 
 namespace OHOS {
@@ -39,11 +42,24 @@ struct CopyInfo {
     }
 };
 
+class PasteboardCopyProgress;
+
 class PasteBoardCopyFile {
 public:
     static PasteBoardCopyFile &GetInstance();
     int32_t CopyPasteData(PasteData &pasteData, std::shared_ptr<GetDataParams> dataParams);
 private:
+    struct CopyJob {
+        size_t recordIndex = 0;
+        std::shared_ptr<PasteDataRecord> record;
+        std::string srcUri;
+        std::shared_ptr<CopyInfo> copyInfo;
+        bool recheckDest = false;
+        bool copied = false;
+        bool keep = false;
+        int32_t ret = 0;
+    };
+
     PasteBoardCopyFile() = default;
     ~PasteBoardCopyFile() = default;
     DISALLOW_COPY_AND_MOVE(PasteBoardCopyFile);
@@ -56,11 +72,18 @@ private:
         std::shared_ptr<CopyInfo> copyInfo);
     static void OnProgressNotify(std::shared_ptr<GetDataParams> params);
     static int32_t CopyFileData(PasteData &pasteData, std::shared_ptr<GetDataParams> dataParams);
+    static int32_t CollectCopyJobs(PasteData &pasteData, std::shared_ptr<GetDataParams> dataParams,
+        std::vector<bool> &removed, std::vector<CopyJob> &jobs);
+    static void RunCopyJob(CopyJob &job, std::shared_ptr<GetDataParams> dataParams,
+        std::shared_ptr<PasteboardCopyProgress> progress);
 
     static void HandleProgress(int32_t index, const CopyInfo &info, uint32_t percentage,
         std::shared_ptr<GetDataParams> dataParams);
     static ProgressListener progressListener_;
     static std::atomic_bool canCancel_;
+    // the copies running now, a cancel reaches every one of them
+    static std::mutex inFlightMutex_;
+    static std::set<CopyInfo> inFlight_;
     static std::atomic_uint32_t recordSize_;
     static bool ShouldKeepRecord(int32_t &ret, const std::string &destUri, std::shared_ptr<PasteDataRecord> record);
 };
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_COPY_SCHEDULER_H
+#define PASTE_BOARD_COPY_SCHEDULER_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS::MiscServices {
+/*
+ * Runs the copies of one paste on a bounded set of workers. Jobs sharing a lane key (the destination path)
+ * run one after another in job order, so a later job sees what an earlier one wrote, other lanes run in
+ * parallel. The calling thread is one of the workers and Run returns once every job has finished. Once
+ * stopped returns true no further job is started, the jobs already running finish.
+ */
+class PasteboardCopyScheduler {
+public:
+    static constexpr size_t MAX_COPY_WORKERS = 4;
+    using Job = std::function<void(size_t job)>;
+    using Stopped = std::function<bool()>;
+
+    static void Run(const std::vector<std::string> &laneKeys, size_t maxWorkers, const Job &job,
+        const Stopped &stopped = nullptr);
+
+private:
+    static std::vector<std::vector<size_t>> BuildLanes(const std::vector<std::string> &laneKeys);
+};
+
+/*
+ * Sums the progress of copies running in parallel. Each slot counts 0 to 100 and the total only ever grows.
+ * The reporter runs without the lock on one thread at a time: a copy that advances the total while another
+ * one reports leaves its total to that thread, so reports arrive in increasing order, the last one is the
+ * latest total, and no copy waits for the reporter to return.
+ */
+class PasteboardCopyProgress {
+public:
+    static constexpr uint32_t SLOT_PERCENTAGE = 100;
+    using Reporter = std::function<void(size_t slot, uint64_t total)>;
+
+    PasteboardCopyProgress(size_t slotCount, Reporter reporter);
+    void Update(size_t slot, uint32_t percentage);
+    // counts the slot as done without reporting, for skipped or finished copies
+    void Complete(size_t slot);
+    uint64_t GetTotal();
+
+private:
+    bool Advance(size_t slot, uint32_t percentage);
+
+    std::mutex mutex_;
+    std::vector<uint32_t> percentages_;
+    uint64_t total_ = 0;
+    size_t latestSlot_ = 0;
+    uint64_t latestTotal_ = 0;
+    bool reporting_ = false;
+    Reporter reporter_;
+};
+} // namespace OHOS::MiscServices
+#endif // PASTE_BOARD_COPY_SCHEDULER_H
@@ -17,9 +17,8 @@
 #define PASTEBOARD_IMG_EXTRACTOR_H
 
 #include <libxml/HTMLparser.h>
-#include <libxml/xpath.h>
-#include <mutex>
 #include <string>
+#include <sys/types.h>
 #include <vector>
 
 namespace OHOS {
@@ -36,17 +35,25 @@ public:
     static constexpr const char *DOC_URI_PREFIX = "file://docs/";
 
 private:
+    struct FileUriCheck {
+        std::string uri;
+        std::string physicalPath;
+        bool resolved = false;
+        bool exists = false;
+    };
+
     PasteboardImgExtractor();
     ~PasteboardImgExtractor();
     static void FilterFileUris(std::vector<std::string> &uris);
     static void FilterImgUris(std::vector<std::string> &uris);
     static void FilterExistFileUris(std::vector<std::string> &uris, const std::string &bundleIndex, int32_t userId);
+    static bool ResolvePhysicalPath(const std::string &uri, const std::string &bundleIndex, const std::string &userId,
+        uid_t callingUid, std::string &physicalPath);
+    static bool CheckFileExists(const FileUriCheck &check);
+    static void CheckFilesExist(std::vector<FileUriCheck> &checks);
     static bool MatchImgExtension(const std::string &uri);
-    std::vector<std::string> FindImgsExcludingSpan(xmlDocPtr doc);
-    std::vector<std::string> ExecuteXPath(xmlDocPtr doc, const char *xpathExpr);
-    std::string SafeXmlToString(const xmlChar *xmlStr);
-
-    std::mutex mutex_;
+    static std::vector<std::string> CollectImgSrc(const std::string &htmlContent);
+    static void OnStartElement(void *ctx, const xmlChar *name, const xmlChar **atts);
 };
 } // namespace MiscServices
 } // namespace OHOS
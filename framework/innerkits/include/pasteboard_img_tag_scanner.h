@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_IMG_TAG_SCANNER_H
+#define PASTEBOARD_IMG_TAG_SCANNER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Linear time scanner for the img tags and src values PasteboardWebController splits out of webview html.
+ * It finds exactly what searching "<img.*?>" over the html and "src=(['\"])(.*?)\1" over each tag found,
+ * the ECMAScript way, used to find. Nothing is copied: visitors get [begin, end) positions into the
+ * scanned string, so memory does not grow with the html.
+ */
+class PasteboardImgTagScanner {
+public:
+    using Visitor = std::function<void(size_t begin, size_t end)>;
+
+    // every img tag, from its '<' to its '>' included
+    static void ForEachImgTag(const std::string &html, const Visitor &visitor);
+    // every quoted src value in [begin, end) of text, quotes excluded
+    static void ForEachSrcValue(const std::string &text, size_t begin, size_t end, const Visitor &visitor);
+    // every src value of every img tag in one pass, positions are into html
+    static void ForEachImgSrc(const std::string &html, const Visitor &visitor);
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_IMG_TAG_SCANNER_H
@@ -49,6 +49,9 @@ private:
         const std::shared_ptr<std::string> html) noexcept;
     std::map<std::string, std::vector<uint8_t>> SplitHtmlWithImgSrcLabel(
         const std::vector<std::pair<std::string, uint32_t>> &matchVec) noexcept;
+    std::map<std::string, std::vector<uint8_t>> SplitHtmlWithImgSrcLabel(const std::string &html) noexcept;
+    void AddImgSrc(std::map<std::string, std::vector<uint8_t>> &imgSrcMap, std::string imgSrc,
+        uint32_t offset) noexcept;
     RecordList BuildPasteDataRecords(const std::map<std::string, std::vector<uint8_t>> &imgSrcMap,
         uint32_t recordId) noexcept;
     void RemoveInvalidImgSrc(const std::vector<std::string> &validImgSrcList,
@@ -16,6 +16,8 @@
 
 #include "paste_data.h"
 
+#include <algorithm>
+
 #include "int_wrapper.h"
 #include "ipc_skeleton.h"
 #include "long_wrapper.h"
@@ -81,6 +83,9 @@ PasteData::PasteData(const PasteData &data)
       textSize_(data.textSize_), originAuthority_(data.originAuthority_), pasteId_(data.pasteId_)
 { // LCOV_EXCL_START
     this->props_ = data.props_;
+    data.DecodeRecords();
+    // the copy drops records that failed to decode, it keeps reporting them
+    this->undecodedRecords_ = data.GetUndecodedRecordCount();
     for (const auto &item : data.records_) {
         if (item == nullptr) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is null");
@@ -107,6 +112,93 @@ PasteData &PasteData::operator=(const PasteData &data)
     if (this == &data) {
         return *this;
     }
+    CopyEnvelope(data);
+    data.DecodeRecords();
+    this->records_.clear();
+    this->lazyRecords_ = nullptr;
+    this->recordFixups_.clear();
+    this->encodedRecords_ = nullptr;
+    this->undecodedRecords_ = data.GetUndecodedRecordCount();
+    for (const auto &item : data.records_) {
+        if (item == nullptr) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is null");
+            continue;
+        }
+        this->records_.emplace_back(std::make_shared<PasteDataRecord>(*item));
+    }
+    return *this;
+} // LCOV_EXCL_STOP
+
+void PasteData::ShareFrom(const PasteData &data)
+{
+    if (this == &data) {
+        return;
+    }
+    CopyEnvelope(data);
+    data.DecodeRecords();
+    this->records_.clear();
+    this->lazyRecords_ = nullptr;
+    this->recordFixups_.clear();
+    this->encodedRecords_ = nullptr;
+    this->undecodedRecords_ = data.GetUndecodedRecordCount();
+    for (const auto &item : data.records_) {
+        if (item == nullptr) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is null");
+            continue;
+        }
+        this->records_.emplace_back(item);
+    }
+}
+
+void PasteData::ShareRecords(const PasteData &data, std::size_t begin, std::size_t end)
+{
+    CopyEnvelope(data);
+    data.DecodeRecords();
+    this->records_.clear();
+    this->lazyRecords_ = nullptr;
+    this->recordFixups_.clear();
+    this->encodedRecords_ = nullptr;
+    this->undecodedRecords_ = 0;
+    end = std::min(end, data.records_.size());
+    for (std::size_t index = begin; index < end; ++index) {
+        if (data.records_[index] == nullptr) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is null");
+            ++this->undecodedRecords_;
+            continue;
+        }
+        this->records_.emplace_back(data.records_[index]);
+    }
+}
+
+void PasteData::AppendRecords(const PasteData &frame)
+{
+    DecodeRecords();
+    frame.DecodeRecords();
+    encodedRecords_ = nullptr;
+    undecodedRecords_ += frame.GetUndecodedRecordCount();
+    for (const auto &item : frame.records_) {
+        if (item == nullptr) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is null");
+            continue;
+        }
+        this->records_.emplace_back(item);
+    }
+}
+
+std::shared_ptr<PasteDataRecord> PasteData::DetachRecordAt(std::size_t index)
+{
+    DecodeRecordAt(index);
+    if (index >= records_.size() || records_[index] == nullptr) {
+        return nullptr;
+    }
+    // the caller changes the detached record, the bytes encoded from the shared one no longer describe it
+    encodedRecords_ = nullptr;
+    records_[index] = std::make_shared<PasteDataRecord>(*records_[index]);
+    return records_[index];
+}
+
+void PasteData::CopyEnvelope(const PasteData &data)
+{
     this->originAuthority_ = data.originAuthority_;
     this->valid_ = data.valid_;
     this->isDraggedData_ = data.isDraggedData_;
@@ -115,22 +207,13 @@ PasteData &PasteData::operator=(const PasteData &data)
     this->isDelayRecord_ = data.isDelayRecord_;
     this->dataId_ = data.dataId_;
     this->props_ = data.props_;
-    this->records_.clear();
     this->deviceId_ = data.deviceId_;
     this->pasteId_ = data.pasteId_;
-    for (const auto &item : data.records_) {
-        if (item == nullptr) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "record is null");
-            continue;
-        }
-        this->records_.emplace_back(std::make_shared<PasteDataRecord>(*item));
-    }
     this->recordId_ = data.GetRecordId();
     this->textSize_ = data.textSize_;
     this->rawDataSize_ = data.rawDataSize_;
     this->userId_ = data.userId_;
-    return *this;
-} // LCOV_EXCL_STOP
+}
 
 PasteDataProperty PasteData::GetProperty() const
 { // LCOV_EXCL_START
@@ -176,6 +259,8 @@ void PasteData::AddRecord(std::shared_ptr<PasteDataRecord> record)
 { // LCOV_EXCL_START
     PASTEBOARD_CHECK_AND_RETURN_LOGE(record != nullptr, PASTEBOARD_MODULE_CLIENT, "record is null");
     record->SetRecordId(++recordId_);
+    DecodeRecords();
+    encodedRecords_ = nullptr;
 
     if (PasteBoardCommon::IsPasteboardService()) {
         props_.mimeTypes.emplace_back(record->GetMimeType());
@@ -194,8 +279,9 @@ void PasteData::AddRecord(const PasteDataRecord &record)
 std::vector<std::string> PasteData::GetMimeTypes()
 { // LCOV_EXCL_START
     std::set<std::string> mimeTypes;
+    DecodeRecords();
     for (const auto &item : records_) {
-        if (item->GetFrom() > 0 && item->GetRecordId() != item->GetFrom()) {
+        if (item == nullptr || (item->GetFrom() > 0 && item->GetRecordId() != item->GetFrom())) {
             continue;
         }
         auto itemTypes = item->GetMimeTypes();
@@ -207,6 +293,7 @@ std::vector<std::string> PasteData::GetMimeTypes()
 std::vector<std::string> PasteData::GetReportMimeTypes()
 { // LCOV_EXCL_START
     std::vector<std::string> mimeTypes;
+    DecodeRecords();
     uint32_t recordNum = records_.size();
     uint32_t maxReportNum = recordNum > MAX_REPORT_RECORD_NUM ? MAX_REPORT_RECORD_NUM : recordNum;
     for (uint32_t i = 0; i < maxReportNum; ++i) {
@@ -273,7 +360,11 @@ DataDescription PasteData::GetReportDescription()
 
 std::shared_ptr<std::string> PasteData::GetPrimaryHtml()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (std::size_t index = 0; index < records_.size(); ++index) {
+        auto item = GetRecordAt(index);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<std::string> primary = item->GetHtmlText();
         if (primary) {
             return primary;
@@ -284,7 +375,11 @@ std::shared_ptr<std::string> PasteData::GetPrimaryHtml()
 
 std::shared_ptr<PixelMap> PasteData::GetPrimaryPixelMap()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (std::size_t index = 0; index < records_.size(); ++index) {
+        auto item = GetRecordAt(index);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<PixelMap> primary = item->GetPixelMap();
         if (primary) {
             return primary;
@@ -295,7 +390,11 @@ std::shared_ptr<PixelMap> PasteData::GetPrimaryPixelMap()
 
 std::shared_ptr<OHOS::AAFwk::Want> PasteData::GetPrimaryWant()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (std::size_t index = 0; index < records_.size(); ++index) {
+        auto item = GetRecordAt(index);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<OHOS::AAFwk::Want> primary = item->GetWant();
         if (primary) {
             return primary;
@@ -306,7 +405,11 @@ std::shared_ptr<OHOS::AAFwk::Want> PasteData::GetPrimaryWant()
 
 std::shared_ptr<std::string> PasteData::GetPrimaryText()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (std::size_t index = 0; index < records_.size(); ++index) {
+        auto item = GetRecordAt(index);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<std::string> primary = item->GetPlainText();
         if (primary) {
             return primary;
@@ -317,7 +420,11 @@ std::shared_ptr<std::string> PasteData::GetPrimaryText()
 
 std::shared_ptr<OHOS::Uri> PasteData::GetPrimaryUri()
 { // LCOV_EXCL_START
-    for (const auto &item : records_) {
+    for (std::size_t index = 0; index < records_.size(); ++index) {
+        auto item = GetRecordAt(index);
+        if (item == nullptr) {
+            continue;
+        }
         std::shared_ptr<OHOS::Uri> primary = item->GetUri();
         if (primary) {
             return primary;
@@ -328,15 +435,17 @@ std::shared_ptr<OHOS::Uri> PasteData::GetPrimaryUri()
 
 std::shared_ptr<std::string> PasteData::GetPrimaryMimeType()
 { // LCOV_EXCL_START
-    if (records_.empty()) {
+    auto item = GetRecordAt(0);
+    if (item == nullptr) {
         return nullptr;
     }
-    return std::make_shared<std::string>(records_.front()->GetMimeType());
+    return std::make_shared<std::string>(item->GetMimeType());
 } // LCOV_EXCL_STOP
 
 std::shared_ptr<PasteDataRecord> PasteData::GetRecordAt(std::size_t index) const
 { // LCOV_EXCL_START
     if (records_.size() > index) {
+        DecodeRecordAt(index);
         return records_[index];
     } else {
         return nullptr;
@@ -345,6 +454,7 @@ std::shared_ptr<PasteDataRecord> PasteData::GetRecordAt(std::size_t index) const
 
 std::shared_ptr<PasteDataRecord> PasteData::GetRecordById(uint32_t recordId) const
 { // LCOV_EXCL_START
+    DecodeRecords();
     for (const auto &record : records_) {
         if (record != nullptr && record->GetRecordId() == recordId) {
             return record;
@@ -389,7 +499,9 @@ void PasteData::SetTokenId(uint32_t tokenId)
 
 bool PasteData::RemoveRecordAt(std::size_t number)
 { // LCOV_EXCL_START
+    DecodeRecords();
     if (records_.size() > number) {
+        encodedRecords_ = nullptr;
         records_.erase(records_.begin() + static_cast<std::int64_t>(number));
         RefreshMimeProp();
         return true;
@@ -398,8 +510,32 @@ bool PasteData::RemoveRecordAt(std::size_t number)
     }
 } // LCOV_EXCL_STOP
 
+std::size_t PasteData::RemoveRecords(const std::vector<bool> &removed)
+{
+    DecodeRecords();
+    std::size_t kept = 0;
+    for (std::size_t index = 0; index < records_.size(); ++index) {
+        if (index < removed.size() && removed[index]) {
+            continue;
+        }
+        if (kept != index) {
+            records_[kept] = std::move(records_[index]);
+        }
+        ++kept;
+    }
+    std::size_t removedCount = records_.size() - kept;
+    if (removedCount != 0) {
+        encodedRecords_ = nullptr;
+        records_.resize(kept);
+        RefreshMimeProp();
+    }
+    return removedCount;
+}
+
 void PasteData::RemoveEmptyEntry()
 { // LCOV_EXCL_START
+    DecodeRecords();
+    encodedRecords_ = nullptr;
     for (auto &record : records_) {
         if (record != nullptr) {
             record->RemoveEmptyEntry();
@@ -413,7 +549,9 @@ bool PasteData::ReplaceRecordAt(std::size_t number, std::shared_ptr<PasteDataRec
     if (record == nullptr) {
         return false;
     }
+    DecodeRecords();
     if (records_.size() > number) {
+        encodedRecords_ = nullptr;
         records_[number] = std::move(record);
         RefreshMimeProp();
         return true;
@@ -424,7 +562,11 @@ bool PasteData::ReplaceRecordAt(std::size_t number, std::shared_ptr<PasteDataRec
 
 bool PasteData::HasMimeType(const std::string &mimeType)
 { // LCOV_EXCL_START
+    DecodeRecords();
     for (const auto &item : records_) {
+        if (item == nullptr) {
+            continue;
+        }
         auto itemTypes = item->GetMimeTypes();
         if (itemTypes.find(mimeType) != itemTypes.end()) {
             return true;
@@ -435,7 +577,11 @@ bool PasteData::HasMimeType(const std::string &mimeType)
 
 bool PasteData::HasUtdType(const std::string &utdType)
 { // LCOV_EXCL_START
+    DecodeRecords();
     for (const auto &item : records_) {
+        if (item == nullptr) {
+            continue;
+        }
         auto itemTypes = item->GetUtdTypes();
         if (itemTypes.find(utdType) != itemTypes.end()) {
             return true;
@@ -444,8 +590,47 @@ bool PasteData::HasUtdType(const std::string &utdType)
     return false;
 } // LCOV_EXCL_STOP
 
+std::shared_ptr<const PasteDataTypeIndex> PasteData::BuildTypeIndex() const
+{
+    auto index = std::make_shared<PasteDataTypeIndex>();
+    DecodeRecords();
+    for (const auto &item : records_) {
+        if (item == nullptr) {
+            continue;
+        }
+        auto utdTypes = item->GetUtdTypes();
+        index->utdTypes.insert(utdTypes.begin(), utdTypes.end());
+        if (item->GetFrom() > 0 && item->GetRecordId() != item->GetFrom()) {
+            continue;
+        }
+        auto mimeTypes = item->GetMimeTypes();
+        index->mimeTypeSet.insert(mimeTypes.begin(), mimeTypes.end());
+    }
+    index->mimeTypes.assign(index->mimeTypeSet.begin(), index->mimeTypeSet.end());
+    std::sort(index->mimeTypes.begin(), index->mimeTypes.end());
+    return index;
+}
+
+bool PasteDataTypeIndex::HasMimeType(const std::string &mimeType) const
+{
+    return mimeTypeSet.find(mimeType) != mimeTypeSet.end();
+}
+
+bool PasteDataTypeIndex::HasUtdType(const std::string &utdType) const
+{
+    return utdTypes.find(utdType) != utdTypes.end();
+}
+
+bool PasteDataTypeIndex::HasAnyMimeType(const std::vector<std::string> &mimeTypes) const
+{
+    return std::any_of(mimeTypes.begin(), mimeTypes.end(), [this](const std::string &mimeType) {
+        return HasMimeType(mimeType);
+    });
+}
+
 std::vector<std::shared_ptr<PasteDataRecord>> PasteData::AllRecords() const
 { // LCOV_EXCL_START
+    DecodeRecords();
     return this->records_;
 } // LCOV_EXCL_STOP
 
@@ -579,6 +764,7 @@ bool PasteData::GetLocalOnly()
 void PasteData::RefreshMimeProp()
 { // LCOV_EXCL_START
     std::vector<std::string> mimeTypes;
+    DecodeRecords();
     for (const auto &record : records_) {
         if (record == nullptr) {
             continue;
@@ -591,7 +777,15 @@ void PasteData::RefreshMimeProp()
 bool PasteData::EncodeTLV(WriteOnlyBuffer &buffer) const
 {
     bool ret = buffer.Write(TAG_PROPS, props_);
-    ret = ret && buffer.Write(TAG_RECORDS, records_);
+    auto lazyRecords = UntouchedLazyRecords();
+    if (encodedRecords_ != nullptr && !IsRemoteEncode()) {
+        ret = ret && buffer.WriteEncoded(*encodedRecords_);
+    } else if (lazyRecords != nullptr) {
+        ret = ret && buffer.WriteEncoded(lazyRecords->Encoded());
+    } else {
+        DecodeRecords();
+        ret = ret && buffer.WriteParallel(TAG_RECORDS, records_);
+    }
     ret = ret && buffer.Write(TAG_DRAGGED_DATA_FLAG, isDraggedData_);
     ret = ret && buffer.Write(TAG_LOCAL_PASTE_FLAG, isLocalPaste_);
     ret = ret && buffer.Write(TAG_DELAY_DATA_FLAG, isDelayData_);
@@ -613,7 +807,7 @@ bool PasteData::DecodeTLV(ReadOnlyBuffer &buffer)
         if (head.tag == TAG_PROPS) {
             ret = buffer.ReadValue(props_, head);
         } else if (head.tag == TAG_RECORDS) {
-            ret = buffer.ReadValue(records_, head);
+            ret = ReadRecords(buffer, head);
         } else if (head.tag == TAG_DRAGGED_DATA_FLAG) {
             ret = buffer.ReadValue(isDraggedData_, head);
         } else if (head.tag == TAG_LOCAL_PASTE_FLAG) {
@@ -645,7 +839,15 @@ size_t PasteData::CountTLV() const
 {
     size_t expectSize = 0;
     expectSize += TLVCountable::Count(props_);
-    expectSize += TLVCountable::Count(records_);
+    auto lazyRecords = UntouchedLazyRecords();
+    if (encodedRecords_ != nullptr && !IsRemoteEncode()) {
+        expectSize += encodedRecords_->size();
+    } else if (lazyRecords != nullptr) {
+        expectSize += lazyRecords->Encoded().size();
+    } else {
+        DecodeRecords();
+        expectSize += TLVCountable::CountParallel(records_);
+    }
     expectSize += TLVCountable::Count(isDraggedData_);
     expectSize += TLVCountable::Count(isLocalPaste_);
     expectSize += TLVCountable::Count(isDelayData_);
@@ -658,6 +860,147 @@ size_t PasteData::CountTLV() const
     return expectSize;
 }
 
+namespace {
+class RecordsTLV : public TLVWriteable {
+public:
+    explicit RecordsTLV(const std::vector<std::shared_ptr<PasteDataRecord>> &records) : records_(records) {}
+
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override
+    {
+        return buffer.WriteParallel(TAG_RECORDS, records_);
+    }
+
+    size_t CountTLV() const override
+    {
+        return TLVCountable::CountParallel(records_);
+    }
+
+private:
+    const std::vector<std::shared_ptr<PasteDataRecord>> &records_;
+};
+} // namespace
+
+std::shared_ptr<const std::vector<uint8_t>> PasteData::EncodeRecordsTLV() const
+{
+    auto encoded = std::make_shared<std::vector<uint8_t>>();
+    DecodeRecords();
+    bool ret = RecordsTLV(records_).Encode(*encoded);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, nullptr, PASTEBOARD_MODULE_COMMON,
+        "encode records failed, count=%{public}zu", records_.size());
+    return encoded;
+}
+
+bool PasteData::EncodeRecordsTLV(uint8_t *buffer, size_t size) const
+{
+    DecodeRecords();
+    return RecordsTLV(records_).Encode(buffer, size);
+}
+
+size_t PasteData::CountRecordsTLV() const
+{
+    DecodeRecords();
+    return RecordsTLV(records_).Count();
+}
+
+void PasteData::SetEncodedRecords(std::shared_ptr<const std::vector<uint8_t>> encodedRecords)
+{
+    encodedRecords_ = std::move(encodedRecords);
+}
+
+void PasteData::SetLazyRecordDecode(bool lazy)
+{
+    lazyDecode_ = lazy;
+}
+
+std::size_t PasteData::GetUndecodedRecordCount() const
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    return undecodedRecords_;
+}
+
+void PasteData::FixupRecords(const RecordFixup &fixup)
+{
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(fixup != nullptr, PASTEBOARD_MODULE_COMMON, "fixup is null");
+    encodedRecords_ = nullptr;
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    for (std::size_t index = 0; index < records_.size(); ++index) {
+        if (lazyRecords_ != nullptr && lazyRecords_->IsPending(index)) {
+            continue;
+        }
+        if (records_[index] != nullptr) {
+            fixup(*records_[index]);
+        }
+    }
+    if (lazyRecords_ != nullptr) {
+        recordFixups_.push_back(fixup);
+    }
+}
+
+bool PasteData::ReadRecords(ReadOnlyBuffer &buffer, const TLVHead &head)
+{
+    encodedRecords_ = nullptr;
+    // records read earlier keep their indexes only if the lazy list starts the vector
+    if (!lazyDecode_ || !records_.empty()) {
+        return buffer.ReadValueParallel(records_, head);
+    }
+    auto lazyRecords = std::make_unique<TLVLazyList>();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(lazyRecords->Read(buffer, head), false, PASTEBOARD_MODULE_COMMON,
+        "read lazy records failed, len=%{public}u", head.len);
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    records_.resize(lazyRecords->Size());
+    if (lazyRecords->Size() != 0) {
+        lazyRecords_ = std::move(lazyRecords);
+    }
+    return true;
+}
+
+std::shared_ptr<const TLVLazyList> PasteData::UntouchedLazyRecords() const
+{
+    // bytes of a local encoding, and no fixup waits to change a record; the bytes never change once read, so the
+    // caller may splice them after another thread decodes a record
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    if (lazyRecords_ == nullptr || !lazyRecords_->IsUntouched() || !recordFixups_.empty() || IsRemoteEncode()) {
+        return nullptr;
+    }
+    return lazyRecords_;
+}
+
+void PasteData::DecodeRecordAt(std::size_t index) const
+{
+    // a slot is written only while its record is pending, so it can be read unlocked once this returns
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    DecodeRecordLocked(index);
+}
+
+void PasteData::DecodeRecordLocked(std::size_t index) const
+{
+    if (lazyRecords_ == nullptr || !lazyRecords_->IsPending(index)) {
+        return;
+    }
+    if (lazyRecords_->Take(index, records_[index]) && records_[index] != nullptr) {
+        for (const auto &fixup : recordFixups_) {
+            fixup(*records_[index]);
+        }
+    } else {
+        records_[index] = nullptr;
+        ++undecodedRecords_;
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "decode record failed, index=%{public}zu, failed=%{public}zu",
+            index, undecodedRecords_);
+    }
+    if (lazyRecords_->Pending() == 0) {
+        lazyRecords_ = nullptr;
+        recordFixups_.clear();
+    }
+}
+
+void PasteData::DecodeRecords() const
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_);
+    for (std::size_t index = 0; lazyRecords_ != nullptr && index < records_.size(); ++index) {
+        DecodeRecordLocked(index);
+    }
+}
+
 bool PasteData::IsValid() const
 { // LCOV_EXCL_START
     return valid_;
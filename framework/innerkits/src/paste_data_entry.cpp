@@ -129,6 +129,11 @@ void PasteDataEntry::SetValue(const EntryValue &value)
     value_ = value;
 } // LCOV_EXCL_STOP
 
+void PasteDataEntry::SetValue(EntryValue &&value)
+{
+    value_ = std::move(value);
+}
+
 bool PasteDataEntry::EncodeTLV(WriteOnlyBuffer &buffer) const
 {
     bool ret = buffer.Write(TAG_ENTRY_UTDID, utdId_);
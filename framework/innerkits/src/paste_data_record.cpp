@@ -469,9 +469,9 @@ bool PasteDataRecord::EncodeTLVLocal(WriteOnlyBuffer &buffer) const
 {
     bool ret = buffer.Write(TAG_MIMETYPE, mimeType_);
     ret = ret && buffer.Write(TAG_HTMLTEXT, htmlText_);
-    ret = ret && buffer.Write(TAG_WANT, TLVUtils::Parcelable2Raw(want_.get()));
+    ret = ret && buffer.Write(TAG_WANT, SerializedCache::Parcelable2Raw(want_));
     ret = ret && buffer.Write(TAG_PLAINTEXT, plainText_);
-    ret = ret && buffer.Write(TAG_URI, TLVUtils::Parcelable2Raw(uri_.get()));
+    ret = ret && buffer.Write(TAG_URI, SerializedCache::Parcelable2Raw(uri_));
     ret = ret && buffer.Write(TAG_CONVERT_URI, convertUri_);
     ret = ret && buffer.Write(TAG_PIXELMAP, pixelMap_);
     ret = ret && buffer.Write(TAG_CUSTOM_DATA, customData_);
@@ -500,8 +500,8 @@ bool PasteDataRecord::EncodeTLVRemote(WriteOnlyBuffer &buffer) const
         ret = ret && buffer.Write(TAG_HTMLTEXT, remoteValue->htmlText_);
         ret = ret && buffer.Write(TAG_PLAINTEXT, remoteValue->plainText_);
         ret = ret && buffer.Write(TAG_PIXELMAP, remoteValue->pixelMap_);
-        ret = ret && buffer.Write(TAG_WANT, TLVUtils::Parcelable2Raw(remoteValue->want_.get()));
-        ret = ret && buffer.Write(TAG_URI, TLVUtils::Parcelable2Raw(remoteValue->uri_.get()));
+        ret = ret && buffer.Write(TAG_WANT, SerializedCache::Parcelable2Raw(remoteValue->want_));
+        ret = ret && buffer.Write(TAG_URI, SerializedCache::Parcelable2Raw(remoteValue->uri_));
         ret = ret && buffer.Write(TAG_UDC_UDMFVALUE, remoteValue->udmfValue_);
         ret = ret && buffer.Write(TAG_UDC_ENTRIES, remoteValue->entries_);
     }
@@ -610,9 +610,9 @@ size_t PasteDataRecord::CountTLVLocal() const
     size_t expectedSize = 0;
     expectedSize += TLVCountable::Count(mimeType_);
     expectedSize += TLVCountable::Count(htmlText_);
-    expectedSize += TLVCountable::Count(TLVUtils::Parcelable2Raw(want_.get()));
+    expectedSize += TLVCountable::Count(SerializedCache::Parcelable2Raw(want_));
     expectedSize += TLVCountable::Count(plainText_);
-    expectedSize += TLVCountable::Count(TLVUtils::Parcelable2Raw(uri_.get()));
+    expectedSize += TLVCountable::Count(SerializedCache::Parcelable2Raw(uri_));
     expectedSize += TLVCountable::Count(convertUri_);
     expectedSize += TLVCountable::Count(pixelMap_);
     expectedSize += TLVCountable::Count(customData_);
@@ -640,8 +640,8 @@ size_t PasteDataRecord::CountTLVRemote() const
         expectedSize += TLVCountable::Count(remoteValue->htmlText_);
         expectedSize += TLVCountable::Count(remoteValue->plainText_);
         expectedSize += TLVCountable::Count(remoteValue->pixelMap_);
-        expectedSize += TLVCountable::Count(TLVUtils::Parcelable2Raw(remoteValue->want_.get()));
-        expectedSize += TLVCountable::Count(TLVUtils::Parcelable2Raw(remoteValue->uri_.get()));
+        expectedSize += TLVCountable::Count(SerializedCache::Parcelable2Raw(remoteValue->want_));
+        expectedSize += TLVCountable::Count(SerializedCache::Parcelable2Raw(remoteValue->uri_));
         expectedSize += TLVCountable::Count(remoteValue->udmfValue_);
         expectedSize += TLVCountable::Count(remoteValue->entries_);
     }
@@ -312,6 +312,8 @@ int32_t PasteboardClient::GetPasteData(PasteData &pasteData)
     int32_t ret = proxyService->GetPasteData(fd, rawDataSize, recvTLV, seqId, syncTime, realErrCode);
     int32_t bizStage = (syncTime == 0) ? RadarReporter::DFX_LOCAL_PASTE_END : RadarReporter::DFX_DISTRIBUTED_PASTE_END;
     ret = ConvertErrCode(realErrCode);
+    // the caller gets a clip of its own, records it never reads are not decoded
+    pasteData.SetLazyRecordDecode(true);
     int32_t result = ProcessPasteData<PasteData>(pasteData, rawDataSize, fd, recvTLV);
     PasteboardWebController::GetInstance().RetainUri(pasteData);
     PasteboardWebController::GetInstance().RemoveInvalidUri(pasteData);
@@ -465,6 +467,8 @@ int32_t PasteboardClient::GetPasteDataFromService(PasteData &pasteData,
     int32_t ret = proxyService->GetPasteData(fd, rawDataSize, recvTLV, pasteSeqId, syncTime, realErrCode);
     int32_t bizStage = (syncTime == 0) ? RadarReporter::DFX_LOCAL_PASTE_END : RadarReporter::DFX_DISTRIBUTED_PASTE_END;
     ret = ConvertErrCode(realErrCode);
+    // the caller gets a clip of its own, records it never reads are not decoded
+    pasteData.SetLazyRecordDecode(true);
     int32_t result = ProcessPasteData<PasteData>(pasteData, rawDataSize, fd, recvTLV);
     ProgressSmoothToTwentyPercent(pasteData, progressKey, params);
     PasteboardWebController::GetInstance().RetainUri(pasteData);
@@ -508,8 +512,12 @@ int32_t PasteboardClient::ProcessPasteData(T &data, int64_t rawDataSize, int fd,
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "mmap failed, size=%{public}" PRId64, rawDataSize);
             return ret;
         }
-        std::vector<uint8_t> pasteDataTlv(rawData, rawData + rawDataSize);
-        result = data.Decode(pasteDataTlv);
+        result = data.Decode(rawData, static_cast<size_t>(rawDataSize));
+        // a clip shared from a sealed region comes with this paste's own fields inline, they are read last
+        if (result && !recvTLV.empty()) {
+            result = data.Decode(recvTLV);
+            rawDataSize += static_cast<int64_t>(recvTLV.size());
+        }
     } else {
         result = data.Decode(recvTLV);
         CloseSharedMemFd(fd);
@@ -518,6 +526,7 @@ int32_t PasteboardClient::ProcessPasteData(T &data, int64_t rawDataSize, int fd,
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to decode pastedata in TLV");
         return ret;
     }
+    data.rawDataSize_ = rawDataSize;
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
 
@@ -731,24 +740,23 @@ void PasteboardClient::CreateGetterAgent(sptr<PasteboardDelayGetterClient> &dela
 int32_t PasteboardClient::WritePasteData(PasteData &pasteData, std::vector<uint8_t> &buffer, int &fd,
     int64_t &tlvSize, MessageParcelWarp &messageData, MessageParcel &parcelPata)
 {
+    SerializedCache cacheScope; // pixel maps and wants serialized by Count are reused by Encode
     tlvSize = static_cast<int64_t>(pasteData.Count());
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(0 < tlvSize && tlvSize <= MessageParcelWarp::GetRawDataSize(),
         static_cast<int32_t>(PasteboardError::INVALID_DATA_SIZE), PASTEBOARD_MODULE_CLIENT,
         "invalid data size, dataSize=%{public}" PRId64, tlvSize);
     std::vector<uint8_t> pasteDataTlv(0);
-    bool result = pasteData.Encode(tlvSize, pasteDataTlv);
-    if (!result) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "paste data encode failed.");
-        return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
-    }
     if (tlvSize > MIN_ASHMEM_DATA_SIZE) {
-        if (!messageData.WriteRawData(parcelPata, pasteDataTlv.data(), pasteDataTlv.size())) {
+        if (!messageData.WriteRawData(parcelPata, pasteData, static_cast<size_t>(tlvSize))) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to WriteRawData");
             return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
         }
         fd = messageData.GetWriteDataFd();
-        pasteDataTlv.clear();
     } else {
+        if (!pasteData.Encode(tlvSize, pasteDataTlv)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "paste data encode failed.");
+            return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+        }
         fd = messageData.CreateTmpFd();
         if (fd < 0) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to create tmp fd");
@@ -779,7 +787,7 @@ int32_t PasteboardClient::SetPasteData(PasteData &pasteData, std::shared_ptr<Pas
     std::vector<uint8_t> pasteDataTlv(0);
     int fd = -1;
     int64_t tlvSize = 0;
-    MessageParcelWarp messageData;
+    MessageParcelWarp messageData(true);
     MessageParcel parcelPata;
     int32_t ret = WritePasteData(pasteData, pasteDataTlv, fd, tlvSize, messageData, parcelPata);
     if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
@@ -1264,10 +1272,13 @@ int32_t PasteboardClient::SyncDelayedData()
 
 std::string PasteboardClient::GetPasteDataInfoSummary(const PasteData &pasteData)
 {
+    // the size it was received in, counting again would decode records the caller has not read
+    size_t pasteDataSize =
+        pasteData.rawDataSize_ > 0 ? static_cast<size_t>(pasteData.rawDataSize_) : pasteData.CountTLV();
     // Deal with pasteData info
     json RadarReportInfoInJson = {
         {"PasteBundle", pasteData.GetBundleName().empty() ? "/" : pasteData.GetBundleName()},
-        {"PasteDataSize", pasteData.CountTLV()},
+        {"PasteDataSize", pasteDataSize},
         {"RecordCount", pasteData.GetRecordCount()},
         {"IsRemote", pasteData.IsRemote()},
         {"IsDelayData", pasteData.IsDelayData()},
@@ -15,10 +15,13 @@
 
 #include "pasteboard_copy.h"
 
+#include <unordered_set>
+
 #include "common_func.h"
 #include "copy/file_copy_manager.h"
 #include "file_uri.h"
 #include "common/pasteboard_common_utils.h"
+#include "pasteboard_copy_scheduler.h"
 #include "pasteboard_error.h"
 #include "pasteboard_hilog.h"
 
@@ -35,6 +38,8 @@ constexpr int DFS_CANCEL_SUCCESS = 204;
 
 ProgressListener PasteBoardCopyFile::progressListener_;
 std::atomic_bool PasteBoardCopyFile::canCancel_{ true };
+std::mutex PasteBoardCopyFile::inFlightMutex_;
+std::set<CopyInfo> PasteBoardCopyFile::inFlight_;
 std::atomic_uint32_t PasteBoardCopyFile::recordSize_{ 0 };
 
 PasteBoardCopyFile &PasteBoardCopyFile::GetInstance()
@@ -169,54 +174,124 @@ int32_t PasteBoardCopyFile::InitCopyInfo(const std::string srcUri, std::shared_p
 
 int32_t PasteBoardCopyFile::CopyFileData(PasteData &pasteData, std::shared_ptr<GetDataParams> dataParams)
 {
-    int32_t ret = static_cast<int32_t>(PasteboardError::E_OK);
     progressListener_ = dataParams->listener;
-    std::shared_ptr<PasteDataRecord> record = std::make_shared<PasteDataRecord>();
-    int32_t recordCount = 0;
-    int32_t recordProcessedIndex = 0;
-    for (size_t index = 0; index < pasteData.GetRecordCount();) {
-        recordProcessedIndex++;
+    size_t recordCount = pasteData.GetRecordCount();
+    std::vector<bool> removed(recordCount, true);
+    std::vector<CopyJob> jobs;
+    int32_t ret = CollectCopyJobs(pasteData, dataParams, removed, jobs);
+    if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
+        return ret;
+    }
+    // records that are not copied count as processed, the aggregated total then feeds HandleProgress as
+    // (index - 1) * 100 + percentage, which keeps its percentage formula and its cancel handling
+    std::vector<std::shared_ptr<CopyInfo>> copyInfos(recordCount);
+    std::vector<std::string> laneKeys;
+    laneKeys.reserve(jobs.size());
+    for (const auto &job : jobs) {
+        copyInfos[job.recordIndex] = job.copyInfo;
+        laneKeys.push_back(job.copyInfo->destPath);
+    }
+    auto progress = std::make_shared<PasteboardCopyProgress>(recordCount,
+        [copyInfos, dataParams](size_t slot, uint64_t total) {
+            HandleProgress(static_cast<int32_t>(total / PERCENTAGE + 1), *copyInfos[slot],
+                static_cast<uint32_t>(total % PERCENTAGE), dataParams);
+        });
+    for (size_t index = 0; index < recordCount; ++index) {
+        if (copyInfos[index] == nullptr) {
+            progress->Complete(index);
+        }
+    }
+    PasteboardCopyScheduler::Run(laneKeys, PasteboardCopyScheduler::MAX_COPY_WORKERS,
+        [&jobs, progress, dataParams](size_t index) {
+            RunCopyJob(jobs[index], dataParams, progress);
+        },
+        []() {
+            return ProgressSignalClient::GetInstance().CheckCancelIfNeed();
+        });
+    for (const auto &job : jobs) {
+        removed[job.recordIndex] = !job.keep;
+    }
+    pasteData.RemoveRecords(removed);
+    for (const auto &job : jobs) {
+        if (job.copied) {
+            ret = job.ret;
+        }
+    }
+    return (ret == ERRNO_NOERR || ret == DFS_CANCEL_SUCCESS) ? static_cast<int32_t>(PasteboardError::E_OK) : ret;
+}
+
+int32_t PasteBoardCopyFile::CollectCopyJobs(PasteData &pasteData, std::shared_ptr<GetDataParams> dataParams,
+    std::vector<bool> &removed, std::vector<CopyJob> &jobs)
+{
+    std::unordered_set<std::string> destPaths;
+    for (size_t index = 0; index < pasteData.GetRecordCount(); ++index) {
         if (ProgressSignalClient::GetInstance().CheckCancelIfNeed()) {
             PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "canceled success!");
-            pasteData.RemoveRecordAt(index);
-            continue;
+            break;
         }
-        record = pasteData.GetRecordAt(index);
+        std::shared_ptr<PasteDataRecord> record = pasteData.GetRecordAt(index);
         if (record == nullptr) {
             return static_cast<int32_t>(PasteboardError::INVALID_PARAM_ERROR);
         }
         std::shared_ptr<OHOS::Uri> uri = record->GetUriV0();
         if (uri == nullptr) {
             PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "Record has no uri");
-            index++;
+            removed[index] = false;
             continue;
         }
-        std::shared_ptr<CopyInfo> copyInfo = std::make_shared<CopyInfo>();
-        std::string srcUri = uri->ToString();
-        if (InitCopyInfo(srcUri, dataParams, copyInfo) == E_EXIST) {
-            recordCount++;
-            pasteData.RemoveRecordAt(index);
+        CopyJob job;
+        job.recordIndex = index;
+        job.record = record;
+        job.srcUri = uri->ToString();
+        job.copyInfo = std::make_shared<CopyInfo>();
+        if (InitCopyInfo(job.srcUri, dataParams, job.copyInfo) == E_EXIST) {
             continue;
         }
-        recordCount++;
-        CopyInfo info = *copyInfo;
-        using ProcessCallBack = std::function<void(uint64_t processSize, uint64_t totalSize)>;
-        ProcessCallBack listener = [=](uint64_t processSize, uint64_t totalSize) {
-            uint32_t percentage = 0;
-            if (totalSize != 0) {
-                percentage = static_cast<uint32_t>(static_cast<uint32_t>(PERCENTAGE) * processSize / totalSize);
-            }
-            HandleProgress(recordProcessedIndex, info, percentage, dataParams);
-        };
-        ret = Storage::DistributedFile::FileCopyManager::GetInstance().Copy(srcUri, copyInfo->destUri, listener);
-        if (!ShouldKeepRecord(ret, copyInfo->destUri, record)) {
-            pasteData.RemoveRecordAt(index);
-        } else {
-            index++;
+        // a later copy to the same destination has to check for the file again once the earlier one is done
+        job.recheckDest = !destPaths.insert(job.copyInfo->destPath).second;
+        jobs.push_back(std::move(job));
+    }
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
+void PasteBoardCopyFile::RunCopyJob(CopyJob &job, std::shared_ptr<GetDataParams> dataParams,
+    std::shared_ptr<PasteboardCopyProgress> progress)
+{
+    if (job.recheckDest && InitCopyInfo(job.srcUri, dataParams, job.copyInfo) == E_EXIST) {
+        progress->Complete(job.recordIndex);
+        return;
+    }
+    CopyInfo info = *job.copyInfo;
+    {
+        std::lock_guard<std::mutex> lock(inFlightMutex_);
+        inFlight_.insert(info);
+    }
+    // registered before the check, so a cancel either reaches this copy or is seen here
+    if (ProgressSignalClient::GetInstance().CheckCancelIfNeed()) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "canceled success!");
+        std::lock_guard<std::mutex> lock(inFlightMutex_);
+        inFlight_.erase(info);
+        progress->Complete(job.recordIndex);
+        return;
+    }
+    using ProcessCallBack = std::function<void(uint64_t processSize, uint64_t totalSize)>;
+    ProcessCallBack listener = [progress, slot = job.recordIndex](uint64_t processSize, uint64_t totalSize) {
+        uint32_t percentage = 0;
+        if (totalSize != 0) {
+            percentage = static_cast<uint32_t>(static_cast<uint32_t>(PERCENTAGE) * processSize / totalSize);
         }
-        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DFS copy ret: %{public}d", ret);
+        progress->Update(slot, percentage);
+    };
+    job.ret = Storage::DistributedFile::FileCopyManager::GetInstance().Copy(job.srcUri, job.copyInfo->destUri,
+        listener);
+    {
+        std::lock_guard<std::mutex> lock(inFlightMutex_);
+        inFlight_.erase(info);
     }
-    return (ret == ERRNO_NOERR || ret == DFS_CANCEL_SUCCESS) ? static_cast<int32_t>(PasteboardError::E_OK) : ret;
+    job.copied = true;
+    job.keep = ShouldKeepRecord(job.ret, job.copyInfo->destUri, job.record);
+    progress->Complete(job.recordIndex);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "DFS copy ret: %{public}d", job.ret);
 }
 
 bool PasteBoardCopyFile::ShouldKeepRecord(
@@ -265,12 +340,25 @@ void PasteBoardCopyFile::HandleProgress(int32_t index, const CopyInfo &info, uin
 
     if (ProgressSignalClient::GetInstance().CheckCancelIfNeed() && canCancel_.load()) {
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "Cancel copy.");
-        std::thread thread([info]() {
+        std::set<CopyInfo> targets;
+        {
+            std::lock_guard<std::mutex> lock(inFlightMutex_);
+            targets = inFlight_;
+        }
+        targets.insert(info);
+        std::thread thread([targets]() {
             canCancel_.store(false);
-            auto ret = Storage::DistributedFile::FileCopyManager::GetInstance().Cancel(info.srcUri, info.destUri);
-            if (ret != ERRNO_NOERR) {
+            bool failed = false;
+            for (const auto &target : targets) {
+                auto ret = Storage::DistributedFile::FileCopyManager::GetInstance().Cancel(target.srcUri,
+                    target.destUri);
+                if (ret != ERRNO_NOERR) {
+                    failed = true;
+                    PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Cancel failed. errno=%{public}d", ret);
+                }
+            }
+            if (failed) {
                 canCancel_.store(true);
-                PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Cancel failed. errno=%{public}d", ret);
             }
         });
         PasteBoardCommonUtils::SetThreadTaskName(thread, "HandleProgress");
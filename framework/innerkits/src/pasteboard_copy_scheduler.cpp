@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_copy_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+#include "common/pasteboard_common_utils.h"
+
+namespace OHOS::MiscServices {
+std::vector<std::vector<size_t>> PasteboardCopyScheduler::BuildLanes(const std::vector<std::string> &laneKeys)
+{
+    std::vector<std::vector<size_t>> lanes;
+    std::unordered_map<std::string, size_t> laneOfKey;
+    for (size_t job = 0; job < laneKeys.size(); ++job) {
+        auto [it, inserted] = laneOfKey.try_emplace(laneKeys[job], lanes.size());
+        if (inserted) {
+            lanes.emplace_back();
+        }
+        lanes[it->second].push_back(job);
+    }
+    return lanes;
+}
+
+void PasteboardCopyScheduler::Run(const std::vector<std::string> &laneKeys, size_t maxWorkers, const Job &job,
+    const Stopped &stopped)
+{
+    auto lanes = BuildLanes(laneKeys);
+    if (lanes.empty() || job == nullptr) {
+        return;
+    }
+    std::atomic<size_t> nextLane{ 0 };
+    auto worker = [&lanes, &nextLane, &job, &stopped]() {
+        for (size_t lane = nextLane++; lane < lanes.size(); lane = nextLane++) {
+            for (size_t index : lanes[lane]) {
+                if (stopped != nullptr && stopped()) {
+                    return;
+                }
+                job(index);
+            }
+        }
+    };
+    size_t workerCount = std::min(std::max<size_t>(maxWorkers, 1), lanes.size());
+    std::vector<std::thread> helpers;
+    helpers.reserve(workerCount - 1);
+    for (size_t i = 1; i < workerCount; ++i) {
+        helpers.emplace_back(worker);
+        PasteBoardCommonUtils::SetThreadTaskName(helpers.back(), "PasteCopy");
+    }
+    worker();
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+}
+
+PasteboardCopyProgress::PasteboardCopyProgress(size_t slotCount, Reporter reporter)
+    : percentages_(slotCount, 0), reporter_(std::move(reporter))
+{
+}
+
+bool PasteboardCopyProgress::Advance(size_t slot, uint32_t percentage)
+{
+    if (slot >= percentages_.size()) {
+        return false;
+    }
+    percentage = std::min(percentage, SLOT_PERCENTAGE);
+    if (percentage <= percentages_[slot]) {
+        return false;
+    }
+    total_ += percentage - percentages_[slot];
+    percentages_[slot] = percentage;
+    return true;
+}
+
+void PasteboardCopyProgress::Update(size_t slot, uint32_t percentage)
+{
+    uint64_t total = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!Advance(slot, percentage) || reporter_ == nullptr) {
+            return;
+        }
+        latestSlot_ = slot;
+        latestTotal_ = total_;
+        if (reporting_) {
+            return;
+        }
+        reporting_ = true;
+        total = total_;
+    }
+    for (;;) {
+        reporter_(slot, total);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (latestTotal_ == total) {
+            reporting_ = false;
+            return;
+        }
+        slot = latestSlot_;
+        total = latestTotal_;
+    }
+}
+
+void PasteboardCopyProgress::Complete(size_t slot)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Advance(slot, SLOT_PERCENTAGE);
+}
+
+uint64_t PasteboardCopyProgress::GetTotal()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_;
+}
+} // namespace OHOS::MiscServices
@@ -16,9 +16,13 @@
 #include "pasteboard_img_extractor.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <climits>
 #include <cstring>
 #include <memory>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "ipc_skeleton.h"
@@ -29,6 +33,8 @@
 namespace OHOS {
 namespace MiscServices {
 constexpr uid_t HWF_SERVICE_UID = 7700;
+constexpr size_t STAT_BATCH_SIZE = 16;
+constexpr size_t MAX_STAT_WORKERS = 4;
 
 PasteboardImgExtractor &PasteboardImgExtractor::GetInstance()
 {
@@ -38,26 +44,18 @@ PasteboardImgExtractor &PasteboardImgExtractor::GetInstance()
 
 PasteboardImgExtractor::PasteboardImgExtractor()
 {
-    std::lock_guard lock(mutex_);
     xmlInitParser();
 }
 
 PasteboardImgExtractor::~PasteboardImgExtractor()
 {
-    std::lock_guard lock(mutex_);
     xmlCleanupParser();
 }
 
 std::vector<std::string> PasteboardImgExtractor::ExtractImgSrc(const std::string &htmlContent,
     const std::string &bundleIndex, int32_t userId)
 {
-    std::lock_guard lock(mutex_);
-    int options = HTML_PARSE_RECOVER | HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING;
-    xmlDocPtr doc = htmlReadDoc(reinterpret_cast<const xmlChar *>(htmlContent.c_str()), nullptr, nullptr, options);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(doc != nullptr, {}, PASTEBOARD_MODULE_COMMON, "parse html failed");
-
-    std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> docGuard(doc, xmlFreeDoc);
-    auto uris = FindImgsExcludingSpan(doc);
+    auto uris = CollectImgSrc(htmlContent);
     FilterFileUris(uris);
     FilterImgUris(uris);
     FilterExistFileUris(uris, bundleIndex, userId);
@@ -67,59 +65,113 @@ std::vector<std::string> PasteboardImgExtractor::ExtractImgSrc(const std::string
 void PasteboardImgExtractor::FilterExistFileUris(std::vector<std::string> &uris, const std::string &bundleIndex,
     int32_t userId)
 {
-    std::vector<std::string> existFileUris;
-    std::string userIdStr = std::to_string(userId);
-    auto callingUid = IPCSkeleton::GetCallingUid();
+    // the same uri is checked once however often the html shows it
+    std::vector<FileUriCheck> checks;
+    std::unordered_map<std::string, size_t> checkIndexes;
+    std::vector<size_t> uriChecks;
+    uriChecks.reserve(uris.size());
     for (const std::string &uriStr : uris) {
-        if (!AppFileService::SandboxHelper::IsValidPath(uriStr)) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "uri path invalid, uri=%{private}s", uriStr.c_str());
-            continue;
-        }
-        std::string oldUriStr = uriStr;
-        std::string newUriStr;
-        if (oldUriStr.find(PasteboardImgExtractor::IMG_LOCAL_URI) != 0) {
-            continue;
-        } else if (oldUriStr.find(PasteboardImgExtractor::DOC_LOCAL_URI) == 0) {
-            newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::DOC_LOCAL_URI),
-                PasteboardImgExtractor::DOC_URI_PREFIX);
-        } else {
-            newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::IMG_LOCAL_URI),
-                PasteboardImgExtractor::FILE_SCHEME_PREFIX + bundleIndex + "/");
+        auto [it, inserted] = checkIndexes.try_emplace(uriStr, checks.size());
+        if (inserted) {
+            checks.emplace_back();
+            checks.back().uri = uriStr;
         }
+        uriChecks.push_back(it->second);
+    }
 
-        std::string physicalPath;
-        if (callingUid == HWF_SERVICE_UID && oldUriStr.find("file://docs/storage/Users/currentUser/") == 0) {
-            physicalPath = oldUriStr.replace(0, std::strlen("file://docs/storage/Users/currentUser/"), "/mnt/");
-        } else {
-            int32_t ret = AppFileService::SandboxHelper::GetPhysicalPath(newUriStr, userIdStr, physicalPath);
-            if (ret != 0) {
-                PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "get phy path fail, uri=%{private}s", newUriStr.c_str());
-                continue;
-            }
-        }
+    std::string userIdStr = std::to_string(userId);
+    auto callingUid = IPCSkeleton::GetCallingUid();
+    for (auto &check : checks) {
+        check.resolved = ResolvePhysicalPath(check.uri, bundleIndex, userIdStr, callingUid, check.physicalPath);
+    }
+    CheckFilesExist(checks);
 
-        errno = 0;
-        struct stat buf = {};
-        if (PasteBoardCommon::Stat(physicalPath, &buf) != 0) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "stat fail, uri=%{private}s, path=%{private}s, err=%{public}d",
-                newUriStr.c_str(), physicalPath.c_str(), errno);
-            if (errno == EACCES) {
-                existFileUris.push_back(uriStr);
-            }
-            continue;
+    std::vector<std::string> existFileUris;
+    for (size_t i = 0; i < uris.size(); ++i) {
+        if (checks[uriChecks[i]].exists) {
+            existFileUris.push_back(std::move(uris[i]));
         }
+    }
+    uris = std::move(existFileUris);
+}
 
-        if ((buf.st_mode & S_IFMT) == S_IFDIR) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "is dir, uri=%{private}s, path=%{private}s",
-                newUriStr.c_str(), physicalPath.c_str());
-            continue;
-        }
+bool PasteboardImgExtractor::ResolvePhysicalPath(const std::string &uri, const std::string &bundleIndex,
+    const std::string &userId, uid_t callingUid, std::string &physicalPath)
+{
+    if (!AppFileService::SandboxHelper::IsValidPath(uri)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "uri path invalid, uri=%{private}s", uri.c_str());
+        return false;
+    }
+    std::string oldUriStr = uri;
+    std::string newUriStr;
+    if (oldUriStr.find(PasteboardImgExtractor::IMG_LOCAL_URI) != 0) {
+        return false;
+    } else if (oldUriStr.find(PasteboardImgExtractor::DOC_LOCAL_URI) == 0) {
+        newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::DOC_LOCAL_URI),
+            PasteboardImgExtractor::DOC_URI_PREFIX);
+    } else {
+        newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::IMG_LOCAL_URI),
+            PasteboardImgExtractor::FILE_SCHEME_PREFIX + bundleIndex + "/");
+    }
 
-        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_COMMON, "uri=%{private}s, path=%{private}s, size=%{public}zu",
-            newUriStr.c_str(), physicalPath.c_str(), static_cast<size_t>(buf.st_size));
-        existFileUris.push_back(uriStr);
+    if (callingUid == HWF_SERVICE_UID && oldUriStr.find("file://docs/storage/Users/currentUser/") == 0) {
+        physicalPath = oldUriStr.replace(0, std::strlen("file://docs/storage/Users/currentUser/"), "/mnt/");
+        return true;
+    }
+    int32_t ret = AppFileService::SandboxHelper::GetPhysicalPath(newUriStr, userId, physicalPath);
+    if (ret != 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "get phy path fail, uri=%{private}s", newUriStr.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool PasteboardImgExtractor::CheckFileExists(const FileUriCheck &check)
+{
+    errno = 0;
+    struct stat buf = {};
+    if (PasteBoardCommon::Stat(check.physicalPath, &buf) != 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "stat fail, uri=%{private}s, path=%{private}s, err=%{public}d",
+            check.uri.c_str(), check.physicalPath.c_str(), errno);
+        return errno == EACCES;
+    }
+
+    if ((buf.st_mode & S_IFMT) == S_IFDIR) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "is dir, uri=%{private}s, path=%{private}s",
+            check.uri.c_str(), check.physicalPath.c_str());
+        return false;
+    }
+
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_COMMON, "uri=%{private}s, path=%{private}s, size=%{public}zu",
+        check.uri.c_str(), check.physicalPath.c_str(), static_cast<size_t>(buf.st_size));
+    return true;
+}
+
+void PasteboardImgExtractor::CheckFilesExist(std::vector<FileUriCheck> &checks)
+{
+    // one worker per STAT_BATCH_SIZE resolved paths, at most MAX_STAT_WORKERS, the calling thread is one of them
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < checks.size(); ++i) {
+        if (checks[i].resolved) {
+            pending.push_back(i);
+        }
+    }
+    size_t workerCount = std::min(MAX_STAT_WORKERS, (pending.size() + STAT_BATCH_SIZE - 1) / STAT_BATCH_SIZE);
+    std::atomic<size_t> next = 0;
+    auto work = [&checks, &pending, &next]() {
+        for (size_t i = next.fetch_add(1); i < pending.size(); i = next.fetch_add(1)) {
+            auto &check = checks[pending[i]];
+            check.exists = CheckFileExists(check);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
     }
-    uris = existFileUris;
 }
 
 void PasteboardImgExtractor::FilterFileUris(std::vector<std::string> &uris)
@@ -194,55 +246,45 @@ bool PasteboardImgExtractor::MatchImgExtension(const std::string &uri)
     return IMG_EXTENSIONS.find(extension) != IMG_EXTENSIONS.end();
 }
 
-std::vector<std::string> PasteboardImgExtractor::FindImgsExcludingSpan(xmlDocPtr doc)
+std::vector<std::string> PasteboardImgExtractor::CollectImgSrc(const std::string &htmlContent)
 {
-    return ExecuteXPath(doc, "//img[@src]");
+    // the html ends at its first NUL, as it did for htmlReadDoc
+    size_t length = std::strlen(htmlContent.c_str());
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(length > 0 && length <= static_cast<size_t>(INT_MAX), {},
+        PASTEBOARD_MODULE_COMMON, "invalid html length=%{public}zu", length);
+    // a parser context of its own and a SAX handler instead of the tree builder: no tree, no XPath and nothing
+    // shared between callers. This is the pull parser htmlReadDoc runs, so the elements seen are the same.
+    htmlParserCtxtPtr ctxt = htmlCreateMemoryParserCtxt(htmlContent.c_str(), static_cast<int>(length));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ctxt != nullptr && ctxt->sax != nullptr, {}, PASTEBOARD_MODULE_COMMON,
+        "new html parser failed");
+
+    std::unique_ptr<htmlParserCtxt, decltype(&htmlFreeParserCtxt)> ctxtGuard(ctxt, htmlFreeParserCtxt);
+    std::vector<std::string> srcs;
+    htmlSAXHandler handler = {};
+    handler.startElement = OnStartElement;
+    *ctxt->sax = handler;
+    ctxt->userData = &srcs;
+    htmlCtxtUseOptions(ctxt, HTML_PARSE_RECOVER | HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING | HTML_PARSE_NONET);
+    htmlParseDocument(ctxt);
+    return srcs;
 }
 
-std::vector<std::string> PasteboardImgExtractor::ExecuteXPath(xmlDocPtr doc, const char *xpathExpr)
+void PasteboardImgExtractor::OnStartElement(void *ctx, const xmlChar *name, const xmlChar **atts)
 {
-    xmlXPathContextPtr context = xmlXPathNewContext(doc);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(context != nullptr, {}, PASTEBOARD_MODULE_COMMON, "xpath new context failed");
-
-    std::unique_ptr<xmlXPathContext, decltype(&xmlXPathFreeContext)> contextGuard(context, xmlXPathFreeContext);
-    xmlXPathObjectPtr result = xmlXPathEvalExpression(reinterpret_cast<const xmlChar *>(xpathExpr), context);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(result != nullptr, {}, PASTEBOARD_MODULE_COMMON, "xpath eval expr failed");
-
-    std::unique_ptr<xmlXPathObject, decltype(&xmlXPathFreeObject)> resultGuard(result, xmlXPathFreeObject);
-    if (!result->nodesetval) {
-        return {};
+    // the html parser lower cases element and attribute names and drops repeated attributes
+    if (ctx == nullptr || name == nullptr || atts == nullptr || xmlStrcmp(name, BAD_CAST "img") != 0) {
+        return;
     }
-
-    std::vector<std::string> results;
-    xmlNodeSetPtr nodeSet = result->nodesetval;
-    for (auto i = 0; i < nodeSet->nodeNr; ++i) {
-        xmlNodePtr node = nodeSet->nodeTab[i];
-        if (node == nullptr) {
+    for (size_t i = 0; atts[i] != nullptr; i += 2) {
+        if (xmlStrcmp(atts[i], BAD_CAST "src") != 0) {
             continue;
         }
-
-        xmlChar *src = xmlGetProp(node, reinterpret_cast<const xmlChar *>("src"));
-        if (src == nullptr) {
-            continue;
+        const xmlChar *value = atts[i + 1];
+        if (value != nullptr && value[0] != '\0') {
+            static_cast<std::vector<std::string> *>(ctx)->emplace_back(reinterpret_cast<const char *>(value));
         }
-
-        std::string srcStr = SafeXmlToString(src);
-        if (!srcStr.empty()) {
-            results.push_back(srcStr);
-        }
-        xmlFree(src);
-    }
-    return results;
-}
-
-std::string PasteboardImgExtractor::SafeXmlToString(const xmlChar *xmlStr)
-{
-    if (xmlStr == nullptr) {
-        return "";
+        return;
     }
-
-    std::string result(reinterpret_cast<const char *>(xmlStr));
-    return result;
 }
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_img_tag_scanner.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr const char *IMG_TAG_HEAD = "<img";
+constexpr size_t IMG_TAG_HEAD_LENGTH = 4;
+constexpr const char *SRC_HEAD = "src=";
+constexpr size_t SRC_HEAD_LENGTH = 4;
+constexpr const char *LINE_TERMINATORS = "\r\n";
+constexpr const char *TAG_END_OR_LINE_TERMINATORS = ">\r\n";
+
+// first position of any of chars in [from, end), end when there is none
+size_t FindFirstOf(const std::string &text, const char *chars, size_t from, size_t end)
+{
+    if (from >= end) {
+        return end;
+    }
+    auto last = text.begin() + end;
+    auto pos = std::find_first_of(text.begin() + from, last, chars, chars + strlen(chars));
+    return static_cast<size_t>(pos - text.begin());
+}
+
+// first position of needle inside [from, end), npos when there is none
+size_t FindIn(const std::string &text, const char *needle, size_t from, size_t end)
+{
+    auto last = text.begin() + end;
+    auto pos = std::search(text.begin() + from, last, needle, needle + strlen(needle));
+    return pos == last ? std::string::npos : static_cast<size_t>(pos - text.begin());
+}
+
+// caches the next occurrence of one set of characters, lookups come with growing from so each character
+// of the text is looked at once
+class NextOf {
+public:
+    NextOf(const std::string &text, const char *chars, size_t end) : text_(text), chars_(chars), end_(end) {}
+
+    size_t From(size_t from)
+    {
+        if (!valid_ || next_ < from) {
+            next_ = FindFirstOf(text_, chars_, from, end_);
+            valid_ = true;
+        }
+        return next_;
+    }
+
+private:
+    const std::string &text_;
+    const char *chars_;
+    size_t end_;
+    size_t next_ = 0;
+    bool valid_ = false;
+};
+
+// the closing quotes and line ends after a src value; one set serves every tag of an html, whose lookups come
+// in order, so a value without a line end after it does not send each tag to the end of the html again
+struct SrcCursors {
+    SrcCursors(const std::string &text, size_t end)
+        : nextSingle(text, "'", end), nextDouble(text, "\"", end), nextLineEnd(text, LINE_TERMINATORS, end)
+    {
+    }
+
+    NextOf nextSingle;
+    NextOf nextDouble;
+    NextOf nextLineEnd;
+};
+
+void ScanSrcValues(const std::string &text, size_t begin, size_t end, SrcCursors &cursors,
+    const OHOS::MiscServices::PasteboardImgTagScanner::Visitor &visitor)
+{
+    size_t cur = begin;
+    while (cur < end) {
+        size_t head = FindIn(text, SRC_HEAD, cur, end);
+        if (head == std::string::npos || head + SRC_HEAD_LENGTH >= end) {
+            return;
+        }
+        size_t quotePos = head + SRC_HEAD_LENGTH;
+        char quote = text[quotePos];
+        if (quote != '\'' && quote != '"') {
+            cur = head + 1;
+            continue;
+        }
+        size_t valueBegin = quotePos + 1;
+        size_t close = (quote == '\'' ? cursors.nextSingle : cursors.nextDouble).From(valueBegin);
+        if (close >= end || cursors.nextLineEnd.From(valueBegin) < close) {
+            // no closing quote on this line, the search resumes right after this "src="
+            cur = head + 1;
+            continue;
+        }
+        visitor(valueBegin, close);
+        cur = close + 1;
+    }
+}
+} // namespace
+
+namespace OHOS {
+namespace MiscServices {
+void PasteboardImgTagScanner::ForEachImgTag(const std::string &html, const Visitor &visitor)
+{
+    size_t cur = 0;
+    while (cur < html.size()) {
+        size_t head = html.find(IMG_TAG_HEAD, cur);
+        if (head == std::string::npos) {
+            return;
+        }
+        // '.' stops at line terminators, so the tag ends on the first '>' of its line or does not exist
+        size_t stop = FindFirstOf(html, TAG_END_OR_LINE_TERMINATORS, head + IMG_TAG_HEAD_LENGTH, html.size());
+        if (stop == html.size()) {
+            return;
+        }
+        if (html[stop] != '>') {
+            // any "<img" before that line terminator hits it as well
+            cur = stop + 1;
+            continue;
+        }
+        visitor(head, stop + 1);
+        cur = stop + 1;
+    }
+}
+
+void PasteboardImgTagScanner::ForEachSrcValue(const std::string &text, size_t begin, size_t end,
+    const Visitor &visitor)
+{
+    end = end > text.size() ? text.size() : end;
+    SrcCursors cursors(text, end);
+    ScanSrcValues(text, begin, end, cursors, visitor);
+}
+
+void PasteboardImgTagScanner::ForEachImgSrc(const std::string &html, const Visitor &visitor)
+{
+    SrcCursors cursors(html, html.size());
+    ForEachImgTag(html, [&html, &cursors, &visitor](size_t begin, size_t end) {
+        ScanSrcValues(html, begin, end, cursors, visitor);
+    });
+}
+} // namespace MiscServices
+} // namespace OHOS
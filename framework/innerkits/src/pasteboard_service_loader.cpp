@@ -194,7 +194,7 @@ int32_t PasteboardServiceLoader::GetRecordValueByType(uint32_t dataId, uint32_t
     }
     int fd = -1;
     int64_t tlvSize = static_cast<int64_t>(sendTLV.size());
-    MessageParcelWarp messageData;
+    MessageParcelWarp messageData(true);
     MessageParcel parcelData;
     if (tlvSize > MIN_ASHMEM_DATA_SIZE) {
         if (!messageData.WriteRawData(parcelData, sendTLV.data(), sendTLV.size())) {
@@ -245,8 +245,7 @@ int32_t PasteboardServiceLoader::ProcessPasteData(PasteDataEntry &data, int64_t
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "mmap failed, size=%{public}" PRId64, rawDataSize);
             return ret;
         }
-        std::vector<uint8_t> pasteDataTlv(rawData, rawData + rawDataSize);
-        result = entryValue.Decode(pasteDataTlv);
+        result = entryValue.Decode(rawData, static_cast<size_t>(rawDataSize));
     } else {
         result = entryValue.Decode(recvTLV);
         fdsan_close_with_tag(fd, PASTEBOARD_FD_TAG);
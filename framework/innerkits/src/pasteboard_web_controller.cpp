@@ -15,20 +15,16 @@
 
 #include "pasteboard_web_controller.h"
 
-#include <regex>
-
 #include "file_uri.h"
 #include "ipc_skeleton.h"
 #include "parameters.h"
 #include "pasteboard_common.h"
 #include "pasteboard_hilog.h"
 #include "pasteboard_img_extractor.h"
+#include "pasteboard_img_tag_scanner.h"
 #include "uri_permission_manager_client.h"
 
 namespace {
-constexpr const char *IMG_TAG_PATTERN = "<img.*?>";
-constexpr const char *IMG_TAG_SRC_PATTERN = "src=(['\"])(.*?)\\1";
-constexpr const char *IMG_TAG_SRC_HEAD = "src=\"";
 constexpr const char *IMG_LOCAL_PATH = "://";
 constexpr const char *FILE_SCHEME = "file";
 
@@ -294,29 +290,21 @@ void PasteboardWebController::RemoveInvalidUri(PasteData &data)
         return;
     }
 
-    uint32_t removeCount = 0;
     auto emptyUri = std::make_shared<OHOS::Uri>("");
-    size_t recordCount = data.GetRecordCount();
-    for (size_t i = 0; i < recordCount; ++i) {
-        auto record = data.GetRecordAt(i);
-        if (record == nullptr) {
-            continue;
-        }
-        auto uriPtr = record->GetOriginUri();
+    // records still encoded are checked when they are decoded, IsValidUri looks only at the record's own uri and
+    // grant flag, so a later check removes exactly what a check at paste time would have
+    data.FixupRecords([this, emptyUri](PasteDataRecord &record) {
+        auto uriPtr = record.GetOriginUri();
         if (uriPtr == nullptr) {
-            continue;
+            return;
         }
-        if (IsValidUri(uriPtr, record->HasGrantUriPermission())) {
-            continue;
+        if (IsValidUri(uriPtr, record.HasGrantUriPermission())) {
+            return;
         }
-        record->SetUri(emptyUri);
-        record->SetConvertUri("");
-        removeCount++;
-    }
-
-    if (removeCount > 0) {
-        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_COMMON, "remove count=%{public}u", removeCount);
-    }
+        record.SetUri(emptyUri);
+        record.SetConvertUri("");
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_COMMON, "remove invalid uri, recordId=%{public}u", record.GetRecordId());
+    });
 }
 
 void PasteboardWebController::RetainUri(PasteData &pasteData)
@@ -326,12 +314,9 @@ void PasteboardWebController::RetainUri(PasteData &pasteData)
         return;
     }
     // clear convert uri
-    for (size_t i = 0; i < pasteData.GetRecordCount(); ++i) {
-        auto record = pasteData.GetRecordAt(i);
-        if (record != nullptr) {
-            record->SetConvertUri("");
-        }
-    }
+    pasteData.FixupRecords([](PasteDataRecord &record) {
+        record.SetConvertUri("");
+    });
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "end");
 }
 
@@ -375,12 +360,7 @@ RecordList PasteboardWebController::SplitHtml2Records(const std::shared_ptr<std:
     if (html == nullptr) {
         return {};
     }
-    std::vector<std::pair<std::string, uint32_t>> matchVec = SplitHtmlWithImgLabel(html);
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "matchVec size: %{public}zu", matchVec.size());
-    if (matchVec.empty()) {
-        return {};
-    }
-    std::map<std::string, std::vector<uint8_t>> imgSrcMap = SplitHtmlWithImgSrcLabel(matchVec);
+    std::map<std::string, std::vector<uint8_t>> imgSrcMap = SplitHtmlWithImgSrcLabel(*html);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "imgSrcMap size: %{public}zu", imgSrcMap.size());
     if (imgSrcMap.empty()) {
         return {};
@@ -406,19 +386,10 @@ void PasteboardWebController::MergeExtraUris2Html(PasteData &data)
 std::vector<std::pair<std::string, uint32_t>> PasteboardWebController::SplitHtmlWithImgLabel(
     const std::shared_ptr<std::string> html) noexcept
 {
-    std::smatch results;
-    std::string pattern(IMG_TAG_PATTERN);
-    std::regex reg(pattern);
-    std::string::const_iterator iterStart = html->begin();
-    std::string::const_iterator iterEnd = html->end();
     std::vector<std::pair<std::string, uint32_t>> matchVec;
-
-    while (std::regex_search(iterStart, iterEnd, results, reg)) {
-        std::string tmp = results[0];
-        iterStart = results[0].second;
-        uint32_t offset = static_cast<uint32_t>(results[0].first - html->begin());
-        matchVec.emplace_back(tmp, offset);
-    }
+    PasteboardImgTagScanner::ForEachImgTag(*html, [&html, &matchVec](size_t begin, size_t end) {
+        matchVec.emplace_back(html->substr(begin, end - begin), static_cast<uint32_t>(begin));
+    });
     return matchVec;
 }
 
@@ -426,30 +397,37 @@ std::map<std::string, std::vector<uint8_t>> PasteboardWebController::SplitHtmlWi
     const std::vector<std::pair<std::string, uint32_t>> &matchVec) noexcept
 {
     std::map<std::string, std::vector<uint8_t>> res;
-    std::smatch match;
-    std::regex re(IMG_TAG_SRC_PATTERN);
     for (const auto &node : matchVec) {
-        std::string::const_iterator iterStart = node.first.begin();
-        std::string::const_iterator iterEnd = node.first.end();
-
-        while (std::regex_search(iterStart, iterEnd, match, re)) {
-            std::string tmp = match[0];
-            iterStart = match[0].second;
-            uint32_t offset = static_cast<uint32_t>(match[0].first - node.first.begin());
-            tmp = tmp.substr(strlen(IMG_TAG_SRC_HEAD));
-            tmp.pop_back();
-            if (!IsLocalURI(tmp)) {
-                continue;
-            }
-            offset += strlen(IMG_TAG_SRC_HEAD) + node.second;
-            for (uint32_t i = 0; i < FOUR_BYTES; i++) {
-                res[tmp].emplace_back((offset >> (EIGHT_BIT * i)) & 0xff);
-            }
-        }
+        PasteboardImgTagScanner::ForEachSrcValue(node.first, 0, node.first.size(),
+            [this, &node, &res](size_t begin, size_t end) {
+                AddImgSrc(res, node.first.substr(begin, end - begin), static_cast<uint32_t>(begin) + node.second);
+            });
     }
     return res;
 }
 
+std::map<std::string, std::vector<uint8_t>> PasteboardWebController::SplitHtmlWithImgSrcLabel(
+    const std::string &html) noexcept
+{
+    std::map<std::string, std::vector<uint8_t>> res;
+    PasteboardImgTagScanner::ForEachImgSrc(html, [this, &html, &res](size_t begin, size_t end) {
+        AddImgSrc(res, html.substr(begin, end - begin), static_cast<uint32_t>(begin));
+    });
+    return res;
+}
+
+void PasteboardWebController::AddImgSrc(std::map<std::string, std::vector<uint8_t>> &imgSrcMap,
+    std::string imgSrc, uint32_t offset) noexcept
+{
+    if (!IsLocalURI(imgSrc)) {
+        return;
+    }
+    auto &offsets = imgSrcMap[imgSrc];
+    for (uint32_t i = 0; i < FOUR_BYTES; i++) {
+        offsets.emplace_back((offset >> (EIGHT_BIT * i)) & 0xff);
+    }
+}
+
 RecordList PasteboardWebController::BuildPasteDataRecords(const std::map<std::string, std::vector<uint8_t>> &imgSrcMap,
     uint32_t recordId) noexcept
 {
@@ -16,7 +16,11 @@
 #include <gtest/gtest.h>
 
 #include "cJSON.h"
+#include "clip/clip_event_codec.h"
+#include "clip/clip_frame_transfer.h"
+#include "clip/clip_payload_codec.h"
 #include "clip/clip_plugin.h"
+#include "clip/loopback_clip.h"
 #include "serializable/serializable.h"
 #include "pasteboard_hilog.h"
 
@@ -342,4 +346,190 @@ HWTEST_F(ClipPluginTest, IsWiFiEnableTest, TestSize.Level0)
     ASSERT_EQ(result, false);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "IsWiFiEnableTest end");
 }
+
+/**
+ * @tc.name: PayloadCodecTest001
+ * @tc.desc: a text payload compressed for a peer that accepts it decodes back to the same bytes.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, PayloadCodecTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "PayloadCodecTest001 start");
+    std::string text;
+    while (text.size() < ClipPayloadCodec::COMPRESS_THRESHOLD * 4) {
+        text += "<p>pasteboard payload " + std::to_string(text.size() % 97) + "</p>";
+    }
+    const std::vector<uint8_t> raw(text.begin(), text.end());
+    std::vector<uint8_t> data = raw;
+    ASSERT_EQ(ClipPayloadCodec::Encode(data, ClipPayloadCodec::RAW), ClipPayloadCodec::RAW);
+    ASSERT_EQ(data, raw);
+    uint8_t version = ClipPayloadCodec::Encode(data, ClipPayloadCodec::LATEST);
+    ASSERT_EQ(version, ClipPayloadCodec::LZ_V1);
+    ASSERT_LT(data.size(), raw.size());
+    ASSERT_EQ(ClipPayloadCodec::GetDecodedSize(version, data), raw.size());
+    ASSERT_TRUE(ClipPayloadCodec::Decode(version, data));
+    ASSERT_EQ(data, raw);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "PayloadCodecTest001 end");
+}
+
+/**
+ * @tc.name: PayloadCodecTest002
+ * @tc.desc: the payload versions of an event survive Marshal and Unmarshal.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, PayloadCodecTest002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "PayloadCodecTest002 start");
+    ClipPlugin::GlobalEvent globalEvent;
+    globalEvent.payloadVersion = ClipPayloadCodec::LZ_V1;
+    globalEvent.acceptPayloadVersion = ClipPayloadCodec::LATEST;
+    ClipPlugin::GlobalEvent result;
+    ASSERT_TRUE(result.Unmarshall(globalEvent.Marshall()));
+    ASSERT_EQ(result.payloadVersion, ClipPayloadCodec::LZ_V1);
+    ASSERT_EQ(result.acceptPayloadVersion, ClipPayloadCodec::LATEST);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "PayloadCodecTest002 end");
+}
+
+/**
+ * @tc.name: FrameTransferTest001
+ * @tc.desc: a plugin that does not override the frame methods keeps clips in one payload.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, FrameTransferTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "FrameTransferTest001 start");
+    auto clipPlugin = std::make_shared<CustomClipPlugin>();
+    ASSERT_NE(clipPlugin, nullptr);
+    ASSERT_FALSE(clipPlugin->IsFrameSupported());
+    ClipPlugin::GlobalEvent event;
+    std::vector<std::vector<uint8_t>> frames = { { 1 }, { 2 } };
+    ASSERT_NE(clipPlugin->SetPasteDataFrames(event, frames, 0, {}), 0);
+    std::vector<uint8_t> frame;
+    ASSERT_NE(clipPlugin->GetPasteDataFrame(event, 0, frame).first, 0);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "FrameTransferTest001 end");
+}
+
+/**
+ * @tc.name: FrameTransferTest002
+ * @tc.desc: records above the frame size are split into frames of whole records, and acceptFrames survives
+ *           Marshal and Unmarshal.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, FrameTransferTest002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "FrameTransferTest002 start");
+    std::vector<size_t> recordSizes(4, ClipFrameTransfer::FRAME_SIZE / 2);
+    auto starts = ClipFrameTransfer::PlanFrames(recordSizes);
+    ASSERT_EQ(starts, std::vector<size_t>({ 0, 2 }));
+    ClipPlugin::GlobalEvent globalEvent;
+    globalEvent.acceptFrames = true;
+    ClipPlugin::GlobalEvent result;
+    ASSERT_TRUE(result.Unmarshall(globalEvent.Marshall()));
+    ASSERT_TRUE(result.acceptFrames);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "FrameTransferTest002 end");
+}
+
+/**
+ * @tc.name: LoopbackClipTest001
+ * @tc.desc: a clip set through a registered loopback plugin comes back as the peer's, and is fetched whole.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, LoopbackClipTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LoopbackClipTest001 start");
+    static LoopbackClip::Factory factory;
+    ASSERT_TRUE(ClipPlugin::RegCreator("loopback_clip_test", &factory));
+    ClipPlugin *clipPlugin = ClipPlugin::CreatePlugin("loopback_clip_test");
+    ASSERT_NE(clipPlugin, nullptr);
+    ClipPlugin::GlobalEvent event;
+    event.user = 100;
+    event.seqId = 1;
+    event.deviceId = "local";
+    std::vector<uint8_t> payload(ClipFrameTransfer::FRAME_SIZE, 'a');
+    ASSERT_EQ(clipPlugin->SetPasteData(event, payload, 0, {}), 0);
+    auto events = clipPlugin->GetTopEvents(1, event.user);
+    ASSERT_EQ(events.size(), 1U);
+    ASSERT_EQ(events[0].deviceId, LoopbackClip::LinkConfig().peerId);
+    std::vector<uint8_t> data;
+    ASSERT_EQ(clipPlugin->GetPasteData(events[0], data).first, 0);
+    ASSERT_EQ(data, payload);
+    clipPlugin->Clear(event.user);
+    ASSERT_TRUE(clipPlugin->GetTopEvents(1, event.user).empty());
+    ASSERT_TRUE(ClipPlugin::DestroyPlugin("loopback_clip_test", clipPlugin));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LoopbackClipTest001 end");
+}
+
+/**
+ * @tc.name: LoopbackClipTest002
+ * @tc.desc: frames cross the loopback link one per fetch, and each fetch pays the configured latency.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, LoopbackClipTest002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LoopbackClipTest002 start");
+    LoopbackClip::LinkConfig config;
+    config.latencyMs = 5;
+    LoopbackClip clipPlugin(config);
+    ASSERT_TRUE(clipPlugin.IsFrameSupported());
+    ClipPlugin::GlobalEvent event;
+    event.frameNum = 2;
+    std::vector<std::vector<uint8_t>> frames = { { 1 }, { 2 } };
+    ASSERT_EQ(clipPlugin.SetPasteDataFrames(event, frames, 0, {}), 0);
+    std::vector<uint8_t> frame;
+    auto [ret, syncTime] = clipPlugin.GetPasteDataFrame(event, 1, frame);
+    ASSERT_EQ(ret, 0);
+    ASSERT_GE(syncTime, static_cast<int32_t>(2 * config.latencyMs));
+    ASSERT_EQ(frame, frames[1]);
+    ASSERT_NE(clipPlugin.GetPasteDataFrame(event, 2, frame).first, 0);
+    ASSERT_NE(clipPlugin.GetPasteData(event, frame).first, 0);
+    ASSERT_EQ(clipPlugin.GetTransferredBytes(), 1U);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LoopbackClipTest002 end");
+}
+
+/**
+ * @tc.name: EventCodecTest001
+ * @tc.desc: an event encoded for a peer that decodes binary keeps its fields, and JSON is sent otherwise.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, EventCodecTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "EventCodecTest001 start");
+    ClipPlugin::GlobalEvent event;
+    event.seqId = 7;
+    event.dataId = 3;
+    event.isDelay = true;
+    event.deviceId = "local";
+    event.dataType = { "text/plain" };
+    event.acceptEventVersion = ClipEventCodec::LATEST;
+    ClipPlugin::GlobalEvent decoded;
+    ASSERT_TRUE(ClipEventCodec::Decode(ClipEventCodec::Encode(event, ClipEventCodec::LATEST), decoded));
+    ASSERT_EQ(decoded.seqId, event.seqId);
+    ASSERT_EQ(decoded.dataId, event.dataId);
+    ASSERT_TRUE(decoded.isDelay);
+    ASSERT_EQ(decoded.dataType, event.dataType);
+    ASSERT_EQ(decoded.acceptEventVersion, ClipEventCodec::LATEST);
+
+    auto json = ClipEventCodec::Encode(event, ClipEventCodec::JSON);
+    ASSERT_EQ(std::string(json.begin(), json.end()), event.Marshall());
+    decoded = ClipPlugin::GlobalEvent();
+    ASSERT_TRUE(ClipEventCodec::Decode(json, decoded));
+    ASSERT_EQ(decoded.seqId, event.seqId);
+    ASSERT_EQ(decoded.acceptEventVersion, ClipEventCodec::LATEST);
+    ASSERT_FALSE(ClipEventCodec::Decode({}, decoded));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "EventCodecTest001 end");
+}
 } // namespace OHOS::MiscServices
@@ -14,10 +14,12 @@
  */
 #include <cstring>
 #include <iostream>
+#include <vector>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <sys/mman.h>
 
+#include "ashmem_pool.h"
 #include "message_parcel_warp.h"
 #include "pasteboard_hilog.h"
 using namespace testing;
@@ -341,5 +343,65 @@ HWTEST_F(MessageParcelWarpTest, ReadRawDataTest003, TestSize.Level0)
     EXPECT_EQ(result, nullptr);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ReadRawDataTest003 end");
 }
+
+/**
+ * @tc.name: WriteRawDataTest005
+ * @tc.desc: a request written with recycleRegion leaves its region to the pool, and the next one reuses it
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MessageParcelWarpTest, WriteRawDataTest005, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "WriteRawDataTest005 start");
+    AshmemPool::GetInstance().Clear();
+    auto before = AshmemPool::GetInstance().GetStats();
+    size_t size = MIN_RAW_SIZE + 1;
+    std::vector<char> data(size, 'A');
+    NiceMock<MessageParcelWarpMock> mock;
+    EXPECT_CALL(mock, WriteInt64).WillRepeatedly(testing::Return(true));
+    EXPECT_CALL(mock, WriteFileDescriptor).WillRepeatedly(testing::Return(true));
+    int fd = -1;
+    {
+        MessageParcelWarp messageParcelWarp(true);
+        MessageParcel parcel;
+        EXPECT_TRUE(messageParcelWarp.WriteRawData(parcel, data.data(), size));
+        fd = messageParcelWarp.GetWriteDataFd();
+        EXPECT_GE(fd, 0);
+    }
+    {
+        MessageParcelWarp messageParcelWarp(true);
+        MessageParcel parcel;
+        EXPECT_TRUE(messageParcelWarp.WriteRawData(parcel, data.data(), size));
+        EXPECT_EQ(messageParcelWarp.GetWriteDataFd(), fd);
+    }
+    auto after = AshmemPool::GetInstance().GetStats();
+    EXPECT_EQ(after.hits - before.hits, 1U);
+    EXPECT_EQ(after.reusedBytes - before.reusedBytes, size);
+    AshmemPool::GetInstance().Clear();
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "WriteRawDataTest005 end");
+}
+
+/**
+ * @tc.name: CreateTmpFdTest001
+ * @tc.desc: tmp fds are owned copies of one shared placeholder
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MessageParcelWarpTest, CreateTmpFdTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "CreateTmpFdTest001 start");
+    auto before = AshmemPool::GetInstance().GetStats();
+    MessageParcelWarp first;
+    MessageParcelWarp second;
+    int firstFd = first.CreateTmpFd();
+    int secondFd = second.CreateTmpFd();
+    EXPECT_GE(firstFd, 0);
+    EXPECT_GE(secondFd, 0);
+    EXPECT_NE(firstFd, secondFd);
+    EXPECT_EQ(first.GetWriteDataFd(), firstFd);
+    auto after = AshmemPool::GetInstance().GetStats();
+    EXPECT_EQ(after.placeholders - before.placeholders, 2U);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "CreateTmpFdTest001 end");
+}
 }
 }
@@ -13,7 +13,10 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <cstdio>
+#include <functional>
+#include <thread>
 #include <gtest/gtest.h>
 
 #include "clip/clip_plugin.h"
@@ -2210,4 +2213,329 @@ HWTEST_F(PasteDataTest, GetPasteIdDefaultTest001, TestSize.Level0)
     EXPECT_EQ("", pasteData.GetPasteId());
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "GetPasteIdDefaultTest001 end");
 }
+
+/**
+ * @tc.name: EncodedRecordsTest001
+ * @tc.desc: splicing records encoded once gives the bytes of a full encode under a different envelope,
+ *           and copies do not inherit the spliced records
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, EncodedRecordsTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "EncodedRecordsTest001 start");
+    PasteData stored;
+    stored.AddTextRecord("encoded records text");
+    stored.AddHtmlRecord("<p>encoded records html</p>");
+    auto encodedRecords = stored.EncodeRecordsTLV();
+    ASSERT_NE(encodedRecords, nullptr);
+
+    PasteData reader = stored;
+    reader.SetBundleInfo("com.example.reader", 1);
+    reader.SetLocalPasteFlag(true);
+    reader.SetPasteId("encoded_records_paste_id");
+    std::vector<uint8_t> expected;
+    ASSERT_TRUE(reader.Encode(expected));
+
+    reader.SetEncodedRecords(encodedRecords);
+    std::vector<uint8_t> spliced;
+    ASSERT_TRUE(reader.Encode(spliced));
+    EXPECT_EQ(spliced, expected);
+    EXPECT_EQ(reader.Count(), expected.size());
+
+    PasteData copied = reader;
+    copied.AddTextRecord("added after copy");
+    std::vector<uint8_t> copiedTlv;
+    ASSERT_TRUE(copied.Encode(copiedTlv));
+    PasteData decoded;
+    ASSERT_TRUE(decoded.Decode(copiedTlv));
+    EXPECT_EQ(decoded.GetRecordCount(), copied.GetRecordCount());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "EncodedRecordsTest001 end");
+}
+
+/**
+ * @tc.name: EncodedRecordsTest002
+ * @tc.desc: every change to the record list drops the spliced records, the clip then encodes as a fresh copy does
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, EncodedRecordsTest002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "EncodedRecordsTest002 start");
+    PasteData other;
+    other.AddTextRecord("encoded records other");
+    std::vector<std::function<void(PasteData &)>> mutations = {
+        [](PasteData &data) { data.AddTextRecord("encoded records added"); },
+        [](PasteData &data) { data.RemoveRecordAt(0); },
+        [](PasteData &data) { data.RemoveRecords({ true }); },
+        [](PasteData &data) { data.ReplaceRecordAt(0, PasteDataRecord::NewPlainTextRecord("replaced")); },
+        [](PasteData &data) { data.DetachRecordAt(0)->SetConvertUri("detached"); },
+        [](PasteData &data) { data.FixupRecords([](PasteDataRecord &record) { record.SetConvertUri("fixed"); }); },
+        [&other](PasteData &data) { data.AppendRecords(other); },
+        [&other](PasteData &data) { data.ShareFrom(other); },
+        [&other](PasteData &data) { data = other; },
+    };
+    for (std::size_t index = 0; index < mutations.size(); ++index) {
+        PasteData data;
+        data.AddTextRecord("encoded records text");
+        data.AddHtmlRecord("<p>encoded records html</p>");
+        data.SetEncodedRecords(data.EncodeRecordsTLV());
+        mutations[index](data);
+        PasteData fresh = data;
+        std::vector<uint8_t> expected;
+        std::vector<uint8_t> encoded;
+        ASSERT_TRUE(fresh.Encode(expected));
+        ASSERT_TRUE(data.Encode(encoded));
+        EXPECT_EQ(encoded, expected) << "mutation " << index;
+        EXPECT_EQ(data.Count(), expected.size()) << "mutation " << index;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "EncodedRecordsTest002 end");
+}
+
+/**
+ * @tc.name: ShareFromTest001
+ * @tc.desc: a shared snapshot reuses the records of its source until one is detached,
+ *           changing a detached record leaves the source untouched
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, ShareFromTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ShareFromTest001 start");
+    PasteData source;
+    source.AddTextRecord("shared text");
+    source.AddUriRecord(OHOS::Uri("file://pasteboard/shared.txt"));
+    source.SetPasteId("share_from_paste_id");
+
+    PasteData snapshot;
+    snapshot.ShareFrom(source);
+    ASSERT_EQ(snapshot.GetRecordCount(), source.GetRecordCount());
+    EXPECT_EQ(snapshot.GetPasteId(), source.GetPasteId());
+    EXPECT_EQ(snapshot.GetRecordAt(0), source.GetRecordAt(0));
+    EXPECT_EQ(snapshot.GetRecordAt(1), source.GetRecordAt(1));
+
+    auto detached = snapshot.DetachRecordAt(1);
+    ASSERT_NE(detached, nullptr);
+    EXPECT_NE(detached, source.GetRecordAt(1));
+    EXPECT_EQ(detached, snapshot.GetRecordAt(1));
+    detached->SetConvertUri("file://pasteboard/converted.txt");
+    EXPECT_TRUE(source.GetRecordAt(1)->GetConvertUri().empty());
+    EXPECT_EQ(snapshot.GetRecordAt(0), source.GetRecordAt(0));
+    EXPECT_EQ(snapshot.DetachRecordAt(snapshot.GetRecordCount()), nullptr);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ShareFromTest001 end");
+}
+
+/**
+ * @tc.name: TypeIndexTest001
+ * @tc.desc: the type index answers the same mime and utd queries as walking the records
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, TypeIndexTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TypeIndexTest001 start");
+    PasteData pasteData;
+    auto emptyIndex = pasteData.BuildTypeIndex();
+    ASSERT_NE(emptyIndex, nullptr);
+    EXPECT_TRUE(emptyIndex->mimeTypes.empty());
+    EXPECT_FALSE(emptyIndex->HasMimeType(MIMETYPE_TEXT_PLAIN));
+
+    pasteData.AddTextRecord("type index text");
+    pasteData.AddHtmlRecord("<p>type index html</p>");
+    pasteData.AddUriRecord(OHOS::Uri("file://pasteboard/type_index.txt"));
+    auto index = pasteData.BuildTypeIndex();
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->mimeTypes, pasteData.GetMimeTypes());
+    EXPECT_TRUE(index->HasMimeType(MIMETYPE_TEXT_PLAIN));
+    EXPECT_TRUE(index->HasMimeType(MIMETYPE_TEXT_HTML));
+    EXPECT_TRUE(index->HasMimeType(MIMETYPE_TEXT_URI));
+    EXPECT_FALSE(index->HasMimeType(MIMETYPE_PIXELMAP));
+    EXPECT_TRUE(index->HasAnyMimeType({ MIMETYPE_PIXELMAP, MIMETYPE_TEXT_HTML }));
+    EXPECT_FALSE(index->HasAnyMimeType({ MIMETYPE_PIXELMAP, MIMETYPE_TEXT_WANT }));
+    EXPECT_FALSE(index->utdTypes.empty());
+    for (const auto &utdType : index->utdTypes) {
+        EXPECT_TRUE(index->HasUtdType(utdType));
+        EXPECT_TRUE(pasteData.HasUtdType(utdType));
+    }
+    EXPECT_FALSE(index->HasUtdType("general.not-a-type"));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "TypeIndexTest001 end");
+}
+
+/**
+ * @tc.name: RemoveRecordsTest001
+ * @tc.desc: RemoveRecords drops the flagged records in one pass and keeps the others in order
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, RemoveRecordsTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "RemoveRecordsTest001 start");
+    PasteData pasteData;
+    pasteData.AddTextRecord("remove records 0");
+    pasteData.AddHtmlRecord("<p>remove records 1</p>");
+    pasteData.AddTextRecord("remove records 2");
+    pasteData.AddUriRecord(OHOS::Uri("file://pasteboard/remove_records.txt"));
+    std::vector<std::shared_ptr<PasteDataRecord>> records = pasteData.AllRecords();
+    ASSERT_EQ(records.size(), 4);
+
+    EXPECT_EQ(pasteData.RemoveRecords({ false, false, false, false }), 0);
+    EXPECT_EQ(pasteData.RemoveRecords({ true, false, true }), 2);
+    ASSERT_EQ(pasteData.GetRecordCount(), 2);
+    EXPECT_EQ(pasteData.GetRecordAt(0), records[1]);
+    EXPECT_EQ(pasteData.GetRecordAt(1), records[3]);
+    std::vector<std::string> mimeTypes = { records[1]->GetMimeType(), records[3]->GetMimeType() };
+    EXPECT_EQ(pasteData.GetProperty().mimeTypes, mimeTypes);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "RemoveRecordsTest001 end");
+}
+
+/**
+ * @tc.name: LazyRecordDecodeTest001
+ * @tc.desc: a clip decoded lazily decodes only the records its getters reach, re-encodes to the bytes it was
+ *           decoded from, and applies fixups to records decoded after them
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, LazyRecordDecodeTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LazyRecordDecodeTest001 start");
+    PasteData stored;
+    stored.AddHtmlRecord("<p>lazy record html</p>");
+    stored.AddTextRecord("lazy record text 1");
+    stored.AddTextRecord("lazy record text 0");
+    std::vector<uint8_t> encoded;
+    ASSERT_TRUE(stored.Encode(encoded));
+
+    PasteData lazy;
+    lazy.SetLazyRecordDecode(true);
+    ASSERT_TRUE(lazy.Decode(encoded));
+    EXPECT_EQ(lazy.GetRecordCount(), 3);
+    std::vector<uint8_t> untouched;
+    ASSERT_TRUE(lazy.Encode(untouched));
+    EXPECT_EQ(untouched, encoded);
+
+    uint32_t fixups = 0;
+    lazy.FixupRecords([&fixups](PasteDataRecord &) {
+        ++fixups;
+    });
+    EXPECT_EQ(fixups, 0);
+    auto primaryText = lazy.GetPrimaryText();
+    ASSERT_NE(primaryText, nullptr);
+    EXPECT_EQ(*primaryText, "lazy record text 0");
+    EXPECT_EQ(fixups, 1);
+    auto primaryMimeType = lazy.GetPrimaryMimeType();
+    ASSERT_NE(primaryMimeType, nullptr);
+    EXPECT_EQ(*primaryMimeType, MIMETYPE_TEXT_PLAIN);
+    EXPECT_EQ(fixups, 1);
+
+    EXPECT_EQ(lazy.AllRecords().size(), 3);
+    EXPECT_EQ(fixups, 3);
+    PasteData eager;
+    ASSERT_TRUE(eager.Decode(encoded));
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> decoded;
+    ASSERT_TRUE(eager.Encode(expected));
+    ASSERT_TRUE(lazy.Encode(decoded));
+    EXPECT_EQ(decoded, expected);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LazyRecordDecodeTest001 end");
+}
+
+/**
+ * @tc.name: LazyRecordDecodeTest002
+ * @tc.desc: a record that fails to decode lazily reads as nullptr and is counted, the type queries skip it
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, LazyRecordDecodeTest002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LazyRecordDecodeTest002 start");
+    PasteData stored;
+    stored.AddHtmlRecord("<p>lazy record html</p>");
+    stored.AddTextRecord("lazy record text");
+    std::vector<uint8_t> encoded;
+    ASSERT_TRUE(stored.Encode(encoded));
+
+    PasteData lazy;
+    lazy.SetLazyRecordDecode(true);
+    ASSERT_TRUE(lazy.Decode(encoded));
+    ASSERT_NE(lazy.lazyRecords_, nullptr);
+    ASSERT_EQ(lazy.lazyRecords_->items_.size(), 2);
+    // the first field head of the text record claims more bytes than the record holds
+    size_t lenOffset = lazy.lazyRecords_->items_[0].offset + sizeof(TLVHead) + sizeof(uint16_t);
+    ASSERT_LT(lenOffset + sizeof(uint32_t), lazy.lazyRecords_->encoded_.size());
+    std::fill_n(lazy.lazyRecords_->encoded_.begin() + lenOffset, sizeof(uint32_t), 0xFF);
+
+    EXPECT_EQ(lazy.GetUndecodedRecordCount(), 0);
+    EXPECT_EQ(lazy.GetRecordAt(0), nullptr);
+    EXPECT_EQ(lazy.GetRecordAt(0), nullptr);
+    EXPECT_EQ(lazy.GetUndecodedRecordCount(), 1);
+    EXPECT_EQ(lazy.GetRecordCount(), 2);
+    EXPECT_TRUE(lazy.HasMimeType(MIMETYPE_TEXT_HTML));
+    EXPECT_FALSE(lazy.HasMimeType(MIMETYPE_TEXT_PLAIN));
+    EXPECT_FALSE(lazy.HasUtdType("lazy.record.invalid"));
+    std::vector<std::string> mimeTypes = { MIMETYPE_TEXT_HTML };
+    EXPECT_EQ(lazy.GetMimeTypes(), mimeTypes);
+    auto primaryHtml = lazy.GetPrimaryHtml();
+    ASSERT_NE(primaryHtml, nullptr);
+    EXPECT_EQ(*primaryHtml, "<p>lazy record html</p>");
+    // a copy drops the record but still reports the clip as partial
+    PasteData copied(lazy);
+    EXPECT_EQ(copied.GetRecordCount(), 1);
+    EXPECT_EQ(copied.GetUndecodedRecordCount(), 1);
+    PasteData shared;
+    shared.ShareFrom(lazy);
+    EXPECT_EQ(shared.GetUndecodedRecordCount(), 1);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LazyRecordDecodeTest002 end");
+}
+
+/**
+ * @tc.name: LazyRecordDecodeTest003
+ * @tc.desc: const getters of one lazily decoded clip may run on several threads, each record is decoded once
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteDataTest, LazyRecordDecodeTest003, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LazyRecordDecodeTest003 start");
+    constexpr size_t recordCount = 64;
+    constexpr size_t threadCount = 4;
+    PasteData stored;
+    for (size_t index = 0; index < recordCount; ++index) {
+        stored.AddTextRecord("lazy record text " + std::to_string(index));
+    }
+    std::vector<uint8_t> encoded;
+    ASSERT_TRUE(stored.Encode(encoded));
+
+    auto lazy = std::make_shared<PasteData>();
+    lazy->SetLazyRecordDecode(true);
+    ASSERT_TRUE(lazy->Decode(encoded));
+    std::atomic<uint32_t> fixups{ 0 };
+    lazy->FixupRecords([&fixups](PasteDataRecord &) {
+        ++fixups;
+    });
+    std::vector<std::thread> readers;
+    for (size_t thread = 0; thread < threadCount; ++thread) {
+        readers.emplace_back([lazy, thread]() {
+            for (size_t index = 0; index < recordCount; ++index) {
+                auto record = lazy->GetRecordAt((index + thread * recordCount / threadCount) % recordCount);
+                EXPECT_NE(record, nullptr);
+            }
+            EXPECT_NE(lazy->CountTLV(), 0);
+            EXPECT_EQ(lazy->AllRecords().size(), recordCount);
+        });
+    }
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(fixups.load(), recordCount);
+    EXPECT_EQ(lazy->lazyRecords_, nullptr);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "LazyRecordDecodeTest003 end");
+}
 } // namespace OHOS::MiscServices
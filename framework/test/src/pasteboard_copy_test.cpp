@@ -13,11 +13,14 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include "folder.h"
 #include "pasteboard_client.h"
 #include "pasteboard_copy.h"
+#include "pasteboard_copy_scheduler.h"
 #include "pasteboard_error.h"
 #include "pasteboard_hilog.h"
 #include "unified_data.h"
@@ -557,4 +560,42 @@ HWTEST_F(PasteboardCopyTest, ProcessCallBackTest004, TestSize.Level0)
     EXPECT_EQ(dataParams->info->percentage, 20);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ProcessCallBackTest004 end");
 }
+
+/**
+ * @tc.name: ProcessCallBackTest005
+ * @tc.desc: progress of parallel copies summed by PasteboardCopyProgress reaches HandleProgress in increasing order
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardCopyTest, ProcessCallBackTest005, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ProcessCallBackTest005 start");
+    PasteBoardCopyFile &pasteBoardCopyFile = PasteBoardCopyFile::GetInstance();
+    constexpr uint32_t recordSize = 4;
+    pasteBoardCopyFile.recordSize_.store(recordSize);
+
+    std::shared_ptr<GetDataParams> dataParams = std::make_shared<GetDataParams>();
+    dataParams->info = new ProgressInfo();
+    dataParams->info->percentage = 0;
+
+    std::vector<int32_t> reported;
+    PasteboardCopyProgress progress(recordSize, [&](size_t slot, uint64_t total) {
+        pasteBoardCopyFile.HandleProgress(static_cast<int32_t>(total / 100 + 1), CopyInfo(),
+            static_cast<uint32_t>(total % 100), dataParams);
+        reported.push_back(dataParams->info->percentage);
+    });
+    progress.Complete(0);
+    progress.Update(2, 50);
+    progress.Update(1, 30);
+    progress.Update(2, 40);
+    progress.Update(3, 100);
+    progress.Update(1, 100);
+    progress.Update(2, 100);
+    ASSERT_EQ(reported.size(), 5);
+    EXPECT_TRUE(std::is_sorted(reported.begin(), reported.end()));
+    EXPECT_EQ(progress.GetTotal(), recordSize * 100);
+    EXPECT_EQ(reported.back(), 100);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "ProcessCallBackTest005 end");
+}
 } // namespace OHOS::MiscServices
@@ -410,6 +410,34 @@ HWTEST_F(PasteboardWebControllerTest, SplitHtmlWithImgSrcLabel_002, TestSize.Lev
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgSrcLabel_002 end");
 }
 
+/**
+ * @tc.name: SplitHtmlWithImgSrcLabel_003.
+ * @tc.desc: scanning the whole html gives the same local src values and offsets as splitting by img tags.
+ * @tc.type: FUNC.
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardWebControllerTest, SplitHtmlWithImgSrcLabel_003, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgSrcLabel_003 start");
+    auto webClipboardController = PasteboardWebController::GetInstance();
+    std::string htmlText = "<p>x<img src=\"file:///a.png\"/><img\nsrc=\"file:///skip.png\">"
+        "<img alt='y' src='file:///a.png'><img src=\"https://example.com/c.png\"></p>";
+    auto html = std::make_shared<std::string>(htmlText);
+
+    auto result = webClipboardController.SplitHtmlWithImgSrcLabel(htmlText);
+
+    EXPECT_EQ(result, webClipboardController.SplitHtmlWithImgSrcLabel(
+        webClipboardController.SplitHtmlWithImgLabel(html)));
+    ASSERT_EQ(result.size(), 1u);
+    ASSERT_NE(result.find("file:///a.png"), result.end());
+    uint32_t first = htmlText.find("file:///a.png");
+    uint32_t second = htmlText.find("file:///a.png", first + 1);
+    EXPECT_EQ(result["file:///a.png"], std::vector<uint8_t>({ static_cast<uint8_t>(first), 0, 0, 0,
+        static_cast<uint8_t>(second), 0, 0, 0 }));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "SplitHtmlWithImgSrcLabel_003 end");
+}
+
 /**
  * @tc.name: ExtractContent_001.
  * @tc.desc: item is nullptr.
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ashmem_pool.h"
+
+#include <cerrno>
+#include <cinttypes>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ashmem.h"
+#ifndef CROSS_PLATFORM
+#include "fd_san.h"
+#endif
+#include "pasteboard_hilog.h"
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr size_t MIN_CAPACITY = 64 * 1024; // 64k, the smallest payload sent in ashmem is 32k
+constexpr size_t MAX_IDLE_BYTES = 16 * 1024 * 1024; // 16M
+constexpr size_t MAX_IDLE_REGIONS = 4;
+
+// power of two capacities let a region serve the next clips of about the same size
+size_t RoundCapacity(size_t size)
+{
+    if (size > MAX_IDLE_BYTES) {
+        return size;
+    }
+    size_t capacity = MIN_CAPACITY;
+    while (capacity < size) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+void CloseFd(int fd)
+{
+#ifndef CROSS_PLATFORM
+    ::fdsan_close_with_tag(fd, PASTEBOARD_FD_TAG);
+#else
+    ::close(fd);
+#endif
+}
+} // namespace
+
+AshmemPool &AshmemPool::GetInstance()
+{
+    static AshmemPool instance;
+    return instance;
+}
+
+AshmemPool::~AshmemPool()
+{
+    Clear();
+    if (placeholderFd_ >= 0) {
+        CloseFd(placeholderFd_);
+        placeholderFd_ = -1;
+    }
+}
+
+bool AshmemPool::Acquire(size_t size, Region &region)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(size > 0, false, PASTEBOARD_MODULE_COMMON, "size invalid");
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto best = idle_.end();
+        for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+            if (it->capacity >= size && (best == idle_.end() || it->capacity < best->capacity)) {
+                best = it;
+            }
+        }
+        if (best != idle_.end()) {
+            region = *best;
+            idleBytes_ -= best->capacity;
+            idle_.erase(best);
+            ++stats_.hits;
+            stats_.reusedBytes += size;
+            return true;
+        }
+        ++stats_.misses;
+        stats = stats_;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "ashmem pool miss, size:%{public}zu hits:%{public}" PRIu64
+        " misses:%{public}" PRIu64, size, stats.hits, stats.misses);
+    return CreateRegion(RoundCapacity(size), region);
+}
+
+void AshmemPool::Recycle(Region &region)
+{
+    if (region.fd < 0) {
+        return;
+    }
+    std::vector<Region> evicted;
+    if (region.capacity <= MAX_IDLE_BYTES) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // the oldest regions make room for the size the process copies now
+        while (!idle_.empty() &&
+            (idle_.size() >= MAX_IDLE_REGIONS || idleBytes_ + region.capacity > MAX_IDLE_BYTES)) {
+            idleBytes_ -= idle_.front().capacity;
+            evicted.push_back(idle_.front());
+            idle_.erase(idle_.begin());
+            ++stats_.evictions;
+        }
+        idle_.push_back(region);
+        idleBytes_ += region.capacity;
+        region = Region();
+    }
+    for (auto &old : evicted) {
+        DestroyRegion(old);
+    }
+    DestroyRegion(region);
+}
+
+int AshmemPool::DupPlaceholder()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (placeholderFd_ < 0) {
+        int fd = AshmemCreate("PasteboardTmpAshmem", 1);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, -1, PASTEBOARD_MODULE_COMMON, "ashmem create failed");
+#ifndef CROSS_PLATFORM
+        fdsan_exchange_owner_tag(fd, 0, PASTEBOARD_FD_TAG);
+#endif
+        // nothing is ever written to it, so every process it is sent to may share it
+        if (AshmemSetProt(fd, PROT_READ) < 0) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "ashmem set prot failed");
+            CloseFd(fd);
+            return -1;
+        }
+        placeholderFd_ = fd;
+    }
+    int fd = ::dup(placeholderFd_);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, -1, PASTEBOARD_MODULE_COMMON,
+        "dup placeholder failed, errno:%{public}d", errno);
+    ++stats_.placeholders;
+    return fd;
+}
+
+AshmemPool::Stats AshmemPool::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void AshmemPool::Clear()
+{
+    std::vector<Region> idle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle.swap(idle_);
+        idleBytes_ = 0;
+    }
+    for (auto &region : idle) {
+        DestroyRegion(region);
+    }
+}
+
+bool AshmemPool::CreateRegion(size_t capacity, Region &region)
+{
+    int fd = AshmemCreate("Pasteboard Ashmem", capacity);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, false, PASTEBOARD_MODULE_COMMON, "ashmem create failed");
+#ifndef CROSS_PLATFORM
+    fdsan_exchange_owner_tag(fd, 0, PASTEBOARD_FD_TAG);
+#endif
+    if (AshmemSetProt(fd, PROT_READ | PROT_WRITE) < 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "ashmem set prot failed");
+        CloseFd(fd);
+        return false;
+    }
+    void *ptr = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "mmap failed, fd:%{public}d size:%{public}zu", fd, capacity);
+        CloseFd(fd);
+        return false;
+    }
+    region.fd = fd;
+    region.ptr = ptr;
+    region.capacity = capacity;
+    return true;
+}
+
+void AshmemPool::DestroyRegion(Region &region)
+{
+    if (region.ptr != nullptr) {
+        ::munmap(region.ptr, region.capacity);
+    }
+    if (region.fd >= 0) {
+        CloseFd(region.fd);
+    }
+    region = Region();
+}
+
+std::shared_ptr<const SealedAshmem> SealedAshmem::Create(size_t size, const Writer &writer)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(size > 0 && writer != nullptr, nullptr, PASTEBOARD_MODULE_COMMON,
+        "param invalid, size:%{public}zu", size);
+    int fd = AshmemCreate("Pasteboard Sealed Ashmem", size);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, nullptr, PASTEBOARD_MODULE_COMMON, "ashmem create failed");
+#ifndef CROSS_PLATFORM
+    fdsan_exchange_owner_tag(fd, 0, PASTEBOARD_FD_TAG);
+#endif
+    std::shared_ptr<const SealedAshmem> sealed(new (std::nothrow) SealedAshmem(fd, size));
+    if (sealed == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "alloc sealed ashmem failed");
+        CloseFd(fd);
+        return nullptr;
+    }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(AshmemSetProt(fd, PROT_READ | PROT_WRITE) >= 0, nullptr,
+        PASTEBOARD_MODULE_COMMON, "ashmem set prot failed");
+    void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ptr != MAP_FAILED, nullptr, PASTEBOARD_MODULE_COMMON,
+        "mmap failed, fd:%{public}d size:%{public}zu", fd, size);
+    bool ret = writer(static_cast<uint8_t *>(ptr), size);
+    // the writable mapping goes first, a seal does not reach mappings made before it
+    ::munmap(ptr, size);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, nullptr, PASTEBOARD_MODULE_COMMON,
+        "write sealed ashmem failed, size:%{public}zu", size);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(AshmemSetProt(fd, PROT_READ) >= 0, nullptr, PASTEBOARD_MODULE_COMMON,
+        "seal ashmem failed, fd:%{public}d", fd);
+    return sealed;
+}
+
+SealedAshmem::SealedAshmem(int fd, size_t size) : fd_(fd), size_(size) {}
+
+SealedAshmem::~SealedAshmem()
+{
+    if (fd_ >= 0) {
+        CloseFd(fd_);
+    }
+}
+
+int SealedAshmem::Dup() const
+{
+    int fd = ::dup(fd_);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, -1, PASTEBOARD_MODULE_COMMON,
+        "dup sealed ashmem failed, errno:%{public}d", errno);
+    return fd;
+}
+
+size_t SealedAshmem::GetSize() const
+{
+    return size_;
+}
+} // namespace MiscServices
+} // namespace OHOS
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASHMEM_POOL_H
+#define ASHMEM_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "api/visibility.h"
+
+namespace OHOS {
+namespace MiscServices {
+
+/*
+ * Shared memory regions of this process, kept mapped across IPC calls. A region may only come back once
+ * its receiver is done with it, which for a synchronous request is when the call returns. Replies, and
+ * anything sent to a process that could keep the fd and read later clips, must use fresh regions.
+ */
+class API_EXPORT AshmemPool final {
+public:
+    struct Region {
+        int fd = -1;
+        void *ptr = nullptr;
+        size_t capacity = 0;
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t reusedBytes = 0;
+        uint64_t evictions = 0;
+        uint64_t placeholders = 0;
+    };
+
+    static AshmemPool &GetInstance();
+
+    // a mapped, writable region of at least size bytes, idle or newly created
+    bool Acquire(size_t size, Region &region);
+    // keeps the region for the next Acquire, or unmaps and closes it when the pool is full
+    void Recycle(Region &region);
+    // a new fd of the shared one byte read-only region sent in place of small payloads, owned by the caller
+    int DupPlaceholder();
+    Stats GetStats();
+    void Clear();
+
+private:
+    AshmemPool() = default;
+    ~AshmemPool();
+
+    static bool CreateRegion(size_t capacity, Region &region);
+    static void DestroyRegion(Region &region);
+
+    std::mutex mutex_;
+    std::vector<Region> idle_;
+    size_t idleBytes_ = 0;
+    int placeholderFd_ = -1;
+    Stats stats_;
+};
+
+/*
+ * A region written once by this process and then sealed read-only, so every process it is sent to reads the
+ * same bytes and none of them can change it. It is closed when the last reference is released.
+ */
+class API_EXPORT SealedAshmem final {
+public:
+    using Writer = std::function<bool(uint8_t *data, size_t size)>;
+
+    // a region of size bytes filled by writer, sealed before its fd is handed to anyone
+    static std::shared_ptr<const SealedAshmem> Create(size_t size, const Writer &writer);
+    ~SealedAshmem();
+
+    // a new fd of the region, owned by the caller
+    int Dup() const;
+    size_t GetSize() const;
+
+private:
+    SealedAshmem(int fd, size_t size);
+
+    int fd_ = -1;
+    size_t size_ = 0;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // ASHMEM_POOL_H
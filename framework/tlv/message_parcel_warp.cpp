@@ -20,6 +20,7 @@
 
 #include "api/visibility.h"
 #include "ashmem.h"
+#include "ashmem_pool.h"
 #ifndef CROSS_PLATFORM
 #include "fd_san.h"
 #else
@@ -40,7 +41,9 @@ constexpr size_t MIN_RAW_SIZE = 32 * 1024; // 32k
 constexpr int32_t DEFAULT_LOCAL_CAPACITY = 128;
 constexpr size_t WRITE_SPLIT_CHUNK_SIZE = 256 * 1024 * 1024;
 
-MessageParcelWarp::MessageParcelWarp()
+MessageParcelWarp::MessageParcelWarp() : MessageParcelWarp(false) {}
+
+MessageParcelWarp::MessageParcelWarp(bool recycleRegion)
 {
     writeRawDataFd_ = -1;
     readRawDataFd_ = -1;
@@ -50,6 +53,8 @@ MessageParcelWarp::MessageParcelWarp()
     rawDataSize_ = 0;
     canWrite_ = true;
     canRead_ = true;
+    recycleRegion_ = recycleRegion;
+    writeCapacity_ = 0;
     static int32_t paramMaxSize =
         OHOS::system::GetIntParameter("const.pasteboard.local_data_capacity", DEFAULT_LOCAL_CAPACITY);
     PASTEBOARD_CHECK_AND_RETURN_LOGE(paramMaxSize >= KERNEL_MIN_SIZE && paramMaxSize <= KERNEL_MAX_SIZE,
@@ -59,6 +64,13 @@ MessageParcelWarp::MessageParcelWarp()
 
 MessageParcelWarp::~MessageParcelWarp()
 {
+    if (writeCapacity_ != 0) {
+        AshmemPool::Region region{ writeRawDataFd_, kernelMappedWrite_, writeCapacity_ };
+        AshmemPool::GetInstance().Recycle(region);
+        writeRawDataFd_ = -1;
+        kernelMappedWrite_ = nullptr;
+        writeCapacity_ = 0;
+    }
     if (kernelMappedWrite_ != nullptr) {
         ::munmap(kernelMappedWrite_, rawDataSize_);
         kernelMappedWrite_ = nullptr;
@@ -141,34 +153,89 @@ bool MessageParcelWarp::WriteRawData(MessageParcel &parcelPata, const void *data
         rawDataSize_ = size;
         return parcelPata.WriteUnpadBuffer(data, size);
     }
+    void *ptr = CreateRawDataRegion(parcelPata, size);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ptr != nullptr, false,
+        PASTEBOARD_MODULE_COMMON, "create region failed, size:%{public}zu", size);
+    if (!MemcpyData(ptr, size, data, size)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "memcpy_s failed, size:%{public}zu", size);
+        return false;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "write ashmem end. fd:%{public}d size:%{public}zu",
+        writeRawDataFd_, size);
+    return true;
+}
+
+bool MessageParcelWarp::WriteRawData(MessageParcel &parcelPata, const TLVWriteable &value, size_t size,
+    bool isRemote)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(canWrite_, false,
+        PASTEBOARD_MODULE_COMMON, "is already write, size:%{public}zu", size);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(0 < size && static_cast<int64_t>(size) <= maxRawDataSize_, false,
+        PASTEBOARD_MODULE_COMMON, "size invalid, size:%{public}zu", size);
+    if (size <= MIN_RAW_SIZE) {
+        std::vector<uint8_t> buffer;
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(value.Encode(size, buffer, isRemote), false,
+            PASTEBOARD_MODULE_COMMON, "encode failed, size:%{public}zu", size);
+        return WriteRawData(parcelPata, buffer.data(), buffer.size());
+    }
+    canWrite_ = false;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(kernelMappedWrite_ == nullptr, false,
+        PASTEBOARD_MODULE_COMMON, "kernelMappedWrite_ not null end.");
+    if (!parcelPata.WriteInt64(size)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "data WriteInt64 failed end.");
+        return false;
+    }
+    void *ptr = CreateRawDataRegion(parcelPata, size);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ptr != nullptr, false,
+        PASTEBOARD_MODULE_COMMON, "create region failed, size:%{public}zu", size);
+    // encode straight into the shared mapping, no intermediate vector
+    if (!value.Encode(static_cast<uint8_t *>(ptr), size, isRemote)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "encode failed, size:%{public}zu", size);
+        return false;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "encode ashmem end. fd:%{public}d size:%{public}zu",
+        writeRawDataFd_, size);
+    return true;
+}
+
+void *MessageParcelWarp::CreateRawDataRegion(MessageParcel &parcelPata, size_t size)
+{
+    if (recycleRegion_) {
+        AshmemPool::Region region;
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(AshmemPool::GetInstance().Acquire(size, region), nullptr,
+            PASTEBOARD_MODULE_COMMON, "acquire region failed, size:%{public}zu", size);
+        // given back to the pool by the destructor, the region never left this process if the write fails
+        writeRawDataFd_ = region.fd;
+        kernelMappedWrite_ = region.ptr;
+        writeCapacity_ = region.capacity;
+        rawDataSize_ = size;
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(parcelPata.WriteFileDescriptor(region.fd), nullptr,
+            PASTEBOARD_MODULE_COMMON, "write file descriptor failed, size:%{public}zu", size);
+        return region.ptr;
+    }
     int fd = AshmemCreate("Pasteboard Ashmem", size);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, false, PASTEBOARD_MODULE_COMMON, "ashmem create failed");
-    
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, nullptr, PASTEBOARD_MODULE_COMMON, "ashmem create failed");
+
     writeRawDataFd_ = fd;
 #ifndef CROSS_PLATFORM
     fdsan_exchange_owner_tag(writeRawDataFd_, 0, PASTEBOARD_FD_TAG);
 #endif
     int result = AshmemSetProt(fd, PROT_READ | PROT_WRITE);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(result >= 0, false, PASTEBOARD_MODULE_COMMON, "ashmem set port failed");
-    
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(result >= 0, nullptr, PASTEBOARD_MODULE_COMMON, "ashmem set port failed");
+
     void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ptr != MAP_FAILED, false,
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ptr != MAP_FAILED, nullptr,
         PASTEBOARD_MODULE_COMMON, "mmap failed, fd:%{public}d size:%{public}zu", fd, size);
 
     if (!parcelPata.WriteFileDescriptor(fd)) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "write file descriptor failed, size:%{public}zu", size);
         ::munmap(ptr, size);
-        return false;
-    }
-    if (!MemcpyData(ptr, size, data, size)) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_COMMON, "memcpy_s failed, fd:%{public}d size:%{public}zu", fd, size);
-        ::munmap(ptr, size);
-        return false;
+        return nullptr;
     }
+    // unmapped by the destructor, also on a later copy/encode failure
     kernelMappedWrite_ = ptr;
     rawDataSize_ = size;
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "write ashmem end. fd:%{public}d size:%{public}zu", fd, size);
-    return true;
+    return ptr;
 }
 
 const void *MessageParcelWarp::ReadRawData(MessageParcel &parcelPata, size_t size)
@@ -206,8 +273,8 @@ const void *MessageParcelWarp::ReadRawData(MessageParcel &parcelPata, size_t siz
 
 int MessageParcelWarp::CreateTmpFd()
 {
-    int fd = AshmemCreate("PasteboardTmpAshmem", 1);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, -1, PASTEBOARD_MODULE_COMMON, "ashmem create failed");
+    int fd = AshmemPool::GetInstance().DupPlaceholder();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, -1, PASTEBOARD_MODULE_COMMON, "dup placeholder failed");
     writeRawDataFd_ = fd;
 #ifndef CROSS_PLATFORM
     fdsan_exchange_owner_tag(writeRawDataFd_, 0, PASTEBOARD_FD_TAG);
@@ -18,6 +18,7 @@
 
 #include "api/visibility.h"
 #include "message_parcel.h"
+#include "tlv_writeable.h"
 
 namespace OHOS {
 namespace MiscServices {
@@ -27,9 +28,12 @@ constexpr int64_t DEFAULT_MAX_RAW_DATA_SIZE = 128 * 1024 * 1024; // 128M
 class API_EXPORT MessageParcelWarp {
 public:
     MessageParcelWarp();
+    // only for synchronous requests to the pasteboard service, which is done with the region when the call returns
+    explicit MessageParcelWarp(bool recycleRegion);
     ~MessageParcelWarp();
 
     bool WriteRawData(MessageParcel &parcelPata, const void *data, size_t size);
+    bool WriteRawData(MessageParcel &parcelPata, const TLVWriteable &value, size_t size, bool isRemote = false);
     const void *ReadRawData(MessageParcel &parcelData, size_t size);
     static int64_t GetRawDataSize();
     int CreateTmpFd();
@@ -37,6 +41,8 @@ public:
     bool MemcpyData(void *ptr, size_t size, const void *data, size_t count);
 
 private:
+    void *CreateRawDataRegion(MessageParcel &parcelPata, size_t size);
+
     std::shared_ptr<char> rawData_ = nullptr;
     int writeRawDataFd_ = -1;
     int readRawDataFd_ = -1;
@@ -45,6 +51,8 @@ private:
     size_t rawDataSize_ = 0;
     bool canWrite_ = true;
     bool canRead_ = true;
+    bool recycleRegion_ = false;
+    size_t writeCapacity_ = 0;
     static inline int64_t maxRawDataSize_ = DEFAULT_MAX_RAW_DATA_SIZE;
 };
 } // namespace MiscServices
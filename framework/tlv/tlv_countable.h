@@ -22,6 +22,20 @@
 
 namespace OHOS::MiscServices {
 
+bool IsRemoteEncode();
+
+// Encode on this thread for a pass another thread runs, with that pass's remote flag until the scope ends.
+class API_EXPORT RemoteEncodeScope final {
+public:
+    explicit RemoteEncodeScope(bool isRemote);
+    ~RemoteEncodeScope();
+    RemoteEncodeScope(const RemoteEncodeScope &) = delete;
+    RemoteEncodeScope &operator=(const RemoteEncodeScope &) = delete;
+
+private:
+    bool saved_ = false;
+};
+
 class TLVCountable {
 public:
     virtual size_t CountTLV() const = 0;
@@ -95,6 +109,43 @@ public:
         return expectSize;
     }
 
+    // the size of each item of a list of TLV objects, as Count gives it item by item; once the items counted so
+    // far pass TLVParallel's threshold the rest are counted on several threads
+    template<typename T>
+    static size_t CountItems(const std::vector<std::shared_ptr<T>> &value, std::vector<size_t> &sizes)
+    {
+        sizes.assign(value.size(), 0);
+        size_t total = 0;
+        size_t begin = 0;
+        for (; begin < value.size() && TLVParallel::ThreadsFor(value.size() - begin, total) <= 1; ++begin) {
+            sizes[begin] = Count(value[begin]);
+            total += sizes[begin];
+        }
+        if (begin == value.size()) {
+            return total;
+        }
+        bool isRemote = IsRemoteEncode();
+        auto entries = SerializedCache::Current();
+        TLVParallel::Run(value.size() - begin, TLVParallel::ThreadsFor(value.size() - begin, total),
+            [&value, &sizes, begin, isRemote, &entries](size_t index) {
+                RemoteEncodeScope remoteScope(isRemote);
+                SerializedCache cacheScope(entries);
+                sizes[begin + index] = Count(value[begin + index]);
+            });
+        for (size_t index = begin; index < value.size(); ++index) {
+            total += sizes[index];
+        }
+        return total;
+    }
+
+    // what Count gives for the list, large lists are counted on several threads
+    template<typename T>
+    static inline size_t CountParallel(const std::vector<std::shared_ptr<T>> &value)
+    {
+        std::vector<size_t> sizes;
+        return sizeof(TLVHead) + CountItems(value, sizes);
+    }
+
     static inline size_t Count(const std::vector<uint8_t> &value)
     {
         size_t expectSize = sizeof(TLVHead);
@@ -128,7 +179,7 @@ public:
             return 0;
         }
         size_t expectSize = sizeof(TLVHead);
-        return expectSize + Count(TLVUtils::Parcelable2Raw(value.get()));
+        return expectSize + Count(SerializedCache::Parcelable2Raw(value));
     }
 
     static inline size_t Count(const std::shared_ptr<Media::PixelMap> value)
@@ -136,8 +187,9 @@ public:
         if (value == nullptr) {
             return 0;
         }
-        size_t expectSize = sizeof(TLVHead);
-        return expectSize + Count(TLVUtils::PixelMap2Vector(value));
+        size_t expectSize = sizeof(TLVHead) * 2; // outer head and the head of the encoded bytes
+        auto rawData = SerializedCache::PixelMap2Vector(value);
+        return rawData == nullptr ? expectSize : expectSize + rawData->size();
     }
 
     static inline size_t Count(const std::shared_ptr<Object> &value)
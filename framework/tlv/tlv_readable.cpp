@@ -26,17 +26,34 @@ bool TLVReadable::Decode(const std::vector<std::uint8_t> &buffer)
     return DecodeTLV(buff);
 }
 
+bool TLVReadable::Decode(const uint8_t *data, size_t len)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr || len == 0, false,
+        PASTEBOARD_MODULE_COMMON, "data is null, len=%{public}zu", len);
+    ReadOnlyBuffer buff(data, len);
+    return DecodeTLV(buff);
+}
+
 bool ReadOnlyBuffer::ReadHead(TLVHead &head)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead)), false,
         PASTEBOARD_MODULE_COMMON, "read head failed");
-    const auto *pHead = reinterpret_cast<const TLVHead *>(data_.data() + cursor_);
+    const auto *pHead = reinterpret_cast<const TLVHead *>(data_ + cursor_);
     head.tag = NetToHost(pHead->tag);
     head.len = NetToHost(pHead->len);
     cursor_ += sizeof(TLVHead);
     return true;
 }
 
+bool ReadOnlyBuffer::ReadElement(const TLVHead &head, std::vector<uint8_t> &element)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(cursor_ >= sizeof(TLVHead) && HasExpectBuffer(head.len), false,
+        PASTEBOARD_MODULE_COMMON, "read element failed, tag=%{public}hu", head.tag);
+    element.assign(data_ + cursor_ - sizeof(TLVHead), data_ + cursor_ + head.len);
+    cursor_ += head.len;
+    return true;
+}
+
 bool ReadOnlyBuffer::ReadValue(std::monostate &value, const TLVHead &head)
 {
     (void)value;
@@ -90,7 +107,7 @@ bool ReadOnlyBuffer::ReadValue(std::string &value, const TLVHead &head)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(head.len), false,
         PASTEBOARD_MODULE_COMMON, "read string failed, tag=%{public}hu", head.tag);
-    value.append(reinterpret_cast<const char *>(data_.data() + cursor_), head.len);
+    value.append(reinterpret_cast<const char *>(data_ + cursor_), head.len);
     cursor_ += head.len;
     return true;
 }
@@ -99,7 +116,7 @@ bool ReadOnlyBuffer::ReadValue(RawMem &rawMem, const TLVHead &head)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(head.len), false,
         PASTEBOARD_MODULE_COMMON, "read RawMem failed, tag=%{public}hu", head.tag);
-    rawMem.buffer = (uintptr_t)(data_.data() + cursor_);
+    rawMem.buffer = (uintptr_t)(data_ + cursor_);
     rawMem.bufferLen = head.len;
     cursor_ += head.len;
     return true;
@@ -120,7 +137,7 @@ bool ReadOnlyBuffer::ReadValue(std::vector<uint8_t> &value, const TLVHead &head)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(head.len), false,
         PASTEBOARD_MODULE_COMMON, "read vector failed, tag=%{public}hu", head.tag);
-    std::vector<uint8_t> buff(data_.data() + cursor_, data_.data() + cursor_ + head.len);
+    std::vector<uint8_t> buff(data_ + cursor_, data_ + cursor_ + head.len);
     value = std::move(buff);
     cursor_ += head.len;
     return true;
@@ -289,4 +306,51 @@ bool ReadOnlyBuffer::ReadValue(std::shared_ptr<Media::PixelMap> &value, const TL
     return ret;
 }
 
+bool TLVLazyList::Read(ReadOnlyBuffer &buffer, const TLVHead &head)
+{
+    std::vector<uint8_t> encoded;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(buffer.ReadElement(head, encoded), false, PASTEBOARD_MODULE_COMMON,
+        "read lazy list failed, tag=%{public}hu", head.tag);
+    std::vector<Item> items;
+    size_t offset = sizeof(TLVHead);
+    while (offset < encoded.size()) {
+        // only the item heads are read here, the same walk ReadValue makes over a vector
+        ReadOnlyBuffer itemBuffer(encoded.data() + offset, encoded.size() - offset);
+        TLVHead itemHead{};
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(itemBuffer.ReadHead(itemHead) && itemBuffer.Skip(itemHead.len), false,
+            PASTEBOARD_MODULE_COMMON, "lazy list item %{public}zu truncated", items.size());
+        size_t length = sizeof(TLVHead) + itemHead.len;
+        items.push_back(Item{ offset, length, true });
+        offset += length;
+    }
+    encoded_ = std::move(encoded);
+    items_ = std::move(items);
+    pending_ = items_.size();
+    return true;
+}
+
+size_t TLVLazyList::Size() const
+{
+    return items_.size();
+}
+
+size_t TLVLazyList::Pending() const
+{
+    return pending_;
+}
+
+bool TLVLazyList::IsPending(size_t index) const
+{
+    return index < items_.size() && items_[index].pending;
+}
+
+bool TLVLazyList::IsUntouched() const
+{
+    return pending_ == items_.size();
+}
+
+const std::vector<uint8_t> &TLVLazyList::Encoded() const
+{
+    return encoded_;
+}
 } // namespace OHOS::MiscServices
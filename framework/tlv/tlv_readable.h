@@ -32,14 +32,25 @@ public:
     virtual bool DecodeTLV(ReadOnlyBuffer &buffer) = 0;
 
     API_EXPORT bool Decode(const std::vector<uint8_t> &buffer);
+
+    // decode from a borrowed read-only view (e.g. a mapped ashmem region), the memory must outlive the call
+    API_EXPORT bool Decode(const uint8_t *data, size_t len);
 };
 
 class ReadOnlyBuffer : public TLVBuffer {
 public:
-    explicit ReadOnlyBuffer(const std::vector<uint8_t> &data) : TLVBuffer(data.size()), data_(data)
+    explicit ReadOnlyBuffer(const std::vector<uint8_t> &data) : ReadOnlyBuffer(data.data(), data.size())
     {
     }
 
+    // the buffer only borrows the memory, it must outlive the buffer
+    ReadOnlyBuffer(const uint8_t *data, size_t len) : TLVBuffer(data == nullptr ? 0 : len), data_(data),
+        dataLen_(data == nullptr ? 0 : len)
+    {
+    }
+
+    explicit ReadOnlyBuffer(std::vector<uint8_t> &&data) = delete;
+
     template<typename T>
     bool ReadValue(std::vector<T> &value, const TLVHead &head)
     {
@@ -47,7 +58,7 @@ public:
             return false;
         }
         auto vectorEnd = cursor_ + head.len;
-        if (vectorEnd > data_.size()) {
+        if (vectorEnd > dataLen_) {
             return false;
         }
         RecursiveGuard guard;
@@ -68,6 +79,54 @@ public:
         return true;
     }
 
+    // what ReadValue(value, head) reads, with the items of a large list decoded on several threads
+    template<typename T>
+    bool ReadValueParallel(std::vector<std::shared_ptr<T>> &value, const TLVHead &head)
+    {
+        if (TLVParallel::GetMaxThreads() <= 1 || head.len < TLVParallel::GetMinBytes() ||
+            !HasExpectBuffer(head.len)) {
+            return ReadValue(value, head);
+        }
+        // the items are located by their heads first, a list that does not split cleanly is read in one pass
+        std::vector<std::pair<size_t, size_t>> items;
+        size_t vectorEnd = cursor_ + head.len;
+        for (size_t offset = cursor_; offset < vectorEnd;) {
+            ReadOnlyBuffer itemBuffer(data_ + offset, vectorEnd - offset);
+            TLVHead itemHead{};
+            if (!itemBuffer.ReadHead(itemHead) || !itemBuffer.Skip(itemHead.len)) {
+                return ReadValue(value, head);
+            }
+            items.emplace_back(offset, sizeof(TLVHead) + itemHead.len);
+            offset += sizeof(TLVHead) + itemHead.len;
+        }
+        size_t threads = TLVParallel::ThreadsFor(items.size(), head.len);
+        if (threads <= 1) {
+            return ReadValue(value, head);
+        }
+        RecursiveGuard guard;
+        if (!guard.IsValid()) {
+            return false;
+        }
+        std::vector<std::shared_ptr<T>> decoded(items.size());
+        std::vector<uint8_t> results(items.size(), 0);
+        uint32_t depth = RecursiveGuard::GetDepth();
+        TLVParallel::Run(items.size(), threads, [this, &items, &decoded, &results, depth](size_t index) {
+            RecursiveGuard depthScope(depth);
+            ReadOnlyBuffer itemBuffer(data_ + items[index].first, items[index].second);
+            TLVHead itemHead{};
+            results[index] = itemBuffer.ReadHead(itemHead) && itemBuffer.ReadValue(decoded[index], itemHead) ? 1 : 0;
+        });
+        // like the one pass, the items before the first that fails are kept
+        for (size_t index = 0; index < items.size(); ++index) {
+            if (results[index] == 0) {
+                return false;
+            }
+            value.push_back(std::move(decoded[index]));
+        }
+        cursor_ = vectorEnd;
+        return true;
+    }
+
     template<typename T>
     bool ReadValue(std::shared_ptr<T> &value, const TLVHead &head)
     {
@@ -83,6 +142,8 @@ public:
     }
 
     bool ReadHead(TLVHead &head);
+    // copy the element whose head was just read, head included, in the form WriteEncoded takes back
+    bool ReadElement(const TLVHead &head, std::vector<uint8_t> &element);
     bool ReadValue(std::monostate &value, const TLVHead &head);
     bool ReadValue(void *value, const TLVHead &head);
     bool ReadValue(bool &value, const TLVHead &head);
@@ -114,9 +175,6 @@ public:
     template<typename... _Types>
     bool ReadValue(std::variant<_Types...> &value, const TLVHead &head);
 
-    template<>
-    bool ReadValue(EntryValue &value, const TLVHead &head);
-
 private:
     bool ReadBasicValue(bool &value, const TLVHead &head)
     {
@@ -127,7 +185,7 @@ private:
             return false;
         }
         uint8_t rawValue = 0;
-        auto ret = memcpy_s(&rawValue, sizeof(bool), data_.data() + cursor_, sizeof(bool));
+        auto ret = memcpy_s(&rawValue, sizeof(bool), data_ + cursor_, sizeof(bool));
         if (ret != EOK) {
             return false;
         }
@@ -148,7 +206,7 @@ private:
         if (!HasExpectBuffer(head.len)) {
             return false;
         }
-        auto ret = memcpy_s(&value, sizeof(T), data_.data() + cursor_, sizeof(T));
+        auto ret = memcpy_s(&value, sizeof(T), data_ + cursor_, sizeof(T));
         if (ret != EOK) {
             return false;
         }
@@ -157,7 +215,51 @@ private:
         return true;
     }
 
-    const std::vector<uint8_t> data_;
+    const uint8_t *data_ = nullptr;
+    size_t dataLen_ = 0;
 };
+
+// A vector element kept encoded: its items are located by their heads alone and each one is decoded on first use.
+class API_EXPORT TLVLazyList final {
+public:
+    // keep the vector element whose head was just read, the buffer moves past it without decoding an item
+    bool Read(ReadOnlyBuffer &buffer, const TLVHead &head);
+    size_t Size() const;
+    size_t Pending() const;
+    bool IsPending(size_t index) const;
+    // no item has been taken, so the element still describes every item exactly
+    bool IsUntouched() const;
+    // the element as it was read, head included
+    const std::vector<uint8_t> &Encoded() const;
+
+    // decode the item at index, which is no longer pending afterwards even if its bytes are invalid
+    template<typename T>
+    bool Take(size_t index, T &value)
+    {
+        if (!IsPending(index)) {
+            return false;
+        }
+        auto &item = items_[index];
+        item.pending = false;
+        --pending_;
+        ReadOnlyBuffer buffer(encoded_.data() + item.offset, item.length);
+        TLVHead head{};
+        return buffer.ReadHead(head) && buffer.ReadValue(value, head);
+    }
+
+private:
+    struct Item {
+        size_t offset = 0;
+        size_t length = 0;
+        bool pending = true;
+    };
+
+    std::vector<uint8_t> encoded_;
+    std::vector<Item> items_;
+    size_t pending_ = 0;
+};
+
+template<>
+bool ReadOnlyBuffer::ReadValue(EntryValue &value, const TLVHead &head);
 } // namespace OHOS::MiscServices
 #endif // DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_READABLE_H
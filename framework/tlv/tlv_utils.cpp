@@ -15,10 +15,47 @@
 
 #include "tlv_utils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 #include "pasteboard_hilog.h"
 #include "pixel_map.h"
 
 namespace OHOS::MiscServices {
+namespace {
+constexpr size_t MAX_PARALLEL_THREADS = 4;
+constexpr size_t DEFAULT_PARALLEL_MIN_BYTES = 512 * 1024; // 512k
+
+// each entry pins its object, so the address cannot be reused by another object while the scope is alive
+template<typename T>
+struct PinnedEntry {
+    std::shared_ptr<const void> pin;
+    T value;
+};
+
+thread_local std::shared_ptr<SerializedCache::Entries> g_serializedEntries;
+
+size_t DefaultParallelThreads()
+{
+    size_t cores = std::thread::hardware_concurrency();
+    return std::clamp<size_t>(cores, 1, MAX_PARALLEL_THREADS);
+}
+
+std::atomic<size_t> g_parallelThreads = DefaultParallelThreads();
+std::atomic<size_t> g_parallelMinBytes = DEFAULT_PARALLEL_MIN_BYTES;
+} // namespace
+
+// shared by the threads working on one encode pass, an object may be serialized twice when two of them miss
+// at once, both results are the same bytes
+struct SerializedCache::Entries {
+    std::mutex mutex;
+    std::unordered_map<const void *, PinnedEntry<RawMem>> parcelables;
+    std::unordered_map<const void *, PinnedEntry<std::shared_ptr<const std::vector<std::uint8_t>>>> pixelMaps;
+};
+
 RawMem TLVUtils::Parcelable2Raw(const Parcelable *value)
 {
     RawMem rawMem{};
@@ -77,4 +114,129 @@ std::vector<std::uint8_t> TLVUtils::PixelMap2Vector(std::shared_ptr<Media::Pixel
 
     return value;
 }
+
+SerializedCache::SerializedCache() : saved_(g_serializedEntries)
+{
+    if (g_serializedEntries == nullptr) {
+        g_serializedEntries = std::make_shared<Entries>();
+    }
+}
+
+SerializedCache::SerializedCache(std::shared_ptr<Entries> entries) : saved_(g_serializedEntries)
+{
+    if (entries != nullptr) {
+        g_serializedEntries = std::move(entries);
+    } else if (g_serializedEntries == nullptr) {
+        g_serializedEntries = std::make_shared<Entries>();
+    }
+}
+
+SerializedCache::~SerializedCache()
+{
+    g_serializedEntries = std::move(saved_);
+}
+
+std::shared_ptr<SerializedCache::Entries> SerializedCache::Current()
+{
+    return g_serializedEntries;
+}
+
+RawMem SerializedCache::Parcelable2Raw(std::shared_ptr<const Parcelable> value)
+{
+    auto entries = g_serializedEntries;
+    if (value == nullptr || entries == nullptr) {
+        return TLVUtils::Parcelable2Raw(value.get());
+    }
+    {
+        std::lock_guard<std::mutex> lock(entries->mutex);
+        auto it = entries->parcelables.find(value.get());
+        if (it != entries->parcelables.end()) {
+            return it->second.value;
+        }
+    }
+    RawMem rawMem = TLVUtils::Parcelable2Raw(value.get());
+    if (rawMem.parcel != nullptr && rawMem.bufferLen != 0) {
+        const void *key = value.get();
+        std::lock_guard<std::mutex> lock(entries->mutex);
+        entries->parcelables.emplace(key, PinnedEntry<RawMem>{ std::move(value), rawMem });
+    }
+    return rawMem;
+}
+
+std::shared_ptr<const std::vector<std::uint8_t>> SerializedCache::PixelMap2Vector(
+    std::shared_ptr<const Media::PixelMap> pixelMap)
+{
+    if (pixelMap == nullptr) {
+        return nullptr;
+    }
+    auto entries = g_serializedEntries;
+    if (entries != nullptr) {
+        std::lock_guard<std::mutex> lock(entries->mutex);
+        auto it = entries->pixelMaps.find(pixelMap.get());
+        if (it != entries->pixelMaps.end()) {
+            return it->second.value;
+        }
+    }
+    auto value = std::make_shared<std::vector<std::uint8_t>>();
+    bool ret = pixelMap->EncodeTlv(*value);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, nullptr, PASTEBOARD_MODULE_COMMON, "EncodeTlv failed");
+    if (entries != nullptr) {
+        const void *key = pixelMap.get();
+        std::lock_guard<std::mutex> lock(entries->mutex);
+        entries->pixelMaps.emplace(key,
+            PinnedEntry<std::shared_ptr<const std::vector<std::uint8_t>>>{ std::move(pixelMap), value });
+    }
+    return value;
+}
+
+void TLVParallel::SetMaxThreads(size_t threads)
+{
+    g_parallelThreads = std::clamp<size_t>(threads, 1, MAX_PARALLEL_THREADS);
+}
+
+size_t TLVParallel::GetMaxThreads()
+{
+    return g_parallelThreads;
+}
+
+void TLVParallel::SetMinBytes(size_t bytes)
+{
+    g_parallelMinBytes = bytes;
+}
+
+size_t TLVParallel::GetMinBytes()
+{
+    return g_parallelMinBytes;
+}
+
+size_t TLVParallel::ThreadsFor(size_t count, size_t bytes)
+{
+    if (count < 2 || bytes < g_parallelMinBytes) {
+        return 1;
+    }
+    return std::min<size_t>(g_parallelThreads, count);
+}
+
+void TLVParallel::Run(size_t count, size_t threads, const Job &job)
+{
+    if (count == 0 || job == nullptr) {
+        return;
+    }
+    std::atomic<size_t> next = 0;
+    auto work = [count, &next, &job]() {
+        for (size_t index = next.fetch_add(1); index < count; index = next.fetch_add(1)) {
+            job(index);
+        }
+    };
+    size_t workerCount = std::min(std::max<size_t>(threads, 1), count);
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount - 1);
+    for (size_t i = 1; i < workerCount; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
 } // namespace OHOS::MiscServices
@@ -16,6 +16,8 @@
 #ifndef DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_UTILS_H
 #define DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_UTILS_H
 #include <cinttypes>
+#include <functional>
+#include <memory>
 #include "parcel.h"
 #include "securec.h"
 #include "unified_meta.h"
@@ -54,14 +56,20 @@ public:
 
 class RecursiveGuard {
 public:
-    RecursiveGuard()
+    RecursiveGuard() : saved_(depth_)
     {
         depth_++;
     }
 
+    // continue at the depth another thread reached, for the work it hands to this one
+    explicit RecursiveGuard(uint32_t depth) : saved_(depth_)
+    {
+        depth_ = depth;
+    }
+
     ~RecursiveGuard()
     {
-        depth_--;
+        depth_ = saved_;
     }
 
     bool IsValid()
@@ -69,9 +77,62 @@ public:
         return depth_ <= MAX_DEPTH;
     }
 
+    static uint32_t GetDepth()
+    {
+        return depth_;
+    }
+
 private:
     static constexpr uint32_t MAX_DEPTH = 10;
     static thread_local inline uint32_t depth_ = 0;
+    uint32_t saved_ = 0;
+};
+
+// Remembers the serialized Want/PixelMap produced while counting, so that writing the same object in the same
+// encode pass reuses it instead of serializing again. Entries live until the outermost scope of the thread that
+// opened them ends, are keyed by object address and keep the object alive, the objects must not change while a
+// scope is alive. Outside a scope every call serializes afresh.
+class API_EXPORT SerializedCache {
+public:
+    struct Entries;
+
+    SerializedCache();
+    // join the entries of a scope open on another thread, for the items that thread hands to this one
+    explicit SerializedCache(std::shared_ptr<Entries> entries);
+    ~SerializedCache();
+    SerializedCache(const SerializedCache &) = delete;
+    SerializedCache &operator=(const SerializedCache &) = delete;
+
+    // the entries of the scope open on this thread, nullptr outside a scope
+    static std::shared_ptr<Entries> Current();
+
+    static RawMem Parcelable2Raw(std::shared_ptr<const Parcelable> value);
+
+    // nullptr if the pixel map fails to encode
+    static std::shared_ptr<const std::vector<std::uint8_t>> PixelMap2Vector(
+        std::shared_ptr<const Media::PixelMap> pixelMap);
+
+private:
+    std::shared_ptr<Entries> saved_;
+};
+
+// Spreads the items of one large list over several threads while it is counted, written or read. Each item is
+// still processed by one thread the way the sequential loop does it, so the bytes and values produced do not
+// depend on the number of threads.
+class API_EXPORT TLVParallel {
+public:
+    using Job = std::function<void(size_t index)>;
+
+    // at most threads threads per list, the calling thread included; 1 keeps every list sequential
+    static void SetMaxThreads(size_t threads);
+    static size_t GetMaxThreads();
+    // lists of fewer bytes stay on the calling thread, starting threads would cost more than they save
+    static void SetMinBytes(size_t bytes);
+    static size_t GetMinBytes();
+    // the threads for count items of bytes bytes in total, 1 for a list that should stay sequential
+    static size_t ThreadsFor(size_t count, size_t bytes);
+    // job(index) for every index below count, spread over threads threads of which the caller is one
+    static void Run(size_t count, size_t threads, const Job &job);
 };
 } // namespace OHOS::MiscServices
 #endif //DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_UTILS_H
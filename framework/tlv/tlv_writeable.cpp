@@ -28,13 +28,24 @@ bool IsRemoteEncode()
     return g_isRemoteEncode;
 }
 
+RemoteEncodeScope::RemoteEncodeScope(bool isRemote) : saved_(g_isRemoteEncode)
+{
+    g_isRemoteEncode = isRemote;
+}
+
+RemoteEncodeScope::~RemoteEncodeScope()
+{
+    g_isRemoteEncode = saved_;
+}
+
 bool TLVWriteable::Encode(std::vector<uint8_t> &buffer, bool isRemote) const
 {
     g_isRemoteEncode = isRemote;
+    SerializedCache cacheScope;
     size_t len = CountTLV();
     WriteOnlyBuffer buff(len);
     bool ret = EncodeTLV(buff);
-    buffer = std::move(buff.data_);
+    buffer = std::move(buff.ownedData_);
     return ret;
 }
 
@@ -49,24 +60,51 @@ bool TLVWriteable::Encode(size_t len, std::vector<uint8_t> &buffer, bool isRemot
     g_isRemoteEncode = isRemote;
     WriteOnlyBuffer buff(len);
     bool ret = EncodeTLV(buff);
-    buffer = std::move(buff.data_);
+    buffer = std::move(buff.ownedData_);
     return ret;
 }
 
-bool WriteOnlyBuffer::Write(uint16_t type, std::monostate value)
+bool TLVWriteable::Encode(uint8_t *buffer, size_t len, bool isRemote) const
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(buffer != nullptr, false,
+        PASTEBOARD_MODULE_COMMON, "buffer is null, len=%{public}zu", len);
+    g_isRemoteEncode = isRemote;
+    WriteOnlyBuffer buff(buffer, len);
+    bool ret = EncodeTLV(buff);
+    buff.ClearTail();
+    return ret;
+}
+
+bool WriteOnlyBuffer::WriteEmptyHead(uint16_t type)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead)), false,
-        PASTEBOARD_MODULE_COMMON, "write monostate failed, type=%{public}hu", type);
+        PASTEBOARD_MODULE_COMMON, "write empty head failed, type=%{public}hu", type);
+    // borrowed memory is not zero-initialized, keep the bytes identical to the vector path
+    auto err = memset_s(data_ + cursor_, total_ - cursor_, 0, sizeof(TLVHead));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(err == EOK, false,
+        PASTEBOARD_MODULE_COMMON, "clear empty head failed, type=%{public}hu", type);
     cursor_ += sizeof(TLVHead);
     return true;
 }
 
+void WriteOnlyBuffer::ClearTail()
+{
+    if (cursor_ >= dataLen_) {
+        return;
+    }
+    auto err = memset_s(data_ + cursor_, dataLen_ - cursor_, 0, dataLen_ - cursor_);
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(err == EOK, PASTEBOARD_MODULE_COMMON,
+        "clear tail failed, cursor=%{public}zu, len=%{public}zu", cursor_, dataLen_);
+}
+
+bool WriteOnlyBuffer::Write(uint16_t type, std::monostate value)
+{
+    return WriteEmptyHead(type);
+}
+
 bool WriteOnlyBuffer::Write(uint16_t type, const void *value)
 {
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead)), false,
-        PASTEBOARD_MODULE_COMMON, "write void* failed, type=%{public}hu", type);
-    cursor_ += sizeof(TLVHead);
-    return true;
+    return WriteEmptyHead(type);
 }
 
 bool WriteOnlyBuffer::Write(uint16_t type, bool value)
@@ -109,7 +147,7 @@ bool WriteOnlyBuffer::Write(uint16_t type, const std::string &value)
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead) + value.size()), false,
         PASTEBOARD_MODULE_COMMON, "write string failed, type=%{public}hu", type);
 
-    auto *tlvHead = reinterpret_cast<TLVHead *>(data_.data() + cursor_);
+    auto *tlvHead = reinterpret_cast<TLVHead *>(data_ + cursor_);
     tlvHead->tag = HostToNet(type);
     tlvHead->len = HostToNet(static_cast<uint32_t>(value.size()));
 
@@ -128,13 +166,13 @@ bool WriteOnlyBuffer::Write(uint16_t type, const RawMem &value)
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead) + value.bufferLen), false,
         PASTEBOARD_MODULE_COMMON, "write RawMem failed, type=%{public}hu", type);
 
-    auto *tlvHead = reinterpret_cast<TLVHead *>(data_.data() + cursor_);
+    auto *tlvHead = reinterpret_cast<TLVHead *>(data_ + cursor_);
     tlvHead->tag = HostToNet(type);
     tlvHead->len = HostToNet(static_cast<uint32_t>(value.bufferLen));
     cursor_ += sizeof(TLVHead);
 
     if (value.bufferLen != 0 && reinterpret_cast<const void *>(value.buffer) != nullptr) {
-        auto err = memcpy_s(data_.data() + cursor_, total_ - cursor_,
+        auto err = memcpy_s(data_ + cursor_, total_ - cursor_,
             reinterpret_cast<const void *>(value.buffer), value.bufferLen);
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(err == EOK, false, PASTEBOARD_MODULE_COMMON,
             "copy RawMem failed, type=%{public}hu, tgtSize=%{public}zu, srcSize=%{public}zu",
@@ -159,6 +197,26 @@ bool WriteOnlyBuffer::Write(uint16_t type, const Media::PixelMap &value)
     return Write(type, rawData);
 }
 
+bool WriteOnlyBuffer::Write(uint16_t type, const std::shared_ptr<AAFwk::Want> &value)
+{
+    if (value == nullptr) {
+        return true;
+    }
+    return Write(type, SerializedCache::Parcelable2Raw(value));
+}
+
+bool WriteOnlyBuffer::Write(uint16_t type, const std::shared_ptr<Media::PixelMap> &value)
+{
+    if (value == nullptr) {
+        return true;
+    }
+    auto rawData = SerializedCache::PixelMap2Vector(value);
+    if (rawData == nullptr) {
+        return false;
+    }
+    return Write(type, *rawData);
+}
+
 bool WriteOnlyBuffer::Write(uint16_t type, const Object &value)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(sizeof(TLVHead)), false,
@@ -295,7 +353,7 @@ bool WriteOnlyBuffer::Write(uint16_t type, const std::vector<uint8_t> &value)
     cursor_ += sizeof(TLVHead);
 
     if (!value.empty()) {
-        auto err = memcpy_s(data_.data() + cursor_, total_ - cursor_, value.data(), value.size());
+        auto err = memcpy_s(data_ + cursor_, total_ - cursor_, value.data(), value.size());
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(err == EOK, false, PASTEBOARD_MODULE_COMMON,
             "copy uint8 vector failed, type=%{public}hu, tgtSize=%{public}zu, srcSize=%{public}zu",
             type, total_ - cursor_, value.size());
@@ -303,4 +361,17 @@ bool WriteOnlyBuffer::Write(uint16_t type, const std::vector<uint8_t> &value)
     cursor_ += value.size();
     return true;
 }
+
+bool WriteOnlyBuffer::WriteEncoded(const std::vector<uint8_t> &value)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(HasExpectBuffer(value.size()), false,
+        PASTEBOARD_MODULE_COMMON, "write encoded failed, size=%{public}zu", value.size());
+    if (!value.empty()) {
+        auto err = memcpy_s(data_ + cursor_, total_ - cursor_, value.data(), value.size());
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(err == EOK, false, PASTEBOARD_MODULE_COMMON,
+            "copy encoded failed, tgtSize=%{public}zu, srcSize=%{public}zu", total_ - cursor_, value.size());
+    }
+    cursor_ += value.size();
+    return true;
+}
 } // namespace OHOS::MiscServices
@@ -21,8 +21,6 @@
 
 namespace OHOS::MiscServices {
 
-bool IsRemoteEncode();
-
 class WriteOnlyBuffer;
 
 class TLVWriteable : public TLVCountable {
@@ -35,12 +33,21 @@ public:
 
     API_EXPORT bool Encode(size_t len, std::vector<uint8_t> &buffer, bool isRemote = false) const;
 
+    // encode into caller-provided memory (e.g. a mapped ashmem region), len is normally the result of Count
+    API_EXPORT bool Encode(uint8_t *buffer, size_t len, bool isRemote = false) const;
+
     API_EXPORT size_t Count(bool isRemote = false) const;
 };
 
 class WriteOnlyBuffer : public TLVBuffer {
 public:
-    explicit WriteOnlyBuffer(size_t len) : TLVBuffer(len), data_(len)
+    explicit WriteOnlyBuffer(size_t len) : TLVBuffer(len), ownedData_(len), data_(ownedData_.data()), dataLen_(len)
+    {
+    }
+
+    // the buffer only borrows the memory, it must outlive the buffer
+    WriteOnlyBuffer(uint8_t *data, size_t len) : TLVBuffer(data == nullptr ? 0 : len), data_(data),
+        dataLen_(data == nullptr ? 0 : len)
     {
     }
 
@@ -67,6 +74,62 @@ public:
         return Write(type, *value);
     }
 
+    // the bytes Write(type, value) gives, with the items of a large list written on several threads
+    template<typename T>
+    bool WriteParallel(uint16_t type, const std::vector<std::shared_ptr<T>> &value)
+    {
+        if (value.size() < 2) {
+            return Write(type, value);
+        }
+        SerializedCache cacheScope; // the items are written from the objects serialized while counting them
+        std::vector<size_t> sizes;
+        size_t total = TLVCountable::CountItems(value, sizes);
+        size_t threads = TLVParallel::ThreadsFor(value.size(), total);
+        if (threads <= 1 || !HasExpectBuffer(sizeof(TLVHead) + total)) {
+            return Write(type, value);
+        }
+        auto tagCursor = cursor_;
+        auto valueCursor = cursor_ + sizeof(TLVHead);
+        std::vector<size_t> offsets(value.size(), valueCursor);
+        for (size_t index = 1; index < value.size(); ++index) {
+            offsets[index] = offsets[index - 1] + sizes[index - 1];
+        }
+        std::vector<size_t> written(value.size(), 0);
+        std::vector<uint8_t> results(value.size(), 0);
+        bool isRemote = IsRemoteEncode();
+        auto entries = SerializedCache::Current();
+        TLVParallel::Run(value.size(), threads, [&](size_t index) {
+            RemoteEncodeScope remoteScope(isRemote);
+            SerializedCache itemScope(entries);
+            WriteOnlyBuffer slot(data_ + offsets[index], sizes[index]);
+            results[index] = slot.Write(TAG_VECTOR_ITEM, value[index]) ? 1 : 0;
+            written[index] = slot.cursor_;
+        });
+        size_t reservedEnd = valueCursor + total;
+        // an item that did not fit the size Count gave it is left to the one pass, over cleared bytes
+        auto writeInOnePass = [this, &type, &value, tagCursor, reservedEnd]() {
+            cursor_ = tagCursor;
+            (void)memset_s(data_ + tagCursor, total_ - tagCursor, 0, reservedEnd - tagCursor);
+            return Write(type, value);
+        };
+        // Count may reserve more than an item takes, the items are moved up to follow each other as they do
+        // when written in one pass
+        cursor_ = valueCursor;
+        for (size_t index = 0; index < value.size(); ++index) {
+            bool moved = results[index] != 0 && (written[index] == 0 || offsets[index] == cursor_ ||
+                memmove_s(data_ + cursor_, total_ - cursor_, data_ + offsets[index], written[index]) == EOK);
+            if (!moved) {
+                return writeInOnePass();
+            }
+            cursor_ += written[index];
+        }
+        if (reservedEnd > cursor_ && memset_s(data_ + cursor_, total_ - cursor_, 0, reservedEnd - cursor_) != EOK) {
+            return writeInOnePass();
+        }
+        WriteHead(type, tagCursor, cursor_ - valueCursor);
+        return true;
+    }
+
     bool Write(uint16_t type, std::monostate value);
     bool Write(uint16_t type, const void *value);
     bool Write(uint16_t type, bool value);
@@ -80,9 +143,14 @@ public:
     bool Write(uint16_t type, const Object &value);
     bool Write(uint16_t type, const AAFwk::Want &value);
     bool Write(uint16_t type, const Media::PixelMap &value);
+    // go through SerializedCache, reusing the bytes produced by Count in the same encode pass
+    bool Write(uint16_t type, const std::shared_ptr<AAFwk::Want> &value);
+    bool Write(uint16_t type, const std::shared_ptr<Media::PixelMap> &value);
     bool Write(uint16_t type, const RawMem &value);
     bool Write(uint16_t type, const TLVWriteable &value);
     bool Write(uint16_t type, const std::vector<uint8_t> &value);
+    // copy an element produced earlier by this codec (head included) verbatim
+    bool WriteEncoded(const std::vector<uint8_t> &value);
     bool Write(uint16_t type, const std::map<std::string, std::vector<uint8_t>> &value);
     bool Write(uint16_t type, const Details &value);
 
@@ -95,16 +163,13 @@ public:
     template<typename... _Types>
     bool Write(uint16_t type, const std::variant<_Types...> &input);
 
-    template<>
-    bool Write(uint16_t type, const EntryValue &input);
-
 private:
     void WriteHead(uint16_t type, size_t tagCursor, uint32_t len)
     {
-        if (tagCursor + sizeof(TLVHead) > data_.size()) {
+        if (tagCursor + sizeof(TLVHead) > dataLen_) {
             return;
         }
-        auto *tlvHead = reinterpret_cast<TLVHead *>(data_.data() + tagCursor);
+        auto *tlvHead = reinterpret_cast<TLVHead *>(data_ + tagCursor);
         tlvHead->tag = HostToNet(type);
         tlvHead->len = HostToNet(len);
     }
@@ -115,7 +180,7 @@ private:
         if (!HasExpectBuffer(sizeof(TLVHead) + sizeof(value))) {
             return false;
         }
-        auto *tlvHead = reinterpret_cast<TLVHead *>(data_.data() + cursor_);
+        auto *tlvHead = reinterpret_cast<TLVHead *>(data_ + cursor_);
         tlvHead->tag = HostToNet(type);
         tlvHead->len = HostToNet(static_cast<uint32_t>(sizeof(value)));
         auto valueBuff = HostToNet(value);
@@ -139,8 +204,16 @@ private:
         return ret;
     }
 
+    bool WriteEmptyHead(uint16_t type);
+    void ClearTail();
+
     friend class TLVWriteable;
-    std::vector<uint8_t> data_;
+    std::vector<uint8_t> ownedData_;
+    uint8_t *data_ = nullptr;
+    size_t dataLen_ = 0;
 };
+
+template<>
+bool WriteOnlyBuffer::Write(uint16_t type, const EntryValue &input);
 } // namespace OHOS::MiscServices
 #endif // DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_WRITEABLE_H
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PASTEBOARD_NAPI_SYNC_EXECUTOR_H
+#define PASTEBOARD_NAPI_SYNC_EXECUTOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/block_object.h"
+
+namespace OHOS::MiscServicesNapi {
+/*
+ * Runs the service calls of the synchronous js APIs. At most maxWorkers threads are started, a worker
+ * idle for idleExitMs exits, and at most maxPending calls wait for a worker; a call beyond that fails at
+ * once instead of adding a thread. A call whose caller timed out before a worker picked it up is dropped.
+ */
+class NapiSyncExecutor final {
+public:
+    using Task = std::function<void()>;
+
+    static constexpr size_t MAX_WORKERS = 4;
+    static constexpr size_t MAX_PENDING_TASKS = 16;
+    static constexpr uint32_t IDLE_EXIT_MS = 30 * 1000;
+    // id of a task that was not accepted
+    static constexpr uint64_t INVALID_TASK_ID = 0;
+
+    explicit NapiSyncExecutor(size_t maxWorkers = MAX_WORKERS, size_t maxPending = MAX_PENDING_TASKS,
+        uint32_t idleExitMs = IDLE_EXIT_MS);
+    // drops the waiting tasks and waits for the workers to finish their running one
+    ~NapiSyncExecutor();
+
+    static NapiSyncExecutor &GetInstance();
+
+    // done runs on the worker after task, once the worker counts as idle again
+    uint64_t Submit(const std::string &name, Task task, Task done = nullptr);
+    // false once a worker has picked the task up
+    bool Cancel(uint64_t taskId);
+
+    // runs func on a worker and waits up to timeoutMs for its result, nullptr when it timed out or was rejected
+    template<typename T>
+    std::shared_ptr<T> Run(const std::string &name, std::function<std::shared_ptr<T>()> func, uint32_t timeoutMs)
+    {
+        auto block = std::make_shared<BlockObject<std::shared_ptr<T>>>(timeoutMs);
+        auto result = std::make_shared<std::shared_ptr<T>>();
+        auto task = [result, func = std::move(func)]() {
+            *result = func();
+        };
+        // a caller polling right away finds the worker idle instead of starting another one
+        uint64_t taskId = Submit(name, task, [block, result]() {
+            block->SetValue(std::move(*result));
+        });
+        if (taskId == INVALID_TASK_ID) {
+            return nullptr;
+        }
+        auto value = block->GetValue();
+        if (value == nullptr) {
+            Cancel(taskId);
+        }
+        return value;
+    }
+
+    size_t GetWorkerCount();
+    size_t GetPendingCount();
+
+private:
+    struct PendingTask {
+        uint64_t id = INVALID_TASK_ID;
+        std::string name;
+        Task task;
+        Task done;
+    };
+
+    void Work();
+
+    const size_t maxWorkers_;
+    const size_t maxPending_;
+    const std::chrono::milliseconds idleExit_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<PendingTask> pending_;
+    uint64_t nextTaskId_ = INVALID_TASK_ID;
+    size_t workers_ = 0;
+    size_t busyWorkers_ = 0;
+    bool stopping_ = false;
+};
+} // namespace OHOS::MiscServicesNapi
+#endif // PASTEBOARD_NAPI_SYNC_EXECUTOR_H
@@ -874,6 +874,10 @@ napi_value PasteDataNapi::GetRecordAt(napi_env env, napi_callback_info info)
     }
 
     std::shared_ptr<PasteDataRecord> record = obj->value_->GetRecordAt(index);
+    if (record == nullptr && index < obj->value_->GetRecordCount()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "record failed to decode, index=%{public}u, failed=%{public}zu",
+            index, obj->value_->GetUndecodedRecordCount());
+    }
     napi_value instance = nullptr;
     PasteDataRecordNapi::NewInstanceByRecord(env, instance, record);
     return instance;
@@ -891,6 +895,10 @@ napi_value PasteDataNapi::GetRecord(napi_env env, napi_callback_info info)
     }
 
     std::shared_ptr<PasteDataRecord> record = obj->value_->GetRecordAt(index);
+    // the record is counted but its bytes were corrupted, the caller must not take the clip as complete
+    if (!CheckExpression(env, record != nullptr, JSErrorCode::ERR_GET_DATA_FAILED, "record failed to decode.")) {
+        return nullptr;
+    }
     napi_value instance = nullptr;
     PasteDataRecordNapi::NewInstanceByRecord(env, instance, record);
     return instance;
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "napi_sync_executor.h"
+
+#include <thread>
+
+#include "common/pasteboard_common_utils.h"
+#include "pasteboard_hilog.h"
+
+using namespace OHOS::MiscServices;
+
+namespace OHOS::MiscServicesNapi {
+NapiSyncExecutor::NapiSyncExecutor(size_t maxWorkers, size_t maxPending, uint32_t idleExitMs)
+    : maxWorkers_(maxWorkers), maxPending_(maxPending), idleExit_(idleExitMs)
+{
+}
+
+NapiSyncExecutor::~NapiSyncExecutor()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopping_ = true;
+    pending_.clear();
+    cv_.notify_all();
+    cv_.wait(lock, [this] {
+        return workers_ == 0;
+    });
+}
+
+NapiSyncExecutor &NapiSyncExecutor::GetInstance()
+{
+    // never destroyed, a worker may still be blocked in the service when the process exits
+    static NapiSyncExecutor *instance = new NapiSyncExecutor();
+    return *instance;
+}
+
+uint64_t NapiSyncExecutor::Submit(const std::string &name, Task task, Task done)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(task != nullptr, INVALID_TASK_ID, PASTEBOARD_MODULE_JS_NAPI, "task is null");
+    std::lock_guard<std::mutex> lock(mutex_);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!stopping_, INVALID_TASK_ID, PASTEBOARD_MODULE_JS_NAPI, "executor stopped");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(pending_.size() < maxPending_, INVALID_TASK_ID, PASTEBOARD_MODULE_JS_NAPI,
+        "too many sync calls waiting, %{public}s rejected", name.c_str());
+    uint64_t taskId = ++nextTaskId_;
+    pending_.push_back({ taskId, name, std::move(task), std::move(done) });
+    if (workers_ - busyWorkers_ >= pending_.size() || workers_ >= maxWorkers_) {
+        cv_.notify_one();
+        return taskId;
+    }
+    std::thread worker(&NapiSyncExecutor::Work, this);
+    ++workers_;
+    worker.detach();
+    return taskId;
+}
+
+bool NapiSyncExecutor::Cancel(uint64_t taskId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+        if (it->id == taskId) {
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_JS_NAPI, "%{public}s timed out before it ran, dropped",
+                it->name.c_str());
+            pending_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t NapiSyncExecutor::GetWorkerCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return workers_;
+}
+
+size_t NapiSyncExecutor::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+void NapiSyncExecutor::Work()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        bool woken = cv_.wait_for(lock, idleExit_, [this] {
+            return stopping_ || !pending_.empty();
+        });
+        if (!woken || stopping_) {
+            --workers_;
+            // notified under mutex_, the destructor can not return before this worker is done with it
+            cv_.notify_all();
+            return;
+        }
+        PendingTask pending = std::move(pending_.front());
+        pending_.pop_front();
+        ++busyWorkers_;
+        lock.unlock();
+        PasteBoardCommonUtils::SetTaskName(pending.name);
+        pending.task();
+        // the captures are released outside mutex_
+        pending.task = nullptr;
+        lock.lock();
+        --busyWorkers_;
+        if (pending.done != nullptr) {
+            pending.done();
+        }
+    }
+}
+} // namespace OHOS::MiscServicesNapi
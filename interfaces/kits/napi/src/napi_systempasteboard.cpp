@@ -12,10 +12,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <thread>
-
 #include "ffrt/ffrt_utils.h"
 #include "napi_pasteboard_common.h"
+#include "napi_sync_executor.h"
 #include "pasteboard_app_event_dfx.h"
 #include "common/pasteboard_common_utils.h"
 #include "pasteboard_hilog.h"
@@ -373,15 +372,11 @@ napi_value SystemPasteboardNapi::HasRemoteData(napi_env env, napi_callback_info
 {
     HISTOGRAM_BOOLEAN_SAMPLED("Pasteboard.APICall.hasRemoteData", true);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "SystemPasteboardNapi HasRemoteData() is called!");
-    auto block = std::make_shared<BlockObject<std::shared_ptr<bool>>>(SYNC_TIMEOUT);
-    std::thread thread([block]() {
+    auto task = []() {
         bool ret = PasteboardClient::GetInstance()->HasRemoteData();
-        auto ptr = std::make_shared<bool>(ret);
-        block->SetValue(ptr);
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NHasRemoteData");
-    thread.detach();
-    auto value = block->GetValue();
+        return std::make_shared<bool>(ret);
+    };
+    auto value = NapiSyncExecutor::GetInstance().Run<bool>("NHasRemoteData", task, SYNC_TIMEOUT);
     napi_value result = nullptr;
     if (value == nullptr) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "time out, HasRemoteData failed.");
@@ -648,15 +643,11 @@ napi_value SystemPasteboardNapi::GetUnifiedDataSync(napi_env env, napi_callback_
             EventReportResult::EVENT_REPORT_FAIL);
         return nullptr;
     }
-    auto block = std::make_shared<BlockObject<std::shared_ptr<int32_t>>>(SYNC_TIMEOUT);
-    std::thread thread([block, unifiedData = obj->value_]() mutable {
+    auto task = [unifiedData = obj->value_]() mutable {
         auto ret = PasteboardClient::GetInstance()->GetUnifiedData(*unifiedData);
-        std::shared_ptr<int32_t> value = std::make_shared<int32_t>(ret);
-        block->SetValue(value);
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NGetUnifiedData");
-    thread.detach();
-    auto value = block->GetValue();
+        return std::make_shared<int32_t>(ret);
+    };
+    auto value = NapiSyncExecutor::GetInstance().Run<int32_t>("NGetUnifiedData", task, SYNC_TIMEOUT);
     if (!CheckExpression(env, value != nullptr, JSErrorCode::REQUEST_TIME_OUT,
                          "Excessive processing time for internal data.")) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "time out, GetUnifiedDataSync failed.");
@@ -699,18 +690,14 @@ napi_value SystemPasteboardNapi::SetUnifiedDataSync(napi_env env, napi_callback_
         delayGetter->GetStub()->SetDelayGetterWrapper(delayGetter);
         isDelay = true;
     }
-    auto block = std::make_shared<BlockObject<std::shared_ptr<int32_t>>>(SYNC_TIMEOUT);
     std::shared_ptr<UDMF::UnifiedData> unifiedData = unifiedDataNapi->value_;
-    std::thread thread([block, unifiedData, isDelay, delayGetter]() mutable {
+    auto task = [unifiedData, isDelay, delayGetter]() mutable {
         int32_t ret = isDelay ?
             PasteboardClient::GetInstance()->SetUnifiedData(*unifiedData, delayGetter->GetStub()) :
             PasteboardClient::GetInstance()->SetUnifiedData(*unifiedData);
-        std::shared_ptr<int32_t> value = std::make_shared<int32_t>(ret);
-        block->SetValue(value);
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NSetUnifiedData");
-    thread.detach();
-    auto value = block->GetValue();
+        return std::make_shared<int32_t>(ret);
+    };
+    auto value = NapiSyncExecutor::GetInstance().Run<int32_t>("NSetUnifiedData", task, SYNC_TIMEOUT);
     if (!CheckExpression(env, value != nullptr, JSErrorCode::REQUEST_TIME_OUT,
                          "Excessive processing time for internal data.")) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "time out, SetUnifiedDataSync failed.");
@@ -854,16 +841,12 @@ napi_value SystemPasteboardNapi::IsRemoteData(napi_env env, napi_callback_info i
 {
     HISTOGRAM_BOOLEAN_SAMPLED("Pasteboard.APICall.isRemoteData", true);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "SystemPasteboardNapi IsRemoteData() is called!");
-    auto block = std::make_shared<BlockObject<std::shared_ptr<int32_t>>>(SYNC_TIMEOUT);
-    std::thread thread([block]() {
+    auto task = []() {
         auto ret = PasteboardClient::GetInstance()->IsRemoteData();
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "value=%{public}d", ret);
-        std::shared_ptr<int32_t> value = std::make_shared<int32_t>(static_cast<int32_t>(ret));
-        block->SetValue(value);
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NIsRemoteData");
-    thread.detach();
-    auto value = block->GetValue();
+        return std::make_shared<int32_t>(static_cast<int32_t>(ret));
+    };
+    auto value = NapiSyncExecutor::GetInstance().Run<int32_t>("NIsRemoteData", task, SYNC_TIMEOUT);
     if (!CheckExpression(env, value != nullptr, JSErrorCode::REQUEST_TIME_OUT,
                          "Excessive processing time for internal data.")) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "time out, IsRemoteData failed.");
@@ -878,16 +861,13 @@ napi_value SystemPasteboardNapi::GetDataSource(napi_env env, napi_callback_info
 {
     HISTOGRAM_BOOLEAN_SAMPLED("Pasteboard.APICall.getDataSource", true);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "SystemPasteboardNapi GetDataSource() is called!");
-    auto block = std::make_shared<BlockObject<std::shared_ptr<std::pair<int32_t, std::string>>>>(SYNC_TIMEOUT);
-    std::thread thread([block]() mutable {
+    auto task = []() mutable {
         std::string bundleName;
         int32_t ret = PasteboardClient::GetInstance()->GetDataSource(bundleName);
-        auto value = std::make_shared<std::pair<int32_t, std::string>>(ret, bundleName);
-        block->SetValue(value);
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NGetDataSource");
-    thread.detach();
-    auto value = block->GetValue();
+        return std::make_shared<std::pair<int32_t, std::string>>(ret, bundleName);
+    };
+    auto value =
+        NapiSyncExecutor::GetInstance().Run<std::pair<int32_t, std::string>>("NGetDataSource", task, SYNC_TIMEOUT);
     if (!CheckExpression(env, value != nullptr, JSErrorCode::REQUEST_TIME_OUT,
                          "Excessive processing time for internal data.")) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "time out, GetDataSource failed.");
@@ -1015,15 +995,11 @@ napi_value SystemPasteboardNapi::ClearDataSync(napi_env env, napi_callback_info
 {
     HISTOGRAM_BOOLEAN_SAMPLED("Pasteboard.APICall.clearDataSync", true);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "SystemPasteboardNapi ClearDataSync() is called!");
-    auto block = std::make_shared<BlockObject<std::shared_ptr<int32_t>>>(SYNC_TIMEOUT);
-    std::thread thread([block]() {
+    auto task = []() {
         PasteboardClient::GetInstance()->Clear();
-        std::shared_ptr<int32_t> value = std::make_shared<int32_t>(0);
-        block->SetValue(value);
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NClearDataSync");
-    thread.detach();
-    auto value = block->GetValue();
+        return std::make_shared<int32_t>(0);
+    };
+    auto value = NapiSyncExecutor::GetInstance().Run<int32_t>("NClearDataSync", task, SYNC_TIMEOUT);
     if (!CheckExpression(env, value != nullptr, JSErrorCode::REQUEST_TIME_OUT,
                          "Excessive processing time for internal data.")) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "time out, ClearDataSync failed.");
@@ -1046,15 +1022,11 @@ napi_value SystemPasteboardNapi::GetDataSync(napi_env env, napi_callback_info in
             EventReportResult::EVENT_REPORT_FAIL);
         return nullptr;
     }
-    auto block = std::make_shared<BlockObject<std::shared_ptr<int32_t>>>(SYNC_TIMEOUT);
-    std::thread thread([block, pasteData = obj->value_]() mutable {
+    auto task = [pasteData = obj->value_]() mutable {
         auto ret = PasteboardClient::GetInstance()->GetPasteData(*pasteData);
-        std::shared_ptr<int32_t> value = std::make_shared<int32_t>(ret);
-        block->SetValue(value);
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NGetDataSync");
-    thread.detach();
-    auto value = block->GetValue();
+        return std::make_shared<int32_t>(ret);
+    };
+    auto value = NapiSyncExecutor::GetInstance().Run<int32_t>("NGetDataSync", task, SYNC_TIMEOUT);
     if (!CheckExpression(env, value != nullptr, JSErrorCode::REQUEST_TIME_OUT,
                          "Excessive processing time for internal data.")) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "time out, GetDataSync failed.");
@@ -1092,16 +1064,12 @@ napi_value SystemPasteboardNapi::SetDataSync(napi_env env, napi_callback_info in
             EventReportResult::EVENT_REPORT_FAIL);
         return nullptr;
     }
-    auto block = std::make_shared<BlockObject<std::shared_ptr<int32_t>>>(SYNC_TIMEOUT);
     std::shared_ptr<PasteData> data = pasteData->value_;
-    std::thread thread([block, data]() {
+    auto task = [data]() {
         auto ret = PasteboardClient::GetInstance()->SetPasteData(*data);
-        std::shared_ptr<int32_t> value = std::make_shared<int32_t>(ret);
-        block->SetValue(value);
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NSetDataSync");
-    thread.detach();
-    auto value = block->GetValue();
+        return std::make_shared<int32_t>(ret);
+    };
+    auto value = NapiSyncExecutor::GetInstance().Run<int32_t>("NSetDataSync", task, SYNC_TIMEOUT);
     if (!CheckExpression(env, value != nullptr, JSErrorCode::REQUEST_TIME_OUT,
                          "Excessive processing time for internal data.")) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "time out, SetDataSync failed.");
@@ -1123,15 +1091,11 @@ napi_value SystemPasteboardNapi::HasDataSync(napi_env env, napi_callback_info in
 {
     HISTOGRAM_BOOLEAN_SAMPLED("Pasteboard.APICall.hasDataSync", true);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "SystemPasteboardNapi HasDataSync() is called!");
-    auto block = std::make_shared<BlockObject<std::shared_ptr<int32_t>>>(SYNC_TIMEOUT);
-    std::thread thread([block]() {
+    auto task = []() {
         auto ret = PasteboardClient::GetInstance()->HasPasteData();
-        std::shared_ptr<int32_t> value = std::make_shared<int32_t>(static_cast<int32_t>(ret));
-        block->SetValue(value);
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NHasDataSync");
-    thread.detach();
-    auto value = block->GetValue();
+        return std::make_shared<int32_t>(static_cast<int32_t>(ret));
+    };
+    auto value = NapiSyncExecutor::GetInstance().Run<int32_t>("NHasDataSync", task, SYNC_TIMEOUT);
     if (!CheckExpression(env, value != nullptr, JSErrorCode::REQUEST_TIME_OUT,
                          "Excessive processing time for internal data.")) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "time out, HasDataSync failed.");
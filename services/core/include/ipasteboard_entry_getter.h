@@ -18,13 +18,30 @@
 
 #include "iremote_broker.h"
 #include "paste_data_entry.h"
+#include "pasteboard_error.h"
 
 namespace OHOS {
 namespace MiscServices {
+struct EntryValueRequest {
+    uint32_t recordId = 0;
+    // milliseconds after the start of the batch, past it the getter skips the entry with TIMEOUT_ERROR
+    uint32_t deadlineMs = 0;
+    PasteDataEntry entry;
+    int32_t result = static_cast<int32_t>(PasteboardError::E_OK);
+};
+
 class IPasteboardEntryGetter : public IRemoteBroker {
 public:
+    static constexpr uint32_t MAX_BATCH_ENTRIES = 32;
     virtual ~IPasteboardEntryGetter() = default;
     virtual int32_t GetRecordValueByType(uint32_t recordId, PasteDataEntry &value) = 0;
+    // resolves the entries of several requests in one call, each request carries its own result. Getters
+    // without batch support report NOT_SUPPORT and are asked entry by entry
+    virtual int32_t GetRecordValuesByType(std::vector<EntryValueRequest> &requests)
+    {
+        (void)requests;
+        return static_cast<int32_t>(PasteboardError::NOT_SUPPORT);
+    }
     DECLARE_INTERFACE_DESCRIPTOR(u"ohos.misc.services.pasteboard.IPasteboardEntryGetter");
 };
 } // namespace MiscServices
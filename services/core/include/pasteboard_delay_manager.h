@@ -16,6 +16,8 @@
 #ifndef PASTEBOARD_DELAY_MANAGER_H
 #define PASTEBOARD_DELAY_MANAGER_H
 
+#include <mutex>
+
 #include "ipasteboard_entry_getter.h"
 #include "paste_data.h"
 
@@ -34,12 +36,32 @@ class DelayManager {
 public:
     static std::vector<DelayEntryInfo> GetAllDelayEntryInfo(const PasteData &data);
     static std::vector<DelayEntryInfo> GetPrimaryDelayEntryInfo(const PasteData &data);
+    // timeoutMs bounds every getter call of the paste together, NO_FETCH_TIMEOUT waits as long as the getter takes
     static void GetLocalEntryValue(const std::vector<DelayEntryInfo> &delayEntryInfos,
-        sptr<IPasteboardEntryGetter> entryGetter, PasteData &data);
+        sptr<IPasteboardEntryGetter> entryGetter, PasteData &data, uint32_t timeoutMs = NO_FETCH_TIMEOUT);
+
+    static constexpr uint32_t NO_FETCH_TIMEOUT = 0;
+    // same budget a getDataSync caller waits for, the GetData path passes it
+    static constexpr uint32_t ENTRY_FETCH_TIMEOUT_MS = 3500;
 
 private:
+    // entries start as TIMEOUT_ERROR, the fetch task publishes each answer until the caller stops waiting
+    struct EntryFetch {
+        std::mutex mutex;
+        bool abandoned = false;
+        std::vector<EntryValueRequest> requests;
+    };
+
     static uint8_t GetEntryPriority(const std::string &utdId);
     static void SortEntryInfo(std::vector<DelayEntryInfo> &entryInfos);
+    static void FetchEntryValues(std::vector<EntryValueRequest> &requests, sptr<IPasteboardEntryGetter> entryGetter,
+        uint32_t timeoutMs);
+    static void RunEntryFetch(EntryFetch &fetch, uint32_t timeoutMs, sptr<IPasteboardEntryGetter> entryGetter);
+    static bool FetchEntryBatch(std::vector<EntryValueRequest> &batch, uint32_t remainingMs,
+        sptr<IPasteboardEntryGetter> entryGetter);
+    static bool PublishEntryValues(EntryFetch &fetch, size_t begin, std::vector<EntryValueRequest> &values);
+    static void CommitEntryValues(const std::vector<std::shared_ptr<PasteDataEntry>> &entries,
+        std::vector<EntryValueRequest> &requests, PasteData &data);
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_ENTITY_ENGINE_H
+#define PASTE_BOARD_ENTITY_ENGINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace OHOS::MiscServices {
+/*
+ * Runs entity recognition of copied text on one worker thread. The backend is loaded on the first request
+ * and unloaded once the worker has been idle for idleUnloadMs, the worker exits with it. Only the newest
+ * request counts: a waiting one is replaced, and the result of one already running is dropped when a newer
+ * request arrives meanwhile. Results are cached by text, so recopying a text skips the inference.
+ */
+class PasteboardEntityEngine {
+public:
+    class Backend {
+    public:
+        virtual ~Backend() = default;
+        virtual bool Load() = 0;
+        virtual int32_t Process(const std::string &text, std::string &entity) = 0;
+        virtual void Unload() = 0;
+    };
+    using ResultCallback = std::function<void(const std::string &text, const std::string &entity)>;
+
+    static constexpr uint32_t IDLE_UNLOAD_MS = 60 * 1000;
+    static constexpr size_t CACHE_CAPACITY = 8;
+
+    PasteboardEntityEngine(
+        std::unique_ptr<Backend> backend, ResultCallback callback, uint32_t idleUnloadMs = IDLE_UNLOAD_MS);
+    ~PasteboardEntityEngine();
+
+    // the AI engine behind libai_nlu_innerapi, OPENSSL_cleanup runs when it is unloaded
+    static std::unique_ptr<Backend> CreateNluBackend();
+
+    void Recognize(const std::string &text);
+    // drops the waiting request and waits for the worker, later requests are ignored
+    void Stop();
+
+private:
+    // hash only rejects most misses quickly, a hit needs the same text
+    struct CacheEntry {
+        size_t hash = 0;
+        std::string text;
+        std::string entity;
+    };
+
+    void Run();
+    bool Resolve(const std::string &text, std::string &entity);
+    bool LookupCache(size_t hash, const std::string &text, std::string &entity);
+    void StoreCache(size_t hash, const std::string &text, const std::string &entity);
+    void UnloadBackend();
+
+    std::unique_ptr<Backend> backend_;
+    ResultCallback callback_;
+    std::chrono::milliseconds idleUnload_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::optional<std::string> pending_;
+    uint64_t generation_ = 0;
+    bool stopping_ = false;
+    bool workerRunning_ = false;
+    std::thread worker_;
+    // touched by the worker only, consecutive workers are ordered by mutex_
+    bool loaded_ = false;
+    std::list<CacheEntry> cache_;
+};
+} // namespace OHOS::MiscServices
+#endif // PASTE_BOARD_ENTITY_ENGINE_H
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_OBSERVER_DISPATCHER_H
+#define PASTE_BOARD_OBSERVER_DISPATCHER_H
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ipasteboard_changed_observer.h"
+
+namespace OHOS::MiscServices {
+/*
+ * Delivers pasteboard change notifications to observers off the caller's thread. Every observer owns a
+ * mailbox that is drained by at most one task at a time, so its notifications keep their order while a slow
+ * observer only delays itself. A pending OnPasteboardChanged absorbs later ones, and a mailbox holds at most
+ * MAX_PENDING_NOTIFICATIONS entries, the oldest one is dropped beyond that. No lock is held across the IPC.
+ */
+class PasteboardObserverDispatcher : public std::enable_shared_from_this<PasteboardObserverDispatcher> {
+public:
+    using Observer = sptr<IPasteboardChangedObserver>;
+    using Event = IPasteboardChangedObserver::PasteboardChangedEvent;
+    using Executor = std::function<void(std::function<void()>)>;
+
+    static constexpr size_t MAX_PENDING_NOTIFICATIONS = 16;
+
+    // executor runs a drain task asynchronously, the service submits it to ffrt
+    explicit PasteboardObserverDispatcher(Executor executor);
+
+    void PostChanged(const std::vector<Observer> &observers);
+    void PostEvent(const std::vector<Observer> &observers, const Event &event);
+    // drops the notifications not yet delivered to observer
+    void Remove(const Observer &observer);
+    size_t GetPendingCount(const Observer &observer);
+
+private:
+    struct Notification {
+        bool isEvent = false;
+        Event event;
+    };
+
+    struct Mailbox {
+        Observer observer;
+        std::deque<Notification> pending;
+        bool changedPending = false;
+        bool draining = false;
+        size_t dropped = 0;
+    };
+
+    using MailboxKey = const void *;
+
+    static MailboxKey GetKey(const Observer &observer);
+    void Post(const std::vector<Observer> &observers, const Notification &notification);
+    void Enqueue(const std::shared_ptr<Mailbox> &mailbox, const Notification &notification);
+    void Drain(MailboxKey key, std::shared_ptr<Mailbox> mailbox);
+
+    Executor executor_;
+    std::mutex mutex_;
+    std::map<MailboxKey, std::shared_ptr<Mailbox>> mailboxes_;
+};
+} // namespace OHOS::MiscServices
+#endif // PASTE_BOARD_OBSERVER_DISPATCHER_H
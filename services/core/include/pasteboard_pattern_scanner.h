@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_PATTERN_SCANNER_H
+#define PASTE_BOARD_PATTERN_SCANNER_H
+
+#include <cstdint>
+#include <string>
+
+namespace OHOS::MiscServices {
+/*
+ * Single pass detector for the patterns of PatternDetection. Each pattern is a hand compiled matcher over
+ * a shared character class table, equivalent to searching its ECMAScript regex in PatternDetection::patterns_
+ * and applying the length checks of DetectPlainText. Pattern ids follow the Pattern enum, a mask carries
+ * bit (1 << id) for each pattern.
+ */
+class PatternScanner {
+public:
+    static constexpr uint32_t URL = 0;
+    static constexpr uint32_t NUMBER = 1;
+    static constexpr uint32_t EMAIL_ADDRESS = 2;
+    static constexpr uint32_t HTTP_URL = 3;
+    static constexpr uint32_t FLIGHT_NUMBER = 4;
+    static constexpr uint32_t COUNT = 5;
+    static constexpr uint32_t ALL_MASK = (1u << COUNT) - 1;
+
+    // returns the subset of wanted found in text, the scan stops as soon as every wanted pattern is found
+    static uint32_t Scan(const std::string &text, uint32_t wanted);
+
+private:
+    static bool MatchUrlAt(const std::string &text, size_t pos);
+    static bool MatchEmailAt(const std::string &text, size_t pos);
+    static bool MatchEmailDomain(const std::string &text, size_t pos);
+    static bool MatchEmailIpDomain(const std::string &text, size_t pos);
+    static bool MatchEmailTail(const std::string &text, size_t pos);
+    static bool MatchHttpUrlAt(const std::string &text, size_t pos);
+    static bool MatchFlightNumberAt(const std::string &text, size_t pos);
+};
+} // namespace OHOS::MiscServices
+#endif // PASTE_BOARD_PATTERN_SCANNER_H
@@ -20,17 +20,20 @@
 #include <system_ability_definition.h>
 
 #include "bundle_mgr_proxy.h"
+#include "clip/clip_frame_transfer.h"
 #include "clip/clip_plugin.h"
 #include "common/block_object.h"
 #include "device/distributed_module_config.h"
 #include "eventcenter/event_center.h"
 #include "ffrt/ffrt_utils.h"
-#include "i_paste_data_processor.h"
 #include "ientity_recognition_observer.h"
 #include "input_manager.h"
 #include "loader.h"
 #include "pasteboard_account_state_subscriber.h"
 #include "pasteboard_common_event_subscriber.h"
+#include "pasteboard_entity_engine.h"
+#include "pasteboard_observer_dispatcher.h"
+#include "pasteboard_set_sequencer.h"
 #ifdef PB_COCKPIT_PLATFORM_ENABLE
 #include "pasteboard_subprofile_subscriber.h"
 #endif
@@ -96,6 +99,7 @@ struct FocusedAppInfo {
 };
 
 class PasteboardService;
+class SealedAshmem;
 class InputEventCallback : public MMI::IInputEventConsumer {
 public:
     enum InputType : int32_t {
@@ -214,7 +218,6 @@ private:
     std::atomic<bool> isCritical_ = false;
     std::mutex saMutex_;
     using Event = ClipPlugin::GlobalEvent;
-    using GetProcessorFunc = IPasteDataProcessor& (*)();
     static constexpr const int32_t LISTENING_SERVICE[] = { DISTRIBUTED_HARDWARE_DEVICEMANAGER_SA_ID,
         WINDOW_MANAGER_SERVICE_ID, MEMORY_MANAGER_SA_ID, DISTRIBUTED_DEVICE_PROFILE_SA_ID };
     static constexpr const char *PLUGIN_NAME = "distributed_clip";
@@ -340,13 +343,33 @@ private:
         Event currentEvent;
     };
     DistributedMemory setDistributedMemory_;
+    // a remote clip whose frames did not all arrive, the next paste of the same event goes on from there
+    struct FrameTransfer {
+        std::mutex mutex;
+        Event event;
+        std::shared_ptr<ClipFrameReader> reader;
+        std::shared_ptr<PasteData> data;
+        int64_t dataSize = 0;
+        // boot time in ms the kept frames are dropped at
+        int64_t keptUntil = 0;
+    };
+    FrameTransfer frameTransfer_;
+    static constexpr const char *FRAME_TRANSFER_ID = "pasteboard_service_frame_transfer_id";
+    // a remote clip is not announced for longer than that, so its frames are not kept longer either
+    static constexpr uint32_t FRAME_RESUME_TTL = EXPIRATION_INTERVAL;
+    static constexpr int64_t FRAME_RESUME_MAX_SIZE = 64 * 1024 * 1024;
 
     int32_t SaveData(PasteData &pasteData, int64_t dataSize, const sptr<IPasteboardDelayGetter> delayGetter = nullptr,
         const sptr<IPasteboardEntryGetter> entryGetter = nullptr);
     void SetPasteDataInfo(PasteData &pasteData, const AppInfo &appInfo);
-    void HandleDelayDataAndRecord(PasteData &pasteData, const sptr<IPasteboardDelayGetter> delayGetter,
+    struct ClipGetters {
+        std::pair<sptr<IPasteboardDelayGetter>, sptr<DelayGetterDeathRecipient>> delayGetter;
+        std::pair<sptr<IPasteboardEntryGetter>, sptr<EntryGetterDeathRecipient>> entryGetter;
+    };
+    ClipGetters HandleDelayDataAndRecord(PasteData &pasteData, const sptr<IPasteboardDelayGetter> delayGetter,
         const sptr<IPasteboardEntryGetter> entryGetter, const AppInfo &appInfo);
-    void RemovePasteData(const AppInfo &appInfo);
+    ClipGetters SwapClipGetters(int32_t userId, const ClipGetters &getters);
+    void RemoveDeathRecipients(const ClipGetters &getters);
     void SetPasteDataDot(PasteData &pasteData, const int32_t &userId);
     std::pair<int32_t, ClipPlugin::GlobalEvent> GetValidDistributeEvent(int32_t user);
     int32_t GetSdkVersion(uint32_t tokenId);
@@ -372,9 +395,11 @@ private:
         const std::string &pasteId, int32_t &syncTime, UeReportInfo &ueReportInfo);
     void GetPasteDataDot(PasteData &pasteData, const std::string &bundleName, const int32_t &userId);
     int32_t GetLocalData(const AppInfo &appInfo, PasteData &data);
+    void SnapshotClip(const PasteData &clip, PasteData &data);
     int32_t GetRemoteData(int32_t userId, const Event &event, PasteData &data, int32_t &syncTime);
     int32_t GetRemotePasteData(int32_t userId, const Event &event, PasteData &data, int32_t &syncTime);
-    int32_t GetDelayPasteRecord(int32_t userId, PasteData &data);
+    // fetchTimeoutMs bounds the entry getter for a caller that waits on the paste, 0 waits until it answers
+    int32_t GetDelayPasteRecord(int32_t userId, PasteData &data, uint32_t fetchTimeoutMs = 0);
     void GetDelayPasteData(int32_t userId, PasteData &data);
     int32_t ProcessDelayHtmlEntry(PasteData &data, const AppInfo &targetAppInfo, PasteDataEntry &entry);
     int32_t PostProcessDelayHtmlEntry(PasteData &data, const AppInfo &targetInfo, PasteDataEntry &entry);
@@ -402,6 +427,10 @@ private:
     bool HasDistributedDataType(const std::string &mimeType);
 
     std::pair<std::shared_ptr<PasteData>, PasteDateResult> GetDistributedData(const Event &event, int32_t user);
+    std::pair<std::shared_ptr<PasteData>, PasteDateResult> GetDistributedPayload(
+        const std::shared_ptr<ClipPlugin> &clipPlugin, const Event &event, int32_t user);
+    std::pair<std::shared_ptr<PasteData>, PasteDateResult> GetDistributedFrames(
+        const std::shared_ptr<ClipPlugin> &clipPlugin, const Event &event, int32_t user);
     int32_t GetDistributedDelayData(const Event &evt, uint8_t version, std::vector<uint8_t> &rawData);
     int32_t GetDistributedDelayEntry(const Event &evt, uint32_t recordId, const std::string &utdId,
         std::vector<uint8_t> &rawData);
@@ -421,9 +450,16 @@ private:
     int32_t GetFullDelayPasteData(int32_t userId, PasteData &data);
     bool IsDisallowDistributed();
     bool IsNeedLink(PasteData &data);
-    bool SetDistributedData(int32_t user, PasteData &data);
-    bool SetCurrentDistributedData(PasteData &data, Event event);
+    // isLatest tells whether the set behind data is still current, its event is dropped once it is not
+    bool SetDistributedData(int32_t user, PasteData &data, const std::function<bool()> &isLatest = nullptr);
+    bool SetCurrentDistributedData(PasteData &data, Event event, const std::function<bool()> &isLatest = nullptr);
     bool SetCurrentData();
+    bool SetCurrentDataFrames(const std::shared_ptr<ClipPlugin> &clipPlugin, PasteData &data, Event &event,
+        uint32_t remoteVersion, uint8_t payloadVersion);
+    void KeepFrameTransfer(FrameTransfer &transfer);
+    void DropFrameTransfer(FrameTransfer &transfer);
+    void ClearExpiredFrameTransfer();
+    void RecordPeerCapability(const Event &event);
     void OnConfigChange(bool isOn);
     void OnConfigChangeInner(bool isOn);
     std::shared_ptr<ClipPlugin> GetClipPlugin();
@@ -439,8 +475,7 @@ private:
     static std::string GetAppBundleName(const AppInfo &appInfo);
     static void SetLocalPasteFlag(bool isCrossPaste, uint32_t tokenId, PasteData &pasteData);
     void RecognizePasteData(PasteData &pasteData);
-    void OnRecognizePasteData(const std::string &primaryText);
-    void OnRecognizePasteDataInner(const std::string &primaryText, void *nulGuard);
+    void OnEntityRecognized(const std::string &primaryText, const std::string &entity);
     void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
     void OnRemoveSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
     void UpdateAgedTime();
@@ -461,7 +496,14 @@ private:
     int32_t GetRecordValueByType(int64_t &rawDataSize, std::vector<uint8_t> &buffer, int &fd,
         const PasteDataEntry &entryValue);
     int32_t DealData(int &fd, int64_t &size, std::vector<uint8_t> &rawData, PasteData &data);
+    int32_t DealSealedData(int &fd, int64_t &size, std::vector<uint8_t> &rawData, PasteData &data,
+        const SealedAshmem &sealed);
+    std::shared_ptr<const SealedAshmem> AttachEncodedRecords(int32_t userId, PasteData &data);
+    void InvalidateClipCache(int32_t userId);
+    std::shared_ptr<const PasteDataTypeIndex> GetTypeIndex(int32_t userId, const std::shared_ptr<PasteData> &clip);
     bool WriteRawData(const void *data, int64_t size, int &serFd);
+    bool WriteRawData(const TLVWriteable &value, int64_t size, int &serFd);
+    void *MapRawDataAshmem(int64_t size, int &fd);
     int32_t WritePasteData(
         int fd, int64_t rawDataSize, const std::vector<uint8_t> &buffer, PasteData &pasteData, bool &hasData);
     void CloseSharedMemFd(int fd);
@@ -487,9 +529,24 @@ private:
     ObserverMap observerLocalChangedMap_;
     ObserverMap observerRemoteChangedMap_;
     ObserverMap observerEventMap_;
+    std::shared_ptr<PasteboardObserverDispatcher> observerDispatcher_;
     ClipPlugin::GlobalEvent currentEvent_;
     ClipPlugin::GlobalEvent remoteEvent_;
     ConcurrentMap<int32_t, std::shared_ptr<PasteData>> clips_;
+    // encoded record list of the clip in clips_, shared by every reader until the clip changes; large lists
+    // live in a sealed region instead when sealedClipStore_ is on
+    struct EncodedClip {
+        std::shared_ptr<PasteData> source;
+        std::shared_ptr<const std::vector<uint8_t>> records;
+        std::shared_ptr<const SealedAshmem> sealed;
+    };
+    ConcurrentMap<int32_t, EncodedClip> encodedClips_;
+    // type index of the clip in clips_, answers HasDataType/HasUtdType/GetMimeTypes until the clip changes
+    struct ClipTypeIndex {
+        std::shared_ptr<PasteData> source;
+        std::shared_ptr<const PasteDataTypeIndex> index;
+    };
+    ConcurrentMap<int32_t, ClipTypeIndex> typeIndexes_;
     ConcurrentMap<int32_t, uint32_t> clipChangeCount_;
     ConcurrentMap<pid_t, std::vector<EntityObserverInfo>> entityObserverMap_;
     ConcurrentMap<int32_t, std::pair<sptr<IPasteboardEntryGetter>, sptr<EntryGetterDeathRecipient>>> entryGetters_;
@@ -516,7 +573,7 @@ private:
     static std::vector<std::string> dataHistory_;
     static std::shared_ptr<Command> copyHistory;
     static std::shared_ptr<Command> copyData;
-    std::atomic<bool> setting_ = false;
+    PasteboardSetSequencer setSequencer_;
 
     struct PasteboardP2pInfo {
         pid_t callPid;
@@ -539,6 +596,14 @@ private:
     };
 
     ConcurrentMap<uint32_t, GlobalShareOption> globalShareOptions_;
+    // what each peer announced in its events, keyed by udid
+    struct PeerCapability {
+        uint8_t payloadVersion = 0;
+        bool acceptFrames = false;
+    };
+    ConcurrentMap<std::string, PeerCapability> peerCapabilities_;
+    // what every trusted device announced, a device not heard from yet counts as an old one
+    PeerCapability GetPeerCapability();
 
     bool AddObserver(int32_t userId, const sptr<IPasteboardChangedObserver> &observer, ObserverMap &observerMap);
     void RemoveSingleObserver(
@@ -567,12 +632,13 @@ private:
     DistributedModuleConfig moduleConfig_;
     int32_t uid_ = -1;
     std::atomic<int64_t> maxLocalCapacity_ = DEFAULT_LOCAL_CAPACITY * SIZE_K * SIZE_K;
+    std::atomic<bool> sealedClipStore_ = false;
     RemoteDataTaskManager taskMgr_;
     std::atomic<pid_t> setPasteDataUId_ = 0;
     static constexpr pid_t TEST_SERVER_UID = 3500;
     std::mutex eventMutex_;
     mutable std::mutex currentEventMutex_;
-    std::mutex entityRecognizeMutex_;
+    std::unique_ptr<PasteboardEntityEngine> entityEngine_;
     SecurityLevel securityLevel_;
     class PasteboardDeathRecipient final : public IRemoteObject::DeathRecipient {
     public:
@@ -587,6 +653,10 @@ private:
     };
     int32_t AppExit(pid_t pid, int32_t userId);
     void RemoveObserverByPid(int32_t userId, pid_t pid, ObserverMap &observerMap);
+    void RemoveDispatchedObservers(
+        const std::shared_ptr<std::set<sptr<IPasteboardChangedObserver>, classcomp>> &observers);
+    static std::vector<sptr<IPasteboardChangedObserver>> CollectObservers(
+        const ObserverMap &observerMap, const std::function<bool(int32_t)> &userFilter);
     ClipPlugin::GlobalEvent GetCurrentEvent() const;
     void SetCurrentEvent(ClipPlugin::GlobalEvent event);
     ConcurrentMap<pid_t, std::pair<sptr<IRemoteObject>, sptr<PasteboardDeathRecipient>>> clients_;
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_SET_SEQUENCER_H
+#define PASTEBOARD_SET_SEQUENCER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace OHOS::MiscServices {
+/*
+ * Orders overlapping SetPasteData calls of each user with last-writer-wins semantics.
+ * A set draws a ticket when it arrives, prepares its data without any lock, and
+ * then commits. The commit only runs when no later ticket of the same user has
+ * committed in the meantime, a set that lost the race is superseded, not rejected.
+ * Users never wait for each other, each one has its own lock. What a committed set
+ * announces to others runs in Publish without any lock held, so its stages check
+ * IsLatest before handing out a result and drop it once a newer set has committed.
+ */
+class PasteboardSetSequencer {
+public:
+    uint64_t Begin()
+    {
+        return ++nextTicket_;
+    }
+
+    bool Commit(int32_t userId, uint64_t ticket, const std::function<void()> &commit)
+    {
+        auto sequence = GetSequence(userId);
+        std::lock_guard<std::mutex> lock(sequence->mutex);
+        if (ticket <= sequence->committed.load()) {
+            return false;
+        }
+        sequence->committed.store(ticket);
+        if (commit) {
+            commit();
+        }
+        return true;
+    }
+
+    // runs publish if ticket is still the latest commit of userId, false if a newer set committed first
+    bool Publish(int32_t userId, uint64_t ticket, const std::function<void()> &publish)
+    {
+        if (!IsLatest(userId, ticket)) {
+            return false;
+        }
+        if (publish) {
+            publish();
+        }
+        return true;
+    }
+
+    bool IsLatest(int32_t userId, uint64_t ticket)
+    {
+        return Committed(userId) == ticket;
+    }
+
+    uint64_t Committed(int32_t userId)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sequences_.find(userId);
+        return it == sequences_.end() ? 0 : it->second->committed.load();
+    }
+
+private:
+    struct Sequence {
+        std::mutex mutex;
+        std::atomic<uint64_t> committed = 0;
+    };
+
+    std::shared_ptr<Sequence> GetSequence(int32_t userId)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &sequence = sequences_[userId];
+        if (sequence == nullptr) {
+            sequence = std::make_shared<Sequence>();
+        }
+        return sequence;
+    }
+
+    std::atomic<uint64_t> nextTicket_ = 0;
+    // guards the map only, a commit holds the lock of its own user
+    std::mutex mutex_;
+    std::map<int32_t, std::shared_ptr<Sequence>> sequences_;
+};
+} // namespace OHOS::MiscServices
+#endif // PASTEBOARD_SET_SEQUENCER_H
@@ -15,6 +15,10 @@
 
 #include "pasteboard_delay_manager.h"
 
+#include <chrono>
+
+#include "common/block_object.h"
+#include "ffrt/ffrt_utils.h"
 #include "message_parcel_warp.h"
 #include "pasteboard_error.h"
 #include "pasteboard_hilog.h"
@@ -97,34 +101,154 @@ std::vector<DelayEntryInfo> DelayManager::GetPrimaryDelayEntryInfo(const PasteDa
 }
 
 void DelayManager::GetLocalEntryValue(const std::vector<DelayEntryInfo> &delayEntryInfos,
-    sptr<IPasteboardEntryGetter> entryGetter, PasteData &data)
+    sptr<IPasteboardEntryGetter> entryGetter, PasteData &data, uint32_t timeoutMs)
 {
     PASTEBOARD_CHECK_AND_RETURN_LOGE(entryGetter != nullptr, PASTEBOARD_MODULE_SERVICE, "entryGetter is null");
+    std::vector<std::shared_ptr<PasteDataEntry>> entries;
+    std::vector<EntryValueRequest> requests;
     for (const auto &entryInfo : delayEntryInfos) {
         auto entry = entryInfo.entry;
         if (entry == nullptr || !std::holds_alternative<std::monostate>(entry->GetValue())) {
             continue;
         }
+        EntryValueRequest request;
+        request.recordId = entryInfo.recordId;
+        request.entry = *entry;
+        requests.push_back(std::move(request));
+        entries.push_back(entry);
+    }
+    if (requests.empty()) {
+        return;
+    }
+    FetchEntryValues(requests, entryGetter, timeoutMs);
+    CommitEntryValues(entries, requests, data);
+}
+
+void DelayManager::FetchEntryValues(std::vector<EntryValueRequest> &requests, sptr<IPasteboardEntryGetter> entryGetter,
+    uint32_t timeoutMs)
+{
+    auto fetch = std::make_shared<EntryFetch>();
+    for (auto &request : requests) {
+        request.result = static_cast<int32_t>(PasteboardError::TIMEOUT_ERROR);
+    }
+    fetch->requests = std::move(requests);
+    if (timeoutMs == NO_FETCH_TIMEOUT) {
+        RunEntryFetch(*fetch, timeoutMs, entryGetter);
+        requests = std::move(fetch->requests);
+        return;
+    }
+    // a getter that never answers must not hold the paste, the fetch task keeps its own copy of everything
+    auto block = std::make_shared<BlockObject<bool>>(timeoutMs, false);
+    FFRTUtils::SubmitTask([fetch, block, timeoutMs, entryGetter]() {
+        RunEntryFetch(*fetch, timeoutMs, entryGetter);
+        block->SetValue(true);
+    });
+    if (!block->GetValue()) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "entry getter timeout, timeout=%{public}u ms", timeoutMs);
+    }
+    std::lock_guard<std::mutex> lock(fetch->mutex);
+    fetch->abandoned = true;
+    requests = std::move(fetch->requests);
+}
+
+void DelayManager::RunEntryFetch(EntryFetch &fetch, uint32_t timeoutMs, sptr<IPasteboardEntryGetter> entryGetter)
+{
+    std::vector<EntryValueRequest> pending;
+    {
+        std::lock_guard<std::mutex> lock(fetch.mutex);
+        PASTEBOARD_CHECK_AND_RETURN_LOGW(!fetch.abandoned, PASTEBOARD_MODULE_SERVICE, "fetch abandoned");
+        pending = fetch.requests;
+    }
+    auto start = std::chrono::steady_clock::now();
+    bool batchSupported = true;
+    for (size_t begin = 0; begin < pending.size(); begin += IPasteboardEntryGetter::MAX_BATCH_ENTRIES) {
+        size_t end = std::min(pending.size(), begin + IPasteboardEntryGetter::MAX_BATCH_ENTRIES);
+        uint32_t remainingMs = UINT32_MAX;
+        if (timeoutMs != NO_FETCH_TIMEOUT) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            PASTEBOARD_CHECK_AND_RETURN_LOGW(elapsed < static_cast<int64_t>(timeoutMs), PASTEBOARD_MODULE_SERVICE,
+                "no time left, fetched=%{public}zu", begin);
+            remainingMs = timeoutMs - static_cast<uint32_t>(elapsed);
+        }
+        if (batchSupported) {
+            std::vector<EntryValueRequest> batch(std::make_move_iterator(pending.begin() + begin),
+                std::make_move_iterator(pending.begin() + end));
+            if (FetchEntryBatch(batch, remainingMs, entryGetter)) {
+                PASTEBOARD_CHECK_AND_RETURN_LOGW(PublishEntryValues(fetch, begin, batch), PASTEBOARD_MODULE_SERVICE,
+                    "fetch abandoned");
+                continue;
+            }
+            std::move(batch.begin(), batch.end(), pending.begin() + begin);
+            batchSupported = false;
+        }
+        for (size_t index = begin; index < end; ++index) {
+            std::vector<EntryValueRequest> value(1, std::move(pending[index]));
+            value[0].result = entryGetter->GetRecordValueByType(value[0].recordId, value[0].entry);
+            PASTEBOARD_CHECK_AND_RETURN_LOGW(PublishEntryValues(fetch, index, value), PASTEBOARD_MODULE_SERVICE,
+                "fetch abandoned");
+        }
+    }
+}
 
-        PasteDataEntry tmpEntry = *entry;
-        int32_t result = entryGetter->GetRecordValueByType(entryInfo.recordId, tmpEntry);
-        if (result != static_cast<int32_t>(PasteboardError::E_OK)) {
+bool DelayManager::FetchEntryBatch(std::vector<EntryValueRequest> &batch, uint32_t remainingMs,
+    sptr<IPasteboardEntryGetter> entryGetter)
+{
+    // the app runs entries in priority order and skips the ones still waiting when the paste runs out of time
+    for (auto &request : batch) {
+        request.deadlineMs = remainingMs;
+    }
+    std::vector<EntryValueRequest> sent = batch;
+    int32_t result = entryGetter->GetRecordValuesByType(batch);
+    if (result != static_cast<int32_t>(PasteboardError::E_OK)) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "batch get fail, result=%{public}d, ask entry by entry", result);
+        batch = std::move(sent);
+        return false;
+    }
+    return true;
+}
+
+bool DelayManager::PublishEntryValues(EntryFetch &fetch, size_t begin, std::vector<EntryValueRequest> &values)
+{
+    std::lock_guard<std::mutex> lock(fetch.mutex);
+    if (fetch.abandoned) {
+        return false;
+    }
+    std::move(values.begin(), values.end(), fetch.requests.begin() + begin);
+    return true;
+}
+
+void DelayManager::CommitEntryValues(const std::vector<std::shared_ptr<PasteDataEntry>> &entries,
+    std::vector<EntryValueRequest> &requests, PasteData &data)
+{
+    std::vector<EntryValue> values(requests.size());
+    for (size_t index = 0; index < requests.size(); ++index) {
+        if (requests[index].result != static_cast<int32_t>(PasteboardError::E_OK)) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
-                "get record value fail, dataId=%{public}d, recordId=%{public}d, utdId=%{public}s",
-                data.GetDataId(), entryInfo.recordId, entry->GetUtdId().c_str());
+                "get record value fail, dataId=%{public}d, recordId=%{public}d, utdId=%{public}s, ret=%{public}d",
+                data.GetDataId(), requests[index].recordId, entries[index]->GetUtdId().c_str(),
+                requests[index].result);
             continue;
         }
-
-        if (data.rawDataSize_ + tmpEntry.rawDataSize_ < MessageParcelWarp::GetRawDataSize()) {
-            std::unique_lock<std::shared_mutex> write(PasteboardService::pasteDataMutex_);
-            entry->SetValue(tmpEntry.GetValue());
-            entry->rawDataSize_ = tmpEntry.rawDataSize_;
-            data.rawDataSize_ += tmpEntry.rawDataSize_;
+        values[index] = requests[index].entry.GetValue();
+    }
+    // every fetched value lands under one short lock, in priority order so the size budget favours the same entries
+    std::unique_lock<std::shared_mutex> write(PasteboardService::pasteDataMutex_);
+    for (size_t index = 0; index < requests.size(); ++index) {
+        if (requests[index].result != static_cast<int32_t>(PasteboardError::E_OK)) {
+            continue;
+        }
+        auto &entry = entries[index];
+        int64_t entrySize = requests[index].entry.rawDataSize_;
+        if (data.rawDataSize_ + entrySize < MessageParcelWarp::GetRawDataSize()) {
+            entry->SetValue(std::move(values[index]));
+            entry->rawDataSize_ = entrySize;
+            data.rawDataSize_ += entrySize;
             PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "add entry, dataSize=%{public}" PRId64
-                ", entrySize=%{public}" PRId64, data.rawDataSize_, tmpEntry.rawDataSize_);
+                ", entrySize=%{public}" PRId64, data.rawDataSize_, entrySize);
         } else {
             PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "no space, dataSize=%{public}" PRId64
-                ", entrySize=%{public}" PRId64, data.rawDataSize_, tmpEntry.rawDataSize_);
+                ", entrySize=%{public}" PRId64, data.rawDataSize_, entrySize);
         }
     }
 }
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_entity_engine.h"
+
+#include <dlfcn.h>
+
+#include "common/pasteboard_common_utils.h"
+#include "errors.h"
+#include "i_paste_data_processor.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr const char *NLU_SO_PATH = "libai_nlu_innerapi.z.so";
+constexpr const char *SSL_SO_PATH = "libcrypto_openssl.z.so";
+constexpr const char *GET_PASTE_DATA_PROCESSOR = "GetPasteDataProcessor";
+constexpr const char *OPENSSL_CLEANUP = "OPENSSL_cleanup";
+
+class NluBackend : public PasteboardEntityEngine::Backend {
+public:
+    ~NluBackend() override
+    {
+        Unload();
+    }
+
+    bool Load() override
+    {
+        using GetProcessorFunc = IPasteDataProcessor &(*)();
+        nluHandle_ = dlopen(NLU_SO_PATH, RTLD_NOW);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(
+            nluHandle_ != nullptr, false, PASTEBOARD_MODULE_SERVICE, "Can not get AIEngine handle");
+        sslHandle_ = dlopen(SSL_SO_PATH, RTLD_NOW);
+        if (sslHandle_ == nullptr) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Can not get SSL handle");
+            Unload();
+            return false;
+        }
+        cleanSSL_ = reinterpret_cast<CleanupFunc>(dlsym(sslHandle_, OPENSSL_CLEANUP));
+        auto getProcessor = reinterpret_cast<GetProcessorFunc>(dlsym(nluHandle_, GET_PASTE_DATA_PROCESSOR));
+        if (cleanSSL_ == nullptr || getProcessor == nullptr) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Can not get cleanSSL or ProcessorFunc");
+            Unload();
+            return false;
+        }
+        processor_ = &getProcessor();
+        return true;
+    }
+
+    int32_t Process(const std::string &text, std::string &entity) override
+    {
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(
+            processor_ != nullptr, ERR_INVALID_VALUE, PASTEBOARD_MODULE_SERVICE, "processor not loaded");
+        return processor_->Process(text, entity);
+    }
+
+    void Unload() override
+    {
+        processor_ = nullptr;
+        if (cleanSSL_ != nullptr) {
+            cleanSSL_();
+            cleanSSL_ = nullptr;
+        }
+        if (sslHandle_ != nullptr) {
+            dlclose(sslHandle_);
+            sslHandle_ = nullptr;
+        }
+        if (nluHandle_ != nullptr) {
+            dlclose(nluHandle_);
+            nluHandle_ = nullptr;
+        }
+    }
+
+private:
+    using CleanupFunc = void (*)();
+
+    void *nluHandle_ = nullptr;
+    void *sslHandle_ = nullptr;
+    CleanupFunc cleanSSL_ = nullptr;
+    IPasteDataProcessor *processor_ = nullptr;
+};
+} // namespace
+
+PasteboardEntityEngine::PasteboardEntityEngine(
+    std::unique_ptr<Backend> backend, ResultCallback callback, uint32_t idleUnloadMs)
+    : backend_(std::move(backend)), callback_(std::move(callback)), idleUnload_(idleUnloadMs)
+{
+}
+
+PasteboardEntityEngine::~PasteboardEntityEngine()
+{
+    Stop();
+}
+
+std::unique_ptr<PasteboardEntityEngine::Backend> PasteboardEntityEngine::CreateNluBackend()
+{
+    return std::make_unique<NluBackend>();
+}
+
+void PasteboardEntityEngine::Recognize(const std::string &text)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(!stopping_, PASTEBOARD_MODULE_SERVICE, "entity engine stopped");
+    if (pending_.has_value()) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "waiting recognition superseded");
+    }
+    pending_ = text;
+    ++generation_;
+    if (workerRunning_) {
+        cv_.notify_one();
+        return;
+    }
+    // an idle worker released mutex_ for the last time on its way out, joining it is immediate
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    workerRunning_ = true;
+    worker_ = std::thread(&PasteboardEntityEngine::Run, this);
+}
+
+void PasteboardEntityEngine::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        pending_.reset();
+        ++generation_;
+    }
+    cv_.notify_one();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void PasteboardEntityEngine::Run()
+{
+    PasteBoardCommonUtils::SetTaskName("PasteDataRecognize");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        bool woken = cv_.wait_for(lock, idleUnload_, [this] {
+            return stopping_ || pending_.has_value();
+        });
+        if (!woken || stopping_) {
+            // unloading under mutex_ keeps the next worker from loading before this one is done
+            UnloadBackend();
+            workerRunning_ = false;
+            return;
+        }
+        std::string text = std::move(*pending_);
+        pending_.reset();
+        uint64_t generation = generation_;
+        lock.unlock();
+        std::string entity;
+        bool resolved = Resolve(text, entity);
+        lock.lock();
+        if (!resolved) {
+            continue;
+        }
+        if (generation != generation_) {
+            PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "recognition result outdated, dropped");
+            continue;
+        }
+        lock.unlock();
+        callback_(text, entity);
+        lock.lock();
+    }
+}
+
+bool PasteboardEntityEngine::Resolve(const std::string &text, std::string &entity)
+{
+    size_t hash = std::hash<std::string>()(text);
+    if (LookupCache(hash, text, entity)) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "recognition served from cache");
+        return true;
+    }
+    if (!loaded_) {
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(backend_ != nullptr, false, PASTEBOARD_MODULE_SERVICE, "no backend");
+        loaded_ = backend_->Load();
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(loaded_, false, PASTEBOARD_MODULE_SERVICE, "load backend failed");
+    }
+    int32_t result = backend_->Process(text, entity);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(
+        result == ERR_OK, false, PASTEBOARD_MODULE_SERVICE, "AI Process failed, result=%{public}d", result);
+    StoreCache(hash, text, entity);
+    return true;
+}
+
+bool PasteboardEntityEngine::LookupCache(size_t hash, const std::string &text, std::string &entity)
+{
+    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+        if (it->hash == hash && it->text == text) {
+            entity = it->entity;
+            cache_.splice(cache_.begin(), cache_, it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void PasteboardEntityEngine::StoreCache(size_t hash, const std::string &text, const std::string &entity)
+{
+    cache_.push_front({ hash, text, entity });
+    if (cache_.size() > CACHE_CAPACITY) {
+        cache_.pop_back();
+    }
+}
+
+void PasteboardEntityEngine::UnloadBackend()
+{
+    if (!loaded_) {
+        return;
+    }
+    backend_->Unload();
+    loaded_ = false;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "entity engine unloaded");
+}
+} // namespace OHOS::MiscServices
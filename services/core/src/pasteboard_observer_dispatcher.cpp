@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_observer_dispatcher.h"
+
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+PasteboardObserverDispatcher::PasteboardObserverDispatcher(Executor executor) : executor_(std::move(executor))
+{
+}
+
+void PasteboardObserverDispatcher::PostChanged(const std::vector<Observer> &observers)
+{
+    Post(observers, Notification());
+}
+
+void PasteboardObserverDispatcher::PostEvent(const std::vector<Observer> &observers, const Event &event)
+{
+    Notification notification;
+    notification.isEvent = true;
+    notification.event = event;
+    Post(observers, notification);
+}
+
+void PasteboardObserverDispatcher::Remove(const Observer &observer)
+{
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(observer != nullptr, PASTEBOARD_MODULE_SERVICE, "observer is null");
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = mailboxes_.find(GetKey(observer));
+    if (it == mailboxes_.end()) {
+        return;
+    }
+    // a running drain sees the empty mailbox and stops after its current delivery
+    it->second->pending.clear();
+    it->second->changedPending = false;
+    mailboxes_.erase(it);
+}
+
+size_t PasteboardObserverDispatcher::GetPendingCount(const Observer &observer)
+{
+    if (observer == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = mailboxes_.find(GetKey(observer));
+    return it == mailboxes_.end() ? 0 : it->second->pending.size();
+}
+
+PasteboardObserverDispatcher::MailboxKey PasteboardObserverDispatcher::GetKey(const Observer &observer)
+{
+    // proxies of one remote observer share its remote object, the same key classcomp orders them by
+    auto object = observer->AsObject();
+    if (object != nullptr) {
+        return object.GetRefPtr();
+    }
+    return observer.GetRefPtr();
+}
+
+void PasteboardObserverDispatcher::Post(const std::vector<Observer> &observers, const Notification &notification)
+{
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(executor_ != nullptr, PASTEBOARD_MODULE_SERVICE, "executor is null");
+    std::vector<std::pair<MailboxKey, std::shared_ptr<Mailbox>>> toDrain;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &observer : observers) {
+            if (observer == nullptr) {
+                continue;
+            }
+            MailboxKey key = GetKey(observer);
+            auto &mailbox = mailboxes_[key];
+            if (mailbox == nullptr) {
+                mailbox = std::make_shared<Mailbox>();
+                mailbox->observer = observer;
+            }
+            Enqueue(mailbox, notification);
+            if (!mailbox->draining && !mailbox->pending.empty()) {
+                mailbox->draining = true;
+                toDrain.emplace_back(key, mailbox);
+            }
+        }
+    }
+    auto self = shared_from_this();
+    for (auto &[key, mailbox] : toDrain) {
+        executor_([self, key = key, mailbox = mailbox]() {
+            self->Drain(key, mailbox);
+        });
+    }
+}
+
+// called with mutex_ held
+void PasteboardObserverDispatcher::Enqueue(const std::shared_ptr<Mailbox> &mailbox, const Notification &notification)
+{
+    if (!notification.isEvent) {
+        // a change carries no payload, the pending one already tells the observer to read the pasteboard again
+        if (mailbox->changedPending) {
+            return;
+        }
+        mailbox->changedPending = true;
+    }
+    if (mailbox->pending.size() >= MAX_PENDING_NOTIFICATIONS) {
+        if (!mailbox->pending.front().isEvent) {
+            mailbox->changedPending = false;
+        }
+        mailbox->pending.pop_front();
+        if (mailbox->dropped++ == 0) {
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observer is slow, dropping stale notifications");
+        }
+    }
+    mailbox->pending.push_back(notification);
+}
+
+void PasteboardObserverDispatcher::Drain(MailboxKey key, std::shared_ptr<Mailbox> mailbox)
+{
+    while (true) {
+        Notification notification;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (mailbox->pending.empty()) {
+                mailbox->draining = false;
+                if (mailbox->dropped != 0) {
+                    PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observer caught up, %{public}zu notifications dropped",
+                        mailbox->dropped);
+                    mailbox->dropped = 0;
+                }
+                // an idle observer keeps no mailbox, Post creates a new one on its next notification
+                auto it = mailboxes_.find(key);
+                if (it != mailboxes_.end() && it->second == mailbox) {
+                    mailboxes_.erase(it);
+                }
+                return;
+            }
+            notification = std::move(mailbox->pending.front());
+            mailbox->pending.pop_front();
+            if (!notification.isEvent) {
+                mailbox->changedPending = false;
+            }
+        }
+        if (notification.isEvent) {
+            mailbox->observer->OnPasteboardEvent(notification.event);
+        } else {
+            mailbox->observer->OnPasteboardChanged();
+        }
+    }
+}
+} // namespace OHOS::MiscServices
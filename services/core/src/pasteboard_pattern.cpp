@@ -16,17 +16,13 @@
 #include <cstdlib>
 #include <dlfcn.h>
 #include <libxml/HTMLparser.h>
-#include <regex>
 
 #include "pasteboard_hilog.h"
 #include "pasteboard_pattern.h"
+#include "pasteboard_pattern_scanner.h"
 
 namespace OHOS::MiscServices {
 
-constexpr int32_t MIN_HTTP_URL_LENGTH = 7;
-constexpr int32_t MIN_FLIGHT_NUMBER_LENGTH = 5;
-constexpr int32_t MAX_FLIGHT_NUMBER_LENGTH = 7;
-
 std::map<uint32_t, std::string> PatternDetection::patterns_{
     { static_cast<uint32_t>(Pattern::URL), std::string("[a-zA-Z0-9+.-]+://[-a-zA-Z0-9+&@#/%?"
                                                        "=~_|!:,.;]*[-a-zA-Z0-9+&@#/%=~_]") },
@@ -62,37 +58,26 @@ const std::set<Pattern> PatternDetection::Detect(
 void PatternDetection::DetectPlainText(
     std::set<Pattern> &patternsOut, const std::set<Pattern> &patternsIn, const std::string &plainText)
 {
+    // patterns_ stays the reference of what each pattern means, the scanner matches all of them in one pass
+    uint32_t wanted = 0;
     for (Pattern pattern : patternsIn) {
         if (patternsOut.find(pattern) != patternsOut.end()) {
             continue;
         }
         uint32_t patternUint32 = static_cast<uint32_t>(pattern);
-        auto it = patterns_.find(patternUint32);
-        if (it == patterns_.end()) {
+        if (patternUint32 >= PatternScanner::COUNT) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "pasteboard pattern, unexpected Pattern value!");
             continue;
         }
-        std::regex curRegex(it->second);
-        std::smatch match;
-
-        if (!std::regex_search(plainText, match, curRegex)) {
-            continue;
-        }
-
-        std::string matched = match.str();
-        bool isValidPattern = false;
-
-        if (pattern == Pattern::HTTP_URL) {
-            isValidPattern = matched.length() >= MIN_HTTP_URL_LENGTH;
-        } else if (pattern == Pattern::FLIGHT_NUMBER) {
-            isValidPattern = (matched.length() >= MIN_FLIGHT_NUMBER_LENGTH &&
-                matched.length() <= MAX_FLIGHT_NUMBER_LENGTH);
-        } else {
-            isValidPattern = true;
-        }
-
-        if (isValidPattern) {
-            patternsOut.insert(pattern);
+        wanted |= 1u << patternUint32;
+    }
+    if (wanted == 0) {
+        return;
+    }
+    uint32_t found = PatternScanner::Scan(plainText, wanted);
+    for (uint32_t id = 0; id < PatternScanner::COUNT; ++id) {
+        if ((found & (1u << id)) != 0) {
+            patternsOut.insert(static_cast<Pattern>(id));
         }
     }
 }
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_pattern_scanner.h"
+
+#include <array>
+
+namespace OHOS::MiscServices {
+namespace {
+enum CharClass : uint16_t {
+    CLASS_DIGIT = 1 << 0,
+    CLASS_UPPER = 1 << 1,
+    CLASS_WORD = 1 << 2,         // \w
+    CLASS_SPACE = 1 << 3,        // \s
+    CLASS_URL_SCHEME = 1 << 4,   // [a-zA-Z0-9+.-]
+    CLASS_URL_BODY = 1 << 5,     // [-a-zA-Z0-9+&@#/%?=~_|!:,.;]
+    CLASS_URL_END = 1 << 6,      // [-a-zA-Z0-9+&@#/%=~_]
+    CLASS_EMAIL_LOCAL = 1 << 7,  // [a-zA-Z0-9_\-\.\%\+]
+    CLASS_EMAIL_DOMAIN = 1 << 8, // [a-zA-Z0-9\-]
+    CLASS_ALPHA = 1 << 9,        // [a-zA-Z]
+};
+
+constexpr const char *HTTP_PREFIX = "http://";
+constexpr const char *HTTPS_PREFIX = "https://";
+constexpr size_t SCHEME_SEPARATOR_LENGTH = 3; // "://"
+constexpr size_t FLIGHT_PREFIX_LENGTH = 2;
+constexpr size_t FLIGHT_MIN_DIGITS = 3;
+constexpr size_t FLIGHT_MAX_DIGITS = 4;
+constexpr size_t IP_MAX_DIGITS = 3;
+constexpr size_t IP_GROUPS = 4;
+
+using ClassTable = std::array<uint16_t, 256>;
+
+void AddClass(ClassTable &table, const std::string &chars, uint16_t mask)
+{
+    for (unsigned char c : chars) {
+        table[c] |= mask;
+    }
+}
+
+ClassTable BuildClassTable()
+{
+    ClassTable table{};
+    std::string digits = "0123456789";
+    std::string upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    std::string lower = "abcdefghijklmnopqrstuvwxyz";
+    std::string alnum = digits + upper + lower;
+    AddClass(table, digits, CLASS_DIGIT);
+    AddClass(table, upper, CLASS_UPPER);
+    AddClass(table, upper + lower, CLASS_ALPHA);
+    AddClass(table, alnum + "_", CLASS_WORD);
+    AddClass(table, " \t\n\v\f\r", CLASS_SPACE);
+    AddClass(table, alnum + "+.-", CLASS_URL_SCHEME);
+    AddClass(table, alnum + "-+&@#/%?=~_|!:,.;", CLASS_URL_BODY);
+    AddClass(table, alnum + "-+&@#/%=~_", CLASS_URL_END);
+    AddClass(table, alnum + "_-.%+", CLASS_EMAIL_LOCAL);
+    AddClass(table, alnum + "-", CLASS_EMAIL_DOMAIN);
+    return table;
+}
+
+// built once, every matcher reads it
+const ClassTable &Classes()
+{
+    static const ClassTable table = BuildClassTable();
+    return table;
+}
+
+inline bool Is(const std::string &text, size_t pos, uint16_t mask)
+{
+    return pos < text.size() && (Classes()[static_cast<unsigned char>(text[pos])] & mask) != 0;
+}
+
+inline bool StartsWith(const std::string &text, size_t pos, const char *prefix)
+{
+    return text.compare(pos, std::char_traits<char>::length(prefix), prefix) == 0;
+}
+
+inline size_t CountRun(const std::string &text, size_t pos, uint16_t mask, size_t limit)
+{
+    size_t count = 0;
+    while (count < limit && Is(text, pos + count, mask)) {
+        ++count;
+    }
+    return count;
+}
+} // namespace
+
+uint32_t PatternScanner::Scan(const std::string &text, uint32_t wanted)
+{
+    uint32_t pending = wanted & ALL_MASK;
+    auto wants = [&pending](uint32_t id) {
+        return (pending & (1u << id)) != 0;
+    };
+    auto mark = [&pending](uint32_t id, bool matched) {
+        if (matched) {
+            pending &= ~(1u << id);
+        }
+    };
+    // every matcher is anchored on a trigger character, so one walk over the text serves all of them
+    for (size_t pos = 0; pos < text.size() && pending != 0; ++pos) {
+        char c = text[pos];
+        if (wants(NUMBER)) {
+            mark(NUMBER, Is(text, pos, CLASS_DIGIT));
+        }
+        if (c == ':' && wants(URL)) {
+            mark(URL, MatchUrlAt(text, pos));
+        }
+        if (c == '@' && wants(EMAIL_ADDRESS)) {
+            mark(EMAIL_ADDRESS, MatchEmailAt(text, pos));
+        }
+        if (c == 'h' && wants(HTTP_URL)) {
+            mark(HTTP_URL, MatchHttpUrlAt(text, pos));
+        }
+        if (wants(FLIGHT_NUMBER)) {
+            mark(FLIGHT_NUMBER, MatchFlightNumberAt(text, pos));
+        }
+    }
+    return (wanted & ALL_MASK) & ~pending;
+}
+
+// [a-zA-Z0-9+.-]+://[-a-zA-Z0-9+&@#/%?=~_|!:,.;]*[-a-zA-Z0-9+&@#/%=~_], pos is the ':'
+bool PatternScanner::MatchUrlAt(const std::string &text, size_t pos)
+{
+    if (pos == 0 || !Is(text, pos - 1, CLASS_URL_SCHEME) || !StartsWith(text, pos, "://")) {
+        return false;
+    }
+    // the body run has to contain an end character, the backtracking regex then ends on the last one
+    for (size_t cur = pos + SCHEME_SEPARATOR_LENGTH; Is(text, cur, CLASS_URL_BODY); ++cur) {
+        if (Is(text, cur, CLASS_URL_END)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// local part of at least one character right before the '@', then a domain followed by a tail
+bool PatternScanner::MatchEmailAt(const std::string &text, size_t pos)
+{
+    if (pos == 0 || !Is(text, pos - 1, CLASS_EMAIL_LOCAL)) {
+        return false;
+    }
+    return MatchEmailDomain(text, pos + 1) || MatchEmailIpDomain(text, pos + 1);
+}
+
+// [a-zA-Z0-9\-]+(?:\.[a-zA-Z0-9\-]+)* ending anywhere the tail can start
+bool PatternScanner::MatchEmailDomain(const std::string &text, size_t pos)
+{
+    for (size_t cur = pos; cur < text.size(); ++cur) {
+        if (text[cur] == '.') {
+            if (cur == pos || text[cur - 1] == '.') {
+                return false;
+            }
+            continue;
+        }
+        if (!Is(text, cur, CLASS_EMAIL_DOMAIN)) {
+            return false;
+        }
+        if (MatchEmailTail(text, cur + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// \[([0-9]{1,3}\.){3}[0-9]{1,3}\] followed by the tail
+bool PatternScanner::MatchEmailIpDomain(const std::string &text, size_t pos)
+{
+    if (pos >= text.size() || text[pos] != '[') {
+        return false;
+    }
+    size_t cur = pos + 1;
+    for (size_t group = 0; group < IP_GROUPS; ++group) {
+        size_t digits = CountRun(text, cur, CLASS_DIGIT, IP_MAX_DIGITS + 1);
+        if (digits == 0 || digits > IP_MAX_DIGITS) {
+            return false;
+        }
+        cur += digits;
+        char separator = group + 1 < IP_GROUPS ? '.' : ']';
+        if (cur >= text.size() || text[cur] != separator) {
+            return false;
+        }
+        ++cur;
+    }
+    return MatchEmailTail(text, cur);
+}
+
+// ([a-zA-Z]{1,}|[0-9]{1,3}|\.[a-zA-Z0-9\-]+), one character of each branch is enough for a match
+bool PatternScanner::MatchEmailTail(const std::string &text, size_t pos)
+{
+    if (Is(text, pos, CLASS_ALPHA | CLASS_DIGIT)) {
+        return true;
+    }
+    return pos < text.size() && text[pos] == '.' && Is(text, pos + 1, CLASS_EMAIL_DOMAIN);
+}
+
+// (?:^|\s+)https?://[^\s]+, pos is the 'h'. A match is at least "http://x" long, so the minimum length
+// DetectPlainText asks for always holds
+bool PatternScanner::MatchHttpUrlAt(const std::string &text, size_t pos)
+{
+    if (pos != 0 && !Is(text, pos - 1, CLASS_SPACE)) {
+        return false;
+    }
+    size_t prefix = 0;
+    if (StartsWith(text, pos, HTTPS_PREFIX)) {
+        prefix = std::char_traits<char>::length(HTTPS_PREFIX);
+    } else if (StartsWith(text, pos, HTTP_PREFIX)) {
+        prefix = std::char_traits<char>::length(HTTP_PREFIX);
+    } else {
+        return false;
+    }
+    return pos + prefix < text.size() && !Is(text, pos + prefix, CLASS_SPACE);
+}
+
+// \b([A-Z]{2}|[0-9][A-Z])\d{3,4}[A-Z]?\b, every match is 5 to 7 characters long as DetectPlainText asks for
+bool PatternScanner::MatchFlightNumberAt(const std::string &text, size_t pos)
+{
+    if (pos != 0 && Is(text, pos - 1, CLASS_WORD)) {
+        return false;
+    }
+    if (!Is(text, pos, CLASS_DIGIT | CLASS_UPPER) || !Is(text, pos + 1, CLASS_UPPER)) {
+        return false;
+    }
+    size_t digitsStart = pos + FLIGHT_PREFIX_LENGTH;
+    size_t digits = CountRun(text, digitsStart, CLASS_DIGIT, FLIGHT_MAX_DIGITS);
+    for (size_t taken = digits; taken >= FLIGHT_MIN_DIGITS; --taken) {
+        size_t end = digitsStart + taken;
+        if (Is(text, end, CLASS_UPPER) && !Is(text, end + 1, CLASS_WORD)) {
+            return true;
+        }
+        if (!Is(text, end, CLASS_WORD)) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace OHOS::MiscServices
@@ -14,13 +14,16 @@
  */
 #include "pasteboard_service.h"
 
-#include <dlfcn.h>
 #include <sys/mman.h>
 
 #include "ashmem.h"
+#include "ashmem_pool.h"
 #include "accesstoken_kit.h"
 #include "account_manager.h"
 #include "calculate_time_consuming.h"
+#include "clip/clip_event_codec.h"
+#include "clip/clip_frame_transfer.h"
+#include "clip/clip_payload_codec.h"
 #include "common_event_manager.h"
 #include "device/dev_profile.h"
 #include "distributed_file_daemon_manager.h"
@@ -89,9 +92,6 @@ constexpr int32_t INIT_INTERVAL = 10000L;
 constexpr uint32_t MAX_IPC_THREAD_NUM = 32;
 constexpr const char *PASTEBOARD_SERVICE_SA_NAME = "pasteboard_service";
 constexpr const char *PASTEBOARD_SERVICE_NAME = "PasteboardService";
-constexpr const char *NLU_SO_PATH = "libai_nlu_innerapi.z.so";
-constexpr const char *SSL_SO_PATH = "libcrypto_openssl.z.so";
-constexpr const char *GET_PASTE_DATA_PROCESSOR = "GetPasteDataProcessor";
 constexpr const char *FAIL_TO_GET_TIME_STAMP = "FAIL_TO_GET_TIME_STAMP";
 constexpr const char *SECURE_PASTE_PERMISSION = "ohos.permission.SECURE_PASTE";
 constexpr const char *READ_PASTEBOARD_PERMISSION = "ohos.permission.READ_PASTEBOARD";
@@ -142,10 +142,18 @@ PasteboardService::PasteboardService(): SystemAbility(PASTEBOARD_SERVICE_ID, tru
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "PasteboardService Start.");
     PasteboardService::state_ = ServiceRunningState::STATE_NOT_START;
     p2pEstablishInfo_.pasteBlock = nullptr;
+    observerDispatcher_ = std::make_shared<PasteboardObserverDispatcher>([](std::function<void()> task) {
+        FFRTUtils::SubmitTask(task);
+    });
+    entityEngine_ = std::make_unique<PasteboardEntityEngine>(PasteboardEntityEngine::CreateNluBackend(),
+        [this](const std::string &primaryText, const std::string &entity) {
+            OnEntityRecognized(primaryText, entity);
+        });
 }
 
 PasteboardService::~PasteboardService()
 {
+    entityEngine_->Stop();
     clients_.Clear();
     UnsubscribeAllEntityObserver();
 }
@@ -208,6 +216,7 @@ void PasteboardService::OnStart()
     int64_t maxLocalCapacity =
         (capacity >= MIN_LOCAL_CAPACITY && capacity <= MAX_LOCAL_CAPACITY) ? capacity : DEFAULT_LOCAL_CAPACITY;
     maxLocalCapacity_.store(maxLocalCapacity * SIZE_K * SIZE_K);
+    sealedClipStore_.store(OHOS::system::GetBoolParameter("const.pasteboard.sealed_clip_store", false));
     moduleConfig_.Init();
     moduleConfig_.Watch(std::bind(&PasteboardService::OnConfigChange, this, std::placeholders::_1));
     ffrtTimer_ = FFRTPool::GetTimer("pasteboard_service");
@@ -351,7 +360,15 @@ void PasteboardService::DelayGetterDeathRecipient::OnRemoteDied(const wptr<IRemo
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start");
     (void)remote;
-    service_.NotifyDelayGetterDied(userId_);
+    // the getter of a superseded set is watched until its recipient is removed, it must not drop the current one
+    bool isCurrent = false;
+    service_.delayGetters_.ComputeIfPresent(userId_, [this, &isCurrent](auto, auto &getter) {
+        isCurrent = getter.second.GetRefPtr() == this;
+        return true;
+    });
+    if (isCurrent) {
+        service_.NotifyDelayGetterDied(userId_);
+    }
 }
 
 void PasteboardService::NotifyDelayGetterDied(int32_t userId)
@@ -373,7 +390,15 @@ void PasteboardService::EntryGetterDeathRecipient::OnRemoteDied(const wptr<IRemo
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start");
     (void)remote;
-    service_.NotifyEntryGetterDied(userId_);
+    // the getter of a superseded set is watched until its recipient is removed, it must not drop the current one
+    bool isCurrent = false;
+    service_.entryGetters_.ComputeIfPresent(userId_, [this, &isCurrent](auto, auto &getter) {
+        isCurrent = getter.second.GetRefPtr() == this;
+        return true;
+    });
+    if (isCurrent) {
+        service_.NotifyEntryGetterDied(userId_);
+    }
 }
 
 void PasteboardService::NotifyEntryGetterDied(int32_t userId)
@@ -539,6 +564,7 @@ int32_t PasteboardService::ClearInner(int32_t userId, const AppInfo &appInfo)
     if (hasData) {
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "ClearInner: found data for userId=%{public}d, erasing", userId);
         clips_.Erase(userId);
+        InvalidateClipCache(userId);
         delayDataId_ = 0;
         delayTokenId_ = 0;
     }
@@ -677,36 +703,10 @@ int32_t PasteboardService::ExtractEntity(const std::string &entity, std::string
     return static_cast<int32_t>(PasteboardError::NO_DATA_ERROR);
 }
 
-void PasteboardService::OnRecognizePasteData(const std::string &primaryText)
-{
-    PasteBoardCommonUtils::SetTaskName("PasteDataRecognize");
-    std::lock_guard lock(entityRecognizeMutex_);
-    auto nulHandle = dlopen(NLU_SO_PATH, RTLD_NOW);
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(nulHandle != nullptr, PASTEBOARD_MODULE_SERVICE, "Can not get AIEngine handle");
-    std::unique_ptr<void, decltype(&dlclose)> nulGuard(nulHandle, dlclose);
-
-    auto sslHandle = dlopen(SSL_SO_PATH, RTLD_NOW);
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(sslHandle != nullptr, PASTEBOARD_MODULE_SERVICE, "Can not get SSL handle");
-    std::unique_ptr<void, decltype(&dlclose)> sslGuard(sslHandle, dlclose);
-
-    auto cleanSSL = reinterpret_cast<GetProcessorFunc>(dlsym(sslHandle, "OPENSSL_cleanup"));
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(cleanSSL != nullptr, PASTEBOARD_MODULE_SERVICE, "Can not get cleanSSL");
-
-    OnRecognizePasteDataInner(primaryText, nulHandle);
-    cleanSSL();
-}
-
-void PasteboardService::OnRecognizePasteDataInner(const std::string &primaryText, void *nulHandle)
+void PasteboardService::OnEntityRecognized(const std::string &primaryText, const std::string &entity)
 {
-    GetProcessorFunc GetProcessor = reinterpret_cast<GetProcessorFunc>(dlsym(nulHandle, GET_PASTE_DATA_PROCESSOR));
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(GetProcessor != nullptr, PASTEBOARD_MODULE_SERVICE, "Can not get ProcessorFunc");
-
-    IPasteDataProcessor &processor = GetProcessor();
-    std::string entity = "";
-    int32_t result = processor.Process(primaryText, entity);
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(
-        result == ERR_OK, PASTEBOARD_MODULE_SERVICE, "AI Process failed, result=%{public}d", result);
-
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(PasteboardService::state_ == ServiceRunningState::STATE_RUNNING,
+        PASTEBOARD_MODULE_SERVICE, "PasteboardService is not running.");
     std::string location = "";
     int32_t ret = ExtractEntity(entity, location);
     PASTEBOARD_CHECK_AND_RETURN_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK),
@@ -725,16 +725,7 @@ void PasteboardService::RecognizePasteData(PasteData &pasteData)
     if (primaryText.empty()) {
         return;
     }
-    FFRTTask task = [this, primaryText]() {
-        std::thread thread([=]() {
-            PASTEBOARD_CHECK_AND_RETURN_LOGE(PasteboardService::state_ == ServiceRunningState::STATE_RUNNING,
-                PASTEBOARD_MODULE_SERVICE, "PasteboardService is not running.");
-            OnRecognizePasteData(primaryText);
-        });
-        PasteBoardCommonUtils::SetThreadTaskName(thread, "RecognizePaste");
-        thread.detach();
-    };
-    FFRTUtils::SubmitTask(task);
+    entityEngine_->Recognize(primaryText);
 }
 
 int32_t PasteboardService::SubscribeEntityObserver(
@@ -845,8 +836,7 @@ int32_t PasteboardService::GetRecordValueByType(uint32_t dataId, uint32_t record
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr,
             static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR),
             PASTEBOARD_MODULE_SERVICE, "Failed to get raw data, size=%{public}" PRId64, rawDataSize);
-        std::vector<uint8_t> pasteDataTlv(rawData, rawData + rawDataSize);
-        ret = entryValue.Decode(pasteDataTlv);
+        ret = entryValue.Decode(rawData, static_cast<size_t>(rawDataSize));
         ::munmap(ptr, rawDataSize);
     } else {
         ret = entryValue.Decode(buffer);
@@ -882,10 +872,10 @@ int32_t PasteboardService::GetRecordValueByType(int64_t &rawDataSize,
         }
         std::vector<uint8_t>().swap(entryValueTLV);
     } else {
-        fd = AshmemCreate("PasteboardTmpAshmem", 1);
+        fd = AshmemPool::GetInstance().DupPlaceholder();
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0,
             static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR),
-            PASTEBOARD_MODULE_SERVICE, "ashmem create failed");
+            PASTEBOARD_MODULE_SERVICE, "placeholder fd failed");
         fdsan_exchange_owner_tag(fd, 0, PASTEBOARD_FD_TAG);
         buffer = std::move(entryValueTLV);
     }
@@ -1223,29 +1213,39 @@ int32_t PasteboardService::ShowProgress(const std::string &progressKey, const sp
     return ERR_OK;
 }
 
-bool PasteboardService::WriteRawData(const void *data, int64_t size, int &serFd)
+void *PasteboardService::MapRawDataAshmem(int64_t size, int &fd)
 {
-    MessageParcelWarp messageData;
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr, false, PASTEBOARD_MODULE_SERVICE, "data is null");
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(0 < size && size <= messageData.GetRawDataSize(), false,
-        PASTEBOARD_MODULE_SERVICE, "size invalid, size:%{public}" PRId64, size);
-
-    int fd = AshmemCreate("WriteRawData Ashmem", size);
-    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, false, PASTEBOARD_MODULE_SERVICE, "ashmem create failed");
+    fd = AshmemCreate("WriteRawData Ashmem", size);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, nullptr, PASTEBOARD_MODULE_SERVICE, "ashmem create failed");
     fdsan_exchange_owner_tag(fd, 0, PASTEBOARD_FD_TAG);
 
     int32_t result = AshmemSetProt(fd, PROT_READ | PROT_WRITE);
     if (result < 0) {
         fdsan_close_with_tag(fd, PASTEBOARD_FD_TAG);
+        fd = -1;
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "ashmem set prot failed");
-        return false;
+        return nullptr;
     }
     void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
     if (ptr == MAP_FAILED) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "mmap failed, fd:%{public}d", fd);
         fdsan_close_with_tag(fd, PASTEBOARD_FD_TAG);
-        return false;
+        fd = -1;
+        return nullptr;
     }
+    return ptr;
+}
+
+bool PasteboardService::WriteRawData(const void *data, int64_t size, int &serFd)
+{
+    MessageParcelWarp messageData;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr, false, PASTEBOARD_MODULE_SERVICE, "data is null");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(0 < size && size <= messageData.GetRawDataSize(), false,
+        PASTEBOARD_MODULE_SERVICE, "size invalid, size:%{public}" PRId64, size);
+
+    int fd = -1;
+    void *ptr = MapRawDataAshmem(size, fd);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ptr != nullptr, false, PASTEBOARD_MODULE_SERVICE, "map ashmem failed");
     if (!messageData.MemcpyData(ptr, static_cast<size_t>(size), data, size)) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "memcpy_s failed, fd:%{public}d", fd);
         ::munmap(ptr, size);
@@ -1258,6 +1258,27 @@ bool PasteboardService::WriteRawData(const void *data, int64_t size, int &serFd)
     return true;
 }
 
+bool PasteboardService::WriteRawData(const TLVWriteable &value, int64_t size, int &serFd)
+{
+    MessageParcelWarp messageData;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(0 < size && size <= messageData.GetRawDataSize(), false,
+        PASTEBOARD_MODULE_SERVICE, "size invalid, size:%{public}" PRId64, size);
+
+    int fd = -1;
+    void *ptr = MapRawDataAshmem(size, fd);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ptr != nullptr, false, PASTEBOARD_MODULE_SERVICE, "map ashmem failed");
+    bool ret = value.Encode(static_cast<uint8_t *>(ptr), static_cast<size_t>(size));
+    ::munmap(ptr, size);
+    if (!ret) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "encode failed, fd:%{public}d", fd);
+        fdsan_close_with_tag(fd, PASTEBOARD_FD_TAG);
+        return false;
+    }
+    serFd = fd;
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "Encode data end. fd:%{public}d size:%{public}" PRId64, serFd, size);
+    return true;
+}
+
 CommonInfo PasteboardService::GetCommonState(int64_t dataSize)
 {
     CommonInfo commonInfo;
@@ -1318,9 +1339,9 @@ int32_t PasteboardService::GetPasteData(int &fd, int64_t &size, std::vector<uint
     UeReportInfo ueReportInfo;
     int32_t ret = GetPasteDataInner(fd, size, rawData, pasteId, syncTime, ueReportInfo);
     if (fd == -1) {
-        fd = AshmemCreate("GetPasteData Ashmem", 1);
+        fd = AshmemPool::GetInstance().DupPlaceholder();
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR),
-            PASTEBOARD_MODULE_SERVICE, "ashmem create failed");
+            PASTEBOARD_MODULE_SERVICE, "placeholder fd failed");
         fdsan_exchange_owner_tag(fd, 0, PASTEBOARD_FD_TAG);
     }
     ueReportInfo.ret = (ret == static_cast<int32_t>(PasteboardError::E_OK) ? E_OK_OPERATION : ret);
@@ -1380,7 +1401,8 @@ int32_t PasteboardService::GetPasteDataInner(int &fd, int64_t &size, std::vector
     delayDataId_ = data.GetDataId();
     delayTokenId_ = tokenId;
 
-    ret = DealData(fd, size, rawData, data);
+    auto sealed = AttachEncodedRecords(appInfo.userId, data);
+    ret = sealed != nullptr ? DealSealedData(fd, size, rawData, data, *sealed) : DealData(fd, size, rawData, data);
     radarReportInfo.commonInfo = GetCommonState(size);
     PASTE_RADAR_REPORT(DFX_GET_PASTEBOARD, DFX_GET_DATA_INFO, radarReportInfo);
     return ret;
@@ -1389,25 +1411,24 @@ int32_t PasteboardService::GetPasteDataInner(int &fd, int64_t &size, std::vector
 int32_t PasteboardService::DealData(int &fd, int64_t &size, std::vector<uint8_t> &rawData, PasteData &data)
 {
     std::vector<uint8_t> pasteDataTlv(0);
+    int64_t tlvSize = 0;
+    int serviceFd = -1;
     {
         std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
-        if (!data.Encode(pasteDataTlv)) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to encode pastedata in TLV");
+        SerializedCache cacheScope; // pixel maps and wants serialized by Count are reused by Encode
+        tlvSize = static_cast<int64_t>(data.Count());
+        // large payloads are encoded straight into the ashmem handed to the reader
+        bool ret = tlvSize > MIN_ASHMEM_DATA_SIZE ? WriteRawData(data, tlvSize, serviceFd) :
+            data.Encode(tlvSize, pasteDataTlv);
+        if (!ret) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to encode pastedata in TLV, size:%{public}" PRId64,
+                tlvSize);
             HiViewAdapter::ReportUseBehaviour(data, HiViewAdapter::PASTE_STATE, ERR_INVALID_VALUE);
             return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
         }
     }
-    int64_t tlvSize = static_cast<int64_t>(pasteDataTlv.size());
-    int serviceFd = -1;
-    if (tlvSize > MIN_ASHMEM_DATA_SIZE) {
-        bool res = WriteRawData(pasteDataTlv.data(), tlvSize, serviceFd);
-        if (!res) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to WriteRawData:%{public}" PRId64, tlvSize);
-            return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
-        }
-        pasteDataTlv.clear();
-    } else {
-        serviceFd = AshmemCreate("DealData Ashmem", 1);
+    if (tlvSize <= MIN_ASHMEM_DATA_SIZE) {
+        serviceFd = AshmemPool::GetInstance().DupPlaceholder();
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(serviceFd >= 0,
             static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR),
             PASTEBOARD_MODULE_SERVICE, "create fd failed");
@@ -1421,6 +1442,98 @@ int32_t PasteboardService::DealData(int &fd, int64_t &size, std::vector<uint8_t>
     return ERR_OK;
 }
 
+int32_t PasteboardService::DealSealedData(int &fd, int64_t &size, std::vector<uint8_t> &rawData, PasteData &data,
+    const SealedAshmem &sealed)
+{
+    std::vector<uint8_t> envelope(0);
+    bool ret = false;
+    {
+        std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+        // the records go in the sealed region, only the per-reader fields are encoded for this paste
+        data.SetEncodedRecords(std::make_shared<const std::vector<uint8_t>>());
+        ret = data.Encode(envelope) && static_cast<int64_t>(envelope.size()) <= MIN_ASHMEM_DATA_SIZE;
+    }
+    if (!ret) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "envelope not sent inline, size:%{public}zu", envelope.size());
+        data.SetEncodedRecords(nullptr);
+        return DealData(fd, size, rawData, data);
+    }
+    int sealedFd = sealed.Dup();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(sealedFd >= 0, static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "dup sealed fd failed");
+    fdsan_exchange_owner_tag(sealedFd, 0, PASTEBOARD_FD_TAG);
+    size = static_cast<int64_t>(sealed.GetSize());
+    fd = sealedFd;
+    rawData = std::move(envelope);
+    HiViewAdapter::ReportUseBehaviour(data, HiViewAdapter::PASTE_STATE, ERR_OK);
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "DealSealedData fd:%{public}d, size:%{public}" PRId64 ", "
+        "envelope:%{public}zu", fd, size, rawData.size());
+    return ERR_OK;
+}
+
+std::shared_ptr<const SealedAshmem> PasteboardService::AttachEncodedRecords(int32_t userId, PasteData &data)
+{
+    auto [hasData, stored] = clips_.Find(userId);
+    if (!hasData || stored == nullptr || stored->IsRemote() || data.IsRemote() || stored->IsDelayData() ||
+        stored->IsDelayRecord() || stored->GetDataId() != data.GetDataId()) {
+        return nullptr;
+    }
+    // CheckUriPermission clears a local convert uri for some readers only, such records differ per reader
+    for (const auto &record : stored->AllRecords()) {
+        if (record != nullptr && !record->isConvertUriFromRemote && !record->GetConvertUri().empty()) {
+            return nullptr;
+        }
+    }
+    // in-place writers of a stored clip hold the write lock and invalidate under it, so an entry built and
+    // published under the read lock never outlives the content it was encoded from
+    std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+    auto [hasEncoded, encoded] = encodedClips_.Find(userId);
+    if (!hasEncoded || encoded.source != stored) {
+        encoded = EncodedClip{ stored, nullptr, nullptr };
+        size_t recordsSize = sealedClipStore_.load() ? stored->CountRecordsTLV() : 0;
+        if (recordsSize > static_cast<size_t>(MIN_ASHMEM_DATA_SIZE)) {
+            // one region for the clip, every reader maps it instead of getting a copy of its own
+            encoded.sealed = SealedAshmem::Create(recordsSize, [&stored](uint8_t *buffer, size_t size) {
+                return stored->EncodeRecordsTLV(buffer, size);
+            });
+        }
+        if (encoded.sealed == nullptr) {
+            encoded.records = stored->EncodeRecordsTLV();
+        }
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(encoded.records != nullptr || encoded.sealed != nullptr, nullptr,
+            PASTEBOARD_MODULE_SERVICE, "encode records failed, userId=%{public}d", userId);
+        encodedClips_.InsertOrAssign(userId, encoded);
+    }
+    if (encoded.sealed != nullptr) {
+        return encoded.sealed;
+    }
+    data.SetEncodedRecords(encoded.records);
+    return nullptr;
+}
+
+void PasteboardService::InvalidateClipCache(int32_t userId)
+{
+    encodedClips_.Erase(userId);
+    typeIndexes_.Erase(userId);
+}
+
+std::shared_ptr<const PasteDataTypeIndex> PasteboardService::GetTypeIndex(int32_t userId,
+    const std::shared_ptr<PasteData> &clip)
+{
+    auto [hasIndex, cached] = typeIndexes_.Find(userId);
+    if (hasIndex && cached.source == clip && cached.index != nullptr) {
+        return cached.index;
+    }
+    // same publishing rule as AttachEncodedRecords, the read lock orders it against in-place writers
+    std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+    auto index = clip->BuildTypeIndex();
+    auto [hasStored, stored] = clips_.Find(userId);
+    if (hasStored && stored == clip) {
+        typeIndexes_.InsertOrAssign(userId, ClipTypeIndex{ clip, index });
+    }
+    return index;
+}
+
 void PasteboardService::AddPermissionRecord(uint32_t tokenId, bool isReadGrant, bool isSecureGrant)
 {
     if (AccessTokenKit::GetTokenTypeFlag(tokenId) != TOKEN_HAP) {
@@ -1664,8 +1777,8 @@ int32_t PasteboardService::GetRemoteData(int32_t userId, const Event &event, Pas
         int32_t ret = distRet == static_cast<int32_t>(PasteboardError::E_OK) ?
             static_cast<int32_t>(PasteboardError::INVALID_EVENT_ERROR) : distRet;
         auto it = clips_.Find(userId);
-        if (it.first) {
-            data = *it.second;
+        if (it.first && it.second != nullptr) {
+            SnapshotClip(*(it.second), data);
             ret = static_cast<int32_t>(PasteboardError::E_OK);
         }
         taskMgr_.ClearRemoteDataTask(event);
@@ -1686,6 +1799,7 @@ int32_t PasteboardService::GetRemotePasteData(int32_t userId, const Event &event
             result.first->SetRemote(true);
             if (distEvt == event) {
                 clips_.InsertOrAssign(userId, result.first);
+                InvalidateClipCache(userId);
                 IncreaseChangeCount(userId);
                 auto curTime =
                     static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
@@ -1732,14 +1846,14 @@ int32_t PasteboardService::GetLocalData(const AppInfo &appInfo, PasteData &data)
             "appInfo.userId = %{public}d", ret, appInfo.userId);
         return ret;
     }
-    data = *(it.second);
+    SnapshotClip(*(it.second), data);
     auto originBundleName = it.second->GetBundleName();
     if (it.second->IsDelayData()) {
         GetDelayPasteData(appInfo.userId, data);
         RADAR_REPORT(DFX_GET_PASTEBOARD, DFX_CHECK_GET_DELAY_PASTE, DFX_SUCCESS, CONCURRENT_ID, pasteId);
     }
     if (it.second->IsDelayRecord()) {
-        GetDelayPasteRecord(appInfo.userId, data);
+        GetDelayPasteRecord(appInfo.userId, data, DelayManager::ENTRY_FETCH_TIMEOUT_MS);
     }
     data.SetBundleInfo(appInfo.bundleName, appInfo.appIndex);
     auto result = copyTime_.Find(appInfo.userId);
@@ -1769,6 +1883,23 @@ int32_t PasteboardService::GetLocalData(const AppInfo &appInfo, PasteData &data)
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
 
+void PasteboardService::SnapshotClip(const PasteData &clip, PasteData &data)
+{
+    if (clip.IsDelayData() || clip.IsDelayRecord()) {
+        data = clip;
+        return;
+    }
+    std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+    data.ShareFrom(clip);
+    // CheckUriPermission clears stale local distributed uris in place, those records get a private copy
+    for (size_t i = 0; i < data.GetRecordCount(); i++) {
+        auto item = data.GetRecordAt(i);
+        if (item != nullptr && !item->isConvertUriFromRemote && !item->GetConvertUri().empty()) {
+            data.DetachRecordAt(i);
+        }
+    }
+}
+
 void PasteboardService::GetDelayPasteData(int32_t userId, PasteData &data)
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "get delay data start");
@@ -1794,7 +1925,7 @@ void PasteboardService::GetDelayPasteData(int32_t userId, PasteData &data)
     });
 }
 
-int32_t PasteboardService::GetDelayPasteRecord(int32_t userId, PasteData &data)
+int32_t PasteboardService::GetDelayPasteRecord(int32_t userId, PasteData &data, uint32_t fetchTimeoutMs)
 {
     auto [hasGetter, getter] = entryGetters_.Find(userId);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(hasGetter && getter.first,
@@ -1804,7 +1935,7 @@ int32_t PasteboardService::GetDelayPasteRecord(int32_t userId, PasteData &data)
     auto delayEntryInfos = DelayManager::GetPrimaryDelayEntryInfo(data);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGI(!delayEntryInfos.empty(), static_cast<int32_t>(PasteboardError::E_OK),
         PASTEBOARD_MODULE_SERVICE, "no delay entry");
-    DelayManager::GetLocalEntryValue(delayEntryInfos, getter.first, data);
+    DelayManager::GetLocalEntryValue(delayEntryInfos, getter.first, data, fetchTimeoutMs);
     {
         std::unique_lock<std::shared_mutex> write(pasteDataMutex_);
         std::string bundleIndex = PasteBoardCommon::GetDirByAuthority(data.GetOriginAuthority());
@@ -2374,14 +2505,10 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
         RADAR_REPORT(DFX_SET_PASTEBOARD, DFX_CHECK_SET_AUTHORITY, DFX_SUCCESS);
         return static_cast<int32_t>(PasteboardError::PROHIBIT_COPY);
     }
-    if (setting_.exchange(true)) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "is setting.");
-        return static_cast<int32_t>(PasteboardError::TASK_PROCESSING);
-    }
+    auto ticket = setSequencer_.Begin();
     CalculateTimeConsuming::SetBeginTime();
     auto appInfo = GetAppInfo(tokenId);
     if (appInfo.userId == ERROR_USERID) {
-        setting_.store(false);
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "userId invalid.");
         return static_cast<int32_t>(PasteboardError::INVALID_USERID_ERROR);
     }
@@ -2397,32 +2524,62 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
     if (hasSplited || dataSize > static_cast<int64_t>(maxLocalCapacity_.load() * RECALCULATE_DATA_SIZE)) {
         int64_t newDataSize = static_cast<int64_t>(pasteData.Count());
         if (newDataSize > maxLocalCapacity_.load()) {
-            setting_.store(false);
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "invalid data size, dataSize=%{public}" PRId64, newDataSize);
             return static_cast<int32_t>(PasteboardError::INVALID_DATA_SIZE);
         }
         pasteData.rawDataSize_ = newDataSize;
     }
-    setPasteDataUId_.store(IPCSkeleton::GetCallingUid());
-    RemovePasteData(appInfo);
-    clips_.InsertOrAssign(appInfo.userId, std::make_shared<PasteData>(pasteData));
-    IncreaseChangeCount(appInfo.userId);
+    auto snapshot = std::make_shared<PasteData>();
+    snapshot->ShareFrom(pasteData);
+    auto typeIndex = snapshot->BuildTypeIndex();
+    auto callingUid = IPCSkeleton::GetCallingUid();
+    // adding and removing death recipients are IPCs, they stay out of the commit
+    auto getters = HandleDelayDataAndRecord(pasteData, delayGetter, entryGetter, appInfo);
+    ClipGetters previous;
+    bool committed = setSequencer_.Commit(appInfo.userId, ticket, [&]() {
+        setPasteDataUId_.store(callingUid);
+        previous = SwapClipGetters(appInfo.userId, getters);
+        clips_.InsertOrAssign(appInfo.userId, snapshot);
+        InvalidateClipCache(appInfo.userId);
+        typeIndexes_.InsertOrAssign(appInfo.userId, ClipTypeIndex{ snapshot, typeIndex });
+        IncreaseChangeCount(appInfo.userId);
+        copyTime_.InsertOrAssign(appInfo.userId, static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs()));
+    });
+    RemoveDeathRecipients(committed ? previous : getters);
+    if (!committed) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "superseded by a later set, userId=%{public}d", appInfo.userId);
+        return static_cast<int32_t>(PasteboardError::SET_DATA_SUPERSEDED);
+    }
+    if (previous.delayGetter.first != nullptr) {
+        RADAR_REPORT(DFX_SET_PASTEBOARD, DFX_CHECK_SET_DELAY_COPY, DFX_SUCCESS, COVER_DELAY_DATA, DFX_SUCCESS);
+    }
     RadarReportInfo radarReportInfo;
     radarReportInfo.stageRes = static_cast<int32_t>(pasteData.IsDelayData());
     radarReportInfo.bundleName = appInfo.bundleName;
     radarReportInfo.description = pasteData.GetReportDescription();
     radarReportInfo.commonInfo = GetCommonState(dataSize);
     COPY_RADAR_REPORT(DFX_SET_PASTEBOARD, DFX_CHECK_SET_DELAY_COPY, radarReportInfo);
-    HandleDelayDataAndRecord(pasteData, delayGetter, entryGetter, appInfo);
-    auto curTime = static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
-    copyTime_.InsertOrAssign(appInfo.userId, curTime);
     SetDataExpirationTimer(appInfo.userId);
-    if (!(pasteData.IsDelayData())) {
-        SetDistributedData(appInfo.userId, pasteData);
-        NotifyObservers(appInfo.bundleName, appInfo.userId, PasteboardEventStatus::PASTEBOARD_WRITE);
+    // the stages run without a lock, whatever they would hand out after a later set committed is dropped
+    auto isLatest = [this, userId = appInfo.userId, ticket]() {
+        return setSequencer_.IsLatest(userId, ticket);
+    };
+    bool published = setSequencer_.Publish(appInfo.userId, ticket, [&]() {
+        if (!(pasteData.IsDelayData())) {
+            SetDistributedData(appInfo.userId, pasteData, isLatest);
+            if (isLatest()) {
+                NotifyObservers(appInfo.bundleName, appInfo.userId, PasteboardEventStatus::PASTEBOARD_WRITE);
+            }
+        }
+        if (entityObserverMap_.Size() != 0 && pasteData.HasMimeType(MIMETYPE_TEXT_PLAIN) && isLatest()) {
+            RecognizePasteData(pasteData);
+        }
+    });
+    if (!published) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "superseded before publish, userId=%{public}d", appInfo.userId);
+        return static_cast<int32_t>(PasteboardError::SET_DATA_SUPERSEDED);
     }
     SetPasteDataDot(pasteData, appInfo.userId);
-    setting_.store(false);
     SubscribeKeyboardEvent();
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
@@ -2432,6 +2589,7 @@ void PasteboardService::ClearAgedData(int32_t userId)
     auto data = clips_.Find(userId);
     if (data.first) {
         clips_.Erase(userId);
+        InvalidateClipCache(userId);
         delayDataId_ = 0;
         delayTokenId_ = 0;
     }
@@ -2481,20 +2639,50 @@ void PasteboardService::SetPasteDataInfo(PasteData &pasteData, const AppInfo &ap
     }
 }
 
-void PasteboardService::HandleDelayDataAndRecord(PasteData &pasteData, const sptr<IPasteboardDelayGetter> delayGetter,
-    const sptr<IPasteboardEntryGetter> entryGetter, const AppInfo &appInfo)
+PasteboardService::ClipGetters PasteboardService::HandleDelayDataAndRecord(PasteData &pasteData,
+    const sptr<IPasteboardDelayGetter> delayGetter, const sptr<IPasteboardEntryGetter> entryGetter,
+    const AppInfo &appInfo)
 {
+    ClipGetters getters;
     if (pasteData.IsDelayData() && delayGetter != nullptr) {
         sptr<DelayGetterDeathRecipient> deathRecipient = new (std::nothrow)
             DelayGetterDeathRecipient(appInfo.userId, *this);
         delayGetter->AsObject()->AddDeathRecipient(deathRecipient);
-        delayGetters_.InsertOrAssign(appInfo.userId, std::make_pair(delayGetter, deathRecipient));
+        getters.delayGetter = std::make_pair(delayGetter, deathRecipient);
     }
     if (pasteData.IsDelayRecord() && entryGetter != nullptr) {
         sptr<EntryGetterDeathRecipient> deathRecipient = new (std::nothrow)
             EntryGetterDeathRecipient(appInfo.userId, *this);
         entryGetter->AsObject()->AddDeathRecipient(deathRecipient);
-        entryGetters_.InsertOrAssign(appInfo.userId, std::make_pair(entryGetter, deathRecipient));
+        getters.entryGetter = std::make_pair(entryGetter, deathRecipient);
+    }
+    return getters;
+}
+
+// installs the getters of the clip being committed and returns those of the clip it replaces
+PasteboardService::ClipGetters PasteboardService::SwapClipGetters(int32_t userId, const ClipGetters &getters)
+{
+    ClipGetters previous;
+    delayGetters_.Compute(userId, [&previous, &getters](auto, auto &delayGetter) {
+        previous.delayGetter = std::move(delayGetter);
+        delayGetter = getters.delayGetter;
+        return delayGetter.first != nullptr;
+    });
+    entryGetters_.Compute(userId, [&previous, &getters](auto, auto &entryGetter) {
+        previous.entryGetter = std::move(entryGetter);
+        entryGetter = getters.entryGetter;
+        return entryGetter.first != nullptr;
+    });
+    return previous;
+}
+
+void PasteboardService::RemoveDeathRecipients(const ClipGetters &getters)
+{
+    if (getters.delayGetter.first != nullptr && getters.delayGetter.second != nullptr) {
+        getters.delayGetter.first->AsObject()->RemoveDeathRecipient(getters.delayGetter.second);
+    }
+    if (getters.entryGetter.first != nullptr && getters.entryGetter.second != nullptr) {
+        getters.entryGetter.first->AsObject()->RemoveDeathRecipient(getters.entryGetter.second);
     }
 }
 
@@ -2513,6 +2701,10 @@ int32_t PasteboardService::GetMimeTypes(std::vector<std::string> &funcResult)
     if (GetScreenStatus(userId) == ScreenEvent::ScreenUnlocked) {
         auto [distRet, distEvt] = GetValidDistributeEvent(userId);
         if (distRet == static_cast<int32_t>(PasteboardError::E_OK)) {
+            if (distEvt.HasTypeInfo()) {
+                funcResult = distEvt.dataType;
+                return ERR_OK;
+            }
             if (distEvt.version != ClipPlugin::InfoType::DEFAULT) {
                 return GetRemoteMimeTypes(funcResult, distEvt);
             }
@@ -2588,11 +2780,10 @@ bool PasteboardService::HasDataType(const std::string &mimeType)
     if (GetScreenStatus(userId) == ScreenEvent::ScreenUnlocked) {
         auto [distRet, distEvt] = GetValidDistributeEvent(userId);
         if (distRet == static_cast<int32_t>(PasteboardError::E_OK)) {
-            auto it = std::find(distEvt.dataType.begin(), distEvt.dataType.end(), mimeType);
-            if (it != distEvt.dataType.end()) {
+            if (distEvt.HasMimeType(mimeType)) {
                 return true;
             }
-            if (IsBasicType(mimeType)) {
+            if (IsBasicType(mimeType) || distEvt.HasTypeInfo()) {
                 return false;
             }
             if (distEvt.version != ClipPlugin::InfoType::DEFAULT) {
@@ -2625,6 +2816,9 @@ bool PasteboardService::HasUtdType(const std::string &utdType)
     if (screenStatus == ScreenEvent::ScreenUnlocked) {
         auto [distRet, distEvt] = GetValidDistributeEvent(userId);
         if (distRet == static_cast<int32_t>(PasteboardError::E_OK)) {
+            if (distEvt.HasTypeInfo()) {
+                return distEvt.HasUtdType(utdType);
+            }
             int32_t syncTime = 0;
             if (GetRemoteData(userId, distEvt, data, syncTime) != static_cast<int32_t>(PasteboardError::E_OK)) {
                 return false;
@@ -2658,7 +2852,7 @@ bool PasteboardService::HasUtdType(const std::string &utdType)
             screenStatus, it.second->GetScreenStatus(), userId, utdType.c_str());
         return false;
     }
-    return it.second->HasUtdType(utdType);
+    return GetTypeIndex(userId, it.second)->HasUtdType(utdType);
 }
 
 int32_t PasteboardService::DetectPatterns(const std::vector<Pattern> &patternsToCheck,
@@ -2709,7 +2903,11 @@ std::pair<int32_t, ClipPlugin::GlobalEvent> PasteboardService::GetValidDistribut
     }
     evt = events[0];
     auto currentEvent = GetCurrentEvent();
-    if (evt.deviceId == DMAdapter::GetInstance().GetLocalNetworkId() || evt.expiration < currentEvent.expiration) {
+    bool isLocalEvent = evt.deviceId == DMAdapter::GetInstance().GetLocalNetworkId();
+    if (!isLocalEvent) {
+        RecordPeerCapability(evt);
+    }
+    if (isLocalEvent || evt.expiration < currentEvent.expiration) {
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "get local data");
         return std::make_pair(static_cast<int32_t>(PasteboardError::GET_LOCAL_DATA), evt);
     }
@@ -2794,7 +2992,7 @@ std::vector<std::string> PasteboardService::GetLocalMimeTypes()
             tokenId, userId, ret);
         return {};
     }
-    return it.second->GetMimeTypes();
+    return GetTypeIndex(userId, it.second)->mimeTypes;
 }
 
 bool PasteboardService::HasLocalDataType(const std::string &mimeType, uint32_t tokenId, int32_t userId)
@@ -2826,9 +3024,7 @@ bool PasteboardService::HasLocalDataType(const std::string &mimeType, uint32_t t
             screenStatus, it.second->GetScreenStatus(), userId, mimeType.c_str());
         return false;
     }
-    std::vector<std::string> mimeTypes = it.second->GetMimeTypes();
-    auto isExistType = std::find(mimeTypes.begin(), mimeTypes.end(), mimeType) != mimeTypes.end();
-    return isExistType;
+    return GetTypeIndex(userId, it.second)->HasMimeType(mimeType);
 }
 
 int32_t PasteboardService::IsRemoteData(bool &funcResult)
@@ -2907,8 +3103,7 @@ int32_t PasteboardService::WritePasteData(
             CloseSharedMemFd(fd);
             return static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR);
         }
-        std::vector<uint8_t> pasteDataTlv(rawData, rawData + rawDataSize);
-        hasData = pasteData.Decode(pasteDataTlv);
+        hasData = pasteData.Decode(rawData, static_cast<size_t>(rawDataSize));
         ::munmap(ptr, rawDataSize);
     } else {
         hasData = pasteData.Decode(buffer);
@@ -2967,8 +3162,9 @@ int32_t PasteboardService::SetPasteData(int fd, int64_t rawDataSize, const std::
         return ERR_OK;
     }
     ret = SaveData(pasteData, rawDataSize, delayGetter, entryGetter);
-    if (entityObserverMap_.Size() != 0 && pasteData.HasMimeType(MIMETYPE_TEXT_PLAIN)) {
-        RecognizePasteData(pasteData);
+    if (ret == static_cast<int32_t>(PasteboardError::SET_DATA_SUPERSEDED)) {
+        // the data of the newer set is on the pasteboard, nothing is reported about this one
+        return ERR_OK;
     }
     ReportUeCopyEvent(pasteData, rawDataSize, ret);
     HiViewAdapter::ReportUseBehaviour(pasteData, HiViewAdapter::COPY_STATE, ret);
@@ -2994,23 +3190,6 @@ int32_t PasteboardService::SetPasteDataOnly(int fd, int64_t rawDataSize, const s
     return SetPasteData(fd, rawDataSize, buffer, nullptr, nullptr);
 }
 
-void PasteboardService::RemovePasteData(const AppInfo &appInfo)
-{
-    delayGetters_.ComputeIfPresent(appInfo.userId, [](auto, auto &delayGetter) {
-        RADAR_REPORT(DFX_SET_PASTEBOARD, DFX_CHECK_SET_DELAY_COPY, DFX_SUCCESS, COVER_DELAY_DATA, DFX_SUCCESS);
-        if (delayGetter.first != nullptr && delayGetter.second != nullptr) {
-            delayGetter.first->AsObject()->RemoveDeathRecipient(delayGetter.second);
-        }
-        return false;
-    });
-    entryGetters_.ComputeIfPresent(appInfo.userId, [](auto, auto &entryGetter) {
-        if (entryGetter.first != nullptr && entryGetter.second != nullptr) {
-            entryGetter.first->AsObject()->RemoveDeathRecipient(entryGetter.second);
-        }
-        return false;
-    });
-}
-
 int32_t PasteboardService::GetCurrentAccountId() const
 {
     if (userContextResolver_ == nullptr) {
@@ -3305,6 +3484,9 @@ void PasteboardService::RemoveSingleObserver(
     PASTEBOARD_HILOGD(
         PASTEBOARD_MODULE_SERVICE, "observers size: %{public}u.", static_cast<unsigned int>(observers->size()));
     auto eraseNum = observers->erase(observer);
+    if (eraseNum != 0) {
+        observerDispatcher_->Remove(observer);
+    }
     RADAR_REPORT(DFX_OBSERVER, DFX_REMOVE_SINGLE_OBSERVER, DFX_SUCCESS);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "observers size = %{public}u, eraseNum = %{public}zu",
         static_cast<unsigned int>(observers->size()), eraseNum);
@@ -3315,6 +3497,7 @@ void PasteboardService::RemoveAllObserver(int32_t userId, ObserverMap &observerM
     std::lock_guard<std::mutex> lock(observerMutex_);
     for (auto it = observerMap.begin(); it != observerMap.end();) {
         if (it->first.first == userId) {
+            RemoveDispatchedObservers(it->second);
             it = observerMap.erase(it);
         } else {
             ++it;
@@ -3541,35 +3724,41 @@ void PasteboardService::NotifyObservers(std::string bundleName, int32_t userId,
     if (hasPid && IsNeedThaw(status)) {
         ThawInputMethod(pid);
     }
-    std::thread thread([this, bundleName, userId, status]() {
+    std::vector<sptr<IPasteboardChangedObserver>> localObservers;
+    std::vector<sptr<IPasteboardChangedObserver>> eventObservers;
+    {
         std::lock_guard<std::mutex> lock(observerMutex_);
-        for (auto &observers : observerLocalChangedMap_) {
-            if (observers.second == nullptr) {
-                PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observerLocalChangedMap_.second is nullptr");
-                continue;
-            }
-            for (const auto &observer : *(observers.second)) {
-                if (status != PasteboardEventStatus::PASTEBOARD_READ && userId == observers.first.first) {
-                    observer->OnPasteboardChanged();
-                }
-            }
+        if (status != PasteboardEventStatus::PASTEBOARD_READ) {
+            localObservers = CollectObservers(observerLocalChangedMap_, [userId](int32_t observerUserId) {
+                return observerUserId == userId;
+            });
         }
-        IPasteboardChangedObserver::PasteboardChangedEvent event;
-        event.status = static_cast<int32_t>(status);
-        event.userId = userId;
-        event.bundleName = bundleName;
-        for (auto &observers : observerEventMap_) {
-            if (observers.second == nullptr) {
-                PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observerEventMap_.second is nullptr");
-                continue;
-            }
-            for (const auto &observer : *(observers.second)) {
-                observer->OnPasteboardEvent(event);
-            }
+        eventObservers = CollectObservers(observerEventMap_, nullptr);
+    }
+    IPasteboardChangedObserver::PasteboardChangedEvent event;
+    event.status = static_cast<int32_t>(status);
+    event.userId = userId;
+    event.bundleName = bundleName;
+    observerDispatcher_->PostChanged(localObservers);
+    observerDispatcher_->PostEvent(eventObservers, event);
+}
+
+std::vector<sptr<IPasteboardChangedObserver>> PasteboardService::CollectObservers(
+    const ObserverMap &observerMap, const std::function<bool(int32_t)> &userFilter)
+{
+    std::vector<sptr<IPasteboardChangedObserver>> result;
+    for (const auto &observers : observerMap) {
+        if (observers.second == nullptr) {
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "observers of userId %{public}d is nullptr",
+                observers.first.first);
+            continue;
         }
-    });
-    PasteBoardCommonUtils::SetThreadTaskName(thread, "NotifyObservers");
-    thread.detach();
+        if (userFilter != nullptr && !userFilter(observers.first.first)) {
+            continue;
+        }
+        result.insert(result.end(), observers.second->begin(), observers.second->end());
+    }
+    return result;
 }
 
 bool PasteboardService::SetPasteboardHistory(HistoryInfo &info)
@@ -4079,6 +4268,32 @@ std::pair<std::shared_ptr<PasteData>, PasteDateResult> PasteboardService::GetDis
         pasteDateResult.errorCode = static_cast<int32_t>(PasteboardError::REMOTE_TASK_ERROR);
         return std::make_pair(nullptr, pasteDateResult);
     }
+    auto [pasteData, result] = event.frameNum > 1 ? GetDistributedFrames(clipPlugin, event, user) :
+        GetDistributedPayload(clipPlugin, event, user);
+    if (pasteData == nullptr) {
+        return std::make_pair(nullptr, result);
+    }
+    SetCurrentEvent(std::move(event));
+    pasteData->SetOriginAuthority(std::make_pair(pasteData->GetBundleName(), pasteData->GetAppIndex()));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "set remote data, dataSize=%{public}" PRId64, pasteData->rawDataSize_);
+    for (size_t i = 0; i < pasteData->GetRecordCount(); i++) {
+        auto item = pasteData->GetRecordAt(i);
+        if (item == nullptr || item->GetConvertUri().empty()) {
+            continue;
+        }
+        if (item->GetOriginUri() == nullptr) {
+            item->SetConvertUri("");
+            continue;
+        }
+        item->isConvertUriFromRemote = true;
+    }
+    return std::make_pair(pasteData, result);
+}
+
+std::pair<std::shared_ptr<PasteData>, PasteDateResult> PasteboardService::GetDistributedPayload(
+    const std::shared_ptr<ClipPlugin> &clipPlugin, const Event &event, int32_t user)
+{
+    PasteDateResult pasteDateResult;
     std::vector<uint8_t> rawData;
     auto result = clipPlugin->GetPasteData(event, rawData);
     if (result.first != 0) {
@@ -4088,34 +4303,132 @@ std::pair<std::shared_ptr<PasteData>, PasteDateResult> PasteboardService::GetDis
         pasteDateResult.errorCode = result.first;
         return std::make_pair(nullptr, pasteDateResult);
     }
-    if (static_cast<int64_t>(rawData.size()) > maxLocalCapacity_.load()) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "remote dataSize exceeded, dataSize=%{public}zu", rawData.size());
+    size_t decodedSize = ClipPayloadCodec::GetDecodedSize(event.payloadVersion, rawData);
+    if (static_cast<int64_t>(decodedSize) > maxLocalCapacity_.load()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "remote dataSize exceeded, dataSize=%{public}zu", decodedSize);
         pasteDateResult.syncTime = 0;
         pasteDateResult.errorCode = static_cast<int32_t>(PasteboardError::REMOTE_DATA_SIZE_EXCEEDED);
         return std::make_pair(nullptr, pasteDateResult);
     }
-    SetCurrentEvent(std::move(event));
+    if (!ClipPayloadCodec::Decode(event.payloadVersion, rawData)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "decode remote payload failed, version=%{public}hhu",
+            event.payloadVersion);
+        pasteDateResult.syncTime = -1;
+        pasteDateResult.errorCode = static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
+        return std::make_pair(nullptr, pasteDateResult);
+    }
     std::shared_ptr<PasteData> pasteData = std::make_shared<PasteData>();
     pasteData->Decode(rawData);
-    pasteData->SetOriginAuthority(std::make_pair(pasteData->GetBundleName(), pasteData->GetAppIndex()));
     pasteData->rawDataSize_ = static_cast<int64_t>(rawData.size());
-    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "set remote data, dataSize=%{public}" PRId64, pasteData->rawDataSize_);
-    for (size_t i = 0; i < pasteData->GetRecordCount(); i++) {
-        auto item = pasteData->GetRecordAt(i);
-        if (item == nullptr || item->GetConvertUri().empty()) {
-            continue;
+    pasteDateResult.syncTime = result.second;
+    pasteDateResult.errorCode = static_cast<int32_t>(PasteboardError::E_OK);
+    return std::make_pair(pasteData, pasteDateResult);
+}
+
+std::pair<std::shared_ptr<PasteData>, PasteDateResult> PasteboardService::GetDistributedFrames(
+    const std::shared_ptr<ClipPlugin> &clipPlugin, const Event &event, int32_t user)
+{
+    PasteDateResult pasteDateResult;
+    auto &transfer = frameTransfer_;
+    std::lock_guard<std::mutex> lock(transfer.mutex);
+    bool isResumed = transfer.reader != nullptr && transfer.event.deviceId == event.deviceId &&
+        transfer.event.seqId == event.seqId && transfer.event.dataId == event.dataId &&
+        PasteBoardTime::GetBootTimeMs() < transfer.keptUntil;
+    if (isResumed) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "resume seqId:%{public}hu from frame %{public}hhu/%{public}hhu",
+            event.seqId, transfer.reader->GetAckedFrames(), event.frameNum);
+    } else {
+        transfer.event = event;
+        transfer.reader = std::make_shared<ClipFrameReader>(event.frameNum);
+        transfer.data = nullptr;
+        transfer.dataSize = 0;
+    }
+    int32_t syncTime = 0;
+    auto fetch = [&clipPlugin, &event, &syncTime](uint8_t frameIndex, std::vector<uint8_t> &frame) {
+        auto result = clipPlugin->GetPasteDataFrame(event, frameIndex, frame);
+        syncTime += result.second;
+        return result.first;
+    };
+    auto decode = [this, &transfer](uint8_t frameIndex, std::vector<uint8_t> &frame) {
+        size_t frameSize = ClipFrameTransfer::GetOpenedSize(frame);
+        if (transfer.dataSize + static_cast<int64_t>(frameSize) > maxLocalCapacity_.load()) {
+            return static_cast<int32_t>(PasteboardError::REMOTE_DATA_SIZE_EXCEEDED);
+        }
+        auto frameData = std::make_shared<PasteData>();
+        if (frameSize == 0 || !ClipFrameTransfer::OpenFrame(frame) || !frameData->Decode(frame) ||
+            (frameIndex != 0 && transfer.data == nullptr)) {
+            return static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
+        }
+        // the first frame carries the envelope, the records of later ones go after its own
+        if (frameIndex == 0) {
+            transfer.data = frameData;
+        } else {
+            transfer.data->AppendRecords(*frameData);
         }
-        if (item->GetOriginUri() == nullptr) {
-            item->SetConvertUri("");
-            continue;
+        transfer.dataSize += static_cast<int64_t>(frameSize);
+        return 0;
+    };
+    int32_t ret = transfer.reader->Read(fetch, decode);
+    if (ret != 0) {
+        bool isExceeded = ret == static_cast<int32_t>(PasteboardError::REMOTE_DATA_SIZE_EXCEEDED);
+        pasteDateResult.syncTime = isExceeded ? 0 : -1;
+        pasteDateResult.errorCode = ret;
+        if (isExceeded || ret == static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "remote frames rejected, ret=%{public}d", ret);
+            DropFrameTransfer(transfer);
+        } else {
+            Reporter::GetInstance().PasteboardFault().Report({ user, "GET_REMOTE_DATA_FAILED" });
+            KeepFrameTransfer(transfer);
         }
-        item->isConvertUriFromRemote = true;
+        return std::make_pair(nullptr, pasteDateResult);
     }
-    pasteDateResult.syncTime = result.second;
+    auto pasteData = transfer.data;
+    pasteData->rawDataSize_ = transfer.dataSize;
+    DropFrameTransfer(transfer);
+    pasteDateResult.syncTime = syncTime;
     pasteDateResult.errorCode = static_cast<int32_t>(PasteboardError::E_OK);
     return std::make_pair(pasteData, pasteDateResult);
 }
 
+void PasteboardService::KeepFrameTransfer(FrameTransfer &transfer)
+{
+    // the frames decoded so far wait for the next paste of this clip, unless they hold too much for too long
+    if (transfer.dataSize > FRAME_RESUME_MAX_SIZE) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "too large to keep, dataSize=%{public}" PRId64,
+            transfer.dataSize);
+        DropFrameTransfer(transfer);
+        return;
+    }
+    transfer.keptUntil = PasteBoardTime::GetBootTimeMs() + FRAME_RESUME_TTL;
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(ffrtTimer_ != nullptr, PASTEBOARD_MODULE_SERVICE, "ffrtTimer_ is null");
+    FFRTTask task = [this]() {
+        std::thread thread([this]() {
+            ClearExpiredFrameTransfer();
+        });
+        PasteBoardCommonUtils::SetThreadTaskName(thread, "ClearFrames");
+        thread.detach();
+    };
+    ffrtTimer_->SetTimer(FRAME_TRANSFER_ID, task, FRAME_RESUME_TTL);
+}
+
+void PasteboardService::DropFrameTransfer(FrameTransfer &transfer)
+{
+    transfer.reader = nullptr;
+    transfer.data = nullptr;
+    transfer.dataSize = 0;
+    transfer.keptUntil = 0;
+}
+
+void PasteboardService::ClearExpiredFrameTransfer()
+{
+    auto &transfer = frameTransfer_;
+    std::lock_guard<std::mutex> lock(transfer.mutex);
+    if (transfer.reader != nullptr && PasteBoardTime::GetBootTimeMs() >= transfer.keptUntil) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "drop kept frames, seqId:%{public}hu", transfer.event.seqId);
+        DropFrameTransfer(transfer);
+    }
+}
+
 bool PasteboardService::IsConstraintEnabled(int32_t user)
 {
     bool isConstraintEnabled = false;
@@ -4152,7 +4465,7 @@ bool PasteboardService::IsNeedLink(PasteData &data)
     return false;
 }
 
-bool PasteboardService::SetDistributedData(int32_t user, PasteData &data)
+bool PasteboardService::SetDistributedData(int32_t user, PasteData &data, const std::function<bool()> &isLatest)
 {
     auto networkId = DMAdapter::GetInstance().GetLocalNetworkId();
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!networkId.empty(), false, PASTEBOARD_MODULE_SERVICE, "networkId is empty.");
@@ -4164,10 +4477,21 @@ bool PasteboardService::SetDistributedData(int32_t user, PasteData &data)
     event.deviceId = networkId;
     event.account = AccountManager::GetInstance().GetCurrentAccount();
     event.status = ClipPlugin::EVT_NORMAL;
-    event.dataType = data.GetMimeTypes();
+    auto typeIndex = data.BuildTypeIndex();
+    event.dataType = typeIndex->mimeTypes;
+    event.utdTypes.assign(typeIndex->utdTypes.begin(), typeIndex->utdTypes.end());
+    std::sort(event.utdTypes.begin(), event.utdTypes.end());
+    event.recordCount = static_cast<uint32_t>(data.GetRecordCount());
     event.isDelay = data.IsDelayRecord();
     event.dataId = data.GetDataId();
-    SetCurrentEvent(event);
+    event.acceptPayloadVersion = ClipPayloadCodec::LATEST;
+    event.acceptEventVersion = ClipEventCodec::LATEST;
+    {
+        std::lock_guard<std::mutex> lock(currentEventMutex_);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGW(isLatest == nullptr || isLatest(), false, PASTEBOARD_MODULE_SERVICE,
+            "superseded, dataId:%{public}u", data.GetDataId());
+        currentEvent_ = event;
+    }
 
     if (IsConstraintEnabled(user) || IsDisallowDistributed()) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "not allowed to send, user:%{public}d", user);
@@ -4179,6 +4503,7 @@ bool PasteboardService::SetDistributedData(int32_t user, PasteData &data)
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "clip plugin is null, dataId:%{public}u", data.GetDataId());
         return false;
     }
+    event.acceptFrames = clipPlugin->IsFrameSupported();
     ShareOption shareOpt = data.GetShareOption();
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(shareOpt != ShareOption::InApp, false, PASTEBOARD_MODULE_SERVICE,
         "data share option is in app, dataId:%{public}u", data.GetDataId());
@@ -4188,14 +4513,18 @@ bool PasteboardService::SetDistributedData(int32_t user, PasteData &data)
     }
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "dataId:%{public}u, seqId:%{public}hu, isDelay:%{public}d,"
         "expiration:%{public}" PRIu64, event.dataId, event.seqId, event.isDelay, event.expiration);
-    return SetCurrentDistributedData(data, event);
+    return SetCurrentDistributedData(data, event, isLatest);
 }
 
-bool PasteboardService::SetCurrentDistributedData(PasteData &data, Event event)
+bool PasteboardService::SetCurrentDistributedData(PasteData &data, Event event,
+    const std::function<bool()> &isLatest)
 {
-    std::thread thread([this, data, event]() mutable {
+    std::thread thread([this, data, event, isLatest]() mutable {
         {
             std::lock_guard<std::mutex> lock(setDistributedMemory_.mutex);
+            // checked under the lock the newer set stores under, so a superseded set never replaces it
+            PASTEBOARD_CHECK_AND_RETURN_LOGW(isLatest == nullptr || isLatest(), PASTEBOARD_MODULE_SERVICE,
+                "superseded, seqId:%{public}hu", event.seqId);
             setDistributedMemory_.latestEvent = event;
             setDistributedMemory_.latestData = std::make_shared<PasteData>(data);
             PASTEBOARD_CHECK_AND_RETURN_LOGD(!setDistributedMemory_.isRunning, PASTEBOARD_MODULE_SERVICE, "running");
@@ -4270,8 +4599,23 @@ bool PasteboardService::SetCurrentData()
     }
     GenerateDistributedUri(currentData);
     currentEvent.notNeedLink = !IsNeedLink(currentData);
-    std::vector<uint8_t> rawData;
     auto remoteVersionMin = moduleConfig_.GetRemoteDeviceMinVersion();
+    bool isDelayed = currentData.IsDelayRecord() && !needFull;
+    if (isDelayed) {
+        clipPlugin->RegisterDelayCallback(
+            std::bind(&PasteboardService::GetDistributedDelayData, this, std::placeholders::_1,
+                std::placeholders::_2, std::placeholders::_3),
+            std::bind(&PasteboardService::GetDistributedDelayEntry, this, std::placeholders::_1,
+                std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
+    }
+    // the peer fetches a delayed clip through GetDistributedDelayData, which answers unframed and uncompressed
+    auto peer = isDelayed ? PeerCapability() : GetPeerCapability();
+    // a framed clip is encoded frame by frame, the whole encoding is only built when it goes as one payload
+    if (peer.acceptFrames && clipPlugin->IsFrameSupported() &&
+        SetCurrentDataFrames(clipPlugin, currentData, currentEvent, remoteVersionMin, peer.payloadVersion)) {
+        return true;
+    }
+    std::vector<uint8_t> rawData;
     {
         std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
         if (!currentData.Encode(rawData, remoteVersionMin <= DistributedModuleConfig::Version::VERSION_FIVE)) {
@@ -4281,13 +4625,7 @@ bool PasteboardService::SetCurrentData()
             return false;
         }
     }
-    if (currentData.IsDelayRecord() && !needFull) {
-        clipPlugin->RegisterDelayCallback(
-            std::bind(&PasteboardService::GetDistributedDelayData, this, std::placeholders::_1,
-                std::placeholders::_2, std::placeholders::_3),
-            std::bind(&PasteboardService::GetDistributedDelayEntry, this, std::placeholders::_1,
-                std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
-    }
+    currentEvent.payloadVersion = ClipPayloadCodec::Encode(rawData, peer.payloadVersion);
     std::vector<uint8_t> rawMimeTypes;
     if (rawData.size() > MAX_TRANSFER_SIZE) {
         auto mimeTypes = currentData.GetMimeTypes();
@@ -4297,6 +4635,76 @@ bool PasteboardService::SetCurrentData()
     return true;
 }
 
+bool PasteboardService::SetCurrentDataFrames(const std::shared_ptr<ClipPlugin> &clipPlugin, PasteData &data,
+    Event &event, uint32_t remoteVersion, uint8_t payloadVersion)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    {
+        std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+        auto records = data.AllRecords();
+        // local sizes, close enough to the remote encoding to cut the frames
+        std::vector<size_t> recordSizes;
+        recordSizes.reserve(records.size());
+        for (const auto &record : records) {
+            recordSizes.push_back(record == nullptr ? 0 : record->CountTLV());
+        }
+        auto starts = ClipFrameTransfer::PlanFrames(recordSizes);
+        if (starts.size() <= 1) {
+            return false;
+        }
+        starts.push_back(records.size());
+        for (size_t i = 0; i + 1 < starts.size(); ++i) {
+            PasteData frameData;
+            frameData.ShareRecords(data, starts[i], starts[i + 1]);
+            std::vector<uint8_t> frame;
+            PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(
+                frameData.Encode(frame, remoteVersion <= DistributedModuleConfig::Version::VERSION_FIVE), false,
+                PASTEBOARD_MODULE_SERVICE, "encode frame %{public}zu failed, dataId:%{public}u", i, event.dataId);
+            frames.push_back(std::move(frame));
+        }
+    }
+    for (auto &frame : frames) {
+        ClipFrameTransfer::SealFrame(frame, payloadVersion);
+    }
+    auto mimeTypes = data.GetMimeTypes();
+    event.frameNum = static_cast<uint8_t>(frames.size());
+    int32_t ret = clipPlugin->SetPasteDataFrames(event, frames, remoteVersion, EncodeMimeTypes(mimeTypes));
+    if (ret != 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "set frames failed, ret:%{public}d, sent as one payload", ret);
+        event.frameNum = 0;
+        return false;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "dataId:%{public}u sent in %{public}zu frames", event.dataId,
+        frames.size());
+    return true;
+}
+
+void PasteboardService::RecordPeerCapability(const Event &event)
+{
+    std::string udid = DMAdapter::GetInstance().GetUdidByNetworkId(event.deviceId);
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(!udid.empty(), PASTEBOARD_MODULE_SERVICE, "peer udid is empty");
+    peerCapabilities_.InsertOrAssign(udid, PeerCapability{ event.acceptPayloadVersion, event.acceptFrames });
+}
+
+PasteboardService::PeerCapability PasteboardService::GetPeerCapability()
+{
+    // any trusted device may fetch the clip, so only what every one of them announced is used
+    auto udids = DMAdapter::GetInstance().GetUdidList();
+    if (udids.empty()) {
+        return PeerCapability();
+    }
+    PeerCapability capability{ ClipPayloadCodec::LATEST, true };
+    for (const auto &udid : udids) {
+        auto [found, peer] = peerCapabilities_.Find(udid);
+        if (!found) {
+            return PeerCapability();
+        }
+        capability.payloadVersion = std::min(capability.payloadVersion, peer.payloadVersion);
+        capability.acceptFrames = capability.acceptFrames && peer.acceptFrames;
+    }
+    return capability;
+}
+
 int32_t PasteboardService::GetDistributedDelayEntry(const Event &evt, uint32_t recordId, const std::string &utdId,
     std::vector<uint8_t> &rawData)
 {
@@ -4469,6 +4877,7 @@ int32_t PasteboardService::GetDistributedDelayData(const Event &evt, uint8_t ver
         PasteboardWebController::GetInstance().SplitWebviewPasteData(*data, bundleIndex, evt.user);
         PasteboardWebController::GetInstance().SetWebviewPasteData(*data, bundleIndex);
         PasteboardWebController::GetInstance().CheckAppUriPermission(*data);
+        InvalidateClipCache(evt.user);
     }
     GenerateDistributedUri(*data);
 
@@ -4711,6 +5120,7 @@ int32_t PasteboardService::GetFullDelayPasteData(int32_t userId, PasteData &data
         value = std::make_shared<PasteData>(data);
         return true;
     });
+    InvalidateClipCache(userId);
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
 
@@ -4739,6 +5149,7 @@ int32_t PasteboardService::SyncDelayedData()
             }
             return true;
         });
+        InvalidateClipCache(userId);
     });
     PasteBoardCommonUtils::SetThreadTaskName(thread, "SyncDelayedData");
     thread.detach();
@@ -5114,6 +5525,7 @@ void PasteboardService::ClearUriOnUninstall(std::shared_ptr<PasteData> pasteData
             if (!pasteData->HasMimeType(MIMETYPE_TEXT_URI)) {
                 return;
             }
+            InvalidateClipCache(pasteData->userId_);
 
             auto emptyUri = std::make_shared<OHOS::Uri>("");
             size_t recordCount = pasteData->GetRecordCount();
@@ -5122,6 +5534,7 @@ void PasteboardService::ClearUriOnUninstall(std::shared_ptr<PasteData> pasteData
                 if (item == nullptr || item->GetOriginUri() == nullptr) {
                     continue;
                 }
+                item = pasteData->DetachRecordAt(i);
                 item->SetUri(emptyUri);
             }
         }
@@ -5277,9 +5690,21 @@ void PasteboardService::RemoveObserverByPid(int32_t userId, pid_t pid, ObserverM
     }
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE,
         "RemoveObserverByPid: removing observer for userId=%{public}d, pid=%{public}d", userId, pid);
+    RemoveDispatchedObservers(it->second);
     observerMap.erase(callObserverKey);
 }
 
+void PasteboardService::RemoveDispatchedObservers(
+    const std::shared_ptr<std::set<sptr<IPasteboardChangedObserver>, classcomp>> &observers)
+{
+    if (observers == nullptr) {
+        return;
+    }
+    for (const auto &observer : *observers) {
+        observerDispatcher_->Remove(observer);
+    }
+}
+
 int32_t PasteboardService::AppExit(pid_t pid, int32_t userId)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "pid %{public}d exit, userId %{public}d.", pid, userId);
@@ -5359,12 +5784,12 @@ std::function<void(const OHOS::MiscServices::Event &)> PasteboardService::Remote
 {
     return [this](const OHOS::MiscServices::Event &event) {
         (void)event;
-        std::lock_guard<std::mutex> lock(observerMutex_);
-        for (auto &observers : observerRemoteChangedMap_) {
-            for (const auto &observer : *(observers.second)) {
-                observer->OnPasteboardChanged();
-            }
+        std::vector<sptr<IPasteboardChangedObserver>> observers;
+        {
+            std::lock_guard<std::mutex> lock(observerMutex_);
+            observers = CollectObservers(observerRemoteChangedMap_, nullptr);
         }
+        observerDispatcher_->PostChanged(observers);
     };
 }
 
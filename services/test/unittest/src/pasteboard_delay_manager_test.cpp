@@ -14,6 +14,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "message_parcel_warp.h"
 #include "pasteboard_delay_manager.h"
@@ -81,6 +82,61 @@ public:
     }
 };
 
+class BatchEntryGetterImpl : public IPasteboardEntryGetter {
+public:
+    int32_t GetRecordValueByType(uint32_t recordId, PasteDataEntry &entry) override
+    {
+        singleCalls_++;
+        entry.SetValue(std::to_string(recordId));
+        entry.rawDataSize_ = ENTRY_SIZE;
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
+
+    int32_t GetRecordValuesByType(std::vector<EntryValueRequest> &requests) override
+    {
+        batchCalls_++;
+        if (batchResult_ != static_cast<int32_t>(PasteboardError::E_OK)) {
+            return batchResult_;
+        }
+        for (auto &request : requests) {
+            deadlines_.push_back(request.deadlineMs);
+            if (request.recordId == FAILED_RECORD_ID) {
+                request.result = static_cast<int32_t>(PasteboardError::TIMEOUT_ERROR);
+                continue;
+            }
+            request.entry.SetValue(std::to_string(request.recordId));
+            request.entry.rawDataSize_ = ENTRY_SIZE;
+            request.result = static_cast<int32_t>(PasteboardError::E_OK);
+        }
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
+
+    sptr<IRemoteObject> AsObject() override
+    {
+        return nullptr;
+    }
+
+    static constexpr int64_t ENTRY_SIZE = 10;
+    static constexpr uint32_t FAILED_RECORD_ID = 7;
+    int32_t batchResult_ = static_cast<int32_t>(PasteboardError::E_OK);
+    uint32_t singleCalls_ = 0;
+    uint32_t batchCalls_ = 0;
+    std::vector<uint32_t> deadlines_;
+};
+
+class SlowBatchEntryGetterImpl : public BatchEntryGetterImpl {
+public:
+    int32_t GetRecordValuesByType(std::vector<EntryValueRequest> &requests) override
+    {
+        if (batchCalls_ > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_BATCH_MS));
+        }
+        return BatchEntryGetterImpl::GetRecordValuesByType(requests);
+    }
+
+    static constexpr uint32_t SLOW_BATCH_MS = 1000;
+};
+
 /**
  * @tc.name: GetEntryPriorityTest001
  * @tc.desc:
@@ -306,4 +362,129 @@ HWTEST_F(PasteboardDelayManagerTest, GetLocalEntryValueTest001, TestSize.Level1)
     EXPECT_EQ(pasteData.rawDataSize_, finalDataSize);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest001 end");
 }
+
+/**
+ * @tc.name: GetLocalEntryValueTest002
+ * @tc.desc: delayed entries are fetched in batches sharing the paste deadline and committed in one pass
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardDelayManagerTest, GetLocalEntryValueTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest002 start");
+    constexpr uint32_t entryCount = IPasteboardEntryGetter::MAX_BATCH_ENTRIES + 8;
+    std::vector<DelayEntryInfo> delayEntryInfos;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        auto entry = std::make_shared<PasteDataEntry>();
+        entry->SetUtdId(UTDID_PLAIN_TEXT);
+        delayEntryInfos.push_back({1, i + 1, entry});
+    }
+    auto entryGetter = sptr<BatchEntryGetterImpl>::MakeSptr();
+    PasteData pasteData;
+    DelayManager::GetLocalEntryValue(delayEntryInfos, entryGetter, pasteData, DelayManager::ENTRY_FETCH_TIMEOUT_MS);
+
+    EXPECT_EQ(entryGetter->batchCalls_, 2);
+    EXPECT_EQ(entryGetter->singleCalls_, 0);
+    ASSERT_EQ(entryGetter->deadlines_.size(), entryCount);
+    EXPECT_EQ(entryGetter->deadlines_[0], entryGetter->deadlines_[1]);
+    EXPECT_LE(entryGetter->deadlines_[0], DelayManager::ENTRY_FETCH_TIMEOUT_MS);
+    EXPECT_LE(entryGetter->deadlines_[IPasteboardEntryGetter::MAX_BATCH_ENTRIES], entryGetter->deadlines_[0]);
+    EXPECT_EQ(pasteData.rawDataSize_, BatchEntryGetterImpl::ENTRY_SIZE * (entryCount - 1));
+    for (const auto &info : delayEntryInfos) {
+        auto value = info.entry->GetValue();
+        if (info.recordId == BatchEntryGetterImpl::FAILED_RECORD_ID) {
+            EXPECT_TRUE(std::holds_alternative<std::monostate>(value));
+            continue;
+        }
+        ASSERT_TRUE(std::holds_alternative<std::string>(value));
+        EXPECT_EQ(std::get<std::string>(value), std::to_string(info.recordId));
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest002 end");
+}
+
+/**
+ * @tc.name: GetLocalEntryValueTest003
+ * @tc.desc: a getter that fails the batch call is asked entry by entry for the rest of the paste
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardDelayManagerTest, GetLocalEntryValueTest003, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest003 start");
+    constexpr uint32_t entryCount = IPasteboardEntryGetter::MAX_BATCH_ENTRIES + 1;
+    std::vector<DelayEntryInfo> delayEntryInfos;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        auto entry = std::make_shared<PasteDataEntry>();
+        entry->SetUtdId(UTDID_PLAIN_TEXT);
+        delayEntryInfos.push_back({1, i + 1, entry});
+    }
+    auto entryGetter = sptr<BatchEntryGetterImpl>::MakeSptr();
+    entryGetter->batchResult_ = static_cast<int32_t>(PasteboardError::NOT_SUPPORT);
+    PasteData pasteData;
+    DelayManager::GetLocalEntryValue(delayEntryInfos, entryGetter, pasteData);
+
+    EXPECT_EQ(entryGetter->batchCalls_, 1);
+    EXPECT_EQ(entryGetter->singleCalls_, entryCount);
+    EXPECT_EQ(pasteData.rawDataSize_, BatchEntryGetterImpl::ENTRY_SIZE * entryCount);
+    for (const auto &info : delayEntryInfos) {
+        EXPECT_TRUE(std::holds_alternative<std::string>(info.entry->GetValue()));
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest003 end");
+}
+/**
+ * @tc.name: GetLocalEntryValueTest004
+ * @tc.desc: a getter that stops answering does not hold the paste past the fetch timeout, earlier answers are kept
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardDelayManagerTest, GetLocalEntryValueTest004, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest004 start");
+    constexpr uint32_t fetchTimeoutMs = 100;
+    constexpr uint32_t entryCount = IPasteboardEntryGetter::MAX_BATCH_ENTRIES + 1;
+    std::vector<DelayEntryInfo> delayEntryInfos;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        auto entry = std::make_shared<PasteDataEntry>();
+        entry->SetUtdId(UTDID_PLAIN_TEXT);
+        delayEntryInfos.push_back({1, i + 1, entry});
+    }
+    auto entryGetter = sptr<SlowBatchEntryGetterImpl>::MakeSptr();
+    PasteData pasteData;
+    auto begin = std::chrono::steady_clock::now();
+    DelayManager::GetLocalEntryValue(delayEntryInfos, entryGetter, pasteData, fetchTimeoutMs);
+    auto waited = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_LT(waited, std::chrono::milliseconds(SlowBatchEntryGetterImpl::SLOW_BATCH_MS));
+    constexpr uint32_t fetchedCount = IPasteboardEntryGetter::MAX_BATCH_ENTRIES - 1;
+    EXPECT_EQ(pasteData.rawDataSize_, BatchEntryGetterImpl::ENTRY_SIZE * fetchedCount);
+    auto lastValue = delayEntryInfos.back().entry->GetValue();
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(lastValue));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest004 end");
+}
+
+/**
+ * @tc.name: GetLocalEntryValueTest005
+ * @tc.desc: without a fetch timeout a slow getter is waited for and every entry it answers is kept
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardDelayManagerTest, GetLocalEntryValueTest005, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest005 start");
+    constexpr uint32_t entryCount = IPasteboardEntryGetter::MAX_BATCH_ENTRIES + 1;
+    std::vector<DelayEntryInfo> delayEntryInfos;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        auto entry = std::make_shared<PasteDataEntry>();
+        entry->SetUtdId(UTDID_PLAIN_TEXT);
+        delayEntryInfos.push_back({1, i + 1, entry});
+    }
+    auto entryGetter = sptr<SlowBatchEntryGetterImpl>::MakeSptr();
+    PasteData pasteData;
+    DelayManager::GetLocalEntryValue(delayEntryInfos, entryGetter, pasteData);
+
+    EXPECT_EQ(entryGetter->batchCalls_, 2);
+    ASSERT_EQ(entryGetter->deadlines_.size(), entryCount);
+    EXPECT_EQ(entryGetter->deadlines_[0], UINT32_MAX);
+    EXPECT_EQ(pasteData.rawDataSize_, BatchEntryGetterImpl::ENTRY_SIZE * (entryCount - 1));
+    auto lastValue = delayEntryInfos.back().entry->GetValue();
+    ASSERT_TRUE(std::holds_alternative<std::string>(lastValue));
+    EXPECT_EQ(std::get<std::string>(lastValue), std::to_string(entryCount));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetLocalEntryValueTest005 end");
+}
 } // namespace OHOS::MiscServices
@@ -14,6 +14,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <thread>
+
 #include "entry_getter.h"
 #include "pasteboard_entry_getter_client.h"
 #include "pasteboard_error.h"
@@ -50,6 +52,16 @@ public:
     }
 };
 
+class SlowEntryGetterImpl : public UDMF::EntryGetter {
+public:
+    UDMF::ValueType GetValueByType(const std::string &utdid) override
+    {
+        constexpr auto delay = std::chrono::milliseconds(20);
+        std::this_thread::sleep_for(delay);
+        return utdid;
+    }
+};
+
 /**
  * @tc.name: GetRecordValueByTypeTest001
  * @tc.desc: Test function GetRecordValueByType
@@ -85,5 +97,57 @@ HWTEST_F(PasteboardEntryGetterClientTest, GetRecordValueByTypeTest002, TestSize.
     EXPECT_EQ(result, static_cast<int32_t>(PasteboardError::E_OK));
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetRecordValueByTypeTest002 end");
 }
+
+/**
+ * @tc.name: GetRecordValuesByTypeTest001
+ * @tc.desc: Test function GetRecordValuesByType resolves every request and reports each result
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardEntryGetterClientTest, GetRecordValuesByTypeTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetRecordValuesByTypeTest001 start");
+    std::map<uint32_t, std::shared_ptr<UDMF::EntryGetter>> entryGetters;
+    entryGetters.insert({0, std::make_shared<SlowEntryGetterImpl>()});
+    auto pasteboardEntryGetterClient = std::make_shared<PasteboardEntryGetterClient>(entryGetters);
+    std::vector<EntryValueRequest> requests(2);
+    requests[0].recordId = 0;
+    requests[0].deadlineMs = UINT32_MAX;
+    requests[0].entry.SetUtdId("general.plain-text");
+    requests[1].recordId = 1;
+    requests[1].deadlineMs = UINT32_MAX;
+    int32_t result = pasteboardEntryGetterClient->GetRecordValuesByType(requests);
+    EXPECT_EQ(result, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_EQ(requests[0].result, static_cast<int32_t>(PasteboardError::E_OK));
+    auto value = requests[0].entry.GetValue();
+    ASSERT_TRUE(std::holds_alternative<std::string>(value));
+    EXPECT_EQ(std::get<std::string>(value), "general.plain-text");
+    EXPECT_EQ(requests[1].result, static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetRecordValuesByTypeTest001 end");
+}
+
+/**
+ * @tc.name: GetRecordValuesByTypeTest002
+ * @tc.desc: Test function GetRecordValuesByType skips an entry whose deadline passed while earlier entries ran
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardEntryGetterClientTest, GetRecordValuesByTypeTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetRecordValuesByTypeTest002 start");
+    std::map<uint32_t, std::shared_ptr<UDMF::EntryGetter>> entryGetters;
+    entryGetters.insert({0, std::make_shared<SlowEntryGetterImpl>()});
+    auto pasteboardEntryGetterClient = std::make_shared<PasteboardEntryGetterClient>(entryGetters);
+    std::vector<EntryValueRequest> requests(3);
+    constexpr uint32_t shortDeadlineMs = 5;
+    requests[0].deadlineMs = shortDeadlineMs;
+    requests[1].deadlineMs = shortDeadlineMs;
+    requests[2].deadlineMs = UINT32_MAX;
+    int32_t result = pasteboardEntryGetterClient->GetRecordValuesByType(requests);
+    EXPECT_EQ(result, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_EQ(requests[0].result, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_EQ(requests[1].result, static_cast<int32_t>(PasteboardError::TIMEOUT_ERROR));
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(requests[1].entry.GetValue()));
+    EXPECT_EQ(requests[2].result, static_cast<int32_t>(PasteboardError::E_OK));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetRecordValuesByTypeTest002 end");
+}
 }
 } // namespace OHOS::MiscServices
\ No newline at end of file
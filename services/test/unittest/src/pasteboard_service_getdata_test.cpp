@@ -14,9 +14,11 @@
  */
 
 #include <gtest/gtest.h>
+#include <sys/mman.h>
 #include <thread>
 #include <unistd.h>
 
+#include "ashmem_pool.h"
 #include "ipc_skeleton.h"
 #include "message_parcel_warp.h"
 #include "pasteboard_error.h"
@@ -1080,5 +1082,61 @@ HWTEST_F(PasteboardServiceGetDataTest, GetRecordValueByTypeTest001, TestSize.Lev
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetRecordValueByTypeTest001 end");
 }
 
+/**
+ * @tc.name: SealedClipStoreTest001
+ * @tc.desc: with the sealed clip store on, a large stored clip is encoded once into a sealed region, every
+ *           reader gets a dup of it plus its own fields inline, and a changed clip gets a new region
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(PasteboardServiceGetDataTest, SealedClipStoreTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "SealedClipStoreTest001 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    int32_t userId = 0x123456;
+    std::string text(64 * 1024, 's');
+    auto stored = std::make_shared<PasteData>();
+    stored->AddTextRecord(text);
+    tempPasteboard->clips_.InsertOrAssign(userId, stored);
+
+    PasteData reader = *stored;
+    EXPECT_EQ(tempPasteboard->AttachEncodedRecords(userId, reader), nullptr);
+    tempPasteboard->InvalidateClipCache(userId);
+
+    tempPasteboard->sealedClipStore_.store(true);
+    auto sealed = tempPasteboard->AttachEncodedRecords(userId, reader);
+    ASSERT_NE(sealed, nullptr);
+    EXPECT_EQ(sealed->GetSize(), stored->CountRecordsTLV());
+    EXPECT_EQ(tempPasteboard->AttachEncodedRecords(userId, reader), sealed);
+
+    reader.SetPasteId("sealed_clip_paste_id");
+    int fd = -1;
+    int64_t size = 0;
+    std::vector<uint8_t> rawData;
+    int32_t ret = tempPasteboard->DealSealedData(fd, size, rawData, reader, *sealed);
+    EXPECT_EQ(ret, ERR_OK);
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(size, static_cast<int64_t>(sealed->GetSize()));
+    EXPECT_FALSE(rawData.empty());
+    EXPECT_EQ(::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0), MAP_FAILED);
+    void *ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ASSERT_NE(ptr, MAP_FAILED);
+    PasteData decoded;
+    EXPECT_TRUE(decoded.Decode(static_cast<const uint8_t *>(ptr), static_cast<size_t>(size)));
+    EXPECT_TRUE(decoded.Decode(rawData));
+    ::munmap(ptr, size);
+    tempPasteboard->CloseSharedMemFd(fd);
+    ASSERT_NE(decoded.GetPrimaryText(), nullptr);
+    EXPECT_EQ(*decoded.GetPrimaryText(), text);
+    EXPECT_EQ(decoded.GetPasteId(), "sealed_clip_paste_id");
+
+    tempPasteboard->InvalidateClipCache(userId);
+    EXPECT_NE(tempPasteboard->AttachEncodedRecords(userId, reader), sealed);
+    tempPasteboard->clips_.Clear();
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "SealedClipStoreTest001 end");
+}
+
 } // namespace MiscServices
 } // namespace OHOS
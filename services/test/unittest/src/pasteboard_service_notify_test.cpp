@@ -13,7 +13,9 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <gtest/gtest.h>
+#include <mutex>
 #include <thread>
 #include <unistd.h>
 
@@ -92,6 +94,23 @@ class MyTestPasteboardChangedObserver : public PasteboardObserverStub {
     }
 };
 
+class CountingPasteboardChangedObserver : public PasteboardObserverStub {
+public:
+    void OnPasteboardChanged()
+    {
+        changedCount++;
+    }
+    void OnPasteboardEvent(const PasteboardChangedEvent &event)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(event);
+    }
+
+    std::atomic<uint32_t> changedCount = 0;
+    std::mutex mutex;
+    std::vector<PasteboardChangedEvent> events;
+};
+
 class PasteboardEntryGetterImpl : public IPasteboardEntryGetter {
 public:
     PasteboardEntryGetterImpl() {};
@@ -577,5 +596,106 @@ HWTEST_F(PasteboardServiceNotifyTest, NotifyObserversTest006, TestSize.Level1)
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "NotifyObserversTest006 end");
 }
 
+/**
+ * @tc.name: NotifyObserversTest007
+ * @tc.desc: local and event observers are notified through the dispatcher after the observer lock is released
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceNotifyTest, NotifyObserversTest007, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "NotifyObserversTest007 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    std::vector<std::function<void()>> tasks;
+    tempPasteboard->observerDispatcher_ = std::make_shared<PasteboardObserverDispatcher>(
+        [&tasks](std::function<void()> task) {
+            tasks.push_back(std::move(task));
+        });
+
+    int32_t userId = 1;
+    pid_t pid = IPCSkeleton::GetCallingPid();
+    sptr<CountingPasteboardChangedObserver> observer = sptr<CountingPasteboardChangedObserver>::MakeSptr();
+    auto localObservers = std::make_shared<std::set<sptr<IPasteboardChangedObserver>, PasteboardService::classcomp>>();
+    localObservers->insert(observer);
+    tempPasteboard->observerLocalChangedMap_[std::make_pair(userId, pid)] = localObservers;
+    tempPasteboard->observerEventMap_[std::make_pair(userId, pid)] = localObservers;
+
+    tempPasteboard->NotifyObservers("bundle", userId, PasteboardEventStatus::PASTEBOARD_WRITE);
+    tempPasteboard->NotifyObservers("bundle", userId, PasteboardEventStatus::PASTEBOARD_READ);
+    tempPasteboard->NotifyObservers("bundle", userId + 1, PasteboardEventStatus::PASTEBOARD_WRITE);
+    EXPECT_EQ(observer->changedCount.load(), 0);
+    ASSERT_EQ(tasks.size(), 1);
+    tasks[0]();
+    EXPECT_EQ(observer->changedCount.load(), 1);
+    ASSERT_EQ(observer->events.size(), 3);
+    EXPECT_EQ(observer->events[0].status, static_cast<int32_t>(PasteboardEventStatus::PASTEBOARD_WRITE));
+    EXPECT_EQ(observer->events[1].status, static_cast<int32_t>(PasteboardEventStatus::PASTEBOARD_READ));
+    EXPECT_EQ(observer->events[2].userId, userId + 1);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "NotifyObserversTest007 end");
+}
+
+/**
+ * @tc.name: NotifyObserversTest008
+ * @tc.desc: removing an observer drops the notifications not yet delivered to it
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceNotifyTest, NotifyObserversTest008, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "NotifyObserversTest008 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    std::vector<std::function<void()>> tasks;
+    tempPasteboard->observerDispatcher_ = std::make_shared<PasteboardObserverDispatcher>(
+        [&tasks](std::function<void()> task) {
+            tasks.push_back(std::move(task));
+        });
+
+    int32_t userId = 1;
+    pid_t pid = 1;
+    sptr<CountingPasteboardChangedObserver> observer = sptr<CountingPasteboardChangedObserver>::MakeSptr();
+    auto observers = std::make_shared<std::set<sptr<IPasteboardChangedObserver>, PasteboardService::classcomp>>();
+    observers->insert(observer);
+    tempPasteboard->observerLocalChangedMap_[std::make_pair(userId, pid)] = observers;
+
+    tempPasteboard->NotifyObservers("bundle", userId, PasteboardEventStatus::PASTEBOARD_WRITE);
+    EXPECT_EQ(tempPasteboard->observerDispatcher_->GetPendingCount(observer), 1);
+    tempPasteboard->RemoveObserverByPid(userId, pid, tempPasteboard->observerLocalChangedMap_);
+    EXPECT_EQ(tempPasteboard->observerDispatcher_->GetPendingCount(observer), 0);
+    ASSERT_EQ(tasks.size(), 1);
+    tasks[0]();
+    EXPECT_EQ(observer->changedCount.load(), 0);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "NotifyObserversTest008 end");
+}
+
+/**
+ * @tc.name: ObserverDispatcherTest001
+ * @tc.desc: a slow observer keeps at most MAX_PENDING_NOTIFICATIONS notifications and loses the oldest ones
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceNotifyTest, ObserverDispatcherTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "ObserverDispatcherTest001 start");
+    std::vector<std::function<void()>> tasks;
+    auto dispatcher = std::make_shared<PasteboardObserverDispatcher>([&tasks](std::function<void()> task) {
+        tasks.push_back(std::move(task));
+    });
+    sptr<CountingPasteboardChangedObserver> observer = sptr<CountingPasteboardChangedObserver>::MakeSptr();
+    std::vector<sptr<IPasteboardChangedObserver>> observers = { observer, nullptr };
+    constexpr int32_t eventCount = PasteboardObserverDispatcher::MAX_PENDING_NOTIFICATIONS + 4;
+    for (int32_t i = 0; i < eventCount; ++i) {
+        IPasteboardChangedObserver::PasteboardChangedEvent event;
+        event.userId = i;
+        dispatcher->PostEvent(observers, event);
+    }
+    EXPECT_EQ(dispatcher->GetPendingCount(observer), PasteboardObserverDispatcher::MAX_PENDING_NOTIFICATIONS);
+    ASSERT_EQ(tasks.size(), 1);
+    tasks[0]();
+    ASSERT_EQ(observer->events.size(), PasteboardObserverDispatcher::MAX_PENDING_NOTIFICATIONS);
+    EXPECT_EQ(observer->events.front().userId, eventCount - PasteboardObserverDispatcher::MAX_PENDING_NOTIFICATIONS);
+    EXPECT_EQ(observer->events.back().userId, eventCount - 1);
+    EXPECT_EQ(dispatcher->GetPendingCount(observer), 0);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "ObserverDispatcherTest001 end");
+}
+
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
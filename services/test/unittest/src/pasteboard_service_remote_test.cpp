@@ -19,6 +19,10 @@
 
 #include "ipc_skeleton.h"
 #include "message_parcel_warp.h"
+#include "clip/clip_frame_transfer.h"
+#include "clip/clip_payload_codec.h"
+#include "clip/loopback_clip.h"
+#include "device/dm_adapter.h"
 #include "pasteboard_error.h"
 #include "pasteboard_hilog.h"
 #include "pasteboard_observer_stub.h"
@@ -445,5 +449,221 @@ HWTEST_F(PasteboardServiceRemoteTest, ProcessRemoteDelayUriTest001, TestSize.Lev
     EXPECT_NE(ret, static_cast<int32_t>(PasteboardError::E_OK));
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "ProcessRemoteDelayUriTest001 end");
 }
+
+/**
+ * @tc.name: LoopbackDistributedDataTest001
+ * @tc.desc: a clip set through the loopback plugin is pasted back as the peer's data
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, LoopbackDistributedDataTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "LoopbackDistributedDataTest001 start");
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    auto clipPlugin = std::make_shared<LoopbackClip>();
+    tempPasteboard->clipPlugin_ = clipPlugin;
+    TestEvent event;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.seqId = 1;
+    event.dataId = 1;
+    event.status = ClipPlugin::EVT_NORMAL;
+    auto data = std::make_shared<PasteData>();
+    data->AddTextRecord(TEST_ENTITY_TEXT);
+    data->SetDataId(event.dataId);
+    tempPasteboard->setDistributedMemory_.latestEvent = event;
+    tempPasteboard->setDistributedMemory_.latestData = data;
+    ASSERT_TRUE(tempPasteboard->SetCurrentData());
+
+    auto events = clipPlugin->GetTopEvents(1, event.user);
+    ASSERT_EQ(events.size(), 1U);
+    auto [pasteData, result] = tempPasteboard->GetDistributedData(events[0], event.user);
+    ASSERT_NE(pasteData, nullptr);
+    EXPECT_EQ(result.errorCode, static_cast<int32_t>(PasteboardError::E_OK));
+    auto text = pasteData->GetPrimaryText();
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(*text, TEST_ENTITY_TEXT);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "LoopbackDistributedDataTest001 end");
+}
+
+/**
+ * @tc.name: LoopbackDistributedDataTest002
+ * @tc.desc: a second paste of the same remote event waits for the first one and gets its data
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, LoopbackDistributedDataTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "LoopbackDistributedDataTest002 start");
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    LoopbackClip::LinkConfig config;
+    config.latencyMs = 100;
+    auto clipPlugin = std::make_shared<LoopbackClip>(config);
+    tempPasteboard->clipPlugin_ = clipPlugin;
+    TestEvent event;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.seqId = 1;
+    PasteData data;
+    data.AddTextRecord(TEST_ENTITY_TEXT_CN_50);
+    std::vector<uint8_t> rawData;
+    ASSERT_TRUE(data.Encode(rawData));
+    ASSERT_EQ(clipPlugin->SetPasteData(event, rawData, 0, {}), 0);
+    auto events = clipPlugin->GetTopEvents(1, event.user);
+    ASSERT_EQ(events.size(), 1U);
+
+    auto [task, isPasting] = tempPasteboard->taskMgr_.GetRemoteDataTask(events[0]);
+    ASSERT_NE(task, nullptr);
+    ASSERT_FALSE(isPasting);
+    std::shared_ptr<PasteDateTime> waited;
+    std::thread waiter([&tempPasteboard, &events, &waited]() {
+        auto [sameTask, isSamePasting] = tempPasteboard->taskMgr_.GetRemoteDataTask(events[0]);
+        if (sameTask != nullptr && isSamePasting) {
+            waited = tempPasteboard->taskMgr_.WaitRemoteData(events[0]);
+        }
+    });
+    PasteData pasteData;
+    int32_t syncTime = 0;
+    int32_t ret = tempPasteboard->GetRemotePasteData(event.user, events[0], pasteData, syncTime);
+    waiter.join();
+    EXPECT_EQ(ret, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_GE(syncTime, static_cast<int32_t>(2 * config.latencyMs));
+    ASSERT_NE(waited, nullptr);
+    ASSERT_NE(waited->data, nullptr);
+    EXPECT_EQ(waited->data->GetRecordCount(), pasteData.GetRecordCount());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "LoopbackDistributedDataTest002 end");
+}
+
+/**
+ * @tc.name: LoopbackDistributedDelayEntryTest001
+ * @tc.desc: an entry fetched through the loopback plugin is answered by GetDistributedDelayEntry of the sender
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, LoopbackDistributedDelayEntryTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "LoopbackDistributedDelayEntryTest001 start");
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    auto clipPlugin = std::make_shared<LoopbackClip>();
+    TestEvent event;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.seqId = 1;
+    event.dataId = 1;
+    auto data = std::make_shared<PasteData>();
+    data->AddTextRecord(TEST_ENTITY_TEXT_CN_10);
+    data->SetDataId(event.dataId);
+    tempPasteboard->clips_.InsertOrAssign(event.user, data);
+    auto record = data->GetRecordAt(0);
+    ASSERT_NE(record, nullptr);
+    clipPlugin->RegisterDelayCallback(nullptr,
+        std::bind(&PasteboardService::GetDistributedDelayEntry, tempPasteboard.get(), std::placeholders::_1,
+            std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
+    ASSERT_EQ(clipPlugin->SetPasteData(event, {}, 0, {}), 0);
+    auto events = clipPlugin->GetTopEvents(1, event.user);
+    ASSERT_EQ(events.size(), 1U);
+
+    std::vector<uint8_t> rawData;
+    int32_t ret = clipPlugin->GetPasteDataEntry(events[0], record->GetRecordId(), "general.plain-text", rawData);
+    EXPECT_EQ(ret, 0);
+    EXPECT_FALSE(rawData.empty());
+    ret = clipPlugin->GetPasteDataEntry(events[0], record->GetRecordId() + 1, "general.plain-text", rawData);
+    EXPECT_EQ(ret, static_cast<int32_t>(PasteboardError::INVALID_RECORD_ID));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "LoopbackDistributedDelayEntryTest001 end");
+}
+
+/**
+ * @tc.name: LoopbackDistributedDelayDataTest001
+ * @tc.desc: a delayed clip copied while every peer decodes compressed payloads is announced raw and unframed,
+ *           so the payload the peer fetches from GetDistributedDelayData decodes
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, LoopbackDistributedDelayDataTest001, TestSize.Level1)
+{
+#ifdef PB_DEVICE_MANAGER_ENABLE
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "LoopbackDistributedDelayDataTest001 start");
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    auto clipPlugin = std::make_shared<LoopbackClip>();
+    tempPasteboard->clipPlugin_ = clipPlugin;
+    const std::string peerUdid = "loopback_udid";
+    DMAdapter::GetInstance().devices_.insert(peerUdid);
+    tempPasteboard->peerCapabilities_.InsertOrAssign(peerUdid,
+        PasteboardService::PeerCapability{ ClipPayloadCodec::LATEST, true });
+    ASSERT_EQ(tempPasteboard->GetPeerCapability().payloadVersion, ClipPayloadCodec::LATEST);
+
+    TestEvent event;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.seqId = 1;
+    event.dataId = 1;
+    event.status = ClipPlugin::EVT_NORMAL;
+    event.isDelay = true;
+    std::string text;
+    while (text.size() < ClipPayloadCodec::COMPRESS_THRESHOLD * 4) {
+        text += TEST_ENTITY_TEXT;
+    }
+    auto data = std::make_shared<PasteData>();
+    data->AddTextRecord(text);
+    data->SetDelayRecord(true);
+    data->SetDataId(event.dataId);
+    tempPasteboard->clips_.InsertOrAssign(event.user, data);
+    sptr<PasteboardEntryGetterImpl> entryGetter = sptr<PasteboardEntryGetterImpl>::MakeSptr();
+    sptr<PasteboardService::EntryGetterDeathRecipient> deathRecipient =
+        sptr<PasteboardService::EntryGetterDeathRecipient>::MakeSptr(event.user, *tempPasteboard);
+    tempPasteboard->entryGetters_.InsertOrAssign(event.user, std::make_pair(entryGetter, deathRecipient));
+    tempPasteboard->setDistributedMemory_.latestEvent = event;
+    tempPasteboard->setDistributedMemory_.latestData = std::make_shared<PasteData>(*data);
+    ASSERT_TRUE(tempPasteboard->SetCurrentData());
+
+    auto events = clipPlugin->GetTopEvents(1, event.user);
+    ASSERT_EQ(events.size(), 1U);
+    EXPECT_EQ(events[0].payloadVersion, ClipPayloadCodec::RAW);
+    EXPECT_EQ(events[0].frameNum, 0);
+    auto [pasteData, result] = tempPasteboard->GetDistributedData(events[0], event.user);
+    DMAdapter::GetInstance().devices_.erase(peerUdid);
+    ASSERT_NE(pasteData, nullptr);
+    EXPECT_EQ(result.errorCode, static_cast<int32_t>(PasteboardError::E_OK));
+    auto pastedText = pasteData->GetPrimaryText();
+    ASSERT_NE(pastedText, nullptr);
+    EXPECT_EQ(*pastedText, text);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "LoopbackDistributedDelayDataTest001 end");
+#else
+    ASSERT_TRUE(true);
+#endif
+}
+
+/**
+ * @tc.name: FrameTransferExpiryTest001
+ * @tc.desc: kept frames over the size cap are dropped at once, the others once their time is up
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceRemoteTest, FrameTransferExpiryTest001, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "FrameTransferExpiryTest001 start");
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    constexpr uint8_t frameNum = 2;
+    auto &transfer = tempPasteboard->frameTransfer_;
+    {
+        std::lock_guard<std::mutex> lock(transfer.mutex);
+        transfer.reader = std::make_shared<ClipFrameReader>(frameNum);
+        transfer.data = std::make_shared<PasteData>();
+        transfer.dataSize = PasteboardService::FRAME_RESUME_MAX_SIZE + 1;
+        tempPasteboard->KeepFrameTransfer(transfer);
+        EXPECT_EQ(transfer.reader, nullptr);
+        EXPECT_EQ(transfer.data, nullptr);
+
+        transfer.reader = std::make_shared<ClipFrameReader>(frameNum);
+        transfer.data = std::make_shared<PasteData>();
+        transfer.dataSize = INT_ONE;
+        tempPasteboard->KeepFrameTransfer(transfer);
+        EXPECT_NE(transfer.reader, nullptr);
+        EXPECT_GT(transfer.keptUntil, PasteBoardTime::GetBootTimeMs());
+    }
+    tempPasteboard->ClearExpiredFrameTransfer();
+    EXPECT_NE(transfer.reader, nullptr);
+    transfer.keptUntil = PasteBoardTime::GetBootTimeMs();
+    tempPasteboard->ClearExpiredFrameTransfer();
+    EXPECT_EQ(transfer.reader, nullptr);
+    EXPECT_EQ(transfer.data, nullptr);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "FrameTransferExpiryTest001 end");
+}
 } // namespace MiscServices
 } // namespace OHOS
@@ -978,6 +978,29 @@ HWTEST_F(PasteboardServiceSetDataTest, SaveData004, TestSize.Level1)
     EXPECT_EQ(ret, static_cast<int32_t>(PasteboardError::E_OK));
 }
 
+/**
+ * @tc.name: SaveData005
+ * @tc.desc: a set overtaken by a newer commit of the same user reports SET_DATA_SUPERSEDED and leaves the
+ *           getters of the current clip in place
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceSetDataTest, SaveData005, TestSize.Level1)
+{
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+    PasteData pasteData;
+    pasteData.SetDelayRecord(true);
+    sptr<PasteboardEntryGetterImpl> entryGetter = sptr<PasteboardEntryGetterImpl>::MakeSptr();
+    ASSERT_NE(entryGetter, nullptr);
+    auto userId = tempPasteboard->GetAppInfo(pasteData.GetTokenId()).userId;
+    ASSERT_TRUE(tempPasteboard->setSequencer_.Commit(userId, UINT64_MAX, nullptr));
+    int32_t ret = tempPasteboard->SaveData(pasteData, 0, nullptr, entryGetter);
+    if (userId != ERROR_USERID) {
+        EXPECT_EQ(ret, static_cast<int32_t>(PasteboardError::SET_DATA_SUPERSEDED));
+        EXPECT_FALSE(tempPasteboard->entryGetters_.Find(userId).first);
+    }
+}
+
 /**
  * @tc.name: WriteRawDataTest001
  * @tc.desc: test Func WriteRawData
@@ -87,6 +87,25 @@ class MyTestPasteboardChangedObserver : public PasteboardObserverStub {
     }
 };
 
+class CountingEntityBackend : public PasteboardEntityEngine::Backend {
+public:
+    explicit CountingEntityBackend(std::shared_ptr<std::atomic<int32_t>> processed) : processed_(processed) {}
+    bool Load()
+    {
+        return true;
+    }
+    int32_t Process(const std::string &text, std::string &entity)
+    {
+        (*processed_)++;
+        entity = "{\"code\":0}";
+        return ERR_OK;
+    }
+    void Unload() {}
+
+private:
+    std::shared_ptr<std::atomic<int32_t>> processed_;
+};
+
 class PasteboardEntryGetterImpl : public IPasteboardEntryGetter {
 public:
     PasteboardEntryGetterImpl() {};
@@ -1278,6 +1297,34 @@ HWTEST_F(PasteboardServiceTest, RecognizePasteDataTest001, TestSize.Level1)
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "RecognizePasteDataTest001 end");
 }
 
+/**
+ * @tc.name: RecognizePasteDataTest002
+ * @tc.desc: recopying the same text is answered by the entity engine cache without another inference
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, RecognizePasteDataTest002, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "RecognizePasteDataTest002 start");
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    auto processed = std::make_shared<std::atomic<int32_t>>(0);
+    tempPasteboard->entityEngine_ = std::make_unique<PasteboardEntityEngine>(
+        std::make_unique<CountingEntityBackend>(processed), [](const std::string &, const std::string &) {});
+    PasteData pasteData;
+    pasteData.AddTextRecord(TEST_ENTITY_TEXT_CN_50);
+
+    tempPasteboard->RecognizePasteData(pasteData);
+    for (int32_t i = 0; i < 200 && processed->load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(processed->load(), 1);
+    tempPasteboard->RecognizePasteData(pasteData);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    tempPasteboard->entityEngine_->Stop();
+    EXPECT_EQ(processed->load(), 1);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "RecognizePasteDataTest002 end");
+}
+
 /**
  * @tc.name: CancelCriticalTimerTest001
  * @tc.desc: test Func CancelCriticalTimer
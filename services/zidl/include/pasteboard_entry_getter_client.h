@@ -28,6 +28,7 @@ public:
     explicit PasteboardEntryGetterClient(const std::map<uint32_t, std::shared_ptr<UDMF::EntryGetter>> entryGetters);
     ~PasteboardEntryGetterClient() = default;
     int32_t GetRecordValueByType(uint32_t recordId, PasteDataEntry& value) override;
+    int32_t GetRecordValuesByType(std::vector<EntryValueRequest> &requests) override;
 private:
     std::map<uint32_t, std::shared_ptr<UDMF::EntryGetter>> entryGetters_;
 };
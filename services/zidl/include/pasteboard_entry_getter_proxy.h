@@ -26,8 +26,11 @@ public:
     explicit PasteboardEntryGetterProxy(const sptr<IRemoteObject> &object);
     ~PasteboardEntryGetterProxy() = default;
     int32_t GetRecordValueByType(uint32_t recordId, PasteDataEntry& value) override;
+    int32_t GetRecordValuesByType(std::vector<EntryValueRequest> &requests) override;
 private:
     int32_t MakeRequest(uint32_t recordId, PasteDataEntry& value, MessageParcel& request);
+    int32_t MakeBatchRequest(const std::vector<EntryValueRequest> &requests, MessageParcel &request);
+    int32_t ReadBatchReply(MessageParcel &reply, std::vector<EntryValueRequest> &requests);
     static inline BrokerDelegator<PasteboardEntryGetterProxy> delegator_;
 };
 } // namespace MiscServices
@@ -28,6 +28,9 @@ public:
     int OnRemoteRequest(uint32_t code, MessageParcel& data, MessageParcel& reply, MessageOption& option) override;
 private:
     int32_t OnGetRecordValueByType(MessageParcel& data, MessageParcel& reply);
+    int32_t OnGetRecordValuesByType(MessageParcel& data, MessageParcel& reply);
+    static int32_t ReadBatchRequest(MessageParcel &data, std::vector<EntryValueRequest> &requests);
+    static int32_t WriteBatchReply(MessageParcel &reply, const std::vector<EntryValueRequest> &requests);
     using Handler = int32_t (PasteboardEntryGetterStub::*)(MessageParcel& data, MessageParcel& reply);
     std::map<uint32_t, Handler> memberFuncMap_;
 };
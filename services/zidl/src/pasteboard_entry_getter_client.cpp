@@ -13,6 +13,8 @@
 * limitations under the License.
 */
 
+#include <chrono>
+
 #include "entry_getter.h"
 #include "pasteboard_entry_getter_client.h"
 #include "pasteboard_error.h"
@@ -40,5 +42,23 @@ int32_t PasteboardEntryGetterClient::GetRecordValueByType(uint32_t recordId, Pas
     }
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
+
+int32_t PasteboardEntryGetterClient::GetRecordValuesByType(std::vector<EntryValueRequest> &requests)
+{
+    // the app getters run one after another, an entry whose deadline passed while earlier ones ran is skipped
+    auto begin = std::chrono::steady_clock::now();
+    for (auto &request : requests) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+        if (elapsed > static_cast<int64_t>(request.deadlineMs)) {
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "recordId:%{public}u, deadline %{public}u ms passed",
+                request.recordId, request.deadlineMs);
+            request.result = static_cast<int32_t>(PasteboardError::TIMEOUT_ERROR);
+            continue;
+        }
+        request.result = GetRecordValueByType(request.recordId, request.entry);
+    }
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
@@ -82,9 +82,8 @@ int32_t PasteboardEntryGetterProxy::GetRecordValueByType(uint32_t recordId, Past
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr,
         static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR),
         PASTEBOARD_MODULE_SERVICE, "read entry tlv raw data failed, size=%{public}" PRId64, rawDataSize);
-    std::vector<uint8_t> recvEntryTlv(rawData, rawData + rawDataSize);
     PasteDataEntry entryValue;
-    if (!entryValue.Decode(recvEntryTlv)) {
+    if (!entryValue.Decode(rawData, static_cast<size_t>(rawDataSize))) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "unmarshall entry value failed");
         return static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
     }
@@ -92,5 +91,113 @@ int32_t PasteboardEntryGetterProxy::GetRecordValueByType(uint32_t recordId, Past
     value.rawDataSize_ = rawDataSize;
     return res;
 }
+int32_t PasteboardEntryGetterProxy::MakeBatchRequest(const std::vector<EntryValueRequest> &requests,
+    MessageParcel &request)
+{
+    if (!request.WriteInterfaceToken(GetDescriptor()) ||
+        !request.WriteUint32(static_cast<uint32_t>(requests.size()))) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "write batch header failed");
+        return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+    }
+    // the entries travel as one raw block, each one announced by its id, deadline and size
+    std::vector<uint8_t> sendEntriesTLV;
+    for (const auto &item : requests) {
+        std::vector<uint8_t> entryTLV(0);
+        if (!item.entry.Encode(entryTLV)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "marshall entry value failed");
+            return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+        }
+        if (!request.WriteUint32(item.recordId) || !request.WriteUint32(item.deadlineMs) ||
+            !request.WriteInt64(entryTLV.size())) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "write batch request failed");
+            return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+        }
+        sendEntriesTLV.insert(sendEntriesTLV.end(), entryTLV.begin(), entryTLV.end());
+    }
+    if (!request.WriteInt64(sendEntriesTLV.size())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "write entries tlv raw data size failed");
+        return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+    }
+    MessageParcelWarp messageRequest;
+    size_t tlvSize = sendEntriesTLV.size();
+    if (!messageRequest.WriteRawData(request, sendEntriesTLV.data(), tlvSize)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "write entries tlv raw data failed size:%{public}zu", tlvSize);
+        return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+    }
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
+int32_t PasteboardEntryGetterProxy::ReadBatchReply(MessageParcel &reply, std::vector<EntryValueRequest> &requests)
+{
+    uint32_t count = reply.ReadUint32();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(count == requests.size(),
+        static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR), PASTEBOARD_MODULE_SERVICE,
+        "batch reply count mismatch, count=%{public}u, expect=%{public}zu", count, requests.size());
+    std::vector<int32_t> results(count);
+    std::vector<int64_t> sizes(count);
+    int64_t totalSize = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        results[i] = reply.ReadInt32();
+        sizes[i] = reply.ReadInt64();
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(sizes[i] >= 0 && sizes[i] <= MessageParcelWarp::GetRawDataSize(),
+            static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR), PASTEBOARD_MODULE_SERVICE,
+            "invalid entry size, index=%{public}u", i);
+        totalSize += sizes[i];
+    }
+    int64_t rawDataSize = reply.ReadInt64();
+    MessageParcelWarp messageReply;
+    if (rawDataSize != totalSize || rawDataSize <= 0 || rawDataSize > messageReply.GetRawDataSize()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read entries tlv raw data size failed");
+        return static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
+    }
+    const uint8_t *rawData = reinterpret_cast<const uint8_t *>(messageReply.ReadRawData(reply, rawDataSize));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr,
+        static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "read entries tlv raw data failed, size=%{public}" PRId64, rawDataSize);
+    size_t offset = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        size_t entrySize = static_cast<size_t>(sizes[i]);
+        requests[i].result = results[i];
+        if (entrySize != 0) {
+            PasteDataEntry entryValue;
+            if (entryValue.Decode(rawData + offset, entrySize)) {
+                requests[i].entry = entryValue;
+                requests[i].entry.rawDataSize_ = sizes[i];
+            } else {
+                PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "unmarshall entry value failed, index=%{public}u", i);
+                requests[i].result = static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
+            }
+        }
+        offset += entrySize;
+    }
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
+int32_t PasteboardEntryGetterProxy::GetRecordValuesByType(std::vector<EntryValueRequest> &requests)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!requests.empty() && requests.size() <= MAX_BATCH_ENTRIES,
+        static_cast<int32_t>(PasteboardError::INVALID_PARAM_ERROR), PASTEBOARD_MODULE_SERVICE,
+        "invalid batch size:%{public}zu", requests.size());
+    MessageParcel request;
+    auto res = MakeBatchRequest(requests, request);
+    if (res != static_cast<int32_t>(PasteboardError::E_OK)) {
+        return res;
+    }
+    MessageParcel reply;
+    MessageOption option;
+    int result = Remote()->SendRequest(
+        static_cast<int>(PasteboardEntryGetterInterfaceCode::GET_RECORD_VALUES_BY_TYPE), request, reply, option);
+    if (result != ERR_OK) {
+        // a getter from before the batch code answers with an ipc error, the caller then asks entry by entry
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "send batch request failed, error:%{public}d", result);
+        return static_cast<int32_t>(PasteboardError::NOT_SUPPORT);
+    }
+    res = reply.ReadInt32();
+    if (res != static_cast<int32_t>(PasteboardError::E_OK)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "batch request failed, res:%{public}d", res);
+        return res;
+    }
+    return ReadBatchReply(reply, requests);
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
@@ -27,6 +27,8 @@ PasteboardEntryGetterStub::PasteboardEntryGetterStub()
 {
     memberFuncMap_[static_cast<uint32_t>(PasteboardEntryGetterInterfaceCode::GET_RECORD_VALUE_BY_TYPE)] =
         &PasteboardEntryGetterStub::OnGetRecordValueByType;
+    memberFuncMap_[static_cast<uint32_t>(PasteboardEntryGetterInterfaceCode::GET_RECORD_VALUES_BY_TYPE)] =
+        &PasteboardEntryGetterStub::OnGetRecordValuesByType;
 }
 
 PasteboardEntryGetterStub::~PasteboardEntryGetterStub()
@@ -67,9 +69,8 @@ int32_t PasteboardEntryGetterStub::OnGetRecordValueByType(MessageParcel &data, M
     const uint8_t *rawData = reinterpret_cast<const uint8_t *>(messageData.ReadRawData(data, rawDataSize));
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr, ERR_INVALID_VALUE,
         PASTEBOARD_MODULE_CLIENT, "read entry tlv raw data failed, size=%{public}" PRId64, rawDataSize);
-    std::vector<uint8_t> recvEntryTlv(rawData, rawData + rawDataSize);
     PasteDataEntry entryValue;
-    bool ret = entryValue.Decode(recvEntryTlv);
+    bool ret = entryValue.Decode(rawData, static_cast<size_t>(rawDataSize));
     if (!ret) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "unmarshall entry value failed");
         return ERR_INVALID_VALUE;
@@ -97,5 +98,101 @@ int32_t PasteboardEntryGetterStub::OnGetRecordValueByType(MessageParcel &data, M
     }
     return ERR_OK;
 }
+
+int32_t PasteboardEntryGetterStub::ReadBatchRequest(MessageParcel &data, std::vector<EntryValueRequest> &requests)
+{
+    uint32_t count = data.ReadUint32();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(count > 0 && count <= MAX_BATCH_ENTRIES, ERR_INVALID_VALUE,
+        PASTEBOARD_MODULE_CLIENT, "invalid batch size:%{public}u", count);
+    requests.resize(count);
+    std::vector<int64_t> sizes(count);
+    int64_t totalSize = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        requests[i].recordId = data.ReadUint32();
+        requests[i].deadlineMs = data.ReadUint32();
+        sizes[i] = data.ReadInt64();
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(sizes[i] > 0 && sizes[i] <= MessageParcelWarp::GetRawDataSize(),
+            ERR_INVALID_VALUE, PASTEBOARD_MODULE_CLIENT, "invalid entry size, index=%{public}u", i);
+        totalSize += sizes[i];
+    }
+    int64_t rawDataSize = data.ReadInt64();
+    MessageParcelWarp messageData;
+    if (rawDataSize != totalSize || rawDataSize > messageData.GetRawDataSize()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "invalid raw data size");
+        return ERR_INVALID_VALUE;
+    }
+    const uint8_t *rawData = reinterpret_cast<const uint8_t *>(messageData.ReadRawData(data, rawDataSize));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(rawData != nullptr, ERR_INVALID_VALUE,
+        PASTEBOARD_MODULE_CLIENT, "read entries tlv raw data failed, size=%{public}" PRId64, rawDataSize);
+    size_t offset = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        size_t entrySize = static_cast<size_t>(sizes[i]);
+        if (!requests[i].entry.Decode(rawData + offset, entrySize)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "unmarshall entry value failed, index=%{public}u", i);
+            return ERR_INVALID_VALUE;
+        }
+        offset += entrySize;
+    }
+    return ERR_OK;
+}
+
+int32_t PasteboardEntryGetterStub::WriteBatchReply(MessageParcel &reply, const std::vector<EntryValueRequest> &requests)
+{
+    if (!reply.WriteUint32(static_cast<uint32_t>(requests.size()))) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "write batch size failed");
+        return ERR_INVALID_VALUE;
+    }
+    std::vector<uint8_t> sendEntriesTLV;
+    for (const auto &item : requests) {
+        int32_t result = item.result;
+        std::vector<uint8_t> entryTLV(0);
+        if (!item.entry.Encode(entryTLV)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "marshall entry value failed");
+            return ERR_INVALID_VALUE;
+        }
+        // a value that does not fit the reply any more goes back empty, the service could not store it either
+        if (static_cast<int64_t>(sendEntriesTLV.size() + entryTLV.size()) > MessageParcelWarp::GetRawDataSize()) {
+            PasteDataEntry emptyEntry;
+            emptyEntry.SetUtdId(item.entry.GetUtdId());
+            emptyEntry.SetMimeType(item.entry.GetMimeType());
+            entryTLV.clear();
+            emptyEntry.Encode(entryTLV);
+            result = static_cast<int32_t>(PasteboardError::EXCEEDING_LIMIT_EXCEPTION);
+        }
+        if (!reply.WriteInt32(result) || !reply.WriteInt64(entryTLV.size())) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "write batch reply failed");
+            return ERR_INVALID_VALUE;
+        }
+        sendEntriesTLV.insert(sendEntriesTLV.end(), entryTLV.begin(), entryTLV.end());
+    }
+    if (!reply.WriteInt64(sendEntriesTLV.size())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "write entries tlv raw data size failed");
+        return ERR_INVALID_VALUE;
+    }
+    MessageParcelWarp messageReply;
+    size_t tlvSize = sendEntriesTLV.size();
+    if (!messageReply.WriteRawData(reply, sendEntriesTLV.data(), tlvSize)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "write entries tlv raw data failed size:%{public}zu", tlvSize);
+        return ERR_INVALID_VALUE;
+    }
+    return ERR_OK;
+}
+
+int32_t PasteboardEntryGetterStub::OnGetRecordValuesByType(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<EntryValueRequest> requests;
+    if (ReadBatchRequest(data, requests) != ERR_OK) {
+        return ERR_INVALID_VALUE;
+    }
+    auto result = GetRecordValuesByType(requests);
+    if (!reply.WriteInt32(result)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write result:%{public}d", result);
+        return ERR_INVALID_VALUE;
+    }
+    if (result != static_cast<int32_t>(PasteboardError::E_OK)) {
+        return ERR_OK;
+    }
+    return WriteBatchReply(reply, requests);
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,530 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::AshmemPool and SealedAshmem
+// (framework/tlv/ashmem_pool.cpp).
+//
+// The fake ashmem backs regions with memfds, so regions are really mapped, shared
+// and sealed. Covers reuse and best fit, the idle bounds, the shared read-only
+// placeholder, failure paths (no fd leaks, no fdsan violations), exclusive use
+// under concurrent acquirers, and PooledCopyCost, which compares a pooled 1 MiB
+// copy with one that creates and maps a fresh region every time. The sealed
+// region tests check that no dup can write it, and SealedShareCost compares
+// sharing one sealed region with a fresh copy per reader.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ashmem.h"
+#include "ashmem_pool.h"
+#include "fd_san.h"
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr size_t KIB = 1024;
+constexpr size_t MIB = 1024 * KIB;
+constexpr size_t MIN_CAPACITY = 64 * KIB;
+constexpr size_t MAX_IDLE_BYTES = 16 * MIB;
+constexpr size_t MAX_IDLE_REGIONS = 4;
+constexpr int THREADS = 8;
+constexpr int ROUNDS = 200;
+constexpr size_t PERF_SIZE = MIB;
+constexpr int PERF_ROUNDS = 200;
+
+AshmemPool::Stats Delta(const AshmemPool::Stats &before)
+{
+    auto now = AshmemPool::GetInstance().GetStats();
+    AshmemPool::Stats delta;
+    delta.hits = now.hits - before.hits;
+    delta.misses = now.misses - before.misses;
+    delta.reusedBytes = now.reusedBytes - before.reusedBytes;
+    delta.evictions = now.evictions - before.evictions;
+    delta.placeholders = now.placeholders - before.placeholders;
+    return delta;
+}
+
+bool IsOpen(int fd)
+{
+    return ::fcntl(fd, F_GETFD) != -1;
+}
+} // namespace
+
+class AshmemPoolHostTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        AshmemPool::GetInstance().Clear();
+        hosttest_ashmem::g_failCreate = false;
+        hosttest_ashmem::g_failSetProt = false;
+        hosttest_fdsan::g_violations = 0;
+        before_ = AshmemPool::GetInstance().GetStats();
+    }
+
+    void TearDown() override
+    {
+        AshmemPool::GetInstance().Clear();
+        EXPECT_EQ(hosttest_fdsan::g_violations, 0);
+    }
+
+    AshmemPool::Stats before_;
+};
+
+/**
+ * @tc.name: ReuseAfterRecycle
+ * @tc.desc: a recycled region comes back mapped and writable for the next payload that fits, and the
+ *           counters record the hit and the bytes it saved creating.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, ReuseAfterRecycle, TestSize.Level0)
+{
+    auto &pool = AshmemPool::GetInstance();
+    AshmemPool::Region region;
+    ASSERT_TRUE(pool.Acquire(40 * KIB, region));
+    EXPECT_EQ(region.capacity, MIN_CAPACITY);
+    std::memset(region.ptr, 'a', 40 * KIB);
+    const int fd = region.fd;
+    void *const ptr = region.ptr;
+    pool.Recycle(region);
+    EXPECT_EQ(region.fd, -1);
+    EXPECT_EQ(region.ptr, nullptr);
+    EXPECT_TRUE(IsOpen(fd));
+
+    AshmemPool::Region again;
+    ASSERT_TRUE(pool.Acquire(50 * KIB, again));
+    EXPECT_EQ(again.fd, fd);
+    EXPECT_EQ(again.ptr, ptr);
+    std::memset(again.ptr, 'b', 50 * KIB);
+    pool.Recycle(again);
+
+    auto delta = Delta(before_);
+    EXPECT_EQ(delta.hits, 1U);
+    EXPECT_EQ(delta.misses, 1U);
+    EXPECT_EQ(delta.reusedBytes, 50 * KIB);
+
+    pool.Clear();
+    EXPECT_FALSE(IsOpen(fd));
+}
+
+/**
+ * @tc.name: BestFitAndRounding
+ * @tc.desc: capacities are rounded up to powers of two from 64 KiB, a payload takes the smallest idle region
+ *           that fits, and one larger than every idle region gets a new one.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, BestFitAndRounding, TestSize.Level0)
+{
+    auto &pool = AshmemPool::GetInstance();
+    AshmemPool::Region large;
+    AshmemPool::Region small;
+    ASSERT_TRUE(pool.Acquire(MIB, large));
+    ASSERT_TRUE(pool.Acquire(100 * KIB, small));
+    EXPECT_EQ(large.capacity, MIB);
+    EXPECT_EQ(small.capacity, 128 * KIB);
+    const int smallFd = small.fd;
+    const int largeFd = large.fd;
+    pool.Recycle(large);
+    pool.Recycle(small);
+
+    AshmemPool::Region fit;
+    ASSERT_TRUE(pool.Acquire(70 * KIB, fit));
+    EXPECT_EQ(fit.fd, smallFd);
+    AshmemPool::Region bigger;
+    ASSERT_TRUE(pool.Acquire(2 * MIB, bigger));
+    EXPECT_NE(bigger.fd, largeFd);
+    EXPECT_EQ(bigger.capacity, 2 * MIB);
+    pool.Recycle(fit);
+    pool.Recycle(bigger);
+
+    auto delta = Delta(before_);
+    EXPECT_EQ(delta.hits, 1U);
+    EXPECT_EQ(delta.misses, 3U);
+}
+
+/**
+ * @tc.name: IdleBounded
+ * @tc.desc: the pool keeps at most four idle regions and 16 MiB, evicting the oldest first, and never keeps
+ *           a region larger than that.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, IdleBounded, TestSize.Level0)
+{
+    auto &pool = AshmemPool::GetInstance();
+    std::vector<AshmemPool::Region> regions(MAX_IDLE_REGIONS + 1);
+    for (auto &region : regions) {
+        ASSERT_TRUE(pool.Acquire(MIN_CAPACITY, region));
+    }
+    const int oldest = regions[0].fd;
+    for (auto &region : regions) {
+        pool.Recycle(region);
+    }
+    EXPECT_EQ(Delta(before_).evictions, 1U);
+    EXPECT_FALSE(IsOpen(oldest));
+
+    // 8 MiB + 8 MiB fill the byte budget, the next region pushes the first out
+    AshmemPool::Region first;
+    AshmemPool::Region second;
+    AshmemPool::Region third;
+    ASSERT_TRUE(pool.Acquire(8 * MIB, first));
+    ASSERT_TRUE(pool.Acquire(8 * MIB, second));
+    ASSERT_TRUE(pool.Acquire(MIN_CAPACITY, third));
+    const int firstFd = first.fd;
+    pool.Clear();
+    pool.Recycle(first);
+    pool.Recycle(second);
+    pool.Recycle(third);
+    EXPECT_FALSE(IsOpen(firstFd));
+
+    AshmemPool::Region huge;
+    ASSERT_TRUE(pool.Acquire(MAX_IDLE_BYTES + 1, huge));
+    EXPECT_EQ(huge.capacity, MAX_IDLE_BYTES + 1);
+    const int hugeFd = huge.fd;
+    pool.Recycle(huge);
+    EXPECT_FALSE(IsOpen(hugeFd));
+    EXPECT_EQ(huge.fd, -1);
+}
+
+/**
+ * @tc.name: PlaceholderShared
+ * @tc.desc: every placeholder fd is a dup of one sealed one-byte region, so no receiver can write through
+ *           it, and closing a dup leaves the pool's own fd open.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, PlaceholderShared, TestSize.Level0)
+{
+    auto &pool = AshmemPool::GetInstance();
+    int created = hosttest_ashmem::g_created;
+    int first = pool.DupPlaceholder();
+    int second = pool.DupPlaceholder();
+    ASSERT_GE(first, 0);
+    ASSERT_GE(second, 0);
+    EXPECT_NE(first, second);
+    EXPECT_LE(hosttest_ashmem::g_created - created, 1);
+
+    struct stat firstStat {};
+    struct stat secondStat {};
+    ASSERT_EQ(::fstat(first, &firstStat), 0);
+    ASSERT_EQ(::fstat(second, &secondStat), 0);
+    EXPECT_EQ(firstStat.st_ino, secondStat.st_ino);
+    EXPECT_EQ(firstStat.st_size, 1);
+    EXPECT_EQ(::mmap(nullptr, 1, PROT_READ | PROT_WRITE, MAP_SHARED, first, 0), MAP_FAILED);
+    void *ptr = ::mmap(nullptr, 1, PROT_READ, MAP_SHARED, first, 0);
+    ASSERT_NE(ptr, MAP_FAILED);
+    ::munmap(ptr, 1);
+
+    // the caller tags and closes its dup as it did the fd of its own tmp region
+    fdsan_exchange_owner_tag(first, 0, PASTEBOARD_FD_TAG);
+    fdsan_close_with_tag(first, PASTEBOARD_FD_TAG);
+    int third = pool.DupPlaceholder();
+    ASSERT_GE(third, 0);
+    ASSERT_EQ(::fstat(third, &secondStat), 0);
+    EXPECT_EQ(firstStat.st_ino, secondStat.st_ino);
+    ::close(second);
+    ::close(third);
+    EXPECT_EQ(Delta(before_).placeholders, 3U);
+}
+
+/**
+ * @tc.name: FailuresLeaveNothingOpen
+ * @tc.desc: a failed create or prot change returns no region and closes what it opened, an empty region
+ *           recycles to nothing, and a zero size is refused.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, FailuresLeaveNothingOpen, TestSize.Level0)
+{
+    auto &pool = AshmemPool::GetInstance();
+    AshmemPool::Region region;
+    EXPECT_FALSE(pool.Acquire(0, region));
+
+    hosttest_ashmem::g_failCreate = true;
+    EXPECT_FALSE(pool.Acquire(MIN_CAPACITY, region));
+    EXPECT_EQ(region.fd, -1);
+    hosttest_ashmem::g_failCreate = false;
+
+    int probe = ::dup(0);
+    ::close(probe);
+    hosttest_ashmem::g_failSetProt = true;
+    EXPECT_FALSE(pool.Acquire(MIN_CAPACITY, region));
+    EXPECT_EQ(region.fd, -1);
+    EXPECT_FALSE(IsOpen(probe));
+    hosttest_ashmem::g_failSetProt = false;
+
+    pool.Recycle(region);
+    EXPECT_EQ(Delta(before_).misses, 2U);
+}
+
+/**
+ * @tc.name: PlaceholderFailures
+ * @tc.desc: the placeholder is retried after a failed create or seal, and a failed seal closes its fd.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, PlaceholderFailures, TestSize.Level0)
+{
+    auto &pool = AshmemPool::GetInstance();
+    // the placeholder of an earlier test is kept for the life of the process, drop it to reach the create
+    int old = pool.placeholderFd_;
+    if (old >= 0) {
+        fdsan_close_with_tag(old, PASTEBOARD_FD_TAG);
+        pool.placeholderFd_ = -1;
+    }
+    hosttest_ashmem::g_failCreate = true;
+    EXPECT_EQ(pool.DupPlaceholder(), -1);
+    hosttest_ashmem::g_failCreate = false;
+    hosttest_ashmem::g_failSetProt = true;
+    EXPECT_EQ(pool.DupPlaceholder(), -1);
+    EXPECT_EQ(pool.placeholderFd_, -1);
+    hosttest_ashmem::g_failSetProt = false;
+    int fd = pool.DupPlaceholder();
+    ASSERT_GE(fd, 0);
+    ::close(fd);
+    EXPECT_EQ(Delta(before_).placeholders, 1U);
+}
+
+/**
+ * @tc.name: ConcurrentAcquirers
+ * @tc.desc: eight threads acquire, fill, check and recycle regions at once; no region is handed to two of
+ *           them, and every acquire is counted as a hit or a miss.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, ConcurrentAcquirers, TestSize.Level0)
+{
+    auto &pool = AshmemPool::GetInstance();
+    std::atomic<int> corrupted{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&pool, &corrupted, t]() {
+            for (int i = 0; i < ROUNDS; ++i) {
+                size_t size = MIN_CAPACITY * (1 + (i + t) % 3);
+                AshmemPool::Region region;
+                if (!pool.Acquire(size, region)) {
+                    ++corrupted;
+                    return;
+                }
+                auto *bytes = static_cast<uint8_t *>(region.ptr);
+                std::memset(bytes, t, size);
+                std::this_thread::yield();
+                for (size_t j = 0; j < size; j += KIB) {
+                    if (bytes[j] != t) {
+                        ++corrupted;
+                        break;
+                    }
+                }
+                pool.Recycle(region);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(corrupted.load(), 0);
+    auto delta = Delta(before_);
+    EXPECT_EQ(delta.hits + delta.misses, static_cast<uint64_t>(THREADS * ROUNDS));
+    EXPECT_GT(delta.hits, delta.misses);
+}
+
+/**
+ * @tc.name: PooledCopyCost
+ * @tc.desc: reports the time of a 1 MiB copy into a pooled region and into a region created, mapped and
+ *           unmapped for the copy alone, as every large request did before the pool.
+ * @tc.type: PERF
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, PooledCopyCost, TestSize.Level0)
+{
+    auto &pool = AshmemPool::GetInstance();
+    std::vector<uint8_t> payload(PERF_SIZE, 'p');
+    auto copy = [&pool, &payload](bool keep) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < PERF_ROUNDS; ++i) {
+            AshmemPool::Region region;
+            if (!pool.Acquire(payload.size(), region)) {
+                return -1.0;
+            }
+            std::memcpy(region.ptr, payload.data(), payload.size());
+            pool.Recycle(region);
+            if (!keep) {
+                pool.Clear();
+            }
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() /
+            PERF_ROUNDS;
+    };
+    double fresh = copy(false);
+    auto afterFresh = pool.GetStats();
+    double pooled = copy(true);
+    ASSERT_GT(fresh, 0);
+    ASSERT_GT(pooled, 0);
+    auto delta = Delta(afterFresh);
+    std::printf("[PERF] 1 MiB copy: fresh region %.1f us, pooled region %.1f us, hit rate %.1f%%\n", fresh,
+        pooled, 100.0 * delta.hits / (delta.hits + delta.misses));
+    EXPECT_EQ(delta.hits, static_cast<uint64_t>(PERF_ROUNDS - 1));
+    EXPECT_LT(pooled, fresh);
+}
+
+/**
+ * @tc.name: SealedRegionSharedReadOnly
+ * @tc.desc: a sealed region holds what its writer wrote, every dup reads it and none can map it writable,
+ *           and a dup outlives the release of the region.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, SealedRegionSharedReadOnly, TestSize.Level0)
+{
+    const size_t size = 100 * KIB;
+    auto sealed = SealedAshmem::Create(size, [](uint8_t *data, size_t len) {
+        std::memset(data, 's', len);
+        return true;
+    });
+    ASSERT_NE(sealed, nullptr);
+    EXPECT_EQ(sealed->GetSize(), size);
+    const int owned = sealed->fd_;
+
+    int fd = sealed->Dup();
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0), MAP_FAILED);
+    sealed.reset();
+    EXPECT_FALSE(IsOpen(owned));
+
+    void *ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ASSERT_NE(ptr, MAP_FAILED);
+    const auto *bytes = static_cast<const uint8_t *>(ptr);
+    EXPECT_EQ(bytes[0], 's');
+    EXPECT_EQ(bytes[size - 1], 's');
+    ::munmap(ptr, size);
+    ::close(fd);
+}
+
+/**
+ * @tc.name: SealedRegionFailures
+ * @tc.desc: a zero size, a missing or failing writer, and a failed create, prot change or seal give no region
+ *           and close what they opened.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, SealedRegionFailures, TestSize.Level0)
+{
+    auto fill = [](uint8_t *data, size_t len) {
+        std::memset(data, 'f', len);
+        return true;
+    };
+    EXPECT_EQ(SealedAshmem::Create(0, fill), nullptr);
+    EXPECT_EQ(SealedAshmem::Create(MIN_CAPACITY, nullptr), nullptr);
+
+    int probe = ::dup(0);
+    ::close(probe);
+    EXPECT_EQ(SealedAshmem::Create(MIN_CAPACITY, [](uint8_t *, size_t) { return false; }), nullptr);
+    EXPECT_FALSE(IsOpen(probe));
+
+    hosttest_ashmem::g_failCreate = true;
+    EXPECT_EQ(SealedAshmem::Create(MIN_CAPACITY, fill), nullptr);
+    hosttest_ashmem::g_failCreate = false;
+
+    hosttest_ashmem::g_failSetProt = true;
+    EXPECT_EQ(SealedAshmem::Create(MIN_CAPACITY, fill), nullptr);
+    EXPECT_FALSE(IsOpen(probe));
+    hosttest_ashmem::g_failSetProt = false;
+
+    // the writer succeeds and the seal after it fails
+    EXPECT_EQ(SealedAshmem::Create(MIN_CAPACITY, [&fill](uint8_t *data, size_t len) {
+        hosttest_ashmem::g_failSetProt = true;
+        return fill(data, len);
+    }), nullptr);
+    EXPECT_FALSE(IsOpen(probe));
+    hosttest_ashmem::g_failSetProt = false;
+}
+
+/**
+ * @tc.name: SealedShareCost
+ * @tc.desc: reports the time to hand one reader a clip of 256 KiB and of 4 MiB, as a copy into a fresh region
+ *           and as a dup of one sealed region the reader maps.
+ * @tc.type: PERF
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(AshmemPoolHostTest, SealedShareCost, TestSize.Level0)
+{
+    for (size_t size : { 256 * KIB, 4 * MIB }) {
+        std::vector<uint8_t> payload(size, 'c');
+        auto writer = [&payload](uint8_t *data, size_t len) {
+            std::memcpy(data, payload.data(), len);
+            return true;
+        };
+        // what a reader gets for the paste: a dup of the region, mapped, read and closed
+        auto read = [size](const SealedAshmem &region) {
+            int fd = region.Dup();
+            if (fd < 0) {
+                return false;
+            }
+            fdsan_exchange_owner_tag(fd, 0, PASTEBOARD_FD_TAG);
+            void *ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            bool ok = ptr != MAP_FAILED && static_cast<const uint8_t *>(ptr)[size - 1] == 'c';
+            if (ptr != MAP_FAILED) {
+                ::munmap(ptr, size);
+            }
+            fdsan_close_with_tag(fd, PASTEBOARD_FD_TAG);
+            return ok;
+        };
+        auto time = [](const std::function<bool()> &reader) {
+            auto begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < PERF_ROUNDS; ++i) {
+                if (!reader()) {
+                    return -1.0;
+                }
+            }
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() /
+                PERF_ROUNDS;
+        };
+        double fresh = time([&]() {
+            auto region = SealedAshmem::Create(size, writer);
+            return region != nullptr && read(*region);
+        });
+        auto sealed = SealedAshmem::Create(size, writer);
+        ASSERT_NE(sealed, nullptr);
+        double shared = time([&]() { return read(*sealed); });
+        ASSERT_GT(fresh, 0);
+        ASSERT_GT(shared, 0);
+        std::printf("[PERF] %zu KiB clip per reader: fresh region %.1f us, sealed region dup %.1f us\n",
+            size / KIB, fresh, shared);
+        EXPECT_LT(shared, fresh);
+    }
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HOST-TEST FAKE for c_utils ashmem.h (ashmem_pool suite).
+//
+// Backs a region with a memfd, so mapping, sharing and dup behave as on a device.
+// AshmemSetProt without PROT_WRITE seals the memfd against writes: like the ashmem
+// prot mask, it cannot be undone and a later writable shared mapping fails.
+// hosttest_ashmem exposes failure switches and a count of created regions.
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_ASHMEM_H
+#define PASTEBOARD_HOSTTEST_FAKE_ASHMEM_H
+
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace hosttest_ashmem {
+inline bool g_failCreate = false;
+inline bool g_failSetProt = false;
+inline int g_created = 0;
+} // namespace hosttest_ashmem
+
+namespace OHOS {
+inline int AshmemCreate(const char *name, size_t size)
+{
+    if (hosttest_ashmem::g_failCreate) {
+        return -1;
+    }
+    int fd = ::memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return -1;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    ++hosttest_ashmem::g_created;
+    return fd;
+}
+
+inline int AshmemSetProt(int fd, int prot)
+{
+    if (hosttest_ashmem::g_failSetProt) {
+        return -1;
+    }
+    if ((prot & PROT_WRITE) != 0) {
+        return 0;
+    }
+    return ::fcntl(fd, F_ADD_SEALS, F_SEAL_WRITE | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+}
+} // namespace OHOS
+
+#endif // PASTEBOARD_HOSTTEST_FAKE_ASHMEM_H
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HOST-TEST FAKE for fd_san.h and the musl fdsan calls it relies on (ashmem_pool suite).
+//
+// Keeps the owner tag of every fd like fdsan does. Where fdsan would abort the
+// process (exchanging from a wrong tag, closing with a wrong tag) the fake counts
+// a violation instead, so a test can assert there were none.
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_FD_SAN_H
+#define PASTEBOARD_HOSTTEST_FAKE_FD_SAN_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unistd.h>
+
+#define PASTEBOARD_FD_TAG 0xD001C11ULL
+
+namespace hosttest_fdsan {
+inline std::mutex g_mutex;
+inline std::map<int, uint64_t> g_tags;
+inline int g_violations = 0;
+
+inline uint64_t TagOf(int fd)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto it = g_tags.find(fd);
+    return it == g_tags.end() ? 0 : it->second;
+}
+} // namespace hosttest_fdsan
+
+inline void fdsan_exchange_owner_tag(int fd, uint64_t expectedTag, uint64_t newTag)
+{
+    std::lock_guard<std::mutex> lock(hosttest_fdsan::g_mutex);
+    uint64_t &tag = hosttest_fdsan::g_tags[fd];
+    if (tag != expectedTag) {
+        ++hosttest_fdsan::g_violations;
+        return;
+    }
+    tag = newTag;
+}
+
+inline int fdsan_close_with_tag(int fd, uint64_t tag)
+{
+    {
+        std::lock_guard<std::mutex> lock(hosttest_fdsan::g_mutex);
+        auto it = hosttest_fdsan::g_tags.find(fd);
+        if ((it == hosttest_fdsan::g_tags.end() ? 0 : it->second) != tag) {
+            ++hosttest_fdsan::g_violations;
+            return -1;
+        }
+        if (it != hosttest_fdsan::g_tags.end()) {
+            hosttest_fdsan::g_tags.erase(it);
+        }
+    }
+    return ::close(fd);
+}
+
+#endif // PASTEBOARD_HOSTTEST_FAKE_FD_SAN_H
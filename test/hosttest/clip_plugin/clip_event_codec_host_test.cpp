@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::ClipEventCodec
+// (framework/framework/clip/clip_event_codec.cpp).
+//
+// Round trips of GlobalEvent in the binary format and in the JSON kept for older
+// peers, rejection of malformed buffers, and EventCodecCost, which compares size and
+// encode/decode time of both for an event of a typical multi-type clip.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "clip/clip_event_codec.h"
+#include "clip/loopback_clip.h"
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr int PERF_ROUNDS = 2000;
+constexpr size_t OVERSIZED_LENGTH = 70000;
+constexpr size_t VERSION_POS = 2;
+
+ClipPlugin::GlobalEvent TypicalEvent()
+{
+    ClipPlugin::GlobalEvent event;
+    event.version = ClipPlugin::InfoType::MIMETYPE;
+    event.frameNum = 3;
+    event.user = 100;
+    event.seqId = 4321;
+    event.status = ClipPlugin::EVT_NORMAL;
+    event.syncTime = -1;
+    event.dataId = 77;
+    event.expiration = 1234567890123ULL;
+    event.isDelay = true;
+    event.notNeedLink = true;
+    event.deviceId = std::string(64, 'd');
+    event.account = "ohosAnonymousUid-0123456789abcdef";
+    event.dataType = { "text/plain", "text/html", "text/uri", "pixelMap", "text/want" };
+    event.utdTypes = { "general.file-uri", "general.html", "general.plain-text", "openharmony.pixel-map",
+        "openharmony.want" };
+    event.recordCount = 5;
+    event.payloadVersion = 1;
+    event.acceptPayloadVersion = 1;
+    event.acceptFrames = true;
+    event.acceptEventVersion = ClipEventCodec::LATEST;
+    return event;
+}
+
+void ExpectSameWireFields(const ClipPlugin::GlobalEvent &lhs, const ClipPlugin::GlobalEvent &rhs)
+{
+    EXPECT_EQ(lhs.version, rhs.version);
+    EXPECT_EQ(lhs.frameNum, rhs.frameNum);
+    EXPECT_EQ(lhs.user, rhs.user);
+    EXPECT_EQ(lhs.seqId, rhs.seqId);
+    EXPECT_EQ(lhs.status, rhs.status);
+    EXPECT_EQ(lhs.syncTime, rhs.syncTime);
+    EXPECT_EQ(lhs.expiration, rhs.expiration);
+    EXPECT_EQ(lhs.deviceId, rhs.deviceId);
+    EXPECT_EQ(lhs.account, rhs.account);
+    EXPECT_EQ(lhs.dataType, rhs.dataType);
+    EXPECT_EQ(lhs.utdTypes, rhs.utdTypes);
+    EXPECT_EQ(lhs.recordCount, rhs.recordCount);
+    EXPECT_EQ(lhs.payloadVersion, rhs.payloadVersion);
+    EXPECT_EQ(lhs.acceptPayloadVersion, rhs.acceptPayloadVersion);
+    EXPECT_EQ(lhs.acceptFrames, rhs.acceptFrames);
+    EXPECT_EQ(lhs.acceptEventVersion, rhs.acceptEventVersion);
+}
+
+template<typename Func>
+double AverageUs(Func func)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < PERF_ROUNDS; ++i) {
+        func();
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() /
+        PERF_ROUNDS;
+}
+} // namespace
+
+class ClipEventCodecHostTest : public testing::Test {};
+
+/**
+ * @tc.name: BinaryRoundTrip
+ * @tc.desc: a peer that announced BINARY_V1 gets the binary format, which keeps every field of the event,
+ *           including the ones the JSON never carried.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipEventCodecHostTest, BinaryRoundTrip, TestSize.Level0)
+{
+    const auto event = TypicalEvent();
+    auto buffer = ClipEventCodec::Encode(event, ClipEventCodec::LATEST);
+    ASSERT_GE(buffer.size(), 3U);
+    EXPECT_EQ(buffer[0], 'G');
+    EXPECT_EQ(buffer[1], 'E');
+    EXPECT_EQ(buffer[VERSION_POS], ClipEventCodec::BINARY_V1);
+
+    ClipPlugin::GlobalEvent decoded;
+    ASSERT_TRUE(ClipEventCodec::Decode(buffer, decoded));
+    ExpectSameWireFields(decoded, event);
+    EXPECT_EQ(decoded.dataId, event.dataId);
+    EXPECT_TRUE(decoded.isDelay);
+    EXPECT_TRUE(decoded.notNeedLink);
+
+    ClipPlugin::GlobalEvent empty;
+    ASSERT_TRUE(ClipEventCodec::Decode(ClipEventCodec::Encode(empty, ClipEventCodec::LATEST), decoded));
+    ExpectSameWireFields(decoded, empty);
+    EXPECT_FALSE(decoded.isDelay);
+}
+
+/**
+ * @tc.name: OldPeerGetsJson
+ * @tc.desc: a peer that announced nothing gets the Marshall JSON, and Decode takes JSON of any sender.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipEventCodecHostTest, OldPeerGetsJson, TestSize.Level0)
+{
+    const auto event = TypicalEvent();
+    auto buffer = ClipEventCodec::Encode(event, ClipEventCodec::JSON);
+    EXPECT_EQ(std::string(buffer.begin(), buffer.end()), event.Marshall());
+
+    ClipPlugin::GlobalEvent decoded;
+    ASSERT_TRUE(ClipEventCodec::Decode(buffer, decoded));
+    ExpectSameWireFields(decoded, event);
+
+    // an older sender knows none of the optional fields
+    const std::string old = R"({"version":0,"frameNum":0,"user":100,"seqId":9,"expiration":5,"status":2,)"
+        R"("deviceId":"old","account":"a","dataType":["text/plain"],"syncTime":0})";
+    ASSERT_TRUE(ClipEventCodec::Decode(std::vector<uint8_t>(old.begin(), old.end()), decoded));
+    EXPECT_EQ(decoded.seqId, 9);
+    EXPECT_EQ(decoded.acceptEventVersion, ClipEventCodec::JSON);
+    EXPECT_FALSE(decoded.HasTypeInfo());
+}
+
+/**
+ * @tc.name: MalformedRejected
+ * @tc.desc: empty, truncated and unknown-version buffers are rejected and leave the event as it was; bytes
+ *           appended by a later version are skipped.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipEventCodecHostTest, MalformedRejected, TestSize.Level0)
+{
+    ClipPlugin::GlobalEvent decoded;
+    decoded.seqId = 1;
+    EXPECT_FALSE(ClipEventCodec::Decode({}, decoded));
+    EXPECT_FALSE(ClipEventCodec::Decode({ '{', 'x' }, decoded));
+
+    const auto buffer = ClipEventCodec::Encode(TypicalEvent(), ClipEventCodec::LATEST);
+    for (size_t size = 3; size < buffer.size(); ++size) {
+        std::vector<uint8_t> cut(buffer.begin(), buffer.begin() + size);
+        EXPECT_FALSE(ClipEventCodec::Decode(cut, decoded)) << "size " << size;
+    }
+    EXPECT_EQ(decoded.seqId, 1);
+
+    auto unknown = buffer;
+    unknown[VERSION_POS] = 0;
+    EXPECT_FALSE(ClipEventCodec::Decode(unknown, decoded));
+
+    auto newer = buffer;
+    newer[VERSION_POS] = ClipEventCodec::LATEST + 1;
+    newer.insert(newer.end(), { 1, 2, 3 });
+    ASSERT_TRUE(ClipEventCodec::Decode(newer, decoded));
+    EXPECT_EQ(decoded.seqId, TypicalEvent().seqId);
+}
+
+/**
+ * @tc.name: OversizedFallsBackToJson
+ * @tc.desc: a string too long for the binary length prefix sends the event as JSON.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipEventCodecHostTest, OversizedFallsBackToJson, TestSize.Level0)
+{
+    auto event = TypicalEvent();
+    event.account = std::string(OVERSIZED_LENGTH, 'a');
+    auto buffer = ClipEventCodec::Encode(event, ClipEventCodec::LATEST);
+    ASSERT_FALSE(buffer.empty());
+    EXPECT_EQ(buffer[0], '{');
+    ClipPlugin::GlobalEvent decoded;
+    ASSERT_TRUE(ClipEventCodec::Decode(buffer, decoded));
+    EXPECT_EQ(decoded.account.size(), OVERSIZED_LENGTH);
+
+    event = TypicalEvent();
+    event.dataType.assign(OVERSIZED_LENGTH, "t");
+    buffer = ClipEventCodec::Encode(event, ClipEventCodec::LATEST);
+    EXPECT_EQ(buffer[0], '{');
+}
+
+/**
+ * @tc.name: LoopbackOlderPeer
+ * @tc.desc: through a loopback link to an older peer the event crosses as JSON and loses what JSON does not
+ *           carry; the binary link keeps it.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipEventCodecHostTest, LoopbackOlderPeer, TestSize.Level0)
+{
+    const auto event = TypicalEvent();
+    LoopbackClip::LinkConfig config;
+    config.eventVersion = ClipEventCodec::JSON;
+    LoopbackClip older(config);
+    ASSERT_EQ(older.SetPasteData(event, {}, 0, {}), 0);
+    auto events = older.GetTopEvents(1, event.user);
+    ASSERT_EQ(events.size(), 1U);
+    EXPECT_EQ(events[0].seqId, event.seqId);
+    EXPECT_EQ(events[0].dataId, 0U);
+    EXPECT_FALSE(events[0].isDelay);
+
+    LoopbackClip current;
+    ASSERT_EQ(current.SetPasteData(event, {}, 0, {}), 0);
+    events = current.GetTopEvents(1, event.user);
+    ASSERT_EQ(events.size(), 1U);
+    EXPECT_EQ(events[0].dataId, event.dataId);
+    EXPECT_TRUE(events[0].isDelay);
+}
+
+/**
+ * @tc.name: EventCodecCost
+ * @tc.desc: reports size and encode/decode time of a typical event as JSON and binary; binary must be
+ *           smaller and cheaper both ways. The strings are the same in both, the saving is in the field names.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipEventCodecHostTest, EventCodecCost, TestSize.Level0)
+{
+    const auto event = TypicalEvent();
+    const auto json = ClipEventCodec::Encode(event, ClipEventCodec::JSON);
+    const auto binary = ClipEventCodec::Encode(event, ClipEventCodec::LATEST);
+    ClipPlugin::GlobalEvent decoded;
+    bool ok = true;
+    double jsonEncode = AverageUs([&event]() { ClipEventCodec::Encode(event, ClipEventCodec::JSON); });
+    double jsonDecode = AverageUs([&json, &decoded, &ok]() { ok = ClipEventCodec::Decode(json, decoded) && ok; });
+    double binaryEncode = AverageUs([&event]() { ClipEventCodec::Encode(event, ClipEventCodec::LATEST); });
+    double binaryDecode = AverageUs([&binary, &decoded, &ok]() {
+        ok = ClipEventCodec::Decode(binary, decoded) && ok;
+    });
+    ASSERT_TRUE(ok);
+    std::printf("[PERF] event json %zu bytes, encode %.2f us, decode %.2f us\n", json.size(), jsonEncode,
+        jsonDecode);
+    std::printf("[PERF] event binary %zu bytes, encode %.2f us, decode %.2f us\n", binary.size(), binaryEncode,
+        binaryDecode);
+    EXPECT_LT(binary.size(), json.size());
+    EXPECT_LT(binaryEncode, jsonEncode);
+    EXPECT_LT(binaryDecode, jsonDecode);
+}
+} // namespace OHOS::MiscServices
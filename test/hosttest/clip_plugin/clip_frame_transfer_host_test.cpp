@@ -0,0 +1,560 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::ClipFrameTransfer / ClipFrameReader
+// (framework/framework/clip/clip_frame_transfer.cpp).
+//
+// A clip of string "records" is cut into frames, sealed and published through an
+// in-process ClipPlugin that serves one frame per call, the way the distributed
+// plugin would. The receiver pulls the frames with ClipFrameReader; the tests check
+// that decoding overlaps the transfer and that an interrupted transfer resumes at
+// the first frame that was not acknowledged.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "clip/clip_frame_transfer.h"
+#include "clip/clip_payload_codec.h"
+#include "clip/clip_plugin.h"
+#include "pasteboard_error.h"
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr size_t RECORD_SIZE = 200 * 1024;
+constexpr size_t RECORD_NUM = 12;
+constexpr int32_t USER_ONE = 1;
+constexpr int32_t ERR_LINK_LOST = 7;
+constexpr int32_t ERR_BAD_FRAME = 8;
+constexpr int32_t SYNC_TIME_PER_FRAME = 3;
+constexpr auto OVERLAP_WAIT = std::chrono::seconds(5);
+
+std::vector<std::string> MakeRecords(size_t count, size_t size)
+{
+    std::vector<std::string> records;
+    for (size_t i = 0; i < count; ++i) {
+        std::string record = "<p>record " + std::to_string(i) + "</p>";
+        while (record.size() < size) {
+            record += "<span>pasteboard " + std::to_string(record.size() % 31) + "</span>";
+        }
+        record.resize(size);
+        records.push_back(record);
+    }
+    return records;
+}
+
+// stand-in for a PasteData encoding: each record with a 4 byte length in front
+std::vector<uint8_t> EncodeRecords(const std::vector<std::string> &records, size_t begin, size_t end)
+{
+    std::vector<uint8_t> frame;
+    for (size_t i = begin; i < end; ++i) {
+        uint32_t len = static_cast<uint32_t>(records[i].size());
+        for (size_t byte = 0; byte < sizeof(len); ++byte) {
+            frame.push_back(static_cast<uint8_t>(len >> (byte * 8)));
+        }
+        frame.insert(frame.end(), records[i].begin(), records[i].end());
+    }
+    return frame;
+}
+
+bool DecodeRecords(const std::vector<uint8_t> &frame, std::vector<std::string> &records)
+{
+    size_t pos = 0;
+    while (pos < frame.size()) {
+        if (frame.size() - pos < sizeof(uint32_t)) {
+            return false;
+        }
+        uint32_t len = 0;
+        for (size_t byte = 0; byte < sizeof(len); ++byte) {
+            len |= static_cast<uint32_t>(frame[pos + byte]) << (byte * 8);
+        }
+        pos += sizeof(len);
+        if (frame.size() - pos < len) {
+            return false;
+        }
+        records.emplace_back(frame.begin() + pos, frame.begin() + pos + len);
+        pos += len;
+    }
+    return true;
+}
+
+std::vector<std::vector<uint8_t>> MakeFrames(const std::vector<std::string> &records, uint8_t peerVersion)
+{
+    std::vector<size_t> sizes;
+    for (const auto &record : records) {
+        sizes.push_back(record.size());
+    }
+    auto starts = ClipFrameTransfer::PlanFrames(sizes);
+    starts.push_back(records.size());
+    std::vector<std::vector<uint8_t>> frames;
+    for (size_t i = 0; i + 1 < starts.size(); ++i) {
+        frames.push_back(EncodeRecords(records, starts[i], starts[i + 1]));
+        ClipFrameTransfer::SealFrame(frames.back(), peerVersion);
+    }
+    return frames;
+}
+} // namespace
+
+// serves the frames of the last clip one per call; a frame can be made to fail once, like a dropped link
+class FramedClip : public ClipPlugin {
+public:
+    int32_t SetPasteData(const GlobalEvent &, const std::vector<uint8_t> &, uint32_t,
+        const std::vector<uint8_t> &) override
+    {
+        return 0;
+    }
+    std::pair<int32_t, int32_t> GetPasteData(const GlobalEvent &, std::vector<uint8_t> &) override
+    {
+        return { ERR_BAD_FRAME, 0 };
+    }
+    std::vector<GlobalEvent> GetTopEvents(uint32_t, int32_t) override
+    {
+        GlobalEvent event;
+        if (wireEvent_.empty() || !event.Unmarshall(wireEvent_)) {
+            return {};
+        }
+        return { event };
+    }
+    bool IsFrameSupported() override
+    {
+        return true;
+    }
+    int32_t SetPasteDataFrames(const GlobalEvent &event, const std::vector<std::vector<uint8_t>> &frames,
+        uint32_t, const std::vector<uint8_t> &) override
+    {
+        wireEvent_ = event.Marshall();
+        frames_ = frames;
+        return 0;
+    }
+    std::pair<int32_t, int32_t> GetPasteDataFrame(const GlobalEvent &, uint8_t frameIndex,
+        std::vector<uint8_t> &frame) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            fetched.push_back(frameIndex);
+            cv_.notify_all();
+        }
+        if (frameIndex == failOnce) {
+            failOnce = -1;
+            return { ERR_LINK_LOST, 0 };
+        }
+        if (frameIndex >= frames_.size()) {
+            return { ERR_BAD_FRAME, 0 };
+        }
+        frame = frames_[frameIndex];
+        return { 0, SYNC_TIME_PER_FRAME };
+    }
+    // true once frameIndex was asked for, waits up to timeout
+    bool WaitFetched(uint8_t frameIndex, std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [this, frameIndex] {
+            return std::find(fetched.begin(), fetched.end(), frameIndex) != fetched.end();
+        });
+    }
+
+    int failOnce = -1;
+    std::vector<uint8_t> fetched;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::string wireEvent_;
+    std::vector<std::vector<uint8_t>> frames_;
+};
+
+class FramedFactory : public ClipPlugin::Factory {
+public:
+    ClipPlugin *Create() override
+    {
+        return new FramedClip();
+    }
+    bool Destroy(ClipPlugin *plugin) override
+    {
+        delete plugin;
+        return true;
+    }
+};
+
+class ClipFrameTransferHostTest : public testing::Test {
+protected:
+    static FramedClip *Publish(const std::vector<std::string> &records, uint8_t peerVersion)
+    {
+        static FramedFactory factory;
+        ClipPlugin::RegCreator("framed_clip", &factory);
+        auto *clip = static_cast<FramedClip *>(ClipPlugin::CreatePlugin("framed_clip"));
+        if (clip == nullptr) {
+            return nullptr;
+        }
+        auto frames = MakeFrames(records, peerVersion);
+        ClipPlugin::GlobalEvent event;
+        event.user = USER_ONE;
+        event.deviceId = "dev-sender";
+        event.acceptFrames = true;
+        event.frameNum = static_cast<uint8_t>(frames.size());
+        clip->SetPasteDataFrames(event, frames, 0, {});
+        return clip;
+    }
+
+    static ClipFrameReader::FetchFunc Fetch(FramedClip *clip, const ClipPlugin::GlobalEvent &event,
+        int32_t &syncTime)
+    {
+        return [clip, event, &syncTime](uint8_t frameIndex, std::vector<uint8_t> &frame) {
+            auto result = clip->GetPasteDataFrame(event, frameIndex, frame);
+            syncTime += result.second;
+            return result.first;
+        };
+    }
+
+    static ClipFrameReader::DecodeFunc Decode(std::vector<std::string> &received)
+    {
+        return [&received](uint8_t, std::vector<uint8_t> &frame) {
+            if (ClipFrameTransfer::GetOpenedSize(frame) == 0 || !ClipFrameTransfer::OpenFrame(frame) ||
+                !DecodeRecords(frame, received)) {
+                return static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
+            }
+            return 0;
+        };
+    }
+};
+
+/**
+ * @tc.name: PlanFramesKeepsRecordsWhole
+ * @tc.desc: records are grouped into frames of about FRAME_SIZE without splitting one, a record larger than
+ *           a frame gets a frame of its own, and an empty or small clip is a single frame.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, PlanFramesKeepsRecordsWhole, TestSize.Level0)
+{
+    EXPECT_EQ(ClipFrameTransfer::PlanFrames({}), std::vector<size_t>{ 0 });
+    EXPECT_EQ(ClipFrameTransfer::PlanFrames({ 1, 2, 3 }), std::vector<size_t>{ 0 });
+
+    const size_t half = ClipFrameTransfer::FRAME_SIZE / 2;
+    EXPECT_EQ(ClipFrameTransfer::PlanFrames({ half, half, half, half, half }), std::vector<size_t>({ 0, 2, 4 }));
+    const size_t huge = ClipFrameTransfer::FRAME_SIZE * 3;
+    EXPECT_EQ(ClipFrameTransfer::PlanFrames({ 1, huge, 1 }), std::vector<size_t>({ 0, 1, 2 }));
+    EXPECT_EQ(ClipFrameTransfer::PlanFrames({ huge, 0, 0 }), std::vector<size_t>({ 0, 1 }));
+}
+
+/**
+ * @tc.name: PlanFramesNeverExceedsFrameNum
+ * @tc.desc: a clip too large for MAX_FRAMES frames of FRAME_SIZE gets larger frames instead of more, even
+ *           when the records barely fit two to a frame.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, PlanFramesNeverExceedsFrameNum, TestSize.Level0)
+{
+    std::vector<size_t> tiny(ClipFrameTransfer::MAX_FRAMES * 8, ClipFrameTransfer::FRAME_SIZE / 2);
+    auto starts = ClipFrameTransfer::PlanFrames(tiny);
+    EXPECT_LE(starts.size(), ClipFrameTransfer::MAX_FRAMES);
+    EXPECT_GT(starts.size(), 1u);
+
+    // one and a half records per frame on average, but packed in order only one fits in each
+    constexpr size_t recordSize = 100;
+    std::vector<size_t> awkward(ClipFrameTransfer::MAX_FRAMES * 3 / 2, recordSize);
+    starts = ClipFrameTransfer::PlanFrames(awkward, 1);
+    EXPECT_LE(starts.size(), ClipFrameTransfer::MAX_FRAMES);
+    for (size_t i = 1; i < starts.size(); ++i) {
+        EXPECT_GT(starts[i], starts[i - 1]);
+    }
+}
+
+/**
+ * @tc.name: SealedFrameOpens
+ * @tc.desc: a frame sealed for a peer that decodes LZ_V1 is compressed and opens to the same bytes, one for
+ *           an old peer only gains the version byte, and an empty or corrupt frame does not open.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, SealedFrameOpens, TestSize.Level0)
+{
+    auto records = MakeRecords(2, RECORD_SIZE);
+    const auto original = EncodeRecords(records, 0, records.size());
+
+    auto frame = original;
+    ClipFrameTransfer::SealFrame(frame, ClipPayloadCodec::LATEST);
+    EXPECT_LT(frame.size(), original.size());
+    EXPECT_EQ(frame.back(), ClipPayloadCodec::LZ_V1);
+    EXPECT_EQ(ClipFrameTransfer::GetOpenedSize(frame), original.size());
+    ASSERT_TRUE(ClipFrameTransfer::OpenFrame(frame));
+    EXPECT_EQ(frame, original);
+
+    frame = original;
+    ClipFrameTransfer::SealFrame(frame, ClipPayloadCodec::RAW);
+    EXPECT_EQ(frame.size(), original.size() + 1);
+    EXPECT_EQ(ClipFrameTransfer::GetOpenedSize(frame), original.size());
+    ASSERT_TRUE(ClipFrameTransfer::OpenFrame(frame));
+    EXPECT_EQ(frame, original);
+
+    std::vector<uint8_t> empty;
+    EXPECT_EQ(ClipFrameTransfer::GetOpenedSize(empty), 0u);
+    EXPECT_FALSE(ClipFrameTransfer::OpenFrame(empty));
+
+    frame = original;
+    ClipFrameTransfer::SealFrame(frame, ClipPayloadCodec::LATEST);
+    frame[0] = 'X';
+    EXPECT_EQ(ClipFrameTransfer::GetOpenedSize(frame), 0u);
+    EXPECT_FALSE(ClipFrameTransfer::OpenFrame(frame));
+}
+
+/**
+ * @tc.name: FramedClipRoundTrip
+ * @tc.desc: a clip published in frames through the stand-in plugin is read back record for record, the
+ *           event tells the receiver how many frames to pull, and the sync time of every frame adds up.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, FramedClipRoundTrip, TestSize.Level0)
+{
+    auto records = MakeRecords(RECORD_NUM, RECORD_SIZE);
+    auto *clip = Publish(records, ClipPayloadCodec::LATEST);
+    ASSERT_NE(clip, nullptr);
+    auto events = clip->GetTopEvents(1, USER_ONE);
+    ASSERT_EQ(events.size(), 1u);
+    const auto &event = events.front();
+    EXPECT_TRUE(event.acceptFrames);
+    ASSERT_GT(event.frameNum, 1);
+
+    ClipFrameReader reader(event.frameNum);
+    int32_t syncTime = 0;
+    std::vector<std::string> received;
+    EXPECT_EQ(reader.Read(Fetch(clip, event, syncTime), Decode(received)), 0);
+    EXPECT_TRUE(reader.IsComplete());
+    EXPECT_EQ(reader.GetAckedFrames(), event.frameNum);
+    EXPECT_EQ(received, records);
+    EXPECT_EQ(syncTime, SYNC_TIME_PER_FRAME * event.frameNum);
+    // a complete reader has nothing left to pull
+    EXPECT_EQ(reader.Read(Fetch(clip, event, syncTime), Decode(received)), 0);
+    EXPECT_EQ(clip->fetched.size(), event.frameNum);
+    EXPECT_TRUE(ClipPlugin::DestroyPlugin("framed_clip", clip));
+}
+
+/**
+ * @tc.name: DecodeOverlapsTransfer
+ * @tc.desc: the records of frame 0 are decoded while frame 1 is still being fetched, so paste starts on the
+ *           first records before the whole clip has arrived.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, DecodeOverlapsTransfer, TestSize.Level0)
+{
+    auto records = MakeRecords(RECORD_NUM, RECORD_SIZE);
+    auto *clip = Publish(records, ClipPayloadCodec::RAW);
+    ASSERT_NE(clip, nullptr);
+    auto event = clip->GetTopEvents(1, USER_ONE).front();
+
+    ClipFrameReader reader(event.frameNum);
+    int32_t syncTime = 0;
+    std::vector<std::string> received;
+    std::vector<size_t> recordsAtFrame;
+    bool overlapped = true;
+    auto decode = Decode(received);
+    auto watch = [&](uint8_t frameIndex, std::vector<uint8_t> &frame) {
+        // the next frame is asked for before this one is decoded
+        if (frameIndex + 1 < event.frameNum) {
+            overlapped = overlapped && clip->WaitFetched(frameIndex + 1, OVERLAP_WAIT);
+        }
+        int32_t ret = decode(frameIndex, frame);
+        recordsAtFrame.push_back(received.size());
+        return ret;
+    };
+    EXPECT_EQ(reader.Read(Fetch(clip, event, syncTime), watch), 0);
+    EXPECT_TRUE(overlapped);
+    ASSERT_EQ(recordsAtFrame.size(), event.frameNum);
+    EXPECT_GT(recordsAtFrame.front(), 0u);
+    EXPECT_LT(recordsAtFrame.front(), records.size());
+    EXPECT_EQ(received, records);
+    EXPECT_TRUE(ClipPlugin::DestroyPlugin("framed_clip", clip));
+}
+
+/**
+ * @tc.name: InterruptedTransferResumes
+ * @tc.desc: when the link drops at frame 2, Read reports the plugin error with frames 0 and 1 acknowledged
+ *           and their records kept; the next Read fetches from frame 2 on and completes the clip.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, InterruptedTransferResumes, TestSize.Level0)
+{
+    constexpr uint8_t lostFrame = 2;
+    auto records = MakeRecords(RECORD_NUM, RECORD_SIZE);
+    auto *clip = Publish(records, ClipPayloadCodec::LATEST);
+    ASSERT_NE(clip, nullptr);
+    auto event = clip->GetTopEvents(1, USER_ONE).front();
+    ASSERT_GT(event.frameNum, lostFrame + 1);
+    clip->failOnce = lostFrame;
+
+    ClipFrameReader reader(event.frameNum);
+    int32_t syncTime = 0;
+    std::vector<std::string> received;
+    EXPECT_EQ(reader.Read(Fetch(clip, event, syncTime), Decode(received)), ERR_LINK_LOST);
+    EXPECT_FALSE(reader.IsComplete());
+    EXPECT_EQ(reader.GetAckedFrames(), lostFrame);
+    size_t keptRecords = received.size();
+    EXPECT_GT(keptRecords, 0u);
+
+    clip->fetched.clear();
+    EXPECT_EQ(reader.Read(Fetch(clip, event, syncTime), Decode(received)), 0);
+    EXPECT_TRUE(reader.IsComplete());
+    ASSERT_FALSE(clip->fetched.empty());
+    EXPECT_EQ(clip->fetched.front(), lostFrame);
+    EXPECT_EQ(clip->fetched.size(), event.frameNum - lostFrame);
+    EXPECT_EQ(received, records);
+    EXPECT_TRUE(ClipPlugin::DestroyPlugin("framed_clip", clip));
+}
+
+/**
+ * @tc.name: FirstFrameLostResumes
+ * @tc.desc: a transfer that fails on its very first frame acknowledges nothing and starts over at frame 0.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, FirstFrameLostResumes, TestSize.Level0)
+{
+    auto records = MakeRecords(RECORD_NUM, RECORD_SIZE);
+    auto *clip = Publish(records, ClipPayloadCodec::LATEST);
+    ASSERT_NE(clip, nullptr);
+    auto event = clip->GetTopEvents(1, USER_ONE).front();
+    clip->failOnce = 0;
+
+    ClipFrameReader reader(event.frameNum);
+    int32_t syncTime = 0;
+    std::vector<std::string> received;
+    EXPECT_EQ(reader.Read(Fetch(clip, event, syncTime), Decode(received)), ERR_LINK_LOST);
+    EXPECT_EQ(reader.GetAckedFrames(), 0);
+    EXPECT_TRUE(received.empty());
+    EXPECT_EQ(reader.Read(Fetch(clip, event, syncTime), Decode(received)), 0);
+    EXPECT_EQ(received, records);
+    EXPECT_TRUE(ClipPlugin::DestroyPlugin("framed_clip", clip));
+}
+
+/**
+ * @tc.name: BadFrameStopsRead
+ * @tc.desc: a frame that fails to decode is not acknowledged and its error is returned as is.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, BadFrameStopsRead, TestSize.Level0)
+{
+    auto records = MakeRecords(RECORD_NUM, RECORD_SIZE);
+    auto *clip = Publish(records, ClipPayloadCodec::LATEST);
+    ASSERT_NE(clip, nullptr);
+    auto event = clip->GetTopEvents(1, USER_ONE).front();
+
+    ClipFrameReader reader(event.frameNum);
+    int32_t syncTime = 0;
+    std::vector<std::string> received;
+    auto decode = Decode(received);
+    auto corruptSecond = [&decode](uint8_t frameIndex, std::vector<uint8_t> &frame) {
+        if (frameIndex == 1) {
+            frame.assign(frame.size(), 0);
+        }
+        return decode(frameIndex, frame);
+    };
+    EXPECT_EQ(reader.Read(Fetch(clip, event, syncTime), corruptSecond),
+        static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR));
+    EXPECT_EQ(reader.GetAckedFrames(), 1);
+    EXPECT_FALSE(reader.IsComplete());
+    EXPECT_TRUE(ClipPlugin::DestroyPlugin("framed_clip", clip));
+}
+
+/**
+ * @tc.name: OneFetcherRunsOneFrameAhead
+ * @tc.desc: every frame after the first is fetched by the same thread, never more than one frame ahead of
+ *           the decoding, and a decode error stops it.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, OneFetcherRunsOneFrameAhead, TestSize.Level0)
+{
+    constexpr uint8_t frameNum = 6;
+    constexpr uint8_t badFrame = 4;
+    std::mutex mutex;
+    std::set<std::thread::id> fetchers;
+    int32_t lastFetched = -1;
+    auto fetch = [&](uint8_t frameIndex, std::vector<uint8_t> &frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (frameIndex > 0) {
+            fetchers.insert(std::this_thread::get_id());
+        }
+        lastFetched = std::max(lastFetched, static_cast<int32_t>(frameIndex));
+        frame.assign(1, frameIndex);
+        return 0;
+    };
+    bool inStep = true;
+    auto decode = [&](uint8_t frameIndex, std::vector<uint8_t> &frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        inStep = inStep && frame == std::vector<uint8_t>(1, frameIndex) && lastFetched <= frameIndex + 1;
+        return frameIndex == badFrame ? ERR_BAD_FRAME : 0;
+    };
+    ClipFrameReader reader(frameNum);
+    EXPECT_EQ(reader.Read(fetch, decode), ERR_BAD_FRAME);
+    EXPECT_TRUE(inStep);
+    EXPECT_EQ(reader.GetAckedFrames(), badFrame);
+    EXPECT_EQ(fetchers.size(), 1U);
+    EXPECT_EQ(fetchers.count(std::this_thread::get_id()), 0U);
+    EXPECT_LE(lastFetched, badFrame + 1);
+}
+
+/**
+ * @tc.name: BasePluginSendsOnePayload
+ * @tc.desc: the ClipPlugin defaults report no frame support and refuse frames, and an event of an older
+ *           sender unmarshals with acceptFrames false.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipFrameTransferHostTest, BasePluginSendsOnePayload, TestSize.Level0)
+{
+    ClipPlugin *base = ClipPlugin::CreatePlugin("no_such_plugin");
+    ASSERT_NE(base, nullptr);
+    ClipPlugin::GlobalEvent event;
+    EXPECT_FALSE(base->IsFrameSupported());
+    EXPECT_EQ(base->SetPasteDataFrames(event, { { 1 } }, 0, {}),
+        static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR));
+    std::vector<uint8_t> frame;
+    EXPECT_EQ(base->GetPasteDataFrame(event, 0, frame).first,
+        static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR));
+
+    const std::string oldEvent = R"({"version":0,"frameNum":0,"user":1,"seqId":2,"expiration":3,"status":1,)"
+        R"("deviceId":"dev-old","account":"acct","dataType":["text/plain"],"syncTime":0})";
+    ClipPlugin::GlobalEvent dst;
+    dst.acceptFrames = true;
+    ASSERT_TRUE(dst.Unmarshall(oldEvent));
+    EXPECT_FALSE(dst.acceptFrames);
+    EXPECT_TRUE(ClipPlugin::DestroyPlugin("no_such_plugin", base));
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::ClipPayloadCodec
+// (framework/framework/clip/clip_payload_codec.cpp).
+//
+// Round-trips text, html, long runs and incompressible input, feeds the decoder
+// truncated and corrupted payloads, and sends a compressed clip between two
+// "devices" through a loopback ClipPlugin that keeps the event only in its
+// marshalled wire form.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "clip/clip_payload_codec.h"
+#include "clip/clip_plugin.h"
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr size_t HEADER_SIZE = 8;
+constexpr size_t SIZE_POS = 4;
+constexpr size_t PAYLOAD_1M = 1024 * 1024;
+constexpr int32_t USER_ONE = 1;
+constexpr uint32_t RANDOM_SEED = 1669;
+constexpr int PERF_ROUNDS = 20;
+
+std::vector<uint8_t> Bytes(const std::string &text)
+{
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+std::vector<uint8_t> HtmlPayload(size_t size)
+{
+    std::string html = "<html><body>";
+    for (size_t i = 0; html.size() < size; ++i) {
+        html += "<p class=\"item\">paragraph " + std::to_string(i) + " of the copied <b>document</b></p>\n";
+    }
+    html.resize(size);
+    return Bytes(html);
+}
+
+std::vector<uint8_t> RandomPayload(size_t size)
+{
+    std::mt19937 engine(RANDOM_SEED);
+    std::vector<uint8_t> data(size);
+    for (auto &byte : data) {
+        byte = static_cast<uint8_t>(engine());
+    }
+    return data;
+}
+
+void ExpectRoundTrip(const std::vector<uint8_t> &original)
+{
+    std::vector<uint8_t> wire = original;
+    uint8_t version = ClipPayloadCodec::Encode(wire, ClipPayloadCodec::LATEST);
+    ASSERT_EQ(version, ClipPayloadCodec::LZ_V1);
+    EXPECT_LT(wire.size(), original.size());
+    EXPECT_EQ(ClipPayloadCodec::GetDecodedSize(version, wire), original.size());
+    ASSERT_TRUE(ClipPayloadCodec::Decode(version, wire));
+    EXPECT_EQ(wire, original);
+}
+
+std::vector<uint8_t> Compressed(const std::vector<uint8_t> &original)
+{
+    std::vector<uint8_t> wire = original;
+    EXPECT_EQ(ClipPayloadCodec::Encode(wire, ClipPayloadCodec::LATEST), ClipPayloadCodec::LZ_V1);
+    return wire;
+}
+} // namespace
+
+class ClipPayloadCodecHostTest : public testing::Test {};
+
+// stands in for the distributed plugin: peers only ever see the marshalled event and the payload bytes
+class WireClip : public ClipPlugin {
+public:
+    int32_t SetPasteData(const GlobalEvent &event, const std::vector<uint8_t> &data, uint32_t,
+        const std::vector<uint8_t> &) override
+    {
+        wireEvent_ = event.Marshall();
+        payload_ = data;
+        return 0;
+    }
+    std::pair<int32_t, int32_t> GetPasteData(const GlobalEvent &, std::vector<uint8_t> &data) override
+    {
+        data = payload_;
+        return {0, 0};
+    }
+    std::vector<GlobalEvent> GetTopEvents(uint32_t, int32_t) override
+    {
+        GlobalEvent event;
+        if (wireEvent_.empty() || !event.Unmarshall(wireEvent_)) {
+            return {};
+        }
+        return { event };
+    }
+    size_t GetWireSize() const
+    {
+        return payload_.size();
+    }
+
+private:
+    std::string wireEvent_;
+    std::vector<uint8_t> payload_;
+};
+
+class WireFactory : public ClipPlugin::Factory {
+public:
+    ClipPlugin *Create() override
+    {
+        return new WireClip();
+    }
+    bool Destroy(ClipPlugin *plugin) override
+    {
+        delete plugin;
+        return true;
+    }
+};
+
+/**
+ * @tc.name: TextAndHtmlRoundTrip
+ * @tc.desc: plain text and html above the threshold compress and decode back to the same bytes.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPayloadCodecHostTest, TextAndHtmlRoundTrip, TestSize.Level0)
+{
+    std::string text;
+    while (text.size() < ClipPayloadCodec::COMPRESS_THRESHOLD * 2) {
+        text += "The quick brown fox jumps over the lazy dog. ";
+    }
+    ExpectRoundTrip(Bytes(text));
+    ExpectRoundTrip(HtmlPayload(ClipPayloadCodec::COMPRESS_THRESHOLD));
+    ExpectRoundTrip(HtmlPayload(PAYLOAD_1M));
+}
+
+/**
+ * @tc.name: LongRunsRoundTrip
+ * @tc.desc: a long run of one byte (a match overlapping its own output, with extended lengths) and long
+ *           literal stretches between repeats round trip.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPayloadCodecHostTest, LongRunsRoundTrip, TestSize.Level0)
+{
+    std::vector<uint8_t> zeros(PAYLOAD_1M, 0);
+    std::vector<uint8_t> wire = Compressed(zeros);
+    EXPECT_LT(wire.size(), zeros.size() / 100);
+    ExpectRoundTrip(zeros);
+
+    // 1000 random bytes, then the same 1000 bytes again, four times over
+    std::vector<uint8_t> block = RandomPayload(1000);
+    std::vector<uint8_t> repeated;
+    for (int i = 0; i < 4; ++i) {
+        repeated.insert(repeated.end(), block.begin(), block.end());
+    }
+    ExpectRoundTrip(repeated);
+}
+
+/**
+ * @tc.name: SmallOrIncompressibleStaysRaw
+ * @tc.desc: payloads below the threshold, random bytes and an empty payload are sent unchanged as RAW.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPayloadCodecHostTest, SmallOrIncompressibleStaysRaw, TestSize.Level0)
+{
+    std::vector<uint8_t> small(ClipPayloadCodec::COMPRESS_THRESHOLD - 1, 'a');
+    std::vector<uint8_t> wire = small;
+    EXPECT_EQ(ClipPayloadCodec::Encode(wire, ClipPayloadCodec::LATEST), ClipPayloadCodec::RAW);
+    EXPECT_EQ(wire, small);
+
+    std::vector<uint8_t> random = RandomPayload(PAYLOAD_1M);
+    wire = random;
+    EXPECT_EQ(ClipPayloadCodec::Encode(wire, ClipPayloadCodec::LATEST), ClipPayloadCodec::RAW);
+    EXPECT_EQ(wire, random);
+    EXPECT_EQ(ClipPayloadCodec::GetDecodedSize(ClipPayloadCodec::RAW, wire), random.size());
+    EXPECT_TRUE(ClipPayloadCodec::Decode(ClipPayloadCodec::RAW, wire));
+    EXPECT_EQ(wire, random);
+
+    std::vector<uint8_t> empty;
+    EXPECT_EQ(ClipPayloadCodec::Encode(empty, ClipPayloadCodec::LATEST), ClipPayloadCodec::RAW);
+    EXPECT_TRUE(empty.empty());
+}
+
+/**
+ * @tc.name: OldPeerGetsRaw
+ * @tc.desc: a peer that announced no payload version gets the payload uncompressed.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPayloadCodecHostTest, OldPeerGetsRaw, TestSize.Level0)
+{
+    std::vector<uint8_t> html = HtmlPayload(PAYLOAD_1M);
+    std::vector<uint8_t> wire = html;
+    EXPECT_EQ(ClipPayloadCodec::Encode(wire, ClipPayloadCodec::RAW), ClipPayloadCodec::RAW);
+    EXPECT_EQ(wire, html);
+}
+
+/**
+ * @tc.name: MalformedPayloadRejected
+ * @tc.desc: bad magic, a wrong or unknown version, a truncated stream, a zero or wrong decoded size and an
+ *           offset reaching before the output are all rejected instead of decoded.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPayloadCodecHostTest, MalformedPayloadRejected, TestSize.Level0)
+{
+    const std::vector<uint8_t> good = Compressed(HtmlPayload(ClipPayloadCodec::COMPRESS_THRESHOLD * 4));
+    constexpr uint8_t unknownVersion = ClipPayloadCodec::LATEST + 1;
+
+    std::vector<uint8_t> data = good;
+    EXPECT_EQ(ClipPayloadCodec::GetDecodedSize(unknownVersion, data), 0u);
+    EXPECT_FALSE(ClipPayloadCodec::Decode(unknownVersion, data));
+
+    data = good;
+    data[0] = 'X';
+    EXPECT_EQ(ClipPayloadCodec::GetDecodedSize(ClipPayloadCodec::LZ_V1, data), 0u);
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+
+    data = good;
+    data[2] = unknownVersion;
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+
+    data.assign(good.begin(), good.begin() + HEADER_SIZE - 1);
+    EXPECT_EQ(ClipPayloadCodec::GetDecodedSize(ClipPayloadCodec::LZ_V1, data), 0u);
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+
+    // a prefix either ends short of the announced size or, cut only after the last match, still yields it all
+    for (size_t cut : { HEADER_SIZE + 1, HEADER_SIZE + 2, good.size() / 4, good.size() / 2 }) {
+        data.assign(good.begin(), good.begin() + cut);
+        EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data)) << "cut at " << cut;
+    }
+
+    data = good;
+    std::fill(data.begin() + SIZE_POS, data.begin() + HEADER_SIZE, 0);
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+
+    data = good;
+    ++data[SIZE_POS];
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+
+    // one literal 'a', then a match 16 bytes back
+    data = { 'P', 'Z', ClipPayloadCodec::LZ_V1, 0, 5, 0, 0, 0, 0x10, 'a', 0x10, 0x00 };
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+    // same with offset 0
+    data = { 'P', 'Z', ClipPayloadCodec::LZ_V1, 0, 5, 0, 0, 0, 0x10, 'a', 0x00, 0x00 };
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+    // a literal length continuation that never ends
+    data = { 'P', 'Z', ClipPayloadCodec::LZ_V1, 0, 5, 0, 0, 0, 0xF0, 0xFF };
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+    // more literals than the header announced
+    data = { 'P', 'Z', ClipPayloadCodec::LZ_V1, 0, 1, 0, 0, 0, 0x20, 'a', 'b' };
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+    // a match past the announced size
+    data = { 'P', 'Z', ClipPayloadCodec::LZ_V1, 0, 2, 0, 0, 0, 0x10, 'a', 0x01, 0x00 };
+    EXPECT_FALSE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, data));
+}
+
+/**
+ * @tc.name: LoopbackTransfer
+ * @tc.desc: the sender encodes for a peer that announced LZ_V1 and publishes through the plugin; the
+ *           receiver reads the version from the unmarshalled event, checks the decoded size and decodes
+ *           the original clip.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPayloadCodecHostTest, LoopbackTransfer, TestSize.Level0)
+{
+    static WireFactory factory;
+    ASSERT_TRUE(ClipPlugin::RegCreator("loopback_codec_clip", &factory));
+    auto *clip = static_cast<WireClip *>(ClipPlugin::CreatePlugin("loopback_codec_clip"));
+    ASSERT_NE(clip, nullptr);
+
+    // the receiver announced what it decodes in an earlier event of its own
+    ClipPlugin::GlobalEvent peerEvent;
+    peerEvent.acceptPayloadVersion = ClipPayloadCodec::LATEST;
+    ClipPlugin::GlobalEvent announced;
+    ASSERT_TRUE(announced.Unmarshall(peerEvent.Marshall()));
+    ASSERT_EQ(announced.acceptPayloadVersion, ClipPayloadCodec::LATEST);
+
+    const std::vector<uint8_t> original = HtmlPayload(PAYLOAD_1M);
+    std::vector<uint8_t> rawData = original;
+    ClipPlugin::GlobalEvent event;
+    event.user = USER_ONE;
+    event.deviceId = "dev-sender";
+    event.dataType = { "text/html" };
+    event.acceptPayloadVersion = ClipPayloadCodec::LATEST;
+    event.payloadVersion = ClipPayloadCodec::Encode(rawData, announced.acceptPayloadVersion);
+    ASSERT_EQ(clip->SetPasteData(event, rawData, 0, {}), 0);
+    EXPECT_LT(clip->GetWireSize(), original.size());
+
+    auto events = clip->GetTopEvents(1, USER_ONE);
+    ASSERT_EQ(events.size(), 1u);
+    const auto &top = events.front();
+    EXPECT_EQ(top.payloadVersion, ClipPayloadCodec::LZ_V1);
+    EXPECT_EQ(top.acceptPayloadVersion, ClipPayloadCodec::LATEST);
+    std::vector<uint8_t> received;
+    ASSERT_EQ(clip->GetPasteData(top, received).first, 0);
+    EXPECT_EQ(ClipPayloadCodec::GetDecodedSize(top.payloadVersion, received), original.size());
+    ASSERT_TRUE(ClipPayloadCodec::Decode(top.payloadVersion, received));
+    EXPECT_EQ(received, original);
+    EXPECT_TRUE(ClipPlugin::DestroyPlugin("loopback_codec_clip", clip));
+}
+
+/**
+ * @tc.name: EventFromOlderSenderIsRaw
+ * @tc.desc: an event without the payload version fields unmarshals with both at RAW, so its payload is
+ *           taken as is and its sender gets raw payloads back.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPayloadCodecHostTest, EventFromOlderSenderIsRaw, TestSize.Level0)
+{
+    const std::string oldEvent = R"({"version":0,"frameNum":0,"user":1,"seqId":2,"expiration":3,"status":1,)"
+        R"("deviceId":"dev-old","account":"acct","dataType":["text/plain"],"syncTime":0,)"
+        R"("utdTypes":["general.plain-text"],"recordCount":1})";
+    ClipPlugin::GlobalEvent dst;
+    dst.payloadVersion = ClipPayloadCodec::LZ_V1;
+    dst.acceptPayloadVersion = ClipPayloadCodec::LZ_V1;
+    ASSERT_TRUE(dst.Unmarshall(oldEvent));
+    EXPECT_EQ(dst.payloadVersion, ClipPayloadCodec::RAW);
+    EXPECT_EQ(dst.acceptPayloadVersion, ClipPayloadCodec::RAW);
+    EXPECT_TRUE(dst.HasTypeInfo());
+}
+
+/**
+ * @tc.name: CodecThroughput
+ * @tc.desc: reports ratio and speed of a 1 MiB html clip; compressing must at least halve it.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPayloadCodecHostTest, CodecThroughput, TestSize.Level0)
+{
+    const std::vector<uint8_t> original = HtmlPayload(PAYLOAD_1M);
+    std::vector<uint8_t> wire;
+    double encodeMs = 0;
+    double decodeMs = 0;
+    for (int i = 0; i < PERF_ROUNDS; ++i) {
+        wire = original;
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_EQ(ClipPayloadCodec::Encode(wire, ClipPayloadCodec::LATEST), ClipPayloadCodec::LZ_V1);
+        auto encoded = std::chrono::steady_clock::now();
+        ASSERT_TRUE(ClipPayloadCodec::Decode(ClipPayloadCodec::LZ_V1, wire));
+        auto decoded = std::chrono::steady_clock::now();
+        encodeMs += std::chrono::duration<double, std::milli>(encoded - start).count();
+        decodeMs += std::chrono::duration<double, std::milli>(decoded - encoded).count();
+    }
+    ASSERT_EQ(wire, original);
+    std::vector<uint8_t> compressed = Compressed(original);
+    std::printf("[PERF] 1 MiB html -> %zu bytes (%.1f%%), encode %.2f ms, decode %.2f ms\n", compressed.size(),
+        compressed.size() * 100.0 / original.size(), encodeMs / PERF_ROUNDS, decodeMs / PERF_ROUNDS);
+    EXPECT_LT(compressed.size(), original.size() / 2);
+}
+} // namespace OHOS::MiscServices
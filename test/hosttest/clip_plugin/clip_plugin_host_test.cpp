@@ -383,4 +383,137 @@ HWTEST_F(ClipPluginHostTest, DefaultClipSetGetPasteData, TestSize.Level0)
     EXPECT_EQ(pr.first, 0);
     EXPECT_EQ(pr.second, 0);
 }
+
+// ---- Remote type queries answered from GlobalEvent metadata ----
+class TypeInfoClip : public FakeClip {
+public:
+    int32_t SetPasteData(const GlobalEvent &event, const std::vector<uint8_t> &data, uint32_t,
+        const std::vector<uint8_t> &) override
+    {
+        // what a peer receives is the event as it went over the wire
+        wireEvent_ = event.Marshall();
+        payload_ = data;
+        return 0;
+    }
+    std::pair<int32_t, int32_t> GetPasteData(const GlobalEvent &, std::vector<uint8_t> &data) override
+    {
+        ++payloadFetches;
+        data = payload_;
+        return {0, 0};
+    }
+    std::vector<GlobalEvent> GetTopEvents(uint32_t, int32_t) override
+    {
+        GlobalEvent event;
+        if (wireEvent_.empty() || !event.Unmarshall(wireEvent_)) {
+            return {};
+        }
+        return { event };
+    }
+    int payloadFetches = 0;
+
+private:
+    std::string wireEvent_;
+    std::vector<uint8_t> payload_;
+};
+
+class TypeInfoFactory : public ClipPlugin::Factory {
+public:
+    ClipPlugin *Create() override
+    {
+        return new TypeInfoClip();
+    }
+    bool Destroy(ClipPlugin *plugin) override
+    {
+        delete plugin;
+        return true;
+    }
+};
+
+/**
+ * @tc.name: GlobalEventRoundTripsTypeInfo
+ * @tc.desc: the utd types and record count of an event survive Marshal/Unmarshal and mark it as carrying
+ *           type info.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginHostTest, GlobalEventRoundTripsTypeInfo, TestSize.Level0)
+{
+    ClipPlugin::GlobalEvent src;
+    EXPECT_FALSE(src.HasTypeInfo());
+    src.dataType = {"text/html", "text/plain"};
+    src.utdTypes = {"general.html", "general.plain-text"};
+    src.recordCount = 2;
+
+    ClipPlugin::GlobalEvent dst;
+    ASSERT_TRUE(dst.Unmarshall(src.Marshall()));
+    EXPECT_EQ(dst.utdTypes, src.utdTypes);
+    EXPECT_EQ(dst.recordCount, src.recordCount);
+    EXPECT_TRUE(dst.HasTypeInfo());
+    EXPECT_TRUE(dst.HasMimeType("text/plain"));
+    EXPECT_FALSE(dst.HasMimeType("text/uri"));
+    EXPECT_TRUE(dst.HasUtdType("general.html"));
+    EXPECT_FALSE(dst.HasUtdType("general.image"));
+}
+
+/**
+ * @tc.name: GlobalEventFromOlderSenderHasNoTypeInfo
+ * @tc.desc: an event without utd types and record count still unmarshals, and reports no type info so
+ *           queries fall back to the payload.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginHostTest, GlobalEventFromOlderSenderHasNoTypeInfo, TestSize.Level0)
+{
+    const std::string oldEvent = R"({"version":0,"frameNum":0,"user":1,"seqId":2,"expiration":3,"status":1,)"
+        R"("deviceId":"dev-old","account":"acct","dataType":["text/plain"],"syncTime":0,"recordCount":7})";
+    ClipPlugin::GlobalEvent dst;
+    ASSERT_TRUE(dst.Unmarshall(oldEvent));
+    EXPECT_EQ(dst.dataType, std::vector<std::string>{"text/plain"});
+    EXPECT_TRUE(dst.utdTypes.empty());
+    EXPECT_EQ(dst.recordCount, 0u);
+    EXPECT_FALSE(dst.HasTypeInfo());
+}
+
+/**
+ * @tc.name: RemoteTypeQueryNeedsNoPayload
+ * @tc.desc: with a stand-in plugin registered through RegCreator, mime and utd queries on the top event are
+ *           answered from its metadata and never fetch the payload.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginHostTest, RemoteTypeQueryNeedsNoPayload, TestSize.Level0)
+{
+    static TypeInfoFactory factory;
+    ASSERT_TRUE(ClipPlugin::RegCreator("type_info_clip", &factory));
+    auto *clip = static_cast<TypeInfoClip *>(ClipPlugin::CreatePlugin("type_info_clip"));
+    ASSERT_NE(clip, nullptr);
+
+    ClipPlugin::GlobalEvent event;
+    event.user = USER_ONE;
+    event.seqId = EVT_SEQ_ID;
+    event.deviceId = "dev-remote";
+    event.dataType = {"text/html", "text/plain"};
+    event.utdTypes = {"general.html", "general.plain-text"};
+    event.recordCount = 1;
+    std::vector<uint8_t> payload(MAX_LOCAL_CAPACITY_1K, 0xA5);
+    ASSERT_EQ(clip->SetPasteData(event, payload, 0, {}), 0);
+
+    auto events = clip->GetTopEvents(1, USER_ONE);
+    ASSERT_EQ(events.size(), 1u);
+    const auto &top = events.front();
+    ASSERT_TRUE(top.HasTypeInfo());
+    EXPECT_TRUE(top.HasMimeType("text/html"));
+    EXPECT_FALSE(top.HasMimeType("pixelMap"));
+    EXPECT_TRUE(top.HasUtdType("general.plain-text"));
+    EXPECT_EQ(clip->payloadFetches, 0);
+
+    std::vector<uint8_t> fetched;
+    clip->GetPasteData(top, fetched);
+    EXPECT_EQ(fetched, payload);
+    EXPECT_EQ(clip->payloadFetches, 1);
+    EXPECT_TRUE(ClipPlugin::DestroyPlugin("type_info_clip", clip));
+}
 } // namespace OHOS::MiscServices
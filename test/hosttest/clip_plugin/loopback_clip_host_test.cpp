@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::LoopbackClip
+// (framework/framework/clip/loopback_clip.cpp).
+//
+// The loopback plugin plays the remote device in process. The tests check that a
+// clip comes back as the peer's, that the link charges latency and bandwidth the way
+// a real one would, and that entry callbacks reach the sender. RemotePasteLatency
+// measures copy-to-paste over the link for one payload, a compressed payload and
+// frames, the three ways PasteboardService sends a clip.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "clip/clip_frame_transfer.h"
+#include "clip/clip_payload_codec.h"
+#include "clip/loopback_clip.h"
+#include "pasteboard_error.h"
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr int32_t USER_ONE = 1;
+constexpr uint16_t SEQ_ONE = 1;
+constexpr uint32_t LATENCY_MS = 5;
+constexpr uint64_t BANDWIDTH = 100 * 1024 * 1024;
+constexpr size_t PAYLOAD_1M = 1024 * 1024;
+constexpr int32_t WIRE_1M_MS = 10;
+constexpr int32_t ERR_SENDER = 9;
+// roughly a p2p Wi-Fi link between two phones
+constexpr uint32_t BENCH_LATENCY_MS = 3;
+constexpr uint64_t BENCH_BANDWIDTH = 40 * 1024 * 1024;
+constexpr size_t BENCH_RECORD_SIZE = 128 * 1024;
+constexpr uint64_t MS_PER_SECOND = 1000;
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<uint8_t> Bytes(const std::string &text)
+{
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+std::string HtmlRecord(size_t index, size_t size)
+{
+    std::string html = "<html><body>";
+    for (size_t i = 0; html.size() < size; ++i) {
+        html += "<p class=\"item\">record " + std::to_string(index) + " paragraph " + std::to_string(i) + "</p>\n";
+    }
+    html.resize(size);
+    return html;
+}
+
+std::vector<std::string> HtmlRecords(size_t total)
+{
+    std::vector<std::string> records;
+    for (size_t size = 0; size < total; size += BENCH_RECORD_SIZE) {
+        records.push_back(HtmlRecord(records.size(), std::min(BENCH_RECORD_SIZE, total - size)));
+    }
+    return records;
+}
+
+std::vector<uint8_t> Join(const std::vector<std::string> &records, size_t begin, size_t end)
+{
+    std::vector<uint8_t> joined;
+    for (size_t i = begin; i < end; ++i) {
+        joined.insert(joined.end(), records[i].begin(), records[i].end());
+    }
+    return joined;
+}
+
+ClipPlugin::GlobalEvent MakeEvent(uint16_t seqId)
+{
+    ClipPlugin::GlobalEvent event;
+    event.user = USER_ONE;
+    event.seqId = seqId;
+    event.dataId = seqId;
+    event.deviceId = "local";
+    event.status = ClipPlugin::EVT_NORMAL;
+    return event;
+}
+
+double ElapsedMs(Clock::time_point begin)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+}
+
+enum class SendMode { RAW, COMPRESSED, FRAMED };
+
+// copies records on one side of the link and pastes them on the other, returns the time it took in ms
+double CopyToPaste(const LoopbackClip::LinkConfig &config, const std::vector<std::string> &records, SendMode mode)
+{
+    LoopbackClip::Factory factory(config);
+    ClipPlugin *sender = factory.Create();
+    ClipPlugin *receiver = factory.Create();
+    auto event = MakeEvent(SEQ_ONE);
+    auto begin = Clock::now();
+    std::vector<size_t> sizes;
+    for (const auto &record : records) {
+        sizes.push_back(record.size());
+    }
+    auto starts = ClipFrameTransfer::PlanFrames(sizes);
+    // like the service, a clip that fits in one frame goes as one compressed payload
+    if (mode == SendMode::FRAMED && starts.size() > 1) {
+        starts.push_back(records.size());
+        std::vector<std::vector<uint8_t>> frames;
+        for (size_t i = 0; i + 1 < starts.size(); ++i) {
+            frames.push_back(Join(records, starts[i], starts[i + 1]));
+            ClipFrameTransfer::SealFrame(frames.back(), ClipPayloadCodec::LATEST);
+        }
+        event.frameNum = static_cast<uint8_t>(frames.size());
+        EXPECT_EQ(sender->SetPasteDataFrames(event, frames, 0, {}), 0);
+    } else {
+        std::vector<uint8_t> payload = Join(records, 0, records.size());
+        event.payloadVersion = ClipPayloadCodec::Encode(payload,
+            mode == SendMode::RAW ? ClipPayloadCodec::RAW : ClipPayloadCodec::LATEST);
+        EXPECT_EQ(sender->SetPasteData(event, payload, 0, {}), 0);
+    }
+
+    auto events = receiver->GetTopEvents(1, USER_ONE);
+    EXPECT_EQ(events.size(), 1U);
+    std::vector<uint8_t> pasted;
+    if (!events.empty() && events[0].frameNum > 1) {
+        ClipFrameReader reader(events[0].frameNum);
+        int32_t ret = reader.Read(
+            [receiver, &events](uint8_t index, std::vector<uint8_t> &frame) {
+                return receiver->GetPasteDataFrame(events[0], index, frame).first;
+            },
+            [&pasted](uint8_t, std::vector<uint8_t> &frame) {
+                if (!ClipFrameTransfer::OpenFrame(frame)) {
+                    return ERR_SENDER;
+                }
+                pasted.insert(pasted.end(), frame.begin(), frame.end());
+                return 0;
+            });
+        EXPECT_EQ(ret, 0);
+    } else if (!events.empty()) {
+        EXPECT_EQ(receiver->GetPasteData(events[0], pasted).first, 0);
+        EXPECT_TRUE(ClipPayloadCodec::Decode(events[0].payloadVersion, pasted));
+    }
+    double elapsed = ElapsedMs(begin);
+    EXPECT_EQ(pasted, Join(records, 0, records.size()));
+    factory.Destroy(sender);
+    factory.Destroy(receiver);
+    return elapsed;
+}
+} // namespace
+
+class LoopbackClipHostTest : public testing::Test {};
+
+/**
+ * @tc.name: PeerEventRoundTrip
+ * @tc.desc: a clip set through a registered loopback plugin is announced as the peer's and fetched whole.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(LoopbackClipHostTest, PeerEventRoundTrip, TestSize.Level0)
+{
+    static LoopbackClip::Factory factory;
+    ASSERT_TRUE(ClipPlugin::RegCreator("loopback_host_test", &factory));
+    ClipPlugin *plugin = ClipPlugin::CreatePlugin("loopback_host_test");
+    ASSERT_NE(plugin, nullptr);
+    EXPECT_TRUE(plugin->GetTopEvents(1, USER_ONE).empty());
+
+    auto event = MakeEvent(SEQ_ONE);
+    const std::vector<uint8_t> payload = Bytes("<p>copied on the peer</p>");
+    ASSERT_EQ(plugin->SetPasteData(event, payload, 0, Bytes("text/html")), 0);
+    auto events = plugin->GetTopEvents(1, USER_ONE);
+    ASSERT_EQ(events.size(), 1U);
+    EXPECT_EQ(events[0].deviceId, LoopbackClip::LinkConfig().peerId);
+    EXPECT_EQ(events[0].seqId, SEQ_ONE);
+    EXPECT_TRUE(plugin->GetTopEvents(0, USER_ONE).empty());
+    EXPECT_TRUE(plugin->GetTopEvents(1, USER_ONE + 1).empty());
+
+    std::vector<uint8_t> data;
+    auto [ret, syncTime] = plugin->GetPasteData(events[0], data);
+    EXPECT_EQ(ret, 0);
+    EXPECT_GE(syncTime, 0);
+    EXPECT_EQ(data, payload);
+    std::vector<uint8_t> mimeTypes;
+    EXPECT_EQ(plugin->GetMimeTypes(mimeTypes, events[0]), static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_EQ(mimeTypes, Bytes("text/html"));
+
+    auto stale = MakeEvent(SEQ_ONE + 1);
+    EXPECT_EQ(plugin->GetPasteData(stale, data).first, static_cast<int32_t>(PasteboardError::NO_DATA_ERROR));
+    EXPECT_EQ(plugin->GetMimeTypes(mimeTypes, stale), static_cast<int32_t>(PasteboardError::NO_DATA_ERROR));
+    plugin->Clear(USER_ONE);
+    EXPECT_TRUE(plugin->GetTopEvents(1, USER_ONE).empty());
+    EXPECT_TRUE(ClipPlugin::DestroyPlugin("loopback_host_test", plugin));
+}
+
+/**
+ * @tc.name: FactorySharesLink
+ * @tc.desc: plugins of one factory see each other's clips, a plugin of its own does not.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(LoopbackClipHostTest, FactorySharesLink, TestSize.Level0)
+{
+    LoopbackClip::LinkConfig config;
+    config.peerId = "peer-a";
+    LoopbackClip::Factory factory(config);
+    ClipPlugin *sender = factory.Create();
+    ClipPlugin *receiver = factory.Create();
+    ASSERT_NE(sender, nullptr);
+    ASSERT_NE(receiver, nullptr);
+    LoopbackClip alone;
+
+    ASSERT_EQ(sender->SetPasteData(MakeEvent(SEQ_ONE), Bytes("shared"), 0, {}), 0);
+    auto events = receiver->GetTopEvents(1, USER_ONE);
+    ASSERT_EQ(events.size(), 1U);
+    EXPECT_EQ(events[0].deviceId, "peer-a");
+    EXPECT_TRUE(alone.GetTopEvents(1, USER_ONE).empty());
+    std::vector<uint8_t> data;
+    EXPECT_EQ(receiver->GetPasteData(events[0], data).first, 0);
+    EXPECT_EQ(data, Bytes("shared"));
+    EXPECT_EQ(static_cast<LoopbackClip *>(sender)->GetTransferredBytes(), data.size());
+    EXPECT_TRUE(factory.Destroy(sender));
+    EXPECT_TRUE(factory.Destroy(receiver));
+}
+
+/**
+ * @tc.name: LinkChargesLatencyAndBandwidth
+ * @tc.desc: a fetch pays the latency both ways plus the bytes on the wire; concurrent fetches share the wire.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(LoopbackClipHostTest, LinkChargesLatencyAndBandwidth, TestSize.Level0)
+{
+    LoopbackClip::LinkConfig config;
+    config.latencyMs = LATENCY_MS;
+    config.bandwidth = BANDWIDTH;
+    LoopbackClip plugin(config);
+    auto event = MakeEvent(SEQ_ONE);
+    auto begin = Clock::now();
+    ASSERT_EQ(plugin.SetPasteData(event, std::vector<uint8_t>(PAYLOAD_1M, 'x'), 0, {}), 0);
+    EXPECT_GE(ElapsedMs(begin), LATENCY_MS);
+
+    std::vector<uint8_t> data;
+    auto [ret, syncTime] = plugin.GetPasteData(event, data);
+    ASSERT_EQ(ret, 0);
+    EXPECT_GE(syncTime, static_cast<int32_t>(2 * LATENCY_MS) + WIRE_1M_MS);
+    EXPECT_EQ(data.size(), PAYLOAD_1M);
+
+    // two fetches at once: the latencies overlap, the bytes do not
+    begin = Clock::now();
+    std::vector<uint8_t> other;
+    std::thread second([&plugin, &event, &other]() {
+        plugin.GetPasteData(event, other);
+    });
+    plugin.GetPasteData(event, data);
+    second.join();
+    EXPECT_GE(ElapsedMs(begin), 2 * LATENCY_MS + 2 * WIRE_1M_MS);
+    EXPECT_EQ(other.size(), PAYLOAD_1M);
+    EXPECT_EQ(plugin.GetTransferredBytes(), 3 * PAYLOAD_1M);
+}
+
+/**
+ * @tc.name: EntryAnsweredBySender
+ * @tc.desc: GetPasteDataEntry calls the sender's entry callback with the sender's own event.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(LoopbackClipHostTest, EntryAnsweredBySender, TestSize.Level0)
+{
+    LoopbackClip plugin;
+    auto event = MakeEvent(SEQ_ONE);
+    event.isDelay = true;
+    std::vector<uint8_t> rawData;
+    EXPECT_EQ(plugin.GetPasteDataEntry(event, 1, "general.html", rawData),
+        static_cast<int32_t>(PasteboardError::NO_DATA_ERROR));
+    ASSERT_EQ(plugin.SetPasteData(event, {}, 0, {}), 0);
+    auto peerEvent = plugin.GetTopEvents(1, USER_ONE).at(0);
+    EXPECT_EQ(plugin.GetPasteDataEntry(peerEvent, 1, "general.html", rawData),
+        static_cast<int32_t>(PasteboardError::NO_DELAY_GETTER));
+
+    std::string askedBy;
+    plugin.RegisterDelayCallback(nullptr,
+        [&askedBy](const ClipPlugin::GlobalEvent &evt, uint32_t recordId, const std::string &utdId,
+            std::vector<uint8_t> &value) {
+            askedBy = evt.deviceId;
+            if (recordId != 1) {
+                return ERR_SENDER;
+            }
+            value = Bytes(utdId);
+            return static_cast<int32_t>(PasteboardError::E_OK);
+        });
+    EXPECT_EQ(plugin.GetPasteDataEntry(peerEvent, 1, "general.html", rawData), 0);
+    EXPECT_EQ(rawData, Bytes("general.html"));
+    EXPECT_EQ(askedBy, "local");
+    EXPECT_EQ(plugin.GetPasteDataEntry(peerEvent, 2, "general.html", rawData), ERR_SENDER);
+}
+
+/**
+ * @tc.name: DelayedPayloadAnsweredBySender
+ * @tc.desc: the payload of a delayed clip comes from the sender's data callback, other clips keep the payload set.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(LoopbackClipHostTest, DelayedPayloadAnsweredBySender, TestSize.Level0)
+{
+    LoopbackClip plugin;
+    auto event = MakeEvent(SEQ_ONE);
+    event.isDelay = true;
+    ASSERT_EQ(plugin.SetPasteData(event, Bytes("set"), 0, {}), 0);
+    auto peerEvent = plugin.GetTopEvents(1, USER_ONE).at(0);
+    std::vector<uint8_t> data;
+    EXPECT_EQ(plugin.GetPasteData(peerEvent, data).first, 0);
+    EXPECT_EQ(data, Bytes("set"));
+
+    std::string askedBy;
+    uint8_t askedVersion = 0;
+    int32_t answer = static_cast<int32_t>(PasteboardError::E_OK);
+    plugin.RegisterDelayCallback(
+        [&askedBy, &askedVersion, &answer](const ClipPlugin::GlobalEvent &evt, uint8_t version,
+            std::vector<uint8_t> &value) {
+            askedBy = evt.deviceId;
+            askedVersion = version;
+            value = Bytes("fetched");
+            return answer;
+        }, nullptr);
+    EXPECT_EQ(plugin.GetPasteData(peerEvent, data).first, 0);
+    EXPECT_EQ(data, Bytes("fetched"));
+    EXPECT_EQ(askedBy, "local");
+    EXPECT_EQ(askedVersion, 1);
+    answer = ERR_SENDER;
+    EXPECT_EQ(plugin.GetPasteData(peerEvent, data).first, ERR_SENDER);
+
+    ASSERT_EQ(plugin.SetPasteData(MakeEvent(SEQ_ONE + 1), Bytes("plain"), 0, {}), 0);
+    peerEvent = plugin.GetTopEvents(1, USER_ONE).at(0);
+    EXPECT_EQ(plugin.GetPasteData(peerEvent, data).first, 0);
+    EXPECT_EQ(data, Bytes("plain"));
+}
+
+/**
+ * @tc.name: FramesAndServiceState
+ * @tc.desc: frames are served one per fetch, a framed clip has no single payload, and the link can refuse frames.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(LoopbackClipHostTest, FramesAndServiceState, TestSize.Level0)
+{
+    LoopbackClip plugin;
+    EXPECT_TRUE(plugin.IsFrameSupported());
+    EXPECT_TRUE(plugin.IsWiFiEnable());
+    EXPECT_EQ(plugin.ApplyAdvancedResource("peer"), 0);
+    EXPECT_EQ(plugin.PublishServiceState("peer", ClipPlugin::ServiceStatus::CONNECT_SUCC), 0);
+
+    auto event = MakeEvent(SEQ_ONE);
+    event.frameNum = 2;
+    const std::vector<std::vector<uint8_t>> frames = { Bytes("first"), Bytes("second") };
+    ASSERT_EQ(plugin.SetPasteDataFrames(event, frames, 0, {}), 0);
+    std::vector<uint8_t> frame;
+    EXPECT_EQ(plugin.GetPasteDataFrame(event, 1, frame).first, 0);
+    EXPECT_EQ(frame, frames[1]);
+    EXPECT_EQ(plugin.GetPasteDataFrame(event, 2, frame).first, static_cast<int32_t>(PasteboardError::NO_DATA_ERROR));
+    EXPECT_EQ(plugin.GetPasteData(event, frame).first, static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR));
+
+    LoopbackClip::LinkConfig config;
+    config.frameSupported = false;
+    LoopbackClip single(config);
+    EXPECT_FALSE(single.IsFrameSupported());
+    EXPECT_EQ(single.SetPasteDataFrames(event, frames, 0, {}),
+        static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR));
+}
+
+/**
+ * @tc.name: RemotePasteLatency
+ * @tc.desc: reports copy-to-paste time of html clips over a p2p-like link, sent as one payload, compressed
+ *           and in frames; the raw payload must take at least the time the link model charges for it.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(LoopbackClipHostTest, RemotePasteLatency, TestSize.Level0)
+{
+    LoopbackClip::LinkConfig config;
+    config.latencyMs = BENCH_LATENCY_MS;
+    config.bandwidth = BENCH_BANDWIDTH;
+    std::printf("[PERF] link %u ms, %llu MiB/s\n", config.latencyMs,
+        static_cast<unsigned long long>(config.bandwidth / PAYLOAD_1M));
+    for (size_t size : { PAYLOAD_1M / 16, PAYLOAD_1M, 4 * PAYLOAD_1M }) {
+        auto records = HtmlRecords(size);
+        double raw = CopyToPaste(config, records, SendMode::RAW);
+        double compressed = CopyToPaste(config, records, SendMode::COMPRESSED);
+        double framed = CopyToPaste(config, records, SendMode::FRAMED);
+        std::printf("[PERF] %7zu KiB html: raw %7.2f ms, compressed %7.2f ms, framed %7.2f ms\n", size / 1024, raw,
+            compressed, framed);
+        // a raw payload crosses the link whole, it can not be faster than the link allows
+        EXPECT_GE(raw, 3 * BENCH_LATENCY_MS + size * MS_PER_SECOND / BENCH_BANDWIDTH);
+    }
+}
+} // namespace OHOS::MiscServices
@@ -13,10 +13,13 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 #
-# Host-side build + run + coverage loop for ClipPlugin / DefaultClip.
+# Host-side build + run + coverage loop for ClipPlugin / DefaultClip / ClipPayloadCodec /
+# ClipFrameTransfer / LoopbackClip / ClipEventCodec.
 # Shallow-dependency module needing a single-header shim (pasteboard_hilog.h,
 # pasteboard_event_dfx.h). Links the real serializable.cpp for GlobalEvent's
-# Marshal/Unmarshal. Coverage is measured on clip_plugin.cpp + default_clip.cpp.
+# Marshal/Unmarshal. Coverage is measured on clip_plugin.cpp + default_clip.cpp +
+# clip_payload_codec.cpp + clip_frame_transfer.cpp + loopback_clip.cpp +
+# clip_event_codec.cpp.
 #
 # Single command:  ./run_host_test.sh
 # Exit: 0 pass+coverage ok | 1 test fail | 2 coverage below gate | 3 build error
@@ -38,10 +41,19 @@ SHIM_INC="${SCRIPT_DIR}/shim"                                    # fake seam (mu
 CLIP_INC="${PASTEBOARD_ROOT}/framework/framework/clip"
 CLIP_PARENT_INC="${PASTEBOARD_ROOT}/framework/framework"       # for "clip/default_clip.h"
 FW_INC="${PASTEBOARD_ROOT}/framework/framework/include"
+UTILS_INC="${PASTEBOARD_ROOT}/utils/native/include"                 # pasteboard_error.h
 CLIP_SRC="${PASTEBOARD_ROOT}/framework/framework/clip/clip_plugin.cpp"
 DEFAULT_SRC="${PASTEBOARD_ROOT}/framework/framework/clip/default_clip.cpp"
+CODEC_SRC="${PASTEBOARD_ROOT}/framework/framework/clip/clip_payload_codec.cpp"
+FRAME_SRC="${PASTEBOARD_ROOT}/framework/framework/clip/clip_frame_transfer.cpp"
+LOOP_SRC="${PASTEBOARD_ROOT}/framework/framework/clip/loopback_clip.cpp"
+EVENT_SRC="${PASTEBOARD_ROOT}/framework/framework/clip/clip_event_codec.cpp"
 SER_SRC="${PASTEBOARD_ROOT}/framework/framework/serializable/serializable.cpp"
 TEST_SRC="${SCRIPT_DIR}/clip_plugin_host_test.cpp"
+CODEC_TEST_SRC="${SCRIPT_DIR}/clip_payload_codec_host_test.cpp"
+FRAME_TEST_SRC="${SCRIPT_DIR}/clip_frame_transfer_host_test.cpp"
+LOOP_TEST_SRC="${SCRIPT_DIR}/loopback_clip_host_test.cpp"
+EVENT_TEST_SRC="${SCRIPT_DIR}/clip_event_codec_host_test.cpp"
 
 BUILD_DIR="${SCRIPT_DIR}/.build"
 BIN="${BUILD_DIR}/clip_plugin_host_test"
@@ -53,7 +65,8 @@ for tool in "${CXX}" "${GCOV}"; do
     command -v "${tool}" >/dev/null 2>&1 || { fail "required tool not found: ${tool}"; exit 3; }
 done
 for f in "${GTEST_ROOT}/src/gtest-all.cc" "${CJSON_ROOT}/cJSON.c" "${CLIP_SRC}" "${DEFAULT_SRC}" \
-         "${SER_SRC}" "${TEST_SRC}" "${SHIM_INC}/pasteboard_hilog.h" "${SHIM_INC}/pasteboard_event_dfx.h"; do
+         "${CODEC_SRC}" "${FRAME_SRC}" "${LOOP_SRC}" "${EVENT_SRC}" "${SER_SRC}" "${TEST_SRC}" "${CODEC_TEST_SRC}" \
+         "${FRAME_TEST_SRC}" "${LOOP_TEST_SRC}" "${EVENT_TEST_SRC}" "${SHIM_INC}/pasteboard_hilog.h" "${SHIM_INC}/pasteboard_event_dfx.h"; do
     [[ -f "${f}" ]] || { fail "missing source: ${f}"; exit 3; }
 done
 
@@ -61,7 +74,7 @@ rm -rf "${BUILD_DIR}"
 mkdir -p "${BUILD_DIR}"
 
 # shim FIRST so it shadows the real hilog/event_dfx headers.
-UUT_INC=(-I"${SHIM_INC}" -I"${CLIP_INC}" -I"${CLIP_PARENT_INC}" -I"${FW_INC}" -I"${CJSON_ROOT}")
+UUT_INC=(-I"${SHIM_INC}" -I"${CLIP_INC}" -I"${CLIP_PARENT_INC}" -I"${FW_INC}" -I"${UTILS_INC}" -I"${CJSON_ROOT}")
 
 info "compiling cJSON (no coverage)"
 "${CXX}" -c -x c "${CJSON_ROOT}/cJSON.c" -I"${CJSON_ROOT}" -O0 -g \
@@ -90,19 +103,34 @@ else
     fi
 fi
 
-info "compiling clip_plugin.cpp + default_clip.cpp (WITH coverage)"
+info "compiling clip_plugin.cpp + default_clip.cpp + clip_payload_codec.cpp + clip_frame_transfer.cpp +" \
+    "loopback_clip.cpp + clip_event_codec.cpp (WITH coverage)"
 ( cd "${BUILD_DIR}" && \
   "${CXX}" -c "${CLIP_SRC}" "${UUT_INC[@]}" -std=c++17 -O0 -g --coverage -o clip_plugin.o && \
-  "${CXX}" -c "${DEFAULT_SRC}" "${UUT_INC[@]}" -std=c++17 -O0 -g --coverage -o default_clip.o ) \
+  "${CXX}" -c "${DEFAULT_SRC}" "${UUT_INC[@]}" -std=c++17 -O0 -g --coverage -o default_clip.o && \
+  "${CXX}" -c "${CODEC_SRC}" "${UUT_INC[@]}" -std=c++17 -O0 -g --coverage -o clip_payload_codec.o && \
+  "${CXX}" -c "${FRAME_SRC}" "${UUT_INC[@]}" -std=c++17 -O0 -g --coverage -o clip_frame_transfer.o && \
+  "${CXX}" -c "${LOOP_SRC}" "${UUT_INC[@]}" -std=c++17 -O0 -g --coverage -o loopback_clip.o && \
+  "${CXX}" -c "${EVENT_SRC}" "${UUT_INC[@]}" -std=c++17 -O0 -g --coverage -o clip_event_codec.o ) \
     || { fail "unit-under-test compile failed"; exit 3; }
 
 info "compiling test"
 "${CXX}" -c "${TEST_SRC}" "${UUT_INC[@]}" -I"${GTEST_ROOT}/include" \
     -std=c++17 -O0 -g -o "${BUILD_DIR}/test.o" || { fail "test compile failed"; exit 3; }
+"${CXX}" -c "${CODEC_TEST_SRC}" "${UUT_INC[@]}" -I"${GTEST_ROOT}/include" \
+    -std=c++17 -O0 -g -o "${BUILD_DIR}/codec_test.o" || { fail "codec test compile failed"; exit 3; }
+"${CXX}" -c "${FRAME_TEST_SRC}" "${UUT_INC[@]}" -I"${GTEST_ROOT}/include" \
+    -std=c++17 -O0 -g -o "${BUILD_DIR}/frame_test.o" || { fail "frame test compile failed"; exit 3; }
+"${CXX}" -c "${LOOP_TEST_SRC}" "${UUT_INC[@]}" -I"${GTEST_ROOT}/include" \
+    -std=c++17 -O0 -g -o "${BUILD_DIR}/loopback_test.o" || { fail "loopback test compile failed"; exit 3; }
+"${CXX}" -c "${EVENT_TEST_SRC}" "${UUT_INC[@]}" -I"${GTEST_ROOT}/include" \
+    -std=c++17 -O0 -g -o "${BUILD_DIR}/event_test.o" || { fail "event test compile failed"; exit 3; }
 
 info "linking"
 "${CXX}" --coverage \
-    "${BUILD_DIR}/test.o" "${BUILD_DIR}/clip_plugin.o" "${BUILD_DIR}/default_clip.o" \
+    "${BUILD_DIR}/test.o" "${BUILD_DIR}/codec_test.o" "${BUILD_DIR}/frame_test.o" "${BUILD_DIR}/loopback_test.o" "${BUILD_DIR}/event_test.o" \
+    "${BUILD_DIR}/clip_plugin.o" "${BUILD_DIR}/default_clip.o" "${BUILD_DIR}/clip_payload_codec.o" \
+    "${BUILD_DIR}/clip_frame_transfer.o" "${BUILD_DIR}/loopback_clip.o" "${BUILD_DIR}/clip_event_codec.o" \
     "${BUILD_DIR}/serializable.o" "${BUILD_DIR}/cJSON.o" \
     "${BUILD_DIR}/gtest-all.o" "${BUILD_DIR}/gtest_main.o" \
     -lpthread -o "${BIN}" || { fail "link failed"; exit 3; }
@@ -115,7 +143,7 @@ TEST_RC=$?
 info "computing coverage"
 total_lines=0
 covered_lines=0
-for gcno in clip_plugin default_clip; do
+for gcno in clip_plugin default_clip clip_payload_codec clip_frame_transfer loopback_clip clip_event_codec; do
     src_base="${gcno}.cpp"
     line="$( cd "${BUILD_DIR}" && "${GCOV}" -n "${gcno}.gcno" 2>/dev/null \
         | grep -A1 "${src_base}'" | grep "Lines executed" | head -1 )"
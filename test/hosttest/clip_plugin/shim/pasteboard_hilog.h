@@ -22,7 +22,7 @@
 
 namespace OHOS {
 namespace MiscServices {
-enum PasteboardModule {
+enum PasteboardSubModule {
     PASTEBOARD_MODULE_SERVICE = 0,
     PASTEBOARD_MODULE_COMMON,
 };
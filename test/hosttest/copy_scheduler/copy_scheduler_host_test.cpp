@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::PasteboardCopyScheduler and PasteboardCopyProgress
+// (framework/innerkits/src/pasteboard_copy_scheduler.cpp), the copy engine behind
+// PasteBoardCopyFile::CopyFileData.
+//
+// The benchmark stands in for FileCopyManager::Copy with a chunked copy of real files in a temp dir
+// that reports progress per chunk, the way the distributed copy calls its listener.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "pasteboard_copy_scheduler.h"
+
+namespace hosttest_common_utils {
+std::atomic<int> g_namedThreads = 0;
+}
+
+using namespace testing::ext;
+using namespace OHOS::MiscServices;
+
+namespace {
+constexpr size_t COPY_CHUNK = 64 * 1024;
+
+class TempDir {
+public:
+    TempDir()
+    {
+        char pattern[] = "/tmp/copy_scheduler_XXXXXX";
+        char *dir = mkdtemp(pattern);
+        path_ = dir != nullptr ? dir : "";
+    }
+    ~TempDir()
+    {
+        if (!path_.empty()) {
+            std::string cmd = "rm -rf '" + path_ + "'";
+            (void)std::system(cmd.c_str());
+        }
+    }
+    const std::string &Path() const
+    {
+        return path_;
+    }
+
+private:
+    std::string path_;
+};
+
+bool WriteFile(const std::string &path, const std::string &content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+    return static_cast<bool>(out);
+}
+
+std::string ReadFile(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    std::string content(static_cast<size_t>(std::max<std::streamoff>(in.tellg(), 0)), '\0');
+    in.seekg(0);
+    in.read(content.data(), static_cast<std::streamsize>(content.size()));
+    return content;
+}
+
+// copies src to dest chunk by chunk and reports (copied, total) after every chunk
+bool CopyWithProgress(const std::string &src, const std::string &dest,
+    const std::function<void(uint64_t, uint64_t)> &listener)
+{
+    FILE *in = std::fopen(src.c_str(), "rb");
+    if (in == nullptr) {
+        return false;
+    }
+    FILE *out = std::fopen(dest.c_str(), "wb");
+    if (out == nullptr) {
+        std::fclose(in);
+        return false;
+    }
+    struct stat buf {};
+    stat(src.c_str(), &buf);
+    uint64_t total = static_cast<uint64_t>(buf.st_size);
+    uint64_t copied = 0;
+    std::vector<char> chunk(COPY_CHUNK);
+    size_t read = 0;
+    bool ok = true;
+    while ((read = std::fread(chunk.data(), 1, chunk.size(), in)) > 0) {
+        ok = ok && std::fwrite(chunk.data(), 1, read, out) == read;
+        copied += read;
+        listener(copied, total);
+    }
+    std::fclose(in);
+    ok = std::fflush(out) == 0 && fsync(fileno(out)) == 0 && ok;
+    std::fclose(out);
+    return ok;
+}
+
+struct CopyRun {
+    double seconds = 0;
+    bool monotonic = true;
+    uint64_t lastTotal = 0;
+    size_t reports = 0;
+};
+
+// the CopyFileData pattern: one lane per destination, per chunk progress summed into one monotonic total
+CopyRun CopyAll(const std::vector<std::string> &srcs, const std::vector<std::string> &dests, size_t workers)
+{
+    CopyRun run;
+    PasteboardCopyProgress progress(srcs.size(), [&run](size_t slot, uint64_t total) {
+        (void)slot;
+        run.monotonic = run.monotonic && total > run.lastTotal;
+        run.lastTotal = total;
+        run.reports++;
+    });
+    auto begin = std::chrono::steady_clock::now();
+    PasteboardCopyScheduler::Run(dests, workers, [&](size_t job) {
+        CopyWithProgress(srcs[job], dests[job], [&progress, job](uint64_t copied, uint64_t total) {
+            progress.Update(job, total == 0 ? 0 : static_cast<uint32_t>(100 * copied / total));
+        });
+        progress.Complete(job);
+    });
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return run;
+}
+} // namespace
+
+class CopySchedulerHostTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        hosttest_common_utils::g_namedThreads = 0;
+    }
+};
+
+/**
+ * @tc.name: RunKeepsLaneOrder
+ * @tc.desc: Run hands every job to exactly one worker, and jobs sharing a lane key run one after another
+ *           in job order while lanes spread over the workers.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(CopySchedulerHostTest, RunKeepsLaneOrder, TestSize.Level0)
+{
+    std::vector<std::string> keys;
+    std::mt19937 rng(1669);
+    for (size_t i = 0; i < 200; ++i) {
+        keys.push_back("/dest/file_" + std::to_string(rng() % 37));
+    }
+    std::mutex mutex;
+    std::map<std::string, std::vector<size_t>> ranPerLane;
+    std::map<std::string, int> inFlightPerLane;
+    std::vector<int> runs(keys.size(), 0);
+    bool overlapInLane = false;
+    PasteboardCopyScheduler::Run(keys, PasteboardCopyScheduler::MAX_COPY_WORKERS, [&](size_t job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            overlapInLane = overlapInLane || inFlightPerLane[keys[job]]++ != 0;
+            ranPerLane[keys[job]].push_back(job);
+            runs[job]++;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        std::lock_guard<std::mutex> lock(mutex);
+        inFlightPerLane[keys[job]]--;
+    });
+    EXPECT_FALSE(overlapInLane);
+    EXPECT_TRUE(std::all_of(runs.begin(), runs.end(), [](int count) { return count == 1; }));
+    for (const auto &[key, jobs] : ranPerLane) {
+        EXPECT_TRUE(std::is_sorted(jobs.begin(), jobs.end())) << key;
+    }
+    EXPECT_EQ(hosttest_common_utils::g_namedThreads.load(),
+        static_cast<int>(PasteboardCopyScheduler::MAX_COPY_WORKERS - 1));
+}
+
+/**
+ * @tc.name: RunBoundsAndOverlapsWorkers
+ * @tc.desc: Run never has more than maxWorkers jobs in flight, does reach that bound, and finishes slow
+ *           independent jobs in well under the one-at-a-time time. Jobs sleep, so this holds on one core.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(CopySchedulerHostTest, RunBoundsAndOverlapsWorkers, TestSize.Level0)
+{
+    constexpr size_t jobCount = 32;
+    constexpr auto jobTime = std::chrono::milliseconds(4);
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < jobCount; ++i) {
+        keys.push_back("/dest/photo_" + std::to_string(i) + ".jpg");
+    }
+    auto timeRun = [&keys, jobTime](size_t workers, int &maxInFlight) {
+        std::atomic<int> inFlight = 0;
+        std::atomic<int> maxSeen = 0;
+        auto begin = std::chrono::steady_clock::now();
+        PasteboardCopyScheduler::Run(keys, workers, [&](size_t job) {
+            (void)job;
+            int now = ++inFlight;
+            int seen = maxSeen.load();
+            while (now > seen && !maxSeen.compare_exchange_weak(seen, now)) {
+            }
+            std::this_thread::sleep_for(jobTime);
+            --inFlight;
+        });
+        maxInFlight = maxSeen.load();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    };
+    int sequentialInFlight = 0;
+    int parallelInFlight = 0;
+    double sequential = timeRun(1, sequentialInFlight);
+    double parallel = timeRun(PasteboardCopyScheduler::MAX_COPY_WORKERS, parallelInFlight);
+    std::printf("[ BENCH    ] %zu slow jobs: 1 worker %.1f ms, %zu workers %.1f ms\n", jobCount,
+        sequential * 1000, PasteboardCopyScheduler::MAX_COPY_WORKERS, parallel * 1000);
+    EXPECT_EQ(sequentialInFlight, 1);
+    EXPECT_EQ(parallelInFlight, static_cast<int>(PasteboardCopyScheduler::MAX_COPY_WORKERS));
+    EXPECT_LT(parallel, sequential / 2);
+}
+
+/**
+ * @tc.name: RunHandlesDegenerateInput
+ * @tc.desc: Run does nothing without jobs or without a job function, treats zero workers as one and starts
+ *           no more workers than there are lanes.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(CopySchedulerHostTest, RunHandlesDegenerateInput, TestSize.Level0)
+{
+    int calls = 0;
+    PasteboardCopyScheduler::Run({}, PasteboardCopyScheduler::MAX_COPY_WORKERS, [&calls](size_t) { calls++; });
+    PasteboardCopyScheduler::Run({ "/dest/a" }, PasteboardCopyScheduler::MAX_COPY_WORKERS, nullptr);
+    EXPECT_EQ(calls, 0);
+
+    auto caller = std::this_thread::get_id();
+    bool onCaller = true;
+    PasteboardCopyScheduler::Run({ "/dest/a", "/dest/b", "/dest/a" }, 0, [&](size_t) {
+        onCaller = onCaller && std::this_thread::get_id() == caller;
+        calls++;
+    });
+    EXPECT_EQ(calls, 3);
+    EXPECT_TRUE(onCaller);
+
+    // one lane only needs one worker, whatever the bound
+    PasteboardCopyScheduler::Run({ "/dest/a", "/dest/a" }, PasteboardCopyScheduler::MAX_COPY_WORKERS,
+        [&calls](size_t) { calls++; });
+    EXPECT_EQ(calls, 5);
+    EXPECT_EQ(hosttest_common_utils::g_namedThreads.load(), 0);
+}
+
+/**
+ * @tc.name: RunStopsStartingJobs
+ * @tc.desc: once stopped returns true no further job starts, on one worker and on several, and the jobs
+ *           already running finish.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(CopySchedulerHostTest, RunStopsStartingJobs, TestSize.Level0)
+{
+    const std::vector<std::string> keys = { "/dest/a", "/dest/b", "/dest/a", "/dest/c", "/dest/b", "/dest/d" };
+    std::atomic<size_t> started = 0;
+    std::atomic<size_t> finished = 0;
+    std::atomic<bool> canceled = false;
+    auto job = [&](size_t) {
+        if (++started == 2) {
+            canceled = true;
+        }
+        ++finished;
+    };
+    auto stopped = [&canceled]() {
+        return canceled.load();
+    };
+    PasteboardCopyScheduler::Run(keys, 1, job, stopped);
+    EXPECT_EQ(started.load(), 2u);
+    EXPECT_EQ(finished.load(), 2u);
+
+    started = 0;
+    finished = 0;
+    canceled = false;
+    PasteboardCopyScheduler::Run(keys, PasteboardCopyScheduler::MAX_COPY_WORKERS, job, stopped);
+    // a worker that checked before the cancel still runs its job, none starts after it
+    EXPECT_LE(started.load(), 1 + PasteboardCopyScheduler::MAX_COPY_WORKERS);
+    EXPECT_LT(started.load(), keys.size());
+    EXPECT_EQ(finished.load(), started.load());
+}
+
+/**
+ * @tc.name: ProgressOnlyGrows
+ * @tc.desc: PasteboardCopyProgress reports strictly increasing totals, ignores regressions and unknown slots,
+ *           clamps a slot at 100, and counts completed slots without reporting them.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(CopySchedulerHostTest, ProgressOnlyGrows, TestSize.Level0)
+{
+    std::vector<std::pair<size_t, uint64_t>> reports;
+    PasteboardCopyProgress progress(3, [&reports](size_t slot, uint64_t total) {
+        reports.emplace_back(slot, total);
+    });
+    progress.Complete(0);
+    EXPECT_EQ(progress.GetTotal(), 100u);
+    EXPECT_TRUE(reports.empty());
+
+    progress.Update(1, 40);
+    progress.Update(1, 30);
+    progress.Update(2, 250);
+    progress.Update(7, 50);
+    progress.Complete(1);
+    progress.Update(1, 100);
+    std::vector<std::pair<size_t, uint64_t>> expected = { { 1, 140 }, { 2, 240 } };
+    EXPECT_EQ(reports, expected);
+    EXPECT_EQ(progress.GetTotal(), 300u);
+
+    PasteboardCopyProgress silent(1, nullptr);
+    silent.Update(0, 10);
+    EXPECT_EQ(silent.GetTotal(), 10u);
+}
+
+/**
+ * @tc.name: ProgressIsMonotonicUnderContention
+ * @tc.desc: Slots updated from several threads at once still produce strictly increasing reports that end
+ *           at slots * 100.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(CopySchedulerHostTest, ProgressIsMonotonicUnderContention, TestSize.Level0)
+{
+    constexpr size_t slots = 64;
+    std::vector<uint64_t> totals;
+    PasteboardCopyProgress progress(slots, [&totals](size_t, uint64_t total) {
+        totals.push_back(total);
+    });
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&progress, t]() {
+            std::mt19937 rng(static_cast<uint32_t>(t));
+            for (size_t slot = t; slot < slots; slot += 4) {
+                for (uint32_t pct = 0; pct < 100; pct += 1 + rng() % 9) {
+                    progress.Update(slot, pct);
+                }
+                progress.Update(slot, 100);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_FALSE(totals.empty());
+    EXPECT_TRUE(std::adjacent_find(totals.begin(), totals.end(), std::greater_equal<uint64_t>()) == totals.end());
+    EXPECT_EQ(totals.back(), slots * 100);
+    EXPECT_EQ(progress.GetTotal(), slots * 100);
+}
+
+/**
+ * @tc.name: ProgressReportsOutsideTheLock
+ * @tc.desc: the reporter may call back into the progress, and a copy that advances while another thread is
+ *           inside the reporter returns at once, its total reported by that thread when the reporter returns.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(CopySchedulerHostTest, ProgressReportsOutsideTheLock, TestSize.Level0)
+{
+    constexpr uint32_t firstPercentage = 10;
+    PasteboardCopyProgress *self = nullptr;
+    std::atomic<bool> entered = false;
+    std::atomic<bool> released = false;
+    std::vector<std::pair<size_t, uint64_t>> reports;
+    PasteboardCopyProgress progress(2, [&](size_t slot, uint64_t total) {
+        reports.emplace_back(slot, total);
+        EXPECT_GE(self->GetTotal(), total);
+        if (total == firstPercentage) {
+            entered = true;
+            while (!released) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    self = &progress;
+    std::thread reporter([&progress]() {
+        progress.Update(0, firstPercentage);
+    });
+    while (!entered) {
+        std::this_thread::yield();
+    }
+    progress.Update(1, 20);
+    progress.Update(1, 30);
+    released = true;
+    reporter.join();
+    std::vector<std::pair<size_t, uint64_t>> expected = { { 0, 10 }, { 1, 40 } };
+    EXPECT_EQ(reports, expected);
+    progress.Update(0, 50);
+    EXPECT_EQ(reports.back(), std::make_pair(size_t(0), uint64_t(80)));
+}
+
+/**
+ * @tc.name: ParallelCopyOnTempFilesystem
+ * @tc.desc: Copies 160 files of 256KB in a temp dir with one worker and with MAX_COPY_WORKERS. Both runs must
+ *           produce identical files, a later copy to a repeated destination must win like it did one at a time,
+ *           and progress must stay monotonic. Prints files per second; the 1.5x speedup is only asserted on a
+ *           host with 4 or more cores.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(CopySchedulerHostTest, ParallelCopyOnTempFilesystem, TestSize.Level0)
+{
+    constexpr size_t fileCount = 160;
+    constexpr size_t fileSize = 256 * 1024;
+    constexpr size_t duplicateEvery = 16;
+    TempDir tmp;
+    ASSERT_FALSE(tmp.Path().empty());
+    ASSERT_EQ(mkdir((tmp.Path() + "/src").c_str(), 0700), 0);
+    std::vector<std::string> srcs;
+    std::vector<std::string> names;
+    std::mt19937 rng(1669);
+    std::string block(fileSize, '\0');
+    for (auto &c : block) {
+        c = static_cast<char>(rng());
+    }
+    for (size_t i = 0; i < fileCount; ++i) {
+        std::string content = std::to_string(i) + block.substr(std::to_string(i).size());
+        srcs.push_back(tmp.Path() + "/src/photo_" + std::to_string(i) + ".jpg");
+        ASSERT_TRUE(WriteFile(srcs.back(), content));
+        // every 16th record pastes under the name of the record before it, so its copy lands on the same file
+        names.push_back(i % duplicateEvery == duplicateEvery - 1 ? names.back() : "photo_" + std::to_string(i) + ".jpg");
+    }
+    auto destsIn = [&names, &tmp](const std::string &dir) {
+        std::vector<std::string> dests;
+        mkdir((tmp.Path() + "/" + dir).c_str(), 0700);
+        for (const auto &name : names) {
+            dests.push_back(tmp.Path() + "/" + dir + "/" + name);
+        }
+        return dests;
+    };
+    auto sequentialDests = destsIn("sequential");
+    auto parallelDests = destsIn("parallel");
+    CopyRun sequential = CopyAll(srcs, sequentialDests, 1);
+    CopyRun parallel = CopyAll(srcs, parallelDests, PasteboardCopyScheduler::MAX_COPY_WORKERS);
+
+    EXPECT_TRUE(sequential.monotonic);
+    EXPECT_TRUE(parallel.monotonic);
+    EXPECT_EQ(sequential.lastTotal, fileCount * 100);
+    EXPECT_EQ(parallel.lastTotal, fileCount * 100);
+    for (size_t i = 0; i < fileCount; ++i) {
+        bool lastForName = i + 1 == fileCount || names[i + 1] != names[i];
+        if (lastForName) {
+            std::string expected = ReadFile(srcs[i]);
+            EXPECT_EQ(ReadFile(sequentialDests[i]), expected) << names[i];
+            EXPECT_EQ(ReadFile(parallelDests[i]), expected) << names[i];
+        }
+    }
+    double speedup = sequential.seconds / parallel.seconds;
+    std::printf("[ BENCH    ] %zu x %zuKB: 1 worker %.0f files/s, %zu workers %.0f files/s (%.2fx, %zu reports)\n",
+        fileCount, fileSize / 1024, fileCount / sequential.seconds, PasteboardCopyScheduler::MAX_COPY_WORKERS,
+        fileCount / parallel.seconds, speedup, parallel.reports);
+    if (std::thread::hardware_concurrency() >= 4) {
+        EXPECT_GT(speedup, 1.5);
+    }
+}
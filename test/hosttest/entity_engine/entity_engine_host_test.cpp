@@ -0,0 +1,501 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <dlfcn.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "i_paste_data_processor.h"
+#include "pasteboard_entity_engine.h"
+
+namespace hosttest_common_utils {
+std::atomic<int> g_namedTasks = 0;
+}
+
+using namespace testing::ext;
+using namespace OHOS::MiscServices;
+
+namespace {
+constexpr auto WAIT_LIMIT = std::chrono::seconds(5);
+constexpr uint32_t SHORT_IDLE_MS = 30;
+constexpr const char *FAKE_NLU = "libai_nlu_innerapi.z.so";
+constexpr const char *FAKE_SSL = "libcrypto_openssl.z.so";
+
+template<typename Pred>
+bool WaitUntil(Pred pred)
+{
+    auto deadline = std::chrono::steady_clock::now() + WAIT_LIMIT;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// counts every call, "fail" fails the inference, a gated text parks Process until Open
+class FakeBackend : public PasteboardEntityEngine::Backend {
+public:
+    struct Counters {
+        std::atomic<int> loads = 0;
+        std::atomic<int> unloads = 0;
+        std::atomic<int> processed = 0;
+        std::atomic<bool> failLoad = false;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::string gatedText;
+        bool gateOpen = true;
+        bool inGate = false;
+        std::vector<std::string> texts;
+    };
+
+    explicit FakeBackend(std::shared_ptr<Counters> counters) : counters_(counters) {}
+
+    bool Load() override
+    {
+        bool fail = counters_->failLoad;
+        counters_->loads++;
+        return !fail;
+    }
+    int32_t Process(const std::string &text, std::string &entity) override
+    {
+        std::unique_lock<std::mutex> lock(counters_->mutex);
+        counters_->processed++;
+        counters_->texts.push_back(text);
+        if (text == counters_->gatedText) {
+            counters_->inGate = true;
+            counters_->cv.notify_all();
+            counters_->cv.wait(lock, [this] { return counters_->gateOpen; });
+            counters_->inGate = false;
+        }
+        if (text == "fail") {
+            return -1;
+        }
+        entity = "entity:" + text;
+        return 0;
+    }
+    void Unload() override
+    {
+        counters_->unloads++;
+    }
+
+private:
+    std::shared_ptr<Counters> counters_;
+};
+
+class Results {
+public:
+    PasteboardEntityEngine::ResultCallback Callback()
+    {
+        return [this](const std::string &text, const std::string &entity) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                texts_.push_back(text);
+                entities_.push_back(entity);
+            }
+            cv_.notify_all();
+        };
+    }
+    bool WaitFor(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, WAIT_LIMIT, [this, count] { return texts_.size() >= count; });
+    }
+    size_t Size()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return texts_.size();
+    }
+    std::vector<std::string> Texts()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return texts_;
+    }
+    std::vector<std::string> Entities()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entities_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::string> texts_;
+    std::vector<std::string> entities_;
+};
+
+std::unique_ptr<PasteboardEntityEngine> MakeEngine(std::shared_ptr<FakeBackend::Counters> counters,
+    Results &results, uint32_t idleMs = PasteboardEntityEngine::IDLE_UNLOAD_MS)
+{
+    return std::make_unique<PasteboardEntityEngine>(
+        std::make_unique<FakeBackend>(counters), results.Callback(), idleMs);
+}
+
+void CloseGate(FakeBackend::Counters &counters, const std::string &text)
+{
+    std::lock_guard<std::mutex> lock(counters.mutex);
+    counters.gatedText = text;
+    counters.gateOpen = false;
+}
+
+void OpenGate(FakeBackend::Counters &counters)
+{
+    {
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        counters.gateOpen = true;
+    }
+    counters.cv.notify_all();
+}
+
+bool WaitInGate(FakeBackend::Counters &counters)
+{
+    std::unique_lock<std::mutex> lock(counters.mutex);
+    return counters.cv.wait_for(lock, WAIT_LIMIT, [&counters] { return counters.inGate; });
+}
+
+int *FakeCounter(void *handle, const char *name)
+{
+    return handle == nullptr ? nullptr : reinterpret_cast<int *>(dlsym(handle, name));
+}
+} // namespace
+
+class EntityEngineHostTest : public testing::Test {};
+
+/**
+ * @tc.name: LoadsOnceAndCachesByText
+ * @tc.desc: The backend loads on the first request only, and a recopied text is answered from the cache
+ *           without another inference while every request still reports its result.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(EntityEngineHostTest, LoadsOnceAndCachesByText, TestSize.Level0)
+{
+    auto counters = std::make_shared<FakeBackend::Counters>();
+    Results results;
+    auto engine = MakeEngine(counters, results);
+    int namedBefore = hosttest_common_utils::g_namedTasks;
+
+    engine->Recognize("Hangzhou");
+    ASSERT_TRUE(results.WaitFor(1));
+    engine->Recognize("Hangzhou");
+    ASSERT_TRUE(results.WaitFor(2));
+    engine->Recognize("Shanghai");
+    ASSERT_TRUE(results.WaitFor(3));
+
+    EXPECT_EQ(counters->loads.load(), 1);
+    EXPECT_EQ(counters->processed.load(), 2);
+    EXPECT_EQ(counters->unloads.load(), 0);
+    EXPECT_EQ(results.Entities(),
+        std::vector<std::string>({ "entity:Hangzhou", "entity:Hangzhou", "entity:Shanghai" }));
+    EXPECT_EQ(hosttest_common_utils::g_namedTasks - namedBefore, 1);
+
+    engine->Stop();
+    EXPECT_EQ(counters->unloads.load(), 1);
+}
+
+/**
+ * @tc.name: NewerCopySupersedes
+ * @tc.desc: While an inference runs, a waiting request is replaced by a newer one and the running result is
+ *           dropped, yet kept in the cache for the next copy of that text.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(EntityEngineHostTest, NewerCopySupersedes, TestSize.Level0)
+{
+    auto counters = std::make_shared<FakeBackend::Counters>();
+    Results results;
+    auto engine = MakeEngine(counters, results);
+    CloseGate(*counters, "slow");
+
+    engine->Recognize("slow");
+    ASSERT_TRUE(WaitInGate(*counters));
+    engine->Recognize("second");
+    engine->Recognize("third");
+    OpenGate(*counters);
+    ASSERT_TRUE(results.WaitFor(1));
+    EXPECT_EQ(results.Texts(), std::vector<std::string>({ "third" }));
+    {
+        std::lock_guard<std::mutex> lock(counters->mutex);
+        EXPECT_EQ(counters->texts, std::vector<std::string>({ "slow", "third" }));
+    }
+
+    engine->Recognize("slow");
+    ASSERT_TRUE(results.WaitFor(2));
+    EXPECT_EQ(counters->processed.load(), 2);
+}
+
+/**
+ * @tc.name: UnloadsWhenIdle
+ * @tc.desc: The worker unloads the backend and exits after the idle time, the next request loads it again.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(EntityEngineHostTest, UnloadsWhenIdle, TestSize.Level0)
+{
+    auto counters = std::make_shared<FakeBackend::Counters>();
+    Results results;
+    auto engine = MakeEngine(counters, results, SHORT_IDLE_MS);
+
+    engine->Recognize("first");
+    ASSERT_TRUE(results.WaitFor(1));
+    ASSERT_TRUE(WaitUntil([&counters] { return counters->unloads == 1; }));
+    ASSERT_TRUE(WaitUntil([&engine] {
+        std::lock_guard<std::mutex> lock(engine->mutex_);
+        return !engine->workerRunning_;
+    }));
+
+    engine->Recognize("second");
+    ASSERT_TRUE(results.WaitFor(2));
+    EXPECT_EQ(counters->loads.load(), 2);
+    // a cached text needs no backend, the idle worker has nothing to unload
+    ASSERT_TRUE(WaitUntil([&counters] { return counters->unloads == 2; }));
+    engine->Recognize("second");
+    ASSERT_TRUE(results.WaitFor(3));
+    engine->Stop();
+    EXPECT_EQ(counters->loads.load(), 2);
+    EXPECT_EQ(counters->unloads.load(), 2);
+}
+
+/**
+ * @tc.name: FailuresAreNeitherReportedNorCached
+ * @tc.desc: A failed load or inference reports nothing, and the next request tries again.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(EntityEngineHostTest, FailuresAreNeitherReportedNorCached, TestSize.Level0)
+{
+    auto counters = std::make_shared<FakeBackend::Counters>();
+    Results results;
+    auto engine = MakeEngine(counters, results);
+
+    counters->failLoad = true;
+    engine->Recognize("text");
+    ASSERT_TRUE(WaitUntil([&counters] { return counters->loads == 1; }));
+    counters->failLoad = false;
+    engine->Recognize("fail");
+    ASSERT_TRUE(WaitUntil([&counters] { return counters->processed == 1; }));
+    engine->Recognize("fail");
+    ASSERT_TRUE(WaitUntil([&counters] { return counters->processed == 2; }));
+    engine->Recognize("text");
+    ASSERT_TRUE(results.WaitFor(1));
+    EXPECT_EQ(results.Texts(), std::vector<std::string>({ "text" }));
+    EXPECT_EQ(counters->loads.load(), 2);
+
+    Results noBackendResults;
+    PasteboardEntityEngine noBackend(nullptr, noBackendResults.Callback());
+    noBackend.Recognize("text");
+    noBackend.Stop();
+    EXPECT_EQ(noBackendResults.Size(), 0u);
+}
+
+/**
+ * @tc.name: CacheEvictsLeastRecent
+ * @tc.desc: The cache keeps the CACHE_CAPACITY most recently used texts, and a hit refreshes its entry.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(EntityEngineHostTest, CacheEvictsLeastRecent, TestSize.Level0)
+{
+    auto counters = std::make_shared<FakeBackend::Counters>();
+    Results results;
+    auto engine = MakeEngine(counters, results);
+    size_t expected = 0;
+    auto recognize = [&engine, &results, &expected](const std::string &text) {
+        engine->Recognize(text);
+        ++expected;
+        return results.WaitFor(expected);
+    };
+
+    for (size_t i = 0; i < PasteboardEntityEngine::CACHE_CAPACITY; ++i) {
+        ASSERT_TRUE(recognize("text" + std::to_string(i)));
+    }
+    ASSERT_TRUE(recognize("text0"));
+    ASSERT_TRUE(recognize("extra"));
+    int processed = counters->processed;
+    EXPECT_EQ(processed, static_cast<int>(PasteboardEntityEngine::CACHE_CAPACITY) + 1);
+    // text0 was refreshed, text1 became the oldest and made room for extra
+    ASSERT_TRUE(recognize("text0"));
+    EXPECT_EQ(counters->processed.load(), processed);
+    ASSERT_TRUE(recognize("text1"));
+    EXPECT_EQ(counters->processed.load(), processed + 1);
+}
+
+/**
+ * @tc.name: CacheHitNeedsTheSameText
+ * @tc.desc: An entry whose hash matches but whose text differs, as after a hash collision, is not a hit.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(EntityEngineHostTest, CacheHitNeedsTheSameText, TestSize.Level0)
+{
+    auto counters = std::make_shared<FakeBackend::Counters>();
+    Results results;
+    auto engine = MakeEngine(counters, results);
+    std::string text = "Hangzhou";
+    // the worker is not running yet, so the test owns the cache
+    engine->cache_.push_front({ std::hash<std::string>()(text), "Shanghai", "entity:Shanghai" });
+
+    engine->Recognize(text);
+    ASSERT_TRUE(results.WaitFor(1));
+    EXPECT_EQ(results.Entities(), std::vector<std::string>({ "entity:Hangzhou" }));
+    EXPECT_EQ(counters->processed.load(), 1);
+    engine->Recognize(text);
+    ASSERT_TRUE(results.WaitFor(2));
+    EXPECT_EQ(counters->processed.load(), 1);
+}
+
+/**
+ * @tc.name: StopDropsInFlightAndLaterRequests
+ * @tc.desc: Stop waits for a running inference but drops its result, unloads, and ignores later requests.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(EntityEngineHostTest, StopDropsInFlightAndLaterRequests, TestSize.Level0)
+{
+    auto counters = std::make_shared<FakeBackend::Counters>();
+    Results results;
+    auto engine = MakeEngine(counters, results);
+    CloseGate(*counters, "slow");
+
+    engine->Recognize("slow");
+    ASSERT_TRUE(WaitInGate(*counters));
+    std::thread stopper([&engine] { engine->Stop(); });
+    ASSERT_TRUE(WaitUntil([&engine] {
+        std::lock_guard<std::mutex> lock(engine->mutex_);
+        return engine->stopping_;
+    }));
+    OpenGate(*counters);
+    stopper.join();
+
+    EXPECT_EQ(results.Size(), 0u);
+    EXPECT_EQ(counters->unloads.load(), 1);
+    engine->Recognize("later");
+    engine->Stop();
+    EXPECT_EQ(counters->processed.load(), 1);
+    EXPECT_EQ(results.Size(), 0u);
+}
+
+/**
+ * @tc.name: NluBackendDrivesTheLibraries
+ * @tc.desc: The NLU backend dlopens the AI engine and OpenSSL, runs their processor, and calls
+ *           OPENSSL_cleanup once when it unloads rather than once per copy.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(EntityEngineHostTest, NluBackendDrivesTheLibraries, TestSize.Level0)
+{
+    // holding the fake libraries keeps their counters alive across the backend's dlclose
+    void *nlu = dlopen(FAKE_NLU, RTLD_NOW);
+    void *ssl = dlopen(FAKE_SSL, RTLD_NOW);
+    ASSERT_NE(nlu, nullptr) << "run through run_host_test.sh, it builds the fake libraries";
+    ASSERT_NE(ssl, nullptr);
+    auto *processed = FakeCounter(nlu, "g_fakeNluProcessCount");
+    auto *cleanups = FakeCounter(ssl, "g_fakeSslCleanupCount");
+    ASSERT_NE(processed, nullptr);
+    ASSERT_NE(cleanups, nullptr);
+    int processedBefore = *processed;
+    int cleanupsBefore = *cleanups;
+
+    Results results;
+    PasteboardEntityEngine engine(PasteboardEntityEngine::CreateNluBackend(), results.Callback(), SHORT_IDLE_MS);
+    engine.Recognize("West Lake");
+    ASSERT_TRUE(results.WaitFor(1));
+    engine.Recognize("fail");
+    engine.Recognize("Broken Bridge");
+    ASSERT_TRUE(results.WaitFor(2));
+    EXPECT_EQ(results.Entities()[0], "{\"code\":0,\"entity\":{\"location\":[\"West Lake\"]}}");
+    EXPECT_EQ(*cleanups, cleanupsBefore);
+    ASSERT_TRUE(WaitUntil([cleanups, cleanupsBefore] { return *cleanups == cleanupsBefore + 1; }));
+    engine.Stop();
+    EXPECT_EQ(*cleanups, cleanupsBefore + 1);
+    EXPECT_GE(*processed - processedBefore, 2);
+
+    auto unloaded = PasteboardEntityEngine::CreateNluBackend();
+    std::string entity;
+    EXPECT_NE(unloaded->Process("text", entity), 0);
+    unloaded->Unload();
+    dlclose(ssl);
+    dlclose(nlu);
+}
+
+/**
+ * @tc.name: WarmEngineBeatsPerCopyLoading
+ * @tc.desc: Recognizing through the resident engine costs less per copy than the old dlopen, process,
+ *           OPENSSL_cleanup and dlclose round on every copy.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(EntityEngineHostTest, WarmEngineBeatsPerCopyLoading, TestSize.Level0)
+{
+    constexpr int copies = 200;
+    using GetProcessorFunc = IPasteDataProcessor &(*)();
+    using CleanupFunc = void (*)();
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < copies; ++i) {
+        void *nlu = dlopen(FAKE_NLU, RTLD_NOW);
+        void *ssl = dlopen(FAKE_SSL, RTLD_NOW);
+        ASSERT_NE(nlu, nullptr);
+        ASSERT_NE(ssl, nullptr);
+        auto cleanSSL = reinterpret_cast<CleanupFunc>(dlsym(ssl, "OPENSSL_cleanup"));
+        auto getProcessor = reinterpret_cast<GetProcessorFunc>(dlsym(nlu, "GetPasteDataProcessor"));
+        std::string entity;
+        getProcessor().Process("copy" + std::to_string(i), entity);
+        cleanSSL();
+        dlclose(ssl);
+        dlclose(nlu);
+    }
+    double perCopyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    Results results;
+    PasteboardEntityEngine engine(PasteboardEntityEngine::CreateNluBackend(), results.Callback());
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < copies; ++i) {
+        engine.Recognize("copy" + std::to_string(i));
+        size_t expected = static_cast<size_t>(i) + 1;
+        ASSERT_TRUE(results.WaitFor(expected));
+    }
+    double engineMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < copies; ++i) {
+        engine.Recognize("copy" + std::to_string(copies - 1));
+        size_t expected = static_cast<size_t>(copies + i) + 1;
+        ASSERT_TRUE(results.WaitFor(expected));
+    }
+    double cachedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    engine.Stop();
+
+    printf("[  BENCH   ] %d copies: load per copy %.2f ms, resident engine %.2f ms, recopied text %.2f ms\n",
+        copies, perCopyMs, engineMs, cachedMs);
+    EXPECT_LT(engineMs, perCopyMs);
+}
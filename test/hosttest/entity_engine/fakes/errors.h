@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HOST-TEST FAKE for c_utils errors.h (entity_engine suite).
+// Only the two codes pasteboard_entity_engine.cpp uses.
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_ENTITY_ENGINE_ERRORS_H
+#define PASTEBOARD_HOSTTEST_FAKE_ENTITY_ENGINE_ERRORS_H
+
+#include <cerrno>
+
+namespace OHOS {
+enum {
+    ERR_OK = 0,
+    ERR_INVALID_VALUE = EINVAL,
+};
+} // namespace OHOS
+
+#endif // PASTEBOARD_HOSTTEST_FAKE_ENTITY_ENGINE_ERRORS_H
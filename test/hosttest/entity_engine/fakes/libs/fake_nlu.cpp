@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HOST-TEST FAKE of libai_nlu_innerapi.z.so (entity_engine suite), built as a shared library of that name.
+// The processor answers with an entity json naming the text as its location, "fail" makes it fail, and
+// every call is counted in g_fakeNluProcessCount.
+
+#include <atomic>
+
+#include "i_paste_data_processor.h"
+
+extern "C" std::atomic<int> g_fakeNluProcessCount;
+std::atomic<int> g_fakeNluProcessCount = 0;
+
+namespace {
+class FakeProcessor : public OHOS::MiscServices::IPasteDataProcessor {
+public:
+    int32_t Process(const std::string &data, std::string &result) override
+    {
+        g_fakeNluProcessCount++;
+        if (data == "fail") {
+            return -1;
+        }
+        result = "{\"code\":0,\"entity\":{\"location\":[\"" + data + "\"]}}";
+        return 0;
+    }
+};
+} // namespace
+
+extern "C" OHOS::MiscServices::IPasteDataProcessor &GetPasteDataProcessor()
+{
+    static FakeProcessor processor;
+    return processor;
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HOST-TEST FAKE of libcrypto_openssl.z.so (entity_engine suite), built as a shared library of that name.
+// OPENSSL_cleanup only counts its calls in g_fakeSslCleanupCount.
+
+#include <atomic>
+
+extern "C" std::atomic<int> g_fakeSslCleanupCount;
+std::atomic<int> g_fakeSslCleanupCount = 0;
+
+extern "C" void OPENSSL_cleanup()
+{
+    g_fakeSslCleanupCount++;
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// HOST-TEST FAKE for ipc_skeleton.h. pasteboard_img_extractor.cpp only asks for
+// the calling uid; the test sets it through hosttest_ipc::g_callingUid.
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_IPC_SKELETON_H
+#define PASTEBOARD_HOSTTEST_FAKE_IPC_SKELETON_H
+
+#include <sys/types.h>
+
+namespace hosttest_ipc {
+extern pid_t g_callingUid;
+}
+
+namespace OHOS {
+class IPCSkeleton {
+public:
+    static pid_t GetCallingUid()
+    {
+        return hosttest_ipc::g_callingUid;
+    }
+};
+} // namespace OHOS
+#endif // PASTEBOARD_HOSTTEST_FAKE_IPC_SKELETON_H
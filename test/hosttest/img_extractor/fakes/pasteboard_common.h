@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// HOST-TEST FAKE for utils/native/include/pasteboard_common.h. The real class
+// pulls in the bundle manager proxy; the extractor only needs Stat, which is a
+// plain stat() on device as well. Test hooks: hosttest_common::g_statCalls
+// counts calls, g_statInFlight / g_statMaxInFlight track how many overlap and
+// g_statDelayUs stretches each call so the overlap is observable.
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_PASTEBOARD_COMMON_H
+#define PASTEBOARD_HOSTTEST_FAKE_PASTEBOARD_COMMON_H
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+
+namespace hosttest_common {
+extern std::atomic<int> g_statCalls;
+extern std::atomic<int> g_statInFlight;
+extern std::atomic<int> g_statMaxInFlight;
+extern int g_statDelayUs;
+}
+
+namespace OHOS {
+namespace MiscServices {
+class PasteBoardCommon {
+public:
+    static int32_t Stat(const std::string &path, struct stat *buf)
+    {
+        ++hosttest_common::g_statCalls;
+        int inFlight = ++hosttest_common::g_statInFlight;
+        int seen = hosttest_common::g_statMaxInFlight.load();
+        while (inFlight > seen && !hosttest_common::g_statMaxInFlight.compare_exchange_weak(seen, inFlight)) {
+        }
+        if (hosttest_common::g_statDelayUs > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(hosttest_common::g_statDelayUs));
+        }
+        int32_t ret = stat(path.c_str(), buf);
+        int savedErrno = errno;
+        --hosttest_common::g_statInFlight;
+        errno = savedErrno;
+        return ret;
+    }
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_HOSTTEST_FAKE_PASTEBOARD_COMMON_H
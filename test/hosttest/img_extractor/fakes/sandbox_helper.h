@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// HOST-TEST FAKE for app_file_service sandbox_helper.h. The real helper maps
+// file://<bundle>/<path> to /data/app/el2/<user>/base/<bundle>/<path>; this one
+// maps it under hosttest_sandbox::g_root (a temp dir the test owns), so the
+// extractor's stat() hits real files. Paths with ".." are invalid, as on device.
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_SANDBOX_HELPER_H
+#define PASTEBOARD_HOSTTEST_FAKE_SANDBOX_HELPER_H
+
+#include <cstdint>
+#include <string>
+
+namespace hosttest_sandbox {
+extern std::string g_root;
+}
+
+namespace OHOS {
+namespace AppFileService {
+class SandboxHelper {
+public:
+    static int32_t GetPhysicalPath(const std::string &fileUri, const std::string &userId,
+        std::string &physicalPath)
+    {
+        static const std::string scheme = "file://";
+        if (hosttest_sandbox::g_root.empty() || fileUri.compare(0, scheme.size(), scheme) != 0) {
+            return -1;
+        }
+        size_t pathBegin = fileUri.find('/', scheme.size());
+        if (pathBegin == std::string::npos) {
+            return -1;
+        }
+        physicalPath = hosttest_sandbox::g_root + "/" + userId + fileUri.substr(pathBegin);
+        return 0;
+    }
+
+    static bool IsValidPath(const std::string &path)
+    {
+        return path.find("/../") == std::string::npos;
+    }
+};
+} // namespace AppFileService
+} // namespace OHOS
+#endif // PASTEBOARD_HOSTTEST_FAKE_SANDBOX_HELPER_H
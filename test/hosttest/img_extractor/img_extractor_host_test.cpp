@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::PasteboardImgExtractor
+// (framework/innerkits/src/pasteboard_img_extractor.cpp) against the host libxml2.
+//
+// The reference for the SAX collection is what the extractor did before it: htmlReadDoc, then
+// "//img[@src]" through XPath and xmlGetProp, skipping empty values.
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <libxml/HTMLparser.h>
+#include <libxml/xpath.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ipc_skeleton.h"
+#include "pasteboard_img_extractor.h"
+#include "sandbox_helper.h"
+
+namespace hosttest_ipc {
+pid_t g_callingUid = 0;
+}
+namespace hosttest_sandbox {
+std::string g_root;
+}
+namespace hosttest_common {
+std::atomic<int> g_statCalls = 0;
+std::atomic<int> g_statInFlight = 0;
+std::atomic<int> g_statMaxInFlight = 0;
+int g_statDelayUs = 0;
+}
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr int32_t USER_ID = 100;
+constexpr const char *BUNDLE_INDEX = "com.example.notes";
+constexpr uint32_t RANDOM_SEED = 20260417;
+constexpr int RANDOM_CASES = 1500;
+constexpr int MAX_RANDOM_PIECES = 16;
+constexpr size_t BENCH_HTML_BYTES = 128 * 1024;
+constexpr int BENCH_PARSES = 48;
+constexpr size_t MIN_CORES_FOR_SCALING = 4;
+constexpr double MIN_SCALING = 1.5;
+constexpr int FILTER_FILES = 200;
+constexpr int FILTER_REPEATS = 3;
+constexpr int SLOW_STAT_FILES = 64;
+constexpr int SLOW_STAT_DELAY_US = 2000;
+constexpr int MAX_STAT_WORKERS = 4;
+constexpr uid_t HWF_SERVICE_UID = 7700;
+
+// the one at a time filter FilterExistFileUris replaced, kept as the reference
+std::vector<std::string> SerialFilterExistFileUris(const std::vector<std::string> &uris,
+    const std::string &bundleIndex, int32_t userId)
+{
+    std::vector<std::string> existFileUris;
+    std::string userIdStr = std::to_string(userId);
+    auto callingUid = IPCSkeleton::GetCallingUid();
+    for (const std::string &uriStr : uris) {
+        if (!AppFileService::SandboxHelper::IsValidPath(uriStr)) {
+            continue;
+        }
+        std::string oldUriStr = uriStr;
+        std::string newUriStr;
+        if (oldUriStr.find(PasteboardImgExtractor::IMG_LOCAL_URI) != 0) {
+            continue;
+        } else if (oldUriStr.find(PasteboardImgExtractor::DOC_LOCAL_URI) == 0) {
+            newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::DOC_LOCAL_URI),
+                PasteboardImgExtractor::DOC_URI_PREFIX);
+        } else {
+            newUriStr = oldUriStr.replace(0, std::strlen(PasteboardImgExtractor::IMG_LOCAL_URI),
+                PasteboardImgExtractor::FILE_SCHEME_PREFIX + bundleIndex + "/");
+        }
+        std::string physicalPath;
+        if (callingUid == HWF_SERVICE_UID && oldUriStr.find("file://docs/storage/Users/currentUser/") == 0) {
+            physicalPath = oldUriStr.replace(0, std::strlen("file://docs/storage/Users/currentUser/"), "/mnt/");
+        } else if (AppFileService::SandboxHelper::GetPhysicalPath(newUriStr, userIdStr, physicalPath) != 0) {
+            continue;
+        }
+        errno = 0;
+        struct stat buf = {};
+        if (stat(physicalPath.c_str(), &buf) != 0) {
+            if (errno == EACCES) {
+                existFileUris.push_back(uriStr);
+            }
+            continue;
+        }
+        if ((buf.st_mode & S_IFMT) != S_IFDIR) {
+            existFileUris.push_back(uriStr);
+        }
+    }
+    return existFileUris;
+}
+
+void ResetStatHooks(int delayUs)
+{
+    hosttest_common::g_statCalls = 0;
+    hosttest_common::g_statInFlight = 0;
+    hosttest_common::g_statMaxInFlight = 0;
+    hosttest_common::g_statDelayUs = delayUs;
+}
+
+std::vector<std::string> DomXPathImgSrc(const std::string &html)
+{
+    int options = HTML_PARSE_RECOVER | HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING;
+    xmlDocPtr doc = htmlReadDoc(reinterpret_cast<const xmlChar *>(html.c_str()), nullptr, nullptr, options);
+    if (doc == nullptr) {
+        return {};
+    }
+    std::unique_ptr<xmlDoc, decltype(&xmlFreeDoc)> docGuard(doc, xmlFreeDoc);
+    std::unique_ptr<xmlXPathContext, decltype(&xmlXPathFreeContext)> context(xmlXPathNewContext(doc),
+        xmlXPathFreeContext);
+    std::unique_ptr<xmlXPathObject, decltype(&xmlXPathFreeObject)> result(
+        xmlXPathEvalExpression(BAD_CAST "//img[@src]", context.get()), xmlXPathFreeObject);
+    std::vector<std::string> srcs;
+    if (result == nullptr || result->nodesetval == nullptr) {
+        return srcs;
+    }
+    for (int i = 0; i < result->nodesetval->nodeNr; ++i) {
+        xmlChar *src = xmlGetProp(result->nodesetval->nodeTab[i], BAD_CAST "src");
+        if (src != nullptr && src[0] != '\0') {
+            srcs.emplace_back(reinterpret_cast<const char *>(src));
+        }
+        xmlFree(src);
+    }
+    return srcs;
+}
+
+std::string ReadFixture(const std::string &name)
+{
+    std::string file = __FILE__;
+    std::ifstream in(file.substr(0, file.rfind('/')) + "/../img_tag_scanner/fixtures/" + name, std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+const std::vector<std::string> &Documents()
+{
+    static const std::vector<std::string> documents = {
+        ReadFixture("webview_article.html"),
+        ReadFixture("chat_export.html"),
+        "<IMG SRC=\"file:///upper.png\"><img src=\"file:///first.png\" src=\"file:///second.png\">",
+        "<img src=\"file:///a&amp;b.png\"><img src><img src=\"\"><img alt=\"no src\">",
+        "<table><tr><td><span><img src='file:///in/table.jpg'></span></td></tr></table>",
+        "<p>unclosed <img src=\"file:///x.png\" <img src=\"file:///y.png\">",
+        "<svg><image href=\"file:///svg.png\"/><img src=\"file:///inside_svg.png\"/></svg>",
+        "<script>var s = '<img src=\"file:///script.png\">';</script><img src=file:///unquoted.jpg>",
+        "<!-- <img src=\"file:///comment.png\"> --><noscript><img src=\"file:///noscript.png\"></noscript>",
+        "",
+    };
+    return documents;
+}
+
+const std::vector<std::string> &Fragments()
+{
+    static const std::vector<std::string> fragments = {
+        "<img", "<IMG", " src=", " SRC=", "\"file:///a.png\"", "'b.jpg'", "c.gif", ">", "/>", "<p>", "</p>", "<div",
+        "<span>", "</span>", "<!--", "-->", "<script>", "</script>", "&amp;", "=", "\"", "'", " ", "\n", "x",
+    };
+    return fragments;
+}
+
+std::string RandomHtml(std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> pieces(0, MAX_RANDOM_PIECES);
+    std::uniform_int_distribution<size_t> pick(0, Fragments().size() - 1);
+    std::string html;
+    for (int count = pieces(rng); count > 0; --count) {
+        html += Fragments()[pick(rng)];
+    }
+    return html;
+}
+
+std::string BenchHtml()
+{
+    std::string html;
+    while (html.size() < BENCH_HTML_BYTES) {
+        html += Documents()[0] + Documents()[1];
+    }
+    return html;
+}
+
+// parses per second with threadCount threads sharing BENCH_PARSES parses
+template<typename Fn>
+double ParsesPerSecond(size_t threadCount, Fn &&parse)
+{
+    std::atomic<int> next = 0;
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&next, &parse]() {
+            while (next.fetch_add(1) < BENCH_PARSES) {
+                parse();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> spent = std::chrono::steady_clock::now() - begin;
+    return BENCH_PARSES / spent.count();
+}
+
+class TempSandbox {
+public:
+    TempSandbox()
+    {
+        char pattern[] = "/tmp/img_extractor_host_test_XXXXXX";
+        root_ = mkdtemp(pattern) == nullptr ? "" : pattern;
+        hosttest_sandbox::g_root = root_;
+        MakeDir(std::to_string(USER_ID));
+    }
+
+    ~TempSandbox()
+    {
+        hosttest_sandbox::g_root.clear();
+        if (!root_.empty()) {
+            std::system(("rm -rf '" + root_ + "'").c_str());
+        }
+    }
+
+    void MakeDir(const std::string &path)
+    {
+        mkdir((root_ + "/" + path).c_str(), S_IRWXU);
+    }
+
+    void MakeFile(const std::string &path)
+    {
+        std::ofstream(root_ + "/" + path) << "img";
+    }
+
+private:
+    std::string root_;
+};
+} // namespace
+
+class ImgExtractorHostTest : public testing::Test {};
+
+/**
+ * @tc.name: CollectsImgSrcInDocumentOrder
+ * @tc.desc: the src of every img element is collected in document order, other elements and empty src are not.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgExtractorHostTest, CollectsImgSrcInDocumentOrder, TestSize.Level0)
+{
+    std::string html = "<div><img src=\"file:///a.png\"><p><img alt=\"x\" src='b.jpg'></p><img src=\"\">"
+                       "<video src=\"file:///v.mp4\"></video></div>";
+    EXPECT_EQ(PasteboardImgExtractor::CollectImgSrc(html), std::vector<std::string>({ "file:///a.png", "b.jpg" }));
+    EXPECT_TRUE(PasteboardImgExtractor::CollectImgSrc("").empty());
+    EXPECT_TRUE(PasteboardImgExtractor::CollectImgSrc("<invalid html>").empty());
+}
+
+/**
+ * @tc.name: MatchesDomXPathOnDocuments
+ * @tc.desc: on the fixtures and on html the parser has to repair, the SAX collection equals the DOM + XPath one.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgExtractorHostTest, MatchesDomXPathOnDocuments, TestSize.Level0)
+{
+    for (const auto &html : Documents()) {
+        EXPECT_EQ(PasteboardImgExtractor::CollectImgSrc(html), DomXPathImgSrc(html)) << "html: \"" << html << "\"";
+    }
+    EXPECT_FALSE(PasteboardImgExtractor::CollectImgSrc(Documents()[0]).empty());
+}
+
+/**
+ * @tc.name: MatchesDomXPathOnRandomHtml
+ * @tc.desc: differential check against the DOM + XPath collection on random html built from tag fragments.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgExtractorHostTest, MatchesDomXPathOnRandomHtml, TestSize.Level0)
+{
+    std::mt19937 rng(RANDOM_SEED);
+    int mismatches = 0;
+    for (int i = 0; i < RANDOM_CASES && mismatches < 10; ++i) {
+        std::string html = RandomHtml(rng);
+        if (PasteboardImgExtractor::CollectImgSrc(html) != DomXPathImgSrc(html)) {
+            ++mismatches;
+            ADD_FAILURE() << "html: \"" << html << "\"";
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+/**
+ * @tc.name: ExtractKeepsExistingLocalImages
+ * @tc.desc: only local image uris whose file exists in the sandbox survive extraction.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgExtractorHostTest, ExtractKeepsExistingLocalImages, TestSize.Level0)
+{
+    TempSandbox sandbox;
+    std::string user = std::to_string(USER_ID);
+    sandbox.MakeDir(user + "/data");
+    sandbox.MakeFile(user + "/data/a.png");
+    sandbox.MakeFile(user + "/data/b.txt");
+    sandbox.MakeDir(user + "/data/dir.png");
+    std::string html = "<img src=\"file:///data/a.png\"><img src=\"file:///data/missing.png\">"
+                       "<img src=\"file:///data/dir.png\"><img src=\"file:///data/b.txt\">"
+                       "<img src=\"https://example.com/c.png\"><img src=\"file:///data/../data/a.png\">";
+
+    auto uris = PasteboardImgExtractor::GetInstance().ExtractImgSrc(html, BUNDLE_INDEX, USER_ID);
+
+    EXPECT_EQ(uris, std::vector<std::string>({ "file:///data/a.png" }));
+}
+
+/**
+ * @tc.name: ExtractMapsDocsUris
+ * @tc.desc: a docs uri resolves through the sandbox for apps and through /mnt for the file manager service.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgExtractorHostTest, ExtractMapsDocsUris, TestSize.Level0)
+{
+    constexpr pid_t fileManagerServiceUid = 7700;
+    TempSandbox sandbox;
+    std::string user = std::to_string(USER_ID);
+    for (const char *dir : { "/storage", "/storage/Users", "/storage/Users/currentUser" }) {
+        sandbox.MakeDir(user + dir);
+    }
+    sandbox.MakeFile(user + "/storage/Users/currentUser/d.png");
+    std::string html = "<img src=\"file:///docs/storage/Users/currentUser/d.png\">";
+
+    EXPECT_EQ(PasteboardImgExtractor::GetInstance().ExtractImgSrc(html, BUNDLE_INDEX, USER_ID),
+        std::vector<std::string>({ "file:///docs/storage/Users/currentUser/d.png" }));
+    hosttest_ipc::g_callingUid = fileManagerServiceUid;
+    auto uris = PasteboardImgExtractor::GetInstance().ExtractImgSrc(html, BUNDLE_INDEX, USER_ID);
+    hosttest_ipc::g_callingUid = 0;
+    EXPECT_TRUE(uris.empty());
+}
+
+/**
+ * @tc.name: FilterKeepsOrderAndVerdicts
+ * @tc.desc: on a temp dir with files, directories, missing files, repeated and invalid uris the batched filter
+ *           keeps exactly the uris the one at a time filter kept, in the same order, duplicates included, and
+ *           stats every distinct resolved path once.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgExtractorHostTest, FilterKeepsOrderAndVerdicts, TestSize.Level0)
+{
+    TempSandbox sandbox;
+    std::string user = std::to_string(USER_ID);
+    sandbox.MakeDir(user + "/data");
+    std::vector<std::string> uris;
+    for (int i = 0; i < FILTER_FILES; ++i) {
+        std::string name = "/data/" + std::to_string(i) + ".png";
+        switch (i % 5) {
+            case 0:
+                sandbox.MakeDir(user + name);
+                break;
+            case 1:
+                break;
+            case 2:
+                sandbox.MakeFile(user + name);
+                uris.push_back("file:///data/../data/" + std::to_string(i) + ".png");
+                break;
+            default:
+                sandbox.MakeFile(user + name);
+                break;
+        }
+        uris.push_back("file://" + name);
+    }
+    uris.push_back("https://example.com/remote.png");
+    std::vector<std::string> repeated;
+    for (int r = 0; r < FILTER_REPEATS; ++r) {
+        repeated.insert(repeated.end(), uris.rbegin(), uris.rend());
+    }
+    std::vector<std::string> expected = SerialFilterExistFileUris(repeated, BUNDLE_INDEX, USER_ID);
+    ResetStatHooks(0);
+
+    PasteboardImgExtractor::FilterExistFileUris(repeated, BUNDLE_INDEX, USER_ID);
+
+    EXPECT_EQ(repeated, expected);
+    EXPECT_EQ(repeated.size(), static_cast<size_t>(FILTER_FILES * 3 / 5 * FILTER_REPEATS));
+    EXPECT_EQ(hosttest_common::g_statCalls.load(), FILTER_FILES);
+    EXPECT_LE(hosttest_common::g_statMaxInFlight.load(), MAX_STAT_WORKERS);
+}
+
+/**
+ * @tc.name: FilterOverlapsSlowStats
+ * @tc.desc: with slow stat calls the existence checks overlap on a bounded number of workers, so the filter
+ *           takes a fraction of the one at a time time. Prints both.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgExtractorHostTest, FilterOverlapsSlowStats, TestSize.Level0)
+{
+    TempSandbox sandbox;
+    std::string user = std::to_string(USER_ID);
+    sandbox.MakeDir(user + "/data");
+    std::vector<std::string> uris;
+    for (int i = 0; i < SLOW_STAT_FILES; ++i) {
+        sandbox.MakeFile(user + "/data/" + std::to_string(i) + ".jpg");
+        uris.push_back("file:///data/" + std::to_string(i) + ".jpg");
+    }
+    ResetStatHooks(SLOW_STAT_DELAY_US);
+    auto begin = std::chrono::steady_clock::now();
+    PasteboardImgExtractor::FilterExistFileUris(uris, BUNDLE_INDEX, USER_ID);
+    std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - begin;
+    int maxInFlight = hosttest_common::g_statMaxInFlight.load();
+    ResetStatHooks(0);
+
+    double serialMs = SLOW_STAT_FILES * SLOW_STAT_DELAY_US / 1000.0;
+    std::printf("[ BENCH    ] %d stats of %d us: batched %.1f ms, one at a time >= %.1f ms, %d in flight\n",
+        SLOW_STAT_FILES, SLOW_STAT_DELAY_US, spent.count(), serialMs, maxInFlight);
+    EXPECT_EQ(uris.size(), static_cast<size_t>(SLOW_STAT_FILES));
+    EXPECT_EQ(maxInFlight, MAX_STAT_WORKERS);
+    EXPECT_LT(spent.count(), serialMs / 2);
+}
+
+/**
+ * @tc.name: ConcurrentExtractionScales
+ * @tc.desc: extractions from many threads give the single thread result, and with no lock between them the
+ *           throughput grows with the thread count where there are cores for it. Prints parses per second for
+ *           the extractor and for the DOM + XPath collection behind one mutex, as before.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgExtractorHostTest, ConcurrentExtractionScales, TestSize.Level0)
+{
+    const std::string html = BenchHtml();
+    const std::vector<std::string> expected = DomXPathImgSrc(html);
+    std::atomic<int> wrong = 0;
+    std::mutex serialMutex;
+    size_t cores = std::thread::hardware_concurrency();
+    double single = 0;
+    double widest = 0;
+    for (size_t threads : { 1u, 2u, 4u, 8u }) {
+        double sax = ParsesPerSecond(threads, [&]() {
+            if (PasteboardImgExtractor::CollectImgSrc(html) != expected) {
+                ++wrong;
+            }
+        });
+        double serial = ParsesPerSecond(threads, [&]() {
+            std::lock_guard<std::mutex> lock(serialMutex);
+            DomXPathImgSrc(html);
+        });
+        std::printf("[ BENCH    ] %zu threads, %zu bytes: extractor %.1f parses/s, locked dom+xpath %.1f parses/s\n",
+            threads, html.size(), sax, serial);
+        single = threads == 1 ? sax : single;
+        widest = (threads <= cores && threads <= MIN_CORES_FOR_SCALING) ? sax : widest;
+    }
+    EXPECT_EQ(wrong.load(), 0);
+    if (cores >= MIN_CORES_FOR_SCALING) {
+        EXPECT_GT(widest, single * MIN_SCALING);
+    } else {
+        std::printf("[ BENCH    ] %zu cores, scaling not asserted\n", cores);
+    }
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::PasteboardImgTagScanner
+// (framework/innerkits/src/pasteboard_img_tag_scanner.cpp). Pure logic, no shim, no fake.
+//
+// The reference is the std::regex splitting PasteboardWebController did before the scanner, "<img.*?>" over
+// the html and "src=(['\"])(.*?)\1" over each tag, so any drift in what is found or where shows up as a diff.
+
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pasteboard_img_tag_scanner.h"
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+using Spans = std::vector<std::pair<std::string, size_t>>;
+
+// copied from the patterns PasteboardWebController used to split html with
+constexpr const char *IMG_TAG_PATTERN = "<img.*?>";
+constexpr const char *IMG_TAG_SRC_PATTERN = "src=(['\"])(.*?)\\1";
+constexpr size_t SRC_HEAD_LENGTH = 5; // src=" or src='
+constexpr uint32_t RANDOM_SEED = 20260416;
+constexpr int RANDOM_CASES = 3000;
+constexpr int MAX_RANDOM_PIECES = 16;
+constexpr size_t BENCH_HTML_BYTES = 1024 * 1024;
+constexpr size_t HOSTILE_HTML_BYTES = 4 * 1024 * 1024;
+constexpr int BENCH_ROUNDS = 3;
+constexpr double MINIFIED_SCAN_LIMIT_MS = 5000;
+
+Spans RegexTags(const std::string &html)
+{
+    Spans tags;
+    std::regex reg(IMG_TAG_PATTERN);
+    std::smatch results;
+    auto iterStart = html.cbegin();
+    while (std::regex_search(iterStart, html.cend(), results, reg)) {
+        tags.emplace_back(results[0], results[0].first - html.cbegin());
+        iterStart = results[0].second;
+    }
+    return tags;
+}
+
+Spans RegexSrcValues(const std::string &text, size_t base)
+{
+    Spans values;
+    std::regex re(IMG_TAG_SRC_PATTERN);
+    std::smatch match;
+    auto iterStart = text.cbegin();
+    while (std::regex_search(iterStart, text.cend(), match, re)) {
+        std::string value = match[0];
+        value = value.substr(SRC_HEAD_LENGTH);
+        value.pop_back();
+        values.emplace_back(value, base + (match[0].first - text.cbegin()) + SRC_HEAD_LENGTH);
+        iterStart = match[0].second;
+    }
+    return values;
+}
+
+Spans RegexImgSrcs(const std::string &html)
+{
+    Spans values;
+    for (const auto &tag : RegexTags(html)) {
+        for (auto &value : RegexSrcValues(tag.first, tag.second)) {
+            values.push_back(std::move(value));
+        }
+    }
+    return values;
+}
+
+Spans ScanTags(const std::string &html)
+{
+    Spans tags;
+    PasteboardImgTagScanner::ForEachImgTag(html, [&html, &tags](size_t begin, size_t end) {
+        tags.emplace_back(html.substr(begin, end - begin), begin);
+    });
+    return tags;
+}
+
+Spans ScanSrcValues(const std::string &text)
+{
+    Spans values;
+    PasteboardImgTagScanner::ForEachSrcValue(text, 0, text.size(), [&text, &values](size_t begin, size_t end) {
+        values.emplace_back(text.substr(begin, end - begin), begin);
+    });
+    return values;
+}
+
+Spans ScanImgSrcs(const std::string &html)
+{
+    Spans values;
+    PasteboardImgTagScanner::ForEachImgSrc(html, [&html, &values](size_t begin, size_t end) {
+        values.emplace_back(html.substr(begin, end - begin), begin);
+    });
+    return values;
+}
+
+std::string ReadFixture(const std::string &name)
+{
+    std::string file = __FILE__;
+    std::ifstream in(file.substr(0, file.rfind('/')) + "/fixtures/" + name, std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+const std::vector<std::string> &Fixtures()
+{
+    static const std::vector<std::string> fixtures = {
+        ReadFixture("webview_article.html"),
+        ReadFixture("chat_export.html"),
+    };
+    return fixtures;
+}
+
+const std::vector<std::string> &Fragments()
+{
+    static const std::vector<std::string> fragments = {
+        "<img", "<im", "<IMG", "<", ">", "/>", " ", "\n", "\r", "src=", "src", "=", "'", "\"", "src=\"", "src='",
+        "a", "file:///x.png", "https://e.com/y.png", "alt=\"q\"", "<img src=\"", "<p>", "</p>", "\xe4\xb8\xad",
+    };
+    return fragments;
+}
+
+std::string RandomHtml(std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> pieces(0, MAX_RANDOM_PIECES);
+    std::uniform_int_distribution<size_t> pick(0, Fragments().size() - 1);
+    std::string html;
+    for (int count = pieces(rng); count > 0; --count) {
+        html += Fragments()[pick(rng)];
+    }
+    return html;
+}
+
+std::string Repeat(const std::string &piece, size_t bytes)
+{
+    std::string text;
+    text.reserve(bytes + piece.size());
+    while (text.size() < bytes) {
+        text += piece;
+    }
+    return text;
+}
+
+template<typename Fn>
+double BestMillis(Fn &&fn)
+{
+    double best = 0;
+    for (int round = 0; round < BENCH_ROUNDS; ++round) {
+        auto begin = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - begin;
+        best = (round == 0 || spent.count() < best) ? spent.count() : best;
+    }
+    return best;
+}
+} // namespace
+
+class ImgTagScannerHostTest : public testing::Test {};
+
+/**
+ * @tc.name: FindsTagsAndSrcValues
+ * @tc.desc: img tags and their quoted src values are found with the offsets the web controller records.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgTagScannerHostTest, FindsTagsAndSrcValues, TestSize.Level0)
+{
+    const std::string html = "<div>a<img src='file:///a.png'/>b<img alt=\"1\" src=\"relative/b.png\"/></div>";
+    Spans tags = ScanTags(html);
+    ASSERT_EQ(tags.size(), 2u);
+    EXPECT_EQ(tags[0], Spans::value_type("<img src='file:///a.png'/>", 6));
+    EXPECT_EQ(tags[1], Spans::value_type("<img alt=\"1\" src=\"relative/b.png\"/>", 33));
+    Spans srcs = ScanImgSrcs(html);
+    ASSERT_EQ(srcs.size(), 2u);
+    EXPECT_EQ(srcs[0], Spans::value_type("file:///a.png", html.find("file:///a.png")));
+    EXPECT_EQ(srcs[1], Spans::value_type("relative/b.png", html.find("relative/b.png")));
+}
+
+/**
+ * @tc.name: KeepsRegexQuirks
+ * @tc.desc: tags broken by a line end, unquoted or unterminated src values, upper case tags and src inside
+ *           other attributes behave as they did with the regex.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgTagScannerHostTest, KeepsRegexQuirks, TestSize.Level0)
+{
+    EXPECT_TRUE(ScanTags("<img\nsrc=\"a\">").empty());
+    EXPECT_TRUE(ScanTags("<IMG src=\"a\">").empty());
+    EXPECT_TRUE(ScanTags("<img src=\"a\"").empty());
+    EXPECT_EQ(ScanTags("<img <img src='x'>").size(), 1u);
+    EXPECT_TRUE(ScanImgSrcs("<img src=a.png>").empty());
+    EXPECT_TRUE(ScanImgSrcs("<img src=\"a.png>").empty());
+    EXPECT_EQ(ScanImgSrcs("<img datasrc=\"a\">"), Spans({ { "a", 14 } }));
+    EXPECT_EQ(ScanImgSrcs("<img src=\"a src='b'>"), Spans({ { "b", 17 } }));
+    EXPECT_EQ(ScanSrcValues("src=\"a\nb\" src='c'"), Spans({ { "c", 15 } }));
+    EXPECT_EQ(ScanSrcValues("src=\"\""), Spans({ { "", 5 } }));
+    EXPECT_TRUE(ScanSrcValues("src=").empty());
+}
+
+/**
+ * @tc.name: MatchesRegexOnFixtures
+ * @tc.desc: on the html fixtures the tags and the src values and their offsets equal the regex splitting.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgTagScannerHostTest, MatchesRegexOnFixtures, TestSize.Level0)
+{
+    for (const auto &html : Fixtures()) {
+        ASSERT_FALSE(html.empty());
+        EXPECT_EQ(ScanTags(html), RegexTags(html));
+        EXPECT_EQ(ScanImgSrcs(html), RegexImgSrcs(html));
+        EXPECT_FALSE(ScanImgSrcs(html).empty());
+    }
+}
+
+/**
+ * @tc.name: MatchesRegexOnRandomHtml
+ * @tc.desc: differential check against the regex splitting on random html built from tag fragments, for
+ *           the tags, for src values in free text and for the combined pass.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgTagScannerHostTest, MatchesRegexOnRandomHtml, TestSize.Level0)
+{
+    std::mt19937 rng(RANDOM_SEED);
+    int mismatches = 0;
+    for (int i = 0; i < RANDOM_CASES && mismatches < 10; ++i) {
+        std::string html = RandomHtml(rng);
+        bool same = ScanTags(html) == RegexTags(html) && ScanSrcValues(html) == RegexSrcValues(html, 0) &&
+            ScanImgSrcs(html) == RegexImgSrcs(html);
+        if (!same) {
+            ++mismatches;
+            ADD_FAILURE() << "html: \"" << html << "\"";
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+/**
+ * @tc.name: StaysLinearOnHostileHtml
+ * @tc.desc: multi megabyte html made of unterminated tags, src values cut by line ends and one huge tag is
+ *           scanned in one pass.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgTagScannerHostTest, StaysLinearOnHostileHtml, TestSize.Level0)
+{
+    EXPECT_TRUE(ScanImgSrcs(Repeat("<img src=\"", HOSTILE_HTML_BYTES)).empty());
+    EXPECT_TRUE(ScanImgSrcs(Repeat("<img src='a\n", HOSTILE_HTML_BYTES)).empty());
+    // every second quote closes the value opened by the one before it
+    std::string heads = Repeat("src=\"", HOSTILE_HTML_BYTES);
+    Spans values = ScanImgSrcs("<img " + heads + ">");
+    EXPECT_EQ(values.size(), heads.size() / strlen("src=\"") / 2);
+    EXPECT_EQ(values.front().first, "src=");
+}
+
+/**
+ * @tc.name: StaysLinearOnMinifiedHtml
+ * @tc.desc: multi megabyte html of thousands of img tags and no line end at all, the shape of minified html, is
+ *           scanned in one pass and every src value is found.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgTagScannerHostTest, StaysLinearOnMinifiedHtml, TestSize.Level0)
+{
+    const std::string tag = "<p>text</p><img alt=\"x\" src=\"https://example.com/a.png\" width='1'>";
+    const std::string html = Repeat(tag, HOSTILE_HTML_BYTES);
+    Spans values;
+    double scannerMs = BestMillis([&]() {
+        values = ScanImgSrcs(html);
+    });
+    ASSERT_EQ(values.size(), html.size() / tag.size());
+    EXPECT_EQ(values.back().first, "https://example.com/a.png");
+    // one pass over 4 MiB takes milliseconds, rescanning the rest of the html for each of its 50k tags minutes
+    std::printf("[ BENCH    ] %zu bytes, %zu tags, no line end: scanner %.3f ms\n", html.size(), values.size(),
+        scannerMs);
+    EXPECT_LT(scannerMs, MINIFIED_SCAN_LIMIT_MS);
+}
+
+/**
+ * @tc.name: OutpacesRegexOnLargeHtml
+ * @tc.desc: on a megabyte of fixture html the scanner agrees with the regex splitting and is faster.
+ *           Prints the throughput of both.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ImgTagScannerHostTest, OutpacesRegexOnLargeHtml, TestSize.Level0)
+{
+    const std::string html = Repeat(Fixtures()[0] + Fixtures()[1], BENCH_HTML_BYTES);
+    Spans scanned;
+    Spans searched;
+    double scannerMs = BestMillis([&]() {
+        scanned = ScanImgSrcs(html);
+    });
+    double regexMs = BestMillis([&]() {
+        searched = RegexImgSrcs(html);
+    });
+    EXPECT_EQ(scanned, searched);
+    double megabytes = static_cast<double>(html.size()) / (1024.0 * 1024.0);
+    std::printf("[ BENCH    ] %zu bytes, %zu src values: scanner %.3f ms (%.1f MB/s), regex %.3f ms (%.1f MB/s)\n",
+        html.size(), scanned.size(), scannerMs, megabytes * 1000.0 / scannerMs, regexMs,
+        megabytes * 1000.0 / regexMs);
+    EXPECT_LT(scannerMs, regexMs);
+}
+} // namespace OHOS::MiscServices
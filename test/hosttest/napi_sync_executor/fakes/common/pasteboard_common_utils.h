@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HOST-TEST FAKE for common/pasteboard_common_utils.h (napi_sync_executor suite).
+// The real one lives in framework/framework and names the thread through pthread; the fake counts the
+// tasks that named their worker instead (hosttest_common_utils::g_namedTasks, defined in the test).
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_NAPI_SYNC_EXECUTOR_COMMON_UTILS_H
+#define PASTEBOARD_HOSTTEST_FAKE_NAPI_SYNC_EXECUTOR_COMMON_UTILS_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace hosttest_common_utils {
+extern std::atomic<int> g_namedTasks;
+}
+
+namespace OHOS {
+namespace MiscServices {
+class PasteBoardCommonUtils {
+public:
+    static void SetThreadTaskName(std::thread &thread, const std::string &taskName)
+    {
+        (void)thread;
+        (void)taskName;
+    }
+    static void SetTaskName(const std::string &taskName)
+    {
+        (void)taskName;
+        hosttest_common_utils::g_namedTasks++;
+    }
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_HOSTTEST_FAKE_NAPI_SYNC_EXECUTOR_COMMON_UTILS_H
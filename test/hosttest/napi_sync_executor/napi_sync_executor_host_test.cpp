@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "napi_sync_executor.h"
+
+namespace hosttest_common_utils {
+std::atomic<int> g_namedTasks = 0;
+}
+
+using namespace testing::ext;
+using namespace OHOS;
+using namespace OHOS::MiscServicesNapi;
+
+namespace {
+constexpr auto WAIT_LIMIT = std::chrono::seconds(5);
+constexpr uint32_t SYNC_TIMEOUT = 3500;
+constexpr uint32_t SHORT_TIMEOUT = 20;
+constexpr uint32_t SHORT_IDLE_MS = 30;
+
+template<typename Pred>
+bool WaitUntil(Pred pred)
+{
+    auto deadline = std::chrono::steady_clock::now() + WAIT_LIMIT;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// parks every task that passes it until Open, standing in for a service that does not answer
+class Gate {
+public:
+    void Pass()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++waiting_;
+        cv_.notify_all();
+        cv_.wait(lock, [this] {
+            return open_;
+        });
+        --waiting_;
+    }
+
+    void Open()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        cv_.notify_all();
+    }
+
+    bool WaitForWaiting(int count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, WAIT_LIMIT, [this, count] {
+            return waiting_ >= count;
+        });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int waiting_ = 0;
+    bool open_ = false;
+};
+} // namespace
+
+class NapiSyncExecutorHostTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        hosttest_common_utils::g_namedTasks = 0;
+    }
+};
+
+/**
+ * @tc.name: RunReturnsResult
+ * @tc.desc: Run hands the result of the call back to the caller and names the worker after the call.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(NapiSyncExecutorHostTest, RunReturnsResult, TestSize.Level0)
+{
+    NapiSyncExecutor executor;
+    auto value = executor.Run<int32_t>("NHasDataSync", []() {
+        return std::make_shared<int32_t>(1);
+    }, SYNC_TIMEOUT);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 1);
+    EXPECT_EQ(hosttest_common_utils::g_namedTasks.load(), 1);
+    EXPECT_EQ(executor.GetWorkerCount(), 1u);
+    EXPECT_EQ(executor.Submit("null", nullptr), NapiSyncExecutor::INVALID_TASK_ID);
+    EXPECT_EQ(&NapiSyncExecutor::GetInstance(), &NapiSyncExecutor::GetInstance());
+}
+
+/**
+ * @tc.name: WorkerIsReused
+ * @tc.desc: Polling one sync API keeps running on the same worker instead of starting a thread per call.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(NapiSyncExecutorHostTest, WorkerIsReused, TestSize.Level0)
+{
+    NapiSyncExecutor executor;
+    std::thread::id first;
+    for (int i = 0; i < 50; ++i) {
+        auto id = executor.Run<std::thread::id>("NHasDataSync", []() {
+            return std::make_shared<std::thread::id>(std::this_thread::get_id());
+        }, SYNC_TIMEOUT);
+        ASSERT_NE(id, nullptr);
+        if (i == 0) {
+            first = *id;
+        }
+        EXPECT_EQ(*id, first);
+    }
+    EXPECT_EQ(executor.GetWorkerCount(), 1u);
+}
+
+/**
+ * @tc.name: WorkersAreCapped
+ * @tc.desc: Calls beyond maxWorkers wait for a worker instead of starting more threads, and all of them run.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(NapiSyncExecutorHostTest, WorkersAreCapped, TestSize.Level0)
+{
+    constexpr size_t maxWorkers = 2;
+    constexpr int calls = 10;
+    NapiSyncExecutor executor(maxWorkers);
+    Gate gate;
+    std::atomic<int> ran = 0;
+    for (int i = 0; i < calls; ++i) {
+        ASSERT_NE(executor.Submit("NGetDataSync", [&gate, &ran]() {
+            gate.Pass();
+            ran++;
+        }), NapiSyncExecutor::INVALID_TASK_ID);
+    }
+    ASSERT_TRUE(gate.WaitForWaiting(maxWorkers));
+    EXPECT_EQ(executor.GetWorkerCount(), maxWorkers);
+    EXPECT_EQ(executor.GetPendingCount(), calls - maxWorkers);
+    gate.Open();
+    EXPECT_TRUE(WaitUntil([&ran] {
+        return ran == calls;
+    }));
+    EXPECT_EQ(executor.GetWorkerCount(), maxWorkers);
+    EXPECT_EQ(executor.GetPendingCount(), 0u);
+}
+
+/**
+ * @tc.name: PendingCallsAreBounded
+ * @tc.desc: With every worker stuck and maxPending calls waiting, a further call fails at once.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(NapiSyncExecutorHostTest, PendingCallsAreBounded, TestSize.Level0)
+{
+    constexpr size_t maxPending = 2;
+    NapiSyncExecutor executor(1, maxPending);
+    Gate gate;
+    auto stuck = [&gate]() {
+        gate.Pass();
+    };
+    ASSERT_NE(executor.Submit("NSetDataSync", stuck), NapiSyncExecutor::INVALID_TASK_ID);
+    ASSERT_TRUE(gate.WaitForWaiting(1));
+    for (size_t i = 0; i < maxPending; ++i) {
+        EXPECT_NE(executor.Submit("NSetDataSync", stuck), NapiSyncExecutor::INVALID_TASK_ID);
+    }
+    auto begin = std::chrono::steady_clock::now();
+    auto value = executor.Run<int32_t>("NHasDataSync", []() {
+        return std::make_shared<int32_t>(1);
+    }, SYNC_TIMEOUT);
+    auto waited = std::chrono::steady_clock::now() - begin;
+    EXPECT_EQ(value, nullptr);
+    EXPECT_LT(waited, std::chrono::milliseconds(SYNC_TIMEOUT));
+    EXPECT_EQ(executor.GetWorkerCount(), 1u);
+    gate.Open();
+}
+
+/**
+ * @tc.name: TimedOutCallIsReclaimed
+ * @tc.desc: A call whose caller timed out before a worker was free is dropped and never reaches the service.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(NapiSyncExecutorHostTest, TimedOutCallIsReclaimed, TestSize.Level0)
+{
+    NapiSyncExecutor executor(1);
+    Gate gate;
+    ASSERT_NE(executor.Submit("NGetDataSync", [&gate]() {
+        gate.Pass();
+    }), NapiSyncExecutor::INVALID_TASK_ID);
+    ASSERT_TRUE(gate.WaitForWaiting(1));
+    std::atomic<bool> ran = false;
+    auto value = executor.Run<int32_t>("NHasDataSync", [&ran]() {
+        ran = true;
+        return std::make_shared<int32_t>(1);
+    }, SHORT_TIMEOUT);
+    EXPECT_EQ(value, nullptr);
+    EXPECT_EQ(executor.GetPendingCount(), 0u);
+    gate.Open();
+    auto next = executor.Run<int32_t>("NHasDataSync", []() {
+        return std::make_shared<int32_t>(2);
+    }, SYNC_TIMEOUT);
+    ASSERT_NE(next, nullptr);
+    EXPECT_EQ(*next, 2);
+    EXPECT_FALSE(ran.load());
+    EXPECT_FALSE(executor.Cancel(NapiSyncExecutor::INVALID_TASK_ID));
+}
+
+/**
+ * @tc.name: SlowCallKeepsItsWorker
+ * @tc.desc: A call that times out while running finishes on its worker, which then serves the next call.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(NapiSyncExecutorHostTest, SlowCallKeepsItsWorker, TestSize.Level0)
+{
+    NapiSyncExecutor executor(1);
+    Gate gate;
+    std::atomic<bool> finished = false;
+    auto value = executor.Run<int32_t>("NSetDataSync", [&gate, &finished]() {
+        gate.Pass();
+        finished = true;
+        return std::make_shared<int32_t>(1);
+    }, SHORT_TIMEOUT);
+    EXPECT_EQ(value, nullptr);
+    gate.Open();
+    EXPECT_TRUE(WaitUntil([&finished] {
+        return finished.load();
+    }));
+    auto next = executor.Run<int32_t>("NHasDataSync", []() {
+        return std::make_shared<int32_t>(2);
+    }, SYNC_TIMEOUT);
+    ASSERT_NE(next, nullptr);
+    EXPECT_EQ(*next, 2);
+    EXPECT_EQ(executor.GetWorkerCount(), 1u);
+}
+
+/**
+ * @tc.name: IdleWorkersExit
+ * @tc.desc: Workers exit after idleExitMs without calls, and the next call starts one again.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(NapiSyncExecutorHostTest, IdleWorkersExit, TestSize.Level0)
+{
+    NapiSyncExecutor executor(NapiSyncExecutor::MAX_WORKERS, NapiSyncExecutor::MAX_PENDING_TASKS, SHORT_IDLE_MS);
+    auto call = [&executor]() {
+        return executor.Run<int32_t>("NHasDataSync", []() {
+            return std::make_shared<int32_t>(1);
+        }, SYNC_TIMEOUT);
+    };
+    ASSERT_NE(call(), nullptr);
+    EXPECT_TRUE(WaitUntil([&executor] {
+        return executor.GetWorkerCount() == 0;
+    }));
+    ASSERT_NE(call(), nullptr);
+    EXPECT_EQ(executor.GetWorkerCount(), 1u);
+}
+
+/**
+ * @tc.name: DestructorDropsWaitingCalls
+ * @tc.desc: Destroying the executor drops the waiting calls, waits for the running one and refuses new ones.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(NapiSyncExecutorHostTest, DestructorDropsWaitingCalls, TestSize.Level0)
+{
+    Gate gate;
+    std::atomic<int> ran = 0;
+    auto task = [&gate, &ran]() {
+        gate.Pass();
+        ran++;
+    };
+    std::thread opener;
+    {
+        NapiSyncExecutor executor(1);
+        ASSERT_NE(executor.Submit("NClearDataSync", task), NapiSyncExecutor::INVALID_TASK_ID);
+        ASSERT_TRUE(gate.WaitForWaiting(1));
+        ASSERT_NE(executor.Submit("NClearDataSync", task), NapiSyncExecutor::INVALID_TASK_ID);
+        {
+            std::lock_guard<std::mutex> lock(executor.mutex_);
+            executor.stopping_ = true;
+        }
+        EXPECT_EQ(executor.Submit("NClearDataSync", task), NapiSyncExecutor::INVALID_TASK_ID);
+        opener = std::thread([&gate]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SHORT_TIMEOUT));
+            gate.Open();
+        });
+    }
+    EXPECT_EQ(ran.load(), 1);
+    opener.join();
+}
+
+/**
+ * @tc.name: SharedWorkersBeatThreadPerCall
+ * @tc.desc: Polling a sync API through the executor costs less than starting and detaching a thread per call,
+ *           the way the sync APIs did before.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(NapiSyncExecutorHostTest, SharedWorkersBeatThreadPerCall, TestSize.Level0)
+{
+    constexpr int calls = 2000;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+        auto block = std::make_shared<BlockObject<std::shared_ptr<int32_t>>>(SYNC_TIMEOUT);
+        std::thread thread([block]() {
+            block->SetValue(std::make_shared<int32_t>(1));
+        });
+        thread.detach();
+        ASSERT_NE(block->GetValue(), nullptr);
+    }
+    double threadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    NapiSyncExecutor executor;
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+        auto value = executor.Run<int32_t>("NHasDataSync", []() {
+            return std::make_shared<int32_t>(1);
+        }, SYNC_TIMEOUT);
+        ASSERT_NE(value, nullptr);
+    }
+    double executorMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    printf("[PERF] %d sync calls: thread per call %.2f ms, shared executor %.2f ms\n", calls, threadMs, executorMs);
+    EXPECT_LT(executorMs, threadMs);
+    EXPECT_EQ(executor.GetWorkerCount(), 1u);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HOST-TEST FAKE for iremote_broker.h (observer_dispatcher suite).
+// The real one pulls in c_utils / ipc. The fake keeps the AsObject identity the dispatcher keys its mailboxes
+// by, on top of a shared_ptr based sptr, so the real ipasteboard_changed_observer.h compiles against it.
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_OBSERVER_DISPATCHER_IREMOTE_BROKER_H
+#define PASTEBOARD_HOSTTEST_FAKE_OBSERVER_DISPATCHER_IREMOTE_BROKER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace OHOS {
+template<typename T>
+class sptr {
+public:
+    sptr() = default;
+    sptr(std::nullptr_t) {}
+    template<typename U>
+    sptr(const sptr<U> &other) : ptr_(other.ptr_) {}
+    template<typename U>
+    sptr(std::shared_ptr<U> ptr) : ptr_(std::move(ptr)) {}
+
+    template<typename... Args>
+    static sptr<T> MakeSptr(Args &&...args)
+    {
+        return sptr<T>(std::make_shared<T>(std::forward<Args>(args)...));
+    }
+
+    T *GetRefPtr() const
+    {
+        return ptr_.get();
+    }
+    T *operator->() const
+    {
+        return ptr_.get();
+    }
+    bool operator==(std::nullptr_t) const
+    {
+        return ptr_ == nullptr;
+    }
+    bool operator!=(std::nullptr_t) const
+    {
+        return ptr_ != nullptr;
+    }
+
+private:
+    template<typename U>
+    friend class sptr;
+    std::shared_ptr<T> ptr_;
+};
+
+class IRemoteObject {
+public:
+    virtual ~IRemoteObject() = default;
+};
+
+class IRemoteBroker {
+public:
+    // a proxy answers with the remote object it wraps, a null object makes the dispatcher key by the broker
+    virtual sptr<IRemoteObject> AsObject() = 0;
+    virtual ~IRemoteBroker() = default;
+};
+} // namespace OHOS
+
+#define DECLARE_INTERFACE_DESCRIPTOR(DESCRIPTOR)
+
+#endif // PASTEBOARD_HOSTTEST_FAKE_OBSERVER_DISPATCHER_IREMOTE_BROKER_H
@@ -0,0 +1,468 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pasteboard_observer_dispatcher.h"
+
+using namespace testing::ext;
+using namespace OHOS;
+using namespace OHOS::MiscServices;
+
+namespace {
+using Event = IPasteboardChangedObserver::PasteboardChangedEvent;
+constexpr size_t MAX_PENDING = PasteboardObserverDispatcher::MAX_PENDING_NOTIFICATIONS;
+
+class RemoteStub : public IRemoteObject {};
+
+sptr<IRemoteObject> NewRemote()
+{
+    return sptr<IRemoteObject>(std::make_shared<RemoteStub>());
+}
+
+// records every callback as a string: "C" for a change, "E<userId>" for an event
+class RecordingObserver : public IPasteboardChangedObserver {
+public:
+    explicit RecordingObserver(sptr<IRemoteObject> remote = nullptr) : remote_(remote) {}
+
+    void OnPasteboardChanged() override
+    {
+        Wait();
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.push_back("C");
+    }
+    void OnPasteboardEvent(const Event &event) override
+    {
+        Wait();
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.push_back("E" + std::to_string(event.userId));
+        events_.push_back(event);
+    }
+    sptr<IRemoteObject> AsObject() override
+    {
+        return remote_;
+    }
+
+    std::vector<std::string> Calls()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_;
+    }
+    std::vector<Event> Events()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+    // a blocked observer parks every callback until Release, the way a hung client parks the IPC
+    void Block()
+    {
+        std::lock_guard<std::mutex> lock(gateMutex_);
+        blocked_ = true;
+    }
+    void Release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(gateMutex_);
+            blocked_ = false;
+        }
+        gate_.notify_all();
+    }
+    bool WaitEntered(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(gateMutex_);
+        return gate_.wait_for(lock, timeout, [this] { return entered_ > 0; });
+    }
+
+private:
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(gateMutex_);
+        ++entered_;
+        gate_.notify_all();
+        gate_.wait(lock, [this] { return !blocked_; });
+    }
+
+    sptr<IRemoteObject> remote_;
+    std::mutex mutex_;
+    std::vector<std::string> calls_;
+    std::vector<Event> events_;
+    std::mutex gateMutex_;
+    std::condition_variable gate_;
+    bool blocked_ = false;
+    int entered_ = 0;
+};
+
+// keeps submitted drain tasks until the test runs them
+class ManualExecutor {
+public:
+    PasteboardObserverDispatcher::Executor Get()
+    {
+        return [this](std::function<void()> task) {
+            tasks_.push_back(std::move(task));
+        };
+    }
+    size_t RunAll()
+    {
+        size_t ran = 0;
+        while (!tasks_.empty()) {
+            auto task = std::move(tasks_.front());
+            tasks_.erase(tasks_.begin());
+            task();
+            ++ran;
+        }
+        return ran;
+    }
+    size_t Size() const
+    {
+        return tasks_.size();
+    }
+
+private:
+    std::vector<std::function<void()>> tasks_;
+};
+
+// runs every drain task on a thread of its own, like ffrt workers
+class ThreadExecutor {
+public:
+    ~ThreadExecutor()
+    {
+        Join();
+    }
+    PasteboardObserverDispatcher::Executor Get()
+    {
+        return [this](std::function<void()> task) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            threads_.emplace_back(std::move(task));
+        };
+    }
+    void Join()
+    {
+        while (true) {
+            std::vector<std::thread> threads;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                threads.swap(threads_);
+            }
+            if (threads.empty()) {
+                return;
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::thread> threads_;
+};
+
+Event MakeEvent(int32_t userId)
+{
+    Event event;
+    event.bundleName = "com.example";
+    event.status = 0;
+    event.userId = userId;
+    return event;
+}
+
+std::vector<std::string> Expected(std::initializer_list<const char *> calls)
+{
+    return std::vector<std::string>(calls.begin(), calls.end());
+}
+} // namespace
+
+class ObserverDispatcherHostTest : public testing::Test {};
+
+/**
+ * @tc.name: DeliversInPostOrderPerObserver
+ * @tc.desc: Each observer gets its notifications in post order from a single drain task, nothing runs before
+ *           the executor does.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ObserverDispatcherHostTest, DeliversInPostOrderPerObserver, TestSize.Level0)
+{
+    ManualExecutor executor;
+    auto dispatcher = std::make_shared<PasteboardObserverDispatcher>(executor.Get());
+    auto first = sptr<RecordingObserver>::MakeSptr(NewRemote());
+    auto second = sptr<RecordingObserver>::MakeSptr(NewRemote());
+    std::vector<sptr<IPasteboardChangedObserver>> both = { first, second, nullptr };
+
+    dispatcher->PostChanged({ first });
+    dispatcher->PostEvent(both, MakeEvent(1));
+    dispatcher->PostEvent(both, MakeEvent(2));
+    EXPECT_EQ(executor.Size(), 2u);
+    EXPECT_TRUE(first->Calls().empty());
+    EXPECT_EQ(dispatcher->GetPendingCount(first), 3u);
+    EXPECT_EQ(dispatcher->GetPendingCount(second), 2u);
+    EXPECT_EQ(dispatcher->GetPendingCount(nullptr), 0u);
+
+    EXPECT_EQ(executor.RunAll(), 2u);
+    EXPECT_EQ(first->Calls(), Expected({ "C", "E1", "E2" }));
+    EXPECT_EQ(second->Calls(), Expected({ "E1", "E2" }));
+    EXPECT_EQ(first->Events()[0].bundleName, "com.example");
+    EXPECT_EQ(dispatcher->GetPendingCount(first), 0u);
+    // the drained mailboxes are gone, the next post schedules a fresh drain
+    EXPECT_TRUE(dispatcher->mailboxes_.empty());
+    dispatcher->PostEvent({ second }, MakeEvent(3));
+    EXPECT_EQ(executor.RunAll(), 1u);
+    EXPECT_EQ(second->Calls(), Expected({ "E1", "E2", "E3" }));
+}
+
+/**
+ * @tc.name: CoalescesPendingChanges
+ * @tc.desc: A change posted while another one is still pending is absorbed, one posted after the delivery
+ *           is not.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ObserverDispatcherHostTest, CoalescesPendingChanges, TestSize.Level0)
+{
+    ManualExecutor executor;
+    auto dispatcher = std::make_shared<PasteboardObserverDispatcher>(executor.Get());
+    auto observer = sptr<RecordingObserver>::MakeSptr(NewRemote());
+
+    for (int i = 0; i < 5; ++i) {
+        dispatcher->PostChanged({ observer });
+    }
+    dispatcher->PostEvent({ observer }, MakeEvent(7));
+    dispatcher->PostChanged({ observer });
+    EXPECT_EQ(dispatcher->GetPendingCount(observer), 2u);
+    executor.RunAll();
+    EXPECT_EQ(observer->Calls(), Expected({ "C", "E7" }));
+
+    dispatcher->PostChanged({ observer });
+    executor.RunAll();
+    EXPECT_EQ(observer->Calls(), Expected({ "C", "E7", "C" }));
+}
+
+/**
+ * @tc.name: DropsOldestBeyondBound
+ * @tc.desc: A mailbox never holds more than MAX_PENDING_NOTIFICATIONS entries, the oldest are dropped, and a
+ *           dropped change no longer absorbs the next one.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ObserverDispatcherHostTest, DropsOldestBeyondBound, TestSize.Level0)
+{
+    ManualExecutor executor;
+    auto dispatcher = std::make_shared<PasteboardObserverDispatcher>(executor.Get());
+    auto observer = sptr<RecordingObserver>::MakeSptr(NewRemote());
+
+    dispatcher->PostChanged({ observer });
+    const int32_t total = static_cast<int32_t>(MAX_PENDING) + 3;
+    for (int32_t i = 0; i < total; ++i) {
+        dispatcher->PostEvent({ observer }, MakeEvent(i));
+    }
+    EXPECT_EQ(dispatcher->GetPendingCount(observer), MAX_PENDING);
+    // the change was the oldest entry, so it went first and a new one is queued again
+    dispatcher->PostChanged({ observer });
+    EXPECT_EQ(dispatcher->GetPendingCount(observer), MAX_PENDING);
+    EXPECT_EQ(executor.Size(), 1u);
+    executor.RunAll();
+
+    auto calls = observer->Calls();
+    ASSERT_EQ(calls.size(), MAX_PENDING);
+    EXPECT_EQ(calls.front(), "E" + std::to_string(total - static_cast<int32_t>(MAX_PENDING) + 1));
+    EXPECT_EQ(calls[MAX_PENDING - 2], "E" + std::to_string(total - 1));
+    EXPECT_EQ(calls.back(), "C");
+}
+
+/**
+ * @tc.name: RemoveDropsUndelivered
+ * @tc.desc: Remove discards what is queued for an observer, a drain already scheduled delivers nothing, and
+ *           a later post starts over.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ObserverDispatcherHostTest, RemoveDropsUndelivered, TestSize.Level0)
+{
+    ManualExecutor executor;
+    auto dispatcher = std::make_shared<PasteboardObserverDispatcher>(executor.Get());
+    auto observer = sptr<RecordingObserver>::MakeSptr(NewRemote());
+    auto stranger = sptr<RecordingObserver>::MakeSptr(NewRemote());
+
+    dispatcher->PostChanged({ observer });
+    dispatcher->PostEvent({ observer }, MakeEvent(1));
+    dispatcher->Remove(observer);
+    dispatcher->Remove(stranger);
+    dispatcher->Remove(nullptr);
+    EXPECT_EQ(dispatcher->GetPendingCount(observer), 0u);
+
+    dispatcher->PostEvent({ observer }, MakeEvent(2));
+    EXPECT_EQ(executor.Size(), 2u);
+    executor.RunAll();
+    EXPECT_EQ(observer->Calls(), Expected({ "E2" }));
+    EXPECT_TRUE(dispatcher->mailboxes_.empty());
+}
+
+/**
+ * @tc.name: KeysByRemoteObject
+ * @tc.desc: Two proxies of one remote object share a mailbox and its order, an observer without a remote
+ *           object gets a mailbox of its own.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ObserverDispatcherHostTest, KeysByRemoteObject, TestSize.Level0)
+{
+    ManualExecutor executor;
+    auto dispatcher = std::make_shared<PasteboardObserverDispatcher>(executor.Get());
+    auto remote = NewRemote();
+    auto proxyA = sptr<RecordingObserver>::MakeSptr(remote);
+    auto proxyB = sptr<RecordingObserver>::MakeSptr(remote);
+    auto local = sptr<RecordingObserver>::MakeSptr();
+
+    dispatcher->PostChanged({ proxyA, local });
+    dispatcher->PostChanged({ proxyB });
+    dispatcher->PostEvent({ proxyB, local }, MakeEvent(4));
+    EXPECT_EQ(dispatcher->GetPendingCount(proxyB), 2u);
+    EXPECT_EQ(executor.Size(), 2u);
+    executor.RunAll();
+    // the mailbox calls the proxy it was created with
+    EXPECT_EQ(proxyA->Calls(), Expected({ "C", "E4" }));
+    EXPECT_TRUE(proxyB->Calls().empty());
+    EXPECT_EQ(local->Calls(), Expected({ "C", "E4" }));
+}
+
+/**
+ * @tc.name: NullExecutorPostsNothing
+ * @tc.desc: Without an executor a post is refused instead of queuing work nobody drains.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ObserverDispatcherHostTest, NullExecutorPostsNothing, TestSize.Level0)
+{
+    auto dispatcher = std::make_shared<PasteboardObserverDispatcher>(nullptr);
+    auto observer = sptr<RecordingObserver>::MakeSptr(NewRemote());
+    dispatcher->PostChanged({ observer });
+    dispatcher->PostEvent({ observer }, MakeEvent(1));
+    EXPECT_EQ(dispatcher->GetPendingCount(observer), 0u);
+}
+
+/**
+ * @tc.name: HungObserverStallsOnlyItself
+ * @tc.desc: While one observer is stuck in its callback, posts return at once, the other observer keeps
+ *           receiving, and the stuck one keeps a bounded backlog that it delivers in order once released.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ObserverDispatcherHostTest, HungObserverStallsOnlyItself, TestSize.Level0)
+{
+    ThreadExecutor executor;
+    auto dispatcher = std::make_shared<PasteboardObserverDispatcher>(executor.Get());
+    auto hung = sptr<RecordingObserver>::MakeSptr(NewRemote());
+    auto healthy = sptr<RecordingObserver>::MakeSptr(NewRemote());
+    hung->Block();
+
+    dispatcher->PostEvent({ hung, healthy }, MakeEvent(0));
+    ASSERT_TRUE(hung->WaitEntered(std::chrono::seconds(5)));
+    const int32_t total = static_cast<int32_t>(MAX_PENDING) * 4;
+    auto begin = std::chrono::steady_clock::now();
+    for (int32_t i = 1; i <= total; ++i) {
+        dispatcher->PostEvent({ hung, healthy }, MakeEvent(i));
+    }
+    auto postMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    printf("[  BENCH   ] %d posts with one hung observer took %.3f ms\n", total, postMs);
+    EXPECT_LT(postMs, 1000.0);
+
+    // the healthy observer catches up with the last post while the hung one is still inside its first callback
+    auto caughtUp = [&healthy, total]() {
+        auto events = healthy->Events();
+        return !events.empty() && events.back().userId == total;
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!caughtUp() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(caughtUp());
+    auto healthyEvents = healthy->Events();
+    for (size_t i = 1; i < healthyEvents.size(); ++i) {
+        EXPECT_LT(healthyEvents[i - 1].userId, healthyEvents[i].userId);
+    }
+    EXPECT_EQ(dispatcher->GetPendingCount(hung), MAX_PENDING);
+
+    hung->Release();
+    executor.Join();
+    auto hungEvents = hung->Events();
+    ASSERT_EQ(hungEvents.size(), MAX_PENDING + 1);
+    EXPECT_EQ(hungEvents.front().userId, 0);
+    EXPECT_EQ(hungEvents[1].userId, total - static_cast<int32_t>(MAX_PENDING) + 1);
+    EXPECT_EQ(hungEvents.back().userId, total);
+}
+
+/**
+ * @tc.name: ConcurrentPostsKeepPerPosterOrder
+ * @tc.desc: Posts from several threads reach every observer exactly once each and in the order every
+ *           poster made them, with drains running on their own threads.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(ObserverDispatcherHostTest, ConcurrentPostsKeepPerPosterOrder, TestSize.Level0)
+{
+    ThreadExecutor executor;
+    auto dispatcher = std::make_shared<PasteboardObserverDispatcher>(executor.Get());
+    std::vector<sptr<RecordingObserver>> observers;
+    std::vector<sptr<IPasteboardChangedObserver>> targets;
+    for (int i = 0; i < 4; ++i) {
+        observers.push_back(sptr<RecordingObserver>::MakeSptr(NewRemote()));
+        targets.push_back(observers.back());
+    }
+    constexpr int32_t posters = 4;
+    // fewer posts per poster than the bound, so nothing is dropped even if no drain runs until the end
+    constexpr int32_t postsPerPoster = static_cast<int32_t>(MAX_PENDING) / posters;
+    constexpr int32_t rounds = 50;
+    for (int32_t round = 0; round < rounds; ++round) {
+        std::vector<std::thread> threads;
+        for (int32_t poster = 0; poster < posters; ++poster) {
+            threads.emplace_back([&dispatcher, &targets, poster, round]() {
+                for (int32_t i = 0; i < postsPerPoster; ++i) {
+                    dispatcher->PostEvent(targets, MakeEvent(round * 10000 + poster * 100 + i));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        executor.Join();
+    }
+    for (auto &observer : observers) {
+        auto events = observer->Events();
+        ASSERT_EQ(events.size(), static_cast<size_t>(rounds * posters * postsPerPoster));
+        std::vector<int32_t> last(posters, -1);
+        for (const auto &event : events) {
+            int32_t poster = (event.userId % 10000) / 100;
+            EXPECT_GT(event.userId, last[poster]);
+            last[poster] = event.userId;
+        }
+    }
+    EXPECT_TRUE(dispatcher->mailboxes_.empty());
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::PatternScanner
+// (services/core/src/pasteboard_pattern_scanner.cpp). Pure logic, no shim, no fake.
+//
+// The reference is the std::regex search PatternDetection::DetectPlainText did before the scanner,
+// with the same pattern strings and length checks, so any drift in semantics shows up as a diff.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pasteboard_pattern_scanner.h"
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr size_t MIN_HTTP_URL_LENGTH = 7;
+constexpr size_t MIN_FLIGHT_NUMBER_LENGTH = 5;
+constexpr size_t MAX_FLIGHT_NUMBER_LENGTH = 7;
+constexpr uint32_t RANDOM_SEED = 20260415;
+constexpr int RANDOM_CASES = 4000;
+constexpr int MAX_RANDOM_PIECES = 12;
+constexpr size_t BENCH_TEXT_BYTES = 64 * 1024;
+constexpr int BENCH_ROUNDS = 3;
+
+// copied from PatternDetection::patterns_ in services/core/src/pasteboard_pattern.cpp
+const std::vector<std::string> &ReferencePatterns()
+{
+    static const std::vector<std::string> patterns = {
+        "[a-zA-Z0-9+.-]+://[-a-zA-Z0-9+&@#/%?=~_|!:,.;]*[-a-zA-Z0-9+&@#/%=~_]",
+        "[-+]?[0-9]*\\.?[0-9]+",
+        "(([a-zA-Z0-9_\\-\\.\\%\\+]+)@(([a-zA-Z0-9\\-]+(?:\\.[a-zA-Z0-9\\-]+)*)|"
+        "(?:\\[([0-9]{1,3}\\.){3}[0-9]{1,3}\\]))([a-zA-Z]{1,}|[0-9]{1,3}|\\.[a-zA-Z0-9\\-]+))",
+        "(?:^|\\s+)https?://[^\\s]+",
+        "\\b([A-Z]{2}|[0-9][A-Z])\\d{3,4}[A-Z]?\\b",
+    };
+    return patterns;
+}
+
+const std::vector<std::regex> &ReferenceRegexes()
+{
+    static const std::vector<std::regex> regexes = [] {
+        std::vector<std::regex> compiled;
+        for (const auto &pattern : ReferencePatterns()) {
+            compiled.emplace_back(pattern);
+        }
+        return compiled;
+    }();
+    return regexes;
+}
+
+uint32_t ReferenceScan(const std::string &text, uint32_t wanted)
+{
+    uint32_t found = 0;
+    for (uint32_t id = 0; id < PatternScanner::COUNT; ++id) {
+        if ((wanted & (1u << id)) == 0) {
+            continue;
+        }
+        std::smatch match;
+        if (!std::regex_search(text, match, ReferenceRegexes()[id])) {
+            continue;
+        }
+        size_t length = match.str().length();
+        bool valid = true;
+        if (id == PatternScanner::HTTP_URL) {
+            valid = length >= MIN_HTTP_URL_LENGTH;
+        } else if (id == PatternScanner::FLIGHT_NUMBER) {
+            valid = length >= MIN_FLIGHT_NUMBER_LENGTH && length <= MAX_FLIGHT_NUMBER_LENGTH;
+        }
+        if (valid) {
+            found |= 1u << id;
+        }
+    }
+    return found;
+}
+
+// fragments that sit on the edges of every pattern, glued together at random
+const std::vector<std::string> &Fragments()
+{
+    static const std::vector<std::string> fragments = {
+        "a", "Z", "h", "x", "0", "7", "42", "1234", "12345", ".", "..", "-", "+", "_", "%", "@", ":", "/",
+        "://", "?", "!", ";", ",", "#", "~", "|", "[", "]", "[1.2.3.4]", "[10.0.0]", "[1234.1.1.1]", " ", "\t",
+        "\n", "http://", "https://", "http:/", "htt", "www", "CA", "CA123", "CA1234", "CA1234B", "9C", "9C876",
+        "MU12345", "ab", "mail", "example.com", ".com", "a-b", "é", "\x01",
+    };
+    return fragments;
+}
+
+std::string RandomText(std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> pieces(0, MAX_RANDOM_PIECES);
+    std::uniform_int_distribution<size_t> pick(0, Fragments().size() - 1);
+    std::string text;
+    for (int count = pieces(rng); count > 0; --count) {
+        text += Fragments()[pick(rng)];
+    }
+    return text;
+}
+
+std::string MaskToString(uint32_t mask)
+{
+    static const char *names[] = { "URL", "NUMBER", "EMAIL_ADDRESS", "HTTP_URL", "FLIGHT_NUMBER" };
+    std::string out;
+    for (uint32_t id = 0; id < PatternScanner::COUNT; ++id) {
+        if ((mask & (1u << id)) != 0) {
+            out += out.empty() ? names[id] : std::string("|") + names[id];
+        }
+    }
+    return out.empty() ? "none" : out;
+}
+
+std::string BenchText(const std::string &tail)
+{
+    static const std::string words = "the quick brown fox jumps over the lazy dog while copying notes between apps ";
+    std::string text;
+    while (text.size() < BENCH_TEXT_BYTES) {
+        text += words;
+    }
+    return text + tail;
+}
+
+template<typename Fn>
+double BestMillis(Fn &&fn)
+{
+    double best = 0;
+    for (int round = 0; round < BENCH_ROUNDS; ++round) {
+        auto begin = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - begin;
+        best = (round == 0 || spent.count() < best) ? spent.count() : best;
+    }
+    return best;
+}
+} // namespace
+
+class PatternScannerHostTest : public testing::Test {};
+
+/**
+ * @tc.name: DetectsEachPattern
+ * @tc.desc: each pattern is found in a text that holds it and nothing is found in a text that holds none.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(PatternScannerHostTest, DetectsEachPattern, TestSize.Level0)
+{
+    const uint32_t all = PatternScanner::ALL_MASK;
+    EXPECT_EQ(PatternScanner::Scan("ftp://example.org", 1u << PatternScanner::URL), 1u << PatternScanner::URL);
+    EXPECT_EQ(PatternScanner::Scan("pi is 3.14", 1u << PatternScanner::NUMBER), 1u << PatternScanner::NUMBER);
+    EXPECT_EQ(PatternScanner::Scan("mail me@example.com", 1u << PatternScanner::EMAIL_ADDRESS),
+        1u << PatternScanner::EMAIL_ADDRESS);
+    EXPECT_EQ(PatternScanner::Scan("root@[192.168.0.1]x", 1u << PatternScanner::EMAIL_ADDRESS),
+        1u << PatternScanner::EMAIL_ADDRESS);
+    EXPECT_EQ(PatternScanner::Scan("see https://a.b", 1u << PatternScanner::HTTP_URL),
+        1u << PatternScanner::HTTP_URL);
+    EXPECT_EQ(PatternScanner::Scan("flight CA1234 today", 1u << PatternScanner::FLIGHT_NUMBER),
+        1u << PatternScanner::FLIGHT_NUMBER);
+    EXPECT_EQ(PatternScanner::Scan("nothing to see here", all), 0u);
+    EXPECT_EQ(PatternScanner::Scan("", all), 0u);
+}
+
+/**
+ * @tc.name: ReportsOnlyWantedPatterns
+ * @tc.desc: patterns that are present but not asked for are not reported, unknown bits are ignored.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(PatternScannerHostTest, ReportsOnlyWantedPatterns, TestSize.Level0)
+{
+    const std::string text = "CA1234 https://a.b me@x.io 42";
+    EXPECT_EQ(PatternScanner::Scan(text, 0), 0u);
+    EXPECT_EQ(PatternScanner::Scan(text, 1u << PatternScanner::NUMBER), 1u << PatternScanner::NUMBER);
+    EXPECT_EQ(PatternScanner::Scan(text, ~0u), ReferenceScan(text, PatternScanner::ALL_MASK));
+}
+
+/**
+ * @tc.name: MatchesRegexOnEdgeCases
+ * @tc.desc: hand picked texts on the edges of every pattern give the same result as the regex search.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(PatternScannerHostTest, MatchesRegexOnEdgeCases, TestSize.Level0)
+{
+    const std::vector<std::string> texts = {
+        "://x", "a://", "a://?", "a://?x", "a:/x", "a@b", "a@bc", "@bc", "a@-x", "a@--", "a@b.", "a@b.c", "a@b..c",
+        "a@.b", "a@[1.2.3.4]", "a@[1.2.3.4]z", "a@[1.2.3]z", "a@[1.2.3.4.]z", "a@[1234.1.1.1]z", "a@b-", "a@b-.c",
+        "http://", "http://x", "xhttp://x", " http://x", "\thttps://x", "https:// x", "https://", "httpx://y",
+        "CA123", "CA12", "CA12345", "CA1234B", "CA1234BC", "xCA1234", "_CA1234", "CA1234_", "9C123", "99C123",
+        "C9123", "CA123 ", "-CA123-", "1", ".5", "-", "+", "\xe9@\xe9", "a@b\xe9",
+    };
+    for (const auto &text : texts) {
+        EXPECT_EQ(MaskToString(PatternScanner::Scan(text, PatternScanner::ALL_MASK)),
+            MaskToString(ReferenceScan(text, PatternScanner::ALL_MASK))) << "text: \"" << text << "\"";
+    }
+}
+
+/**
+ * @tc.name: MatchesRegexOnRandomTexts
+ * @tc.desc: differential check against the regex search on random texts built from pattern fragments, for
+ *           every pattern alone and for all of them at once.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(PatternScannerHostTest, MatchesRegexOnRandomTexts, TestSize.Level0)
+{
+    std::mt19937 rng(RANDOM_SEED);
+    int mismatches = 0;
+    for (int i = 0; i < RANDOM_CASES && mismatches < 10; ++i) {
+        std::string text = RandomText(rng);
+        uint32_t expected = ReferenceScan(text, PatternScanner::ALL_MASK);
+        uint32_t actual = PatternScanner::Scan(text, PatternScanner::ALL_MASK);
+        for (uint32_t id = 0; id < PatternScanner::COUNT; ++id) {
+            EXPECT_EQ(PatternScanner::Scan(text, 1u << id), expected & (1u << id)) << "text: \"" << text << "\"";
+        }
+        if (actual != expected) {
+            ++mismatches;
+            ADD_FAILURE() << "text: \"" << text << "\" scanner: " << MaskToString(actual)
+                          << " regex: " << MaskToString(expected);
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+/**
+ * @tc.name: OutpacesRegexOnLargeText
+ * @tc.desc: on a large text where every pattern has to be searched to the end, one scanner pass is faster
+ *           than the regex searches and agrees with them. Prints the throughput of both.
+ * @tc.type: PERF
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(PatternScannerHostTest, OutpacesRegexOnLargeText, TestSize.Level0)
+{
+    const std::string text = BenchText("mail me@example.com or fly CA1234");
+    uint32_t scanned = 0;
+    uint32_t searched = 0;
+    double scannerMs = BestMillis([&]() {
+        scanned = PatternScanner::Scan(text, PatternScanner::ALL_MASK);
+    });
+    double regexMs = BestMillis([&]() {
+        searched = ReferenceScan(text, PatternScanner::ALL_MASK);
+    });
+    EXPECT_EQ(MaskToString(scanned), MaskToString(searched));
+    double megabytes = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+    std::printf("[ BENCH    ] %zu bytes: scanner %.3f ms (%.1f MB/s), regex %.3f ms (%.1f MB/s)\n", text.size(),
+        scannerMs, megabytes * 1000.0 / scannerMs, regexMs, megabytes * 1000.0 / regexMs);
+    EXPECT_LT(scannerMs, regexMs);
+}
+} // namespace OHOS::MiscServices
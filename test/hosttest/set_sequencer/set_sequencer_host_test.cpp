@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for OHOS::MiscServices::PasteboardSetSequencer
+// (services/core/include/pasteboard_set_sequencer.h). Header-only, pure std.
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pasteboard_set_sequencer.h"
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr int32_t USER_ID = 100;
+constexpr int32_t OTHER_USER_ID = 101;
+} // namespace
+
+class SetSequencerHostTest : public testing::Test {};
+
+/**
+ * @tc.name: BeginHandsOutIncreasingTickets
+ * @tc.desc: every set draws a ticket strictly greater than the one drawn before it.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(SetSequencerHostTest, BeginHandsOutIncreasingTickets, TestSize.Level0)
+{
+    PasteboardSetSequencer sequencer;
+    uint64_t first = sequencer.Begin();
+    uint64_t second = sequencer.Begin();
+    EXPECT_GT(first, 0u);
+    EXPECT_GT(second, first);
+}
+
+/**
+ * @tc.name: CommittedOfUnknownUserIsZero
+ * @tc.desc: a user that never committed reports ticket 0, below any ticket Begin hands out.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(SetSequencerHostTest, CommittedOfUnknownUserIsZero, TestSize.Level0)
+{
+    PasteboardSetSequencer sequencer;
+    EXPECT_EQ(sequencer.Committed(USER_ID), 0u);
+}
+
+/**
+ * @tc.name: CommitAppliesNewerTicket
+ * @tc.desc: a set whose ticket is newer than the committed one runs its commit and becomes current.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(SetSequencerHostTest, CommitAppliesNewerTicket, TestSize.Level0)
+{
+    PasteboardSetSequencer sequencer;
+    uint64_t ticket = sequencer.Begin();
+    int calls = 0;
+    EXPECT_TRUE(sequencer.Commit(USER_ID, ticket, [&calls]() { ++calls; }));
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(sequencer.Committed(USER_ID), ticket);
+}
+
+/**
+ * @tc.name: CommitSkipsStaleTicket
+ * @tc.desc: a set that finishes preparing after a later set committed is superseded, its commit never runs
+ *           and the later set stays current.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(SetSequencerHostTest, CommitSkipsStaleTicket, TestSize.Level0)
+{
+    PasteboardSetSequencer sequencer;
+    uint64_t older = sequencer.Begin();
+    uint64_t newer = sequencer.Begin();
+    int value = 0;
+    EXPECT_TRUE(sequencer.Commit(USER_ID, newer, [&value]() { value = 2; }));
+    EXPECT_FALSE(sequencer.Commit(USER_ID, older, [&value]() { value = 1; }));
+    EXPECT_FALSE(sequencer.Commit(USER_ID, newer, [&value]() { value = 3; }));
+    EXPECT_EQ(value, 2);
+    EXPECT_EQ(sequencer.Committed(USER_ID), newer);
+}
+
+/**
+ * @tc.name: UsersAreOrderedIndependently
+ * @tc.desc: a newer set of one user does not supersede an older set of another user.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(SetSequencerHostTest, UsersAreOrderedIndependently, TestSize.Level0)
+{
+    PasteboardSetSequencer sequencer;
+    uint64_t older = sequencer.Begin();
+    uint64_t newer = sequencer.Begin();
+    EXPECT_TRUE(sequencer.Commit(USER_ID, newer, nullptr));
+    EXPECT_TRUE(sequencer.Commit(OTHER_USER_ID, older, nullptr));
+    EXPECT_EQ(sequencer.Committed(USER_ID), newer);
+    EXPECT_EQ(sequencer.Committed(OTHER_USER_ID), older);
+}
+
+/**
+ * @tc.name: ConcurrentSetsAreNeverRejected
+ * @tc.desc: under overlapping sets from many threads every set either commits or is superseded, commits land
+ *           in ticket order, and the newest set is what remains.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(SetSequencerHostTest, ConcurrentSetsAreNeverRejected, TestSize.Level0)
+{
+    constexpr int threadCount = 16;
+    constexpr int setsPerThread = 500;
+    PasteboardSetSequencer sequencer;
+    uint64_t current = 0;
+    std::atomic<uint64_t> newest = 0;
+    std::atomic<int> committed = 0;
+    std::atomic<int> superseded = 0;
+    std::atomic<int> outOfOrder = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < setsPerThread; ++i) {
+                uint64_t ticket = sequencer.Begin();
+                uint64_t seen = newest.load();
+                while (ticket > seen && !newest.compare_exchange_weak(seen, ticket)) {
+                }
+                // the heavy stages run outside the commit, let them overlap
+                if ((i + t) % 7 == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+                bool ok = sequencer.Commit(USER_ID, ticket, [&current, &outOfOrder, ticket]() {
+                    if (ticket <= current) {
+                        ++outOfOrder;
+                    }
+                    current = ticket;
+                });
+                ok ? ++committed : ++superseded;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(committed.load() + superseded.load(), threadCount * setsPerThread);
+    EXPECT_GT(committed.load(), 0);
+    EXPECT_EQ(outOfOrder.load(), 0);
+    EXPECT_EQ(current, newest.load());
+    EXPECT_EQ(sequencer.Committed(USER_ID), newest.load());
+}
+
+/**
+ * @tc.name: PublishSkipsSupersededSet
+ * @tc.desc: a set that committed and was then overtaken does not publish, the set that overtook it does.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(SetSequencerHostTest, PublishSkipsSupersededSet, TestSize.Level0)
+{
+    PasteboardSetSequencer sequencer;
+    uint64_t older = sequencer.Begin();
+    uint64_t newer = sequencer.Begin();
+    int published = 0;
+    EXPECT_TRUE(sequencer.Commit(USER_ID, older, nullptr));
+    EXPECT_TRUE(sequencer.Commit(USER_ID, newer, nullptr));
+    EXPECT_FALSE(sequencer.Publish(USER_ID, older, [&published]() { published = 1; }));
+    EXPECT_TRUE(sequencer.Publish(USER_ID, newer, [&published]() { published = 2; }));
+    EXPECT_TRUE(sequencer.Publish(OTHER_USER_ID, 0, nullptr));
+    EXPECT_EQ(published, 2);
+}
+
+/**
+ * @tc.name: PublishRunsWithoutLock
+ * @tc.desc: a publish that is still running holds no lock, a newer set of the same user commits meanwhile and
+ *           the running one sees it is no longer the latest; a set of another user commits and publishes too.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(SetSequencerHostTest, PublishRunsWithoutLock, TestSize.Level0)
+{
+    PasteboardSetSequencer sequencer;
+    uint64_t older = sequencer.Begin();
+    uint64_t newer = sequencer.Begin();
+    uint64_t other = sequencer.Begin();
+    bool olderWasLatest = true;
+    bool otherPublished = false;
+    EXPECT_TRUE(sequencer.Commit(USER_ID, older, nullptr));
+    EXPECT_TRUE(sequencer.Publish(USER_ID, older, [&]() {
+        std::thread thread([&]() {
+            EXPECT_TRUE(sequencer.Commit(USER_ID, newer, nullptr));
+            EXPECT_TRUE(sequencer.Commit(OTHER_USER_ID, other, nullptr));
+            otherPublished = sequencer.Publish(OTHER_USER_ID, other, nullptr);
+        });
+        thread.join();
+        olderWasLatest = sequencer.IsLatest(USER_ID, older);
+    }));
+    EXPECT_FALSE(olderWasLatest);
+    EXPECT_TRUE(otherPublished);
+    EXPECT_TRUE(sequencer.IsLatest(USER_ID, newer));
+}
+
+/**
+ * @tc.name: ConcurrentPublishesEndWithNewest
+ * @tc.desc: under overlapping sets from many threads publishes may overlap, but a result handed out only while
+ *           its set is the latest leaves the newest set as the last one handed out.
+ * @tc.type: FUNC
+ * @tc.require: issueI1669
+ * @tc.author:
+ */
+HWTEST_F(SetSequencerHostTest, ConcurrentPublishesEndWithNewest, TestSize.Level0)
+{
+    constexpr int threadCount = 8;
+    constexpr int setsPerThread = 500;
+    PasteboardSetSequencer sequencer;
+    std::mutex resultMutex;
+    uint64_t lastResult = 0;
+    std::atomic<uint64_t> newest = 0;
+    std::atomic<int> outOfOrder = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < setsPerThread; ++i) {
+                uint64_t ticket = sequencer.Begin();
+                if (!sequencer.Commit(USER_ID, ticket, nullptr)) {
+                    continue;
+                }
+                uint64_t seen = newest.load();
+                while (ticket > seen && !newest.compare_exchange_weak(seen, ticket)) {
+                }
+                sequencer.Publish(USER_ID, ticket, [&]() {
+                    // the heavy stage runs unlocked, only its result is handed out under the consumer's lock
+                    if ((i + t) % 5 == 0) {
+                        std::this_thread::yield();
+                    }
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    if (!sequencer.IsLatest(USER_ID, ticket)) {
+                        return;
+                    }
+                    if (ticket <= lastResult) {
+                        ++outOfOrder;
+                    }
+                    lastResult = ticket;
+                });
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(outOfOrder.load(), 0);
+    EXPECT_EQ(lastResult, newest.load());
+}
+} // namespace OHOS::MiscServices
@@ -25,6 +25,7 @@
 #ifndef PASTEBOARD_HOSTTEST_FAKE_PIXEL_MAP_H
 #define PASTEBOARD_HOSTTEST_FAKE_PIXEL_MAP_H
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -35,10 +36,15 @@ class PixelMap {
 public:
     // Test hook: when true, EncodeTlv reports failure (covers the error branch).
     bool encodeShouldFail = false;
+    // Test hook: number of EncodeTlv calls, lets tests count how often an image is serialized, from any thread.
+    static inline std::atomic<uint32_t> encodeTlvCalls = 0;
+    // Test hook: number of DecodeTlv calls, lets tests count how many images were decoded.
+    static inline std::atomic<uint32_t> decodeTlvCalls = 0;
     std::vector<uint8_t> blob;
 
     static PixelMap *DecodeTlv(std::vector<uint8_t> &value)
     {
+        decodeTlvCalls++;
         auto *pm = new PixelMap();
         pm->blob = value;
         return pm;
@@ -46,6 +52,7 @@ public:
 
     bool EncodeTlv(std::vector<uint8_t> &value) const
     {
+        encodeTlvCalls++;
         if (encodeShouldFail) {
             return false;
         }
@@ -16,16 +16,20 @@
 // HOST-TEST FAKE for udmf's unified_meta.h (as included by tlv_utils.h).
 //
 // The real header drags in string_ex.h + unified_key.h and a chain of UDMF
-// types. tlv_utils.{h,cpp} only needs API_EXPORT from this include (it does not
-// use any UDMF::ValueType / Object here). So the fake provides just the macro
-// and the common stdlib headers the TLV headers expect to be in scope.
+// types. tlv_utils.{h,cpp} only needs API_EXPORT from this include; the codec
+// (tlv_buffer.h and up) also needs UDMF::ValueType and UDMF::Object. The fake
+// provides those with the same alternative order as the real variant, since
+// the variant index is what goes on the wire.
 
 #ifndef PASTEBOARD_HOSTTEST_FAKE_UNIFIED_META_H
 #define PASTEBOARD_HOSTTEST_FAKE_UNIFIED_META_H
 
+#include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <variant>
 #include <vector>
 
 #ifndef API_EXPORT
@@ -40,6 +44,22 @@ namespace OHOS {
 namespace Media {
 class PixelMap;
 } // namespace Media
+namespace AAFwk {
+class Want;
+} // namespace AAFwk
+} // namespace OHOS
+
+namespace OHOS {
+namespace UDMF {
+class Object;
+using ValueType = std::variant<std::monostate, int32_t, int64_t, double, bool, std::string, std::vector<uint8_t>,
+    std::shared_ptr<OHOS::AAFwk::Want>, std::shared_ptr<OHOS::Media::PixelMap>, std::shared_ptr<Object>, nullptr_t>;
+
+class Object {
+public:
+    std::map<std::string, ValueType> value_;
+};
+} // namespace UDMF
 } // namespace OHOS
 
 #endif // PASTEBOARD_HOSTTEST_FAKE_UNIFIED_META_H
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HOST-TEST FAKE for ability_base's uri.h.
+//
+// tlv_readable.h reads a Uri back through Raw2Parcelable<Uri>; like the fake
+// Want, it only has to be a Parcelable with a static Unmarshalling.
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_URI_H
+#define PASTEBOARD_HOSTTEST_FAKE_URI_H
+
+#include <cstdint>
+
+#include "parcel.h"
+
+namespace OHOS {
+
+class Uri : public Parcelable {
+public:
+    uint32_t id = 0;
+
+    bool Marshalling(Parcel &parcel) const override
+    {
+        return parcel.WriteUint32(id);
+    }
+
+    static Uri *Unmarshalling(Parcel &parcel)
+    {
+        auto *uri = new Uri();
+        uri->id = parcel.ReadUint32();
+        return uri;
+    }
+};
+
+} // namespace OHOS
+#endif // PASTEBOARD_HOSTTEST_FAKE_URI_H
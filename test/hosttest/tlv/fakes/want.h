@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HOST-TEST FAKE for ability_base's want.h.
+//
+// The codec only treats a Want as a Parcelable: Parcelable2Raw on write, and
+// Raw2Parcelable<Want> (-> Want::Unmarshalling) on read. The fake carries a
+// single uint32 so a round-trip through the TLV stream is observable.
+
+#ifndef PASTEBOARD_HOSTTEST_FAKE_WANT_H
+#define PASTEBOARD_HOSTTEST_FAKE_WANT_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "parcel.h"
+
+namespace OHOS {
+namespace AAFwk {
+
+class Want : public Parcelable {
+public:
+    uint32_t flags = 0;
+    // Test hook: number of Marshalling calls, lets tests count how often a Want is serialized, from any thread.
+    static inline std::atomic<uint32_t> marshallingCalls = 0;
+
+    bool Marshalling(Parcel &parcel) const override
+    {
+        marshallingCalls++;
+        return parcel.WriteUint32(flags);
+    }
+
+    static Want *Unmarshalling(Parcel &parcel)
+    {
+        auto *want = new Want();
+        want->flags = parcel.ReadUint32();
+        return want;
+    }
+};
+
+} // namespace AAFwk
+} // namespace OHOS
+#endif // PASTEBOARD_HOSTTEST_FAKE_WANT_H
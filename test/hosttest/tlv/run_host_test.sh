@@ -13,12 +13,14 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 #
-# Host-side build + run + coverage loop for the TLVUtils module.
+# Host-side build + run + coverage loop for the TLV codec (tlv_utils,
+# tlv_writeable, tlv_readable).
 #
-# DEEP-dependency sample: TLVUtils sits behind Parcel/Parcelable (c_utils),
-# Media::PixelMap (image_framework), securec and hilog. Instead of a device, it
-# builds against minimal *fakes* under fakes/ (see README). The -Ifakes dir is
-# placed FIRST so the fake headers shadow the real platform ones.
+# DEEP-dependency sample: the codec sits behind Parcel/Parcelable (c_utils),
+# Media::PixelMap (image_framework), Want/Uri (ability_base), UDMF, securec and
+# hilog. Instead of a device, it builds against minimal *fakes* under fakes/
+# (see README). The -Ifakes dir is placed FIRST so the fake headers shadow the
+# real platform ones. Each unit is gated separately.
 #
 # Single command:  ./run_host_test.sh
 # Exit: 0 pass+coverage ok | 1 test fail | 2 coverage below gate | 3 build error
@@ -39,11 +41,11 @@ SECUREC_ROOT="${CODE_ROOT}/third_party/bounds_checking_function"
 FAKES_INC="${SCRIPT_DIR}/fakes"                        # fake seam (must be first)
 TLV_INC="${PASTEBOARD_ROOT}/framework/tlv"
 FW_INC="${PASTEBOARD_ROOT}/framework/framework/include"
-TLV_SRC="${PASTEBOARD_ROOT}/framework/tlv/tlv_utils.cpp"
-TEST_SRC="${SCRIPT_DIR}/tlv_utils_host_test.cpp"
+TLV_UNITS=(tlv_utils tlv_writeable tlv_readable)
+TEST_SRCS=("${SCRIPT_DIR}/tlv_utils_host_test.cpp" "${SCRIPT_DIR}/tlv_codec_host_test.cpp")
 
 BUILD_DIR="${SCRIPT_DIR}/.build"
-BIN="${BUILD_DIR}/tlv_utils_host_test"
+BIN="${BUILD_DIR}/tlv_host_test"
 
 fail() { echo "[FAIL] $*" >&2; }
 info() { echo "[INFO] $*"; }
@@ -51,12 +53,15 @@ info() { echo "[INFO] $*"; }
 for tool in "${CXX}" "${GCOV}"; do
     command -v "${tool}" >/dev/null 2>&1 || { fail "required tool not found: ${tool}"; exit 3; }
 done
-for f in "${GTEST_ROOT}/src/gtest-all.cc" "${TLV_SRC}" "${TEST_SRC}" \
-         "${FAKES_INC}/parcel.h" "${FAKES_INC}/pixel_map.h" \
+for f in "${GTEST_ROOT}/src/gtest-all.cc" "${TEST_SRCS[@]}" \
+         "${FAKES_INC}/parcel.h" "${FAKES_INC}/pixel_map.h" "${FAKES_INC}/want.h" "${FAKES_INC}/uri.h" \
          "${FAKES_INC}/unified_meta.h" "${FAKES_INC}/pasteboard_hilog.h" \
          "${SECUREC_ROOT}/include/securec.h" "${SECUREC_ROOT}/src/memcpy_s.c"; do
     [[ -f "${f}" ]] || { fail "missing source: ${f}"; exit 3; }
 done
+for unit in "${TLV_UNITS[@]}"; do
+    [[ -f "${TLV_INC}/${unit}.cpp" ]] || { fail "missing source: ${TLV_INC}/${unit}.cpp"; exit 3; }
+done
 
 rm -rf "${BUILD_DIR}"
 mkdir -p "${BUILD_DIR}"
@@ -90,18 +95,27 @@ info "compiling securec memcpy_s.c (real safe function, no coverage)"
 "${CXX}" -c -x c "${SECUREC_ROOT}/src/memcpy_s.c" -I"${SECUREC_ROOT}/include" -O0 -g \
     -o "${BUILD_DIR}/memcpy_s.o" || { fail "securec compile failed"; exit 3; }
 
-info "compiling tlv_utils.cpp (WITH coverage, against fakes)"
-( cd "${BUILD_DIR}" && "${CXX}" -c "${TLV_SRC}" "${UUT_INC[@]}" \
-    -std=c++17 -O0 -g --coverage -o tlv_utils.o ) \
-    || { fail "unit-under-test compile failed"; exit 3; }
+UUT_OBJS=()
+for unit in "${TLV_UNITS[@]}"; do
+    info "compiling ${unit}.cpp (WITH coverage, against fakes)"
+    ( cd "${BUILD_DIR}" && "${CXX}" -c "${TLV_INC}/${unit}.cpp" "${UUT_INC[@]}" \
+        -std=c++17 -O0 -g --coverage -o "${unit}.o" ) \
+        || { fail "unit-under-test compile failed: ${unit}.cpp"; exit 3; }
+    UUT_OBJS+=("${BUILD_DIR}/${unit}.o")
+done
 
-info "compiling test"
-"${CXX}" -c "${TEST_SRC}" "${UUT_INC[@]}" -I"${GTEST_ROOT}/include" \
-    -std=c++17 -O0 -g -o "${BUILD_DIR}/test.o" || { fail "test compile failed"; exit 3; }
+TEST_OBJS=()
+for src in "${TEST_SRCS[@]}"; do
+    obj="${BUILD_DIR}/$(basename "${src}" .cpp).o"
+    info "compiling $(basename "${src}")"
+    "${CXX}" -c "${src}" "${UUT_INC[@]}" -I"${GTEST_ROOT}/include" \
+        -std=c++17 -O0 -g -o "${obj}" || { fail "test compile failed: ${src}"; exit 3; }
+    TEST_OBJS+=("${obj}")
+done
 
 info "linking"
 "${CXX}" --coverage \
-    "${BUILD_DIR}/test.o" "${BUILD_DIR}/tlv_utils.o" "${BUILD_DIR}/memcpy_s.o" \
+    "${TEST_OBJS[@]}" "${UUT_OBJS[@]}" "${BUILD_DIR}/memcpy_s.o" \
     "${BUILD_DIR}/gtest-all.o" "${BUILD_DIR}/gtest_main.o" \
     -lpthread -o "${BIN}" || { fail "link failed"; exit 3; }
 
@@ -111,18 +125,22 @@ TEST_RC=$?
 [[ ${TEST_RC} -eq 0 ]] || { fail "unit tests failed (rc=${TEST_RC})"; exit 1; }
 
 info "computing coverage"
-COV_LINE="$( cd "${BUILD_DIR}" && "${GCOV}" -n tlv_utils.gcno 2>/dev/null \
-    | grep -A1 "tlv_utils.cpp'" | grep "Lines executed" | head -1 )"
-echo "  ${COV_LINE}"
-LINE_COV="$(echo "${COV_LINE}" | grep -oE "[0-9]+\.[0-9]+" | head -1)"
-
-[[ -n "${LINE_COV}" ]] || { fail "could not parse coverage output"; exit 3; }
-info "tlv_utils.cpp line coverage: ${LINE_COV}% (min ${COVERAGE_MIN}%)"
+GATE_RC=0
+for unit in "${TLV_UNITS[@]}"; do
+    COV_LINE="$( cd "${BUILD_DIR}" && "${GCOV}" -n "${unit}.gcno" 2>/dev/null \
+        | grep -A1 "${unit}.cpp'" | grep "Lines executed" | head -1 )"
+    echo "  ${COV_LINE}"
+    LINE_COV="$(echo "${COV_LINE}" | grep -oE "[0-9]+\.[0-9]+" | head -1)"
+
+    [[ -n "${LINE_COV}" ]] || { fail "could not parse coverage output for ${unit}.cpp"; exit 3; }
+    info "${unit}.cpp line coverage: ${LINE_COV}% (min ${COVERAGE_MIN}%)"
+    if ! awk "BEGIN{exit !(${LINE_COV} >= ${COVERAGE_MIN})}"; then
+        fail "${unit}.cpp coverage ${LINE_COV}% below gate ${COVERAGE_MIN}%"
+        GATE_RC=2
+    fi
+done
 
-if awk "BEGIN{exit !(${LINE_COV} >= ${COVERAGE_MIN})}"; then
-    echo "[PASS] tests green and coverage ${LINE_COV}% >= ${COVERAGE_MIN}%"
-    exit 0
-else
-    fail "coverage ${LINE_COV}% below gate ${COVERAGE_MIN}%"
-    exit 2
+if [[ ${GATE_RC} -eq 0 ]]; then
+    echo "[PASS] tests green and every unit >= ${COVERAGE_MIN}% line coverage"
 fi
+exit ${GATE_RC}
@@ -0,0 +1,1250 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only unit test for the TLV codec (TLVWriteable / TLVReadable).
+//
+// The codec is exercised through two small TLV objects shaped like PasteData
+// and PasteDataRecord (a clip holding a vector of records, each carrying every
+// value kind the real records use). Links the real tlv_readable.cpp,
+// tlv_writeable.cpp and tlv_utils.cpp against the same fakes as the TLVUtils
+// suite.
+
+#include <sys/mman.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pixel_map.h"  // fake
+#include "tlv_readable.h"
+#include "tlv_writeable.h"
+#include "want.h"       // fake
+
+using namespace testing::ext;
+
+namespace OHOS::MiscServices {
+namespace {
+enum TestTag : uint16_t {
+    TAG_CLIP_TAG = TAG_BUFF + 1,
+    TAG_CLIP_TIMESTAMP,
+    TAG_CLIP_LOCAL_ONLY,
+    TAG_CLIP_RECORDS,
+    TAG_RECORD_MIMETYPE,
+    TAG_RECORD_HTML,
+    TAG_RECORD_PIXELMAP,
+    TAG_RECORD_WANT,
+    TAG_RECORD_CUSTOM,
+    TAG_RECORD_DETAILS,
+    TAG_RECORD_ENTRY,
+    TAG_SCALAR_INT8,
+    TAG_SCALAR_INT16,
+    TAG_SCALAR_DOUBLE,
+    TAG_SCALAR_URI,
+    TAG_SCALAR_DETAILS,
+    TAG_SCALAR_OBJECT,
+};
+
+constexpr size_t HTML_BYTES = 256 * 1024;
+constexpr size_t PIXEL_BYTES = 64 * 1024;
+constexpr size_t RECORD_COUNT = 8;
+constexpr uint32_t WANT_FLAGS = 0x5A5A;
+constexpr int64_t CLIP_TIMESTAMP = 1700000000000;
+constexpr int32_t ENTRY_INT = 42;
+constexpr int64_t ENTRY_INT64 = -7;
+constexpr double ENTRY_DOUBLE = 2.5;
+constexpr int8_t SCALAR_INT8 = -3;
+constexpr int16_t SCALAR_INT16 = 1234;
+constexpr uint32_t URI_ID = 99;
+constexpr size_t LAZY_RECORD_COUNT = 512;
+constexpr size_t LAZY_RECORD_BYTES = 4 * 1024;
+constexpr int PERF_ROUNDS = 20;
+constexpr size_t MAX_TEST_THREADS = 4;
+constexpr size_t PARALLEL_RECORD_COUNT = 16;
+constexpr size_t PARALLEL_RECORD_BYTES = 1024 * 1024;
+
+// sets the TLVParallel limits for one test and puts back the process defaults when it ends
+class ParallelLimits {
+public:
+    ParallelLimits(size_t threads, size_t minBytes)
+        : savedThreads_(TLVParallel::GetMaxThreads()), savedMinBytes_(TLVParallel::GetMinBytes())
+    {
+        TLVParallel::SetMaxThreads(threads);
+        TLVParallel::SetMinBytes(minBytes);
+    }
+
+    ~ParallelLimits()
+    {
+        TLVParallel::SetMaxThreads(savedThreads_);
+        TLVParallel::SetMinBytes(savedMinBytes_);
+    }
+
+private:
+    size_t savedThreads_;
+    size_t savedMinBytes_;
+};
+} // namespace
+
+class FakeRecord : public TLVWriteable, public TLVReadable {
+public:
+    std::string mimeType;
+    std::string html;
+    std::shared_ptr<Media::PixelMap> pixelMap;
+    std::shared_ptr<AAFwk::Want> want;
+    std::map<std::string, std::vector<uint8_t>> custom;
+    std::shared_ptr<Object> details;
+    EntryValue entry;
+
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override
+    {
+        bool ret = buffer.Write(TAG_RECORD_MIMETYPE, mimeType);
+        ret = ret && buffer.Write(TAG_RECORD_HTML, html);
+        ret = ret && buffer.Write(TAG_RECORD_PIXELMAP, pixelMap);
+        ret = ret && buffer.Write(TAG_RECORD_WANT, want);
+        ret = ret && buffer.Write(TAG_RECORD_CUSTOM, custom);
+        ret = ret && buffer.Write(TAG_RECORD_DETAILS, details);
+        ret = ret && buffer.Write(TAG_RECORD_ENTRY, entry);
+        return ret;
+    }
+
+    bool DecodeTLV(ReadOnlyBuffer &buffer) override
+    {
+        for (; buffer.IsEnough();) {
+            TLVHead head{};
+            bool ret = buffer.ReadHead(head);
+            if (!ret) {
+                return false;
+            }
+            if (head.tag == TAG_RECORD_MIMETYPE) {
+                ret = buffer.ReadValue(mimeType, head);
+            } else if (head.tag == TAG_RECORD_HTML) {
+                ret = buffer.ReadValue(html, head);
+            } else if (head.tag == TAG_RECORD_PIXELMAP) {
+                ret = buffer.ReadValue(pixelMap, head);
+            } else if (head.tag == TAG_RECORD_WANT) {
+                ret = buffer.ReadValue(want, head);
+            } else if (head.tag == TAG_RECORD_CUSTOM) {
+                ret = buffer.ReadValue(custom, head);
+            } else if (head.tag == TAG_RECORD_DETAILS) {
+                ret = buffer.ReadValue(details, head);
+            } else if (head.tag == TAG_RECORD_ENTRY) {
+                ret = buffer.ReadValue(entry, head);
+            } else {
+                ret = buffer.Skip(head.len);
+            }
+            if (!ret) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t CountTLV() const override
+    {
+        size_t expectSize = 0;
+        expectSize += TLVCountable::Count(mimeType);
+        expectSize += TLVCountable::Count(html);
+        expectSize += TLVCountable::Count(pixelMap);
+        expectSize += TLVCountable::Count(want);
+        expectSize += TLVCountable::Count(custom);
+        expectSize += TLVCountable::Count(details);
+        expectSize += TLVCountable::Count(entry);
+        return expectSize;
+    }
+};
+
+class FakeClip : public TLVWriteable, public TLVReadable {
+public:
+    std::string tag;
+    int64_t timestamp = 0;
+    bool localOnly = false;
+    std::vector<std::shared_ptr<FakeRecord>> records;
+    // mirrors PasteData::SetEncodedRecords: spliced verbatim instead of encoding records again
+    std::shared_ptr<const std::vector<uint8_t>> encodedRecords;
+    // mirrors PasteData: records go through the list codec that may spread them over threads
+    bool parallel = false;
+
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override
+    {
+        bool ret = buffer.Write(TAG_CLIP_TAG, tag);
+        ret = ret && buffer.Write(TAG_CLIP_TIMESTAMP, timestamp);
+        ret = ret && buffer.Write(TAG_CLIP_LOCAL_ONLY, localOnly);
+        if (encodedRecords != nullptr) {
+            ret = ret && buffer.WriteEncoded(*encodedRecords);
+        } else if (parallel) {
+            ret = ret && buffer.WriteParallel(TAG_CLIP_RECORDS, records);
+        } else {
+            ret = ret && buffer.Write(TAG_CLIP_RECORDS, records);
+        }
+        return ret;
+    }
+
+    bool DecodeTLV(ReadOnlyBuffer &buffer) override
+    {
+        for (; buffer.IsEnough();) {
+            TLVHead head{};
+            bool ret = buffer.ReadHead(head);
+            if (!ret) {
+                return false;
+            }
+            if (head.tag == TAG_CLIP_TAG) {
+                ret = buffer.ReadValue(tag, head);
+            } else if (head.tag == TAG_CLIP_TIMESTAMP) {
+                ret = buffer.ReadValue(timestamp, head);
+            } else if (head.tag == TAG_CLIP_LOCAL_ONLY) {
+                ret = buffer.ReadValue(localOnly, head);
+            } else if (head.tag == TAG_CLIP_RECORDS) {
+                ret = parallel ? buffer.ReadValueParallel(records, head) : buffer.ReadValue(records, head);
+            } else {
+                ret = buffer.Skip(head.len);
+            }
+            if (!ret) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t CountTLV() const override
+    {
+        size_t expectSize = 0;
+        expectSize += TLVCountable::Count(tag);
+        expectSize += TLVCountable::Count(timestamp);
+        expectSize += TLVCountable::Count(localOnly);
+        if (encodedRecords != nullptr) {
+            expectSize += encodedRecords->size();
+        } else {
+            expectSize += parallel ? TLVCountable::CountParallel(records) : TLVCountable::Count(records);
+        }
+        return expectSize;
+    }
+};
+
+// The record list alone, as FakeClip writes it: the shape of PasteData::EncodeRecordsTLV.
+class FakeRecordsTLV : public TLVWriteable {
+public:
+    explicit FakeRecordsTLV(const std::vector<std::shared_ptr<FakeRecord>> &records) : records_(records) {}
+
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override
+    {
+        return buffer.Write(TAG_CLIP_RECORDS, records_);
+    }
+
+    size_t CountTLV() const override
+    {
+        return TLVCountable::Count(records_);
+    }
+
+private:
+    const std::vector<std::shared_ptr<FakeRecord>> &records_;
+};
+
+// Carries the value kinds FakeRecord does not: the narrow integers, double, a
+// Uri written as raw parcel bytes, Details, and an Object holding every
+// EntryValue alternative.
+class FakeScalars : public TLVWriteable, public TLVReadable {
+public:
+    int8_t int8Value = 0;
+    int16_t int16Value = 0;
+    double doubleValue = 0;
+    std::shared_ptr<Uri> uri;
+    Details details;
+    Object object;
+
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override
+    {
+        bool ret = buffer.Write(TAG_SCALAR_INT8, int8Value);
+        ret = ret && buffer.Write(TAG_SCALAR_INT16, int16Value);
+        ret = ret && buffer.Write(TAG_SCALAR_DOUBLE, doubleValue);
+        ret = ret && buffer.Write(TAG_SCALAR_URI, TLVUtils::Parcelable2Raw(uri.get()));
+        ret = ret && buffer.Write(TAG_SCALAR_DETAILS, details);
+        ret = ret && buffer.Write(TAG_SCALAR_OBJECT, object);
+        return ret;
+    }
+
+    bool DecodeTLV(ReadOnlyBuffer &buffer) override
+    {
+        for (; buffer.IsEnough();) {
+            TLVHead head{};
+            bool ret = buffer.ReadHead(head);
+            if (!ret) {
+                return false;
+            }
+            if (head.tag == TAG_SCALAR_INT8) {
+                ret = buffer.ReadValue(int8Value, head);
+            } else if (head.tag == TAG_SCALAR_INT16) {
+                ret = buffer.ReadValue(int16Value, head);
+            } else if (head.tag == TAG_SCALAR_DOUBLE) {
+                ret = buffer.ReadValue(doubleValue, head);
+            } else if (head.tag == TAG_SCALAR_URI) {
+                ret = buffer.ReadValue(uri, head);
+            } else if (head.tag == TAG_SCALAR_DETAILS) {
+                ret = buffer.ReadValue(details, head);
+            } else if (head.tag == TAG_SCALAR_OBJECT) {
+                ret = buffer.ReadValue(object, head);
+            } else {
+                ret = buffer.Skip(head.len);
+            }
+            if (!ret) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t CountTLV() const override
+    {
+        size_t expectSize = 0;
+        expectSize += TLVCountable::Count(int8Value);
+        expectSize += TLVCountable::Count(int16Value);
+        expectSize += TLVCountable::Count(doubleValue);
+        expectSize += TLVCountable::Count(TLVUtils::Parcelable2Raw(uri.get()));
+        expectSize += TLVCountable::Count(details);
+        expectSize += TLVCountable::Count(std::make_shared<Object>(object));
+        return expectSize;
+    }
+};
+
+class TlvCodecHostTest : public testing::Test {
+protected:
+    static FakeClip MakeClip()
+    {
+        FakeClip clip;
+        clip.tag = "codec-host-test";
+        clip.timestamp = CLIP_TIMESTAMP;
+        clip.localOnly = true;
+        for (size_t i = 0; i < RECORD_COUNT; ++i) {
+            auto record = std::make_shared<FakeRecord>();
+            record->mimeType = "text/html";
+            record->html.assign(HTML_BYTES, static_cast<char>('a' + i));
+            record->pixelMap = std::make_shared<Media::PixelMap>();
+            record->pixelMap->blob.assign(PIXEL_BYTES, static_cast<uint8_t>(i));
+            record->want = std::make_shared<AAFwk::Want>();
+            record->want->flags = WANT_FLAGS + static_cast<uint32_t>(i);
+            record->custom["openharmony.custom"] = std::vector<uint8_t>(i + 1, static_cast<uint8_t>(i));
+            record->details = std::make_shared<Object>();
+            record->details->value_["title"] = std::string("record") + std::to_string(i);
+            record->details->value_["index"] = static_cast<int32_t>(i);
+            record->entry = ENTRY_INT;
+            clip.records.emplace_back(std::move(record));
+        }
+        return clip;
+    }
+
+    // many small records, the shape of a multi-select copy; the first one carries the primary text
+    static FakeClip MakeWideClip()
+    {
+        FakeClip clip;
+        clip.tag = "codec-host-test-wide";
+        for (size_t i = 0; i < LAZY_RECORD_COUNT; ++i) {
+            auto record = std::make_shared<FakeRecord>();
+            record->mimeType = i == 0 ? "text/plain" : "text/html";
+            record->html.assign(LAZY_RECORD_BYTES, static_cast<char>('a' + i % 26));
+            record->pixelMap = std::make_shared<Media::PixelMap>();
+            record->pixelMap->blob.assign(LAZY_RECORD_BYTES, static_cast<uint8_t>(i));
+            record->want = std::make_shared<AAFwk::Want>();
+            record->details = std::make_shared<Object>();
+            record->details->value_["index"] = static_cast<int32_t>(i);
+            clip.records.emplace_back(std::move(record));
+        }
+        return clip;
+    }
+
+    // the record list element alone, without the slack Count leaves after it
+    static std::vector<uint8_t> EncodeElement(const std::vector<std::shared_ptr<FakeRecord>> &records)
+    {
+        std::vector<uint8_t> element = EncodeOrDie(FakeRecordsTLV(records));
+        TLVHead head{};
+        ReadOnlyBuffer buffer(element);
+        EXPECT_TRUE(buffer.ReadHead(head));
+        element.resize(sizeof(TLVHead) + head.len);
+        return element;
+    }
+
+    // a record list element read into a lazy list the way PasteData reads TAG_RECORDS
+    static bool ReadLazy(const std::vector<uint8_t> &element, TLVLazyList &list)
+    {
+        ReadOnlyBuffer buffer(element);
+        TLVHead head{};
+        return buffer.ReadHead(head) && list.Read(buffer, head) && !buffer.IsEnough();
+    }
+
+    static FakeScalars MakeScalars()
+    {
+        FakeScalars scalars;
+        scalars.int8Value = SCALAR_INT8;
+        scalars.int16Value = SCALAR_INT16;
+        scalars.doubleValue = ENTRY_DOUBLE;
+        scalars.uri = std::make_shared<Uri>();
+        scalars.uri->id = URI_ID;
+        scalars.details["int32"] = ENTRY_INT;
+        scalars.details["int64"] = ENTRY_INT64;
+        scalars.details["bool"] = true;
+        scalars.details["double"] = ENTRY_DOUBLE;
+        scalars.details["string"] = std::string("details");
+        scalars.details["bytes"] = std::vector<uint8_t>{ 1, 2, 3 };
+        auto want = std::make_shared<AAFwk::Want>();
+        want->flags = WANT_FLAGS;
+        auto pixelMap = std::make_shared<Media::PixelMap>();
+        pixelMap->blob = { 4, 5, 6 };
+        auto nested = std::make_shared<Object>();
+        nested->value_["inner"] = std::string("nested");
+        scalars.object.value_["monostate"] = std::monostate{};
+        scalars.object.value_["int32"] = ENTRY_INT;
+        scalars.object.value_["int64"] = ENTRY_INT64;
+        scalars.object.value_["double"] = ENTRY_DOUBLE;
+        scalars.object.value_["bool"] = false;
+        scalars.object.value_["string"] = std::string("object");
+        scalars.object.value_["bytes"] = std::vector<uint8_t>{ 7, 8 };
+        scalars.object.value_["want"] = want;
+        scalars.object.value_["pixelMap"] = pixelMap;
+        scalars.object.value_["object"] = nested;
+        scalars.object.value_["null"] = nullptr;
+        return scalars;
+    }
+
+    static std::vector<uint8_t> EncodeOrDie(const TLVWriteable &object)
+    {
+        std::vector<uint8_t> buffer;
+        EXPECT_TRUE(object.Encode(buffer));
+        return buffer;
+    }
+
+    // offset of the index-th record item inside an encoded clip, located by walking the heads
+    static size_t RecordItemOffset(const std::vector<uint8_t> &encoded, size_t index)
+    {
+        size_t offset = 0;
+        while (offset + sizeof(TLVHead) <= encoded.size()) {
+            const auto *head = reinterpret_cast<const TLVHead *>(encoded.data() + offset);
+            if (NetToHost(head->tag) == TAG_CLIP_RECORDS) {
+                break;
+            }
+            offset += sizeof(TLVHead) + NetToHost(head->len);
+        }
+        offset += sizeof(TLVHead);
+        for (size_t i = 0; i < index; ++i) {
+            offset += sizeof(TLVHead) + NetToHost(reinterpret_cast<const TLVHead *>(encoded.data() + offset)->len);
+        }
+        return offset;
+    }
+};
+
+/**
+ * @tc.name: BorrowedDecodeMatchesVectorDecode
+ * @tc.desc: Decoding from a borrowed pointer view yields an object that re-encodes to the exact bytes produced
+ *           by the vector decode path.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, BorrowedDecodeMatchesVectorDecode, TestSize.Level0)
+{
+    std::vector<uint8_t> encoded = EncodeOrDie(MakeClip());
+    ASSERT_FALSE(encoded.empty());
+
+    FakeClip fromVector;
+    ASSERT_TRUE(fromVector.Decode(encoded));
+    FakeClip fromView;
+    ASSERT_TRUE(fromView.Decode(encoded.data(), encoded.size()));
+
+    EXPECT_EQ(EncodeOrDie(fromVector), encoded);
+    EXPECT_EQ(EncodeOrDie(fromView), encoded);
+    ASSERT_EQ(fromView.records.size(), RECORD_COUNT);
+    EXPECT_EQ(fromView.records.back()->want->flags, WANT_FLAGS + RECORD_COUNT - 1);
+    EXPECT_EQ(fromView.records.front()->pixelMap->blob.size(), PIXEL_BYTES);
+}
+
+/**
+ * @tc.name: BorrowedDecodeFromMappedRegion
+ * @tc.desc: A read-only shared mapping, as handed over for an ashmem fd, decodes in place to the same object.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, BorrowedDecodeFromMappedRegion, TestSize.Level0)
+{
+    std::vector<uint8_t> encoded = EncodeOrDie(MakeClip());
+    void *region = ::mmap(nullptr, encoded.size(), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(region, MAP_FAILED);
+    std::memcpy(region, encoded.data(), encoded.size());
+    ASSERT_EQ(::mprotect(region, encoded.size(), PROT_READ), 0);
+
+    FakeClip clip;
+    bool ret = clip.Decode(static_cast<const uint8_t *>(region), encoded.size());
+    ::munmap(region, encoded.size());
+    ASSERT_TRUE(ret);
+    EXPECT_EQ(EncodeOrDie(clip), encoded);
+}
+
+/**
+ * @tc.name: BorrowedDecodeRejectsTruncatedView
+ * @tc.desc: A view cut short in the middle of a record fails exactly as the vector path does on the same bytes.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, BorrowedDecodeRejectsTruncatedView, TestSize.Level0)
+{
+    std::vector<uint8_t> encoded = EncodeOrDie(MakeClip());
+    std::vector<uint8_t> truncated(encoded.begin(), encoded.begin() + encoded.size() / 2);
+
+    FakeClip fromVector;
+    FakeClip fromView;
+    EXPECT_FALSE(fromVector.Decode(truncated));
+    EXPECT_FALSE(fromView.Decode(truncated.data(), truncated.size()));
+}
+
+/**
+ * @tc.name: BorrowedDecodeRejectsNullView
+ * @tc.desc: A null view with a non-zero length is refused, while an empty view decodes to an empty object.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, BorrowedDecodeRejectsNullView, TestSize.Level0)
+{
+    FakeClip clip;
+    EXPECT_FALSE(clip.Decode(nullptr, sizeof(TLVHead)));
+    EXPECT_TRUE(clip.Decode(nullptr, 0));
+    EXPECT_TRUE(clip.records.empty());
+}
+
+/**
+ * @tc.name: VectorReadStaysInsideView
+ * @tc.desc: A vector head whose length runs past the end of the view is refused instead of reading beyond it.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, VectorReadStaysInsideView, TestSize.Level0)
+{
+    std::vector<uint8_t> bytes(sizeof(TLVHead), 0);
+    ReadOnlyBuffer buffer(bytes.data(), bytes.size());
+    TLVHead head{};
+    head.tag = TAG_VECTOR_ITEM;
+    head.len = sizeof(TLVHead) + 1;
+    std::vector<std::string> value;
+    EXPECT_FALSE(buffer.ReadValue(value, head));
+}
+
+/**
+ * @tc.name: EveryValueKindRoundTrips
+ * @tc.desc: Every scalar, Details and EntryValue alternative survives an encode and a borrowed decode unchanged.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, EveryValueKindRoundTrips, TestSize.Level0)
+{
+    FakeScalars source = MakeScalars();
+    std::vector<uint8_t> encoded = EncodeOrDie(source);
+    EXPECT_EQ(encoded.size(), source.Count());
+
+    FakeScalars decoded;
+    ASSERT_TRUE(decoded.Decode(encoded.data(), encoded.size()));
+    EXPECT_EQ(decoded.int8Value, SCALAR_INT8);
+    EXPECT_EQ(decoded.int16Value, SCALAR_INT16);
+    EXPECT_EQ(decoded.doubleValue, ENTRY_DOUBLE);
+    ASSERT_NE(decoded.uri, nullptr);
+    EXPECT_EQ(decoded.uri->id, URI_ID);
+    EXPECT_EQ(std::get<int64_t>(decoded.details["int64"]), ENTRY_INT64);
+    EXPECT_EQ(std::get<std::string>(decoded.object.value_["string"]), "object");
+    auto want = std::get<std::shared_ptr<AAFwk::Want>>(decoded.object.value_["want"]);
+    ASSERT_NE(want, nullptr);
+    EXPECT_EQ(want->flags, WANT_FLAGS);
+    auto nested = std::get<std::shared_ptr<Object>>(decoded.object.value_["object"]);
+    ASSERT_NE(nested, nullptr);
+    EXPECT_EQ(std::get<std::string>(nested->value_["inner"]), "nested");
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(decoded.object.value_["monostate"]));
+    EXPECT_EQ(EncodeOrDie(decoded), encoded);
+}
+
+/**
+ * @tc.name: PresizedEncodeMatchesEncode
+ * @tc.desc: Encode with a length from Count produces the same bytes as Encode, and both report the remote flag.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, PresizedEncodeMatchesEncode, TestSize.Level0)
+{
+    FakeClip clip = MakeClip();
+    size_t len = clip.Count(true);
+    EXPECT_TRUE(IsRemoteEncode());
+    std::vector<uint8_t> presized;
+    ASSERT_TRUE(clip.Encode(len, presized, false));
+    EXPECT_FALSE(IsRemoteEncode());
+    EXPECT_EQ(presized, EncodeOrDie(clip));
+}
+
+/**
+ * @tc.name: EncodeRefusesShortBuffer
+ * @tc.desc: Encode into a buffer shorter than Count reports failure instead of writing past the end.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, EncodeRefusesShortBuffer, TestSize.Level0)
+{
+    FakeScalars scalars = MakeScalars();
+    std::vector<uint8_t> buffer;
+    EXPECT_FALSE(scalars.Encode(scalars.Count() / 2, buffer));
+}
+
+/**
+ * @tc.name: EncodeIntoRegionMatchesVectorEncode
+ * @tc.desc: Encoding into a caller-provided region that holds stale bytes yields exactly the vector encoding,
+ *           including the empty heads of monostate and nullptr values and a zeroed tail.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, EncodeIntoRegionMatchesVectorEncode, TestSize.Level0)
+{
+    constexpr size_t slack = 16;
+    constexpr uint8_t staleByte = 0xA5;
+    FakeScalars scalars = MakeScalars();
+    std::vector<uint8_t> expected = EncodeOrDie(scalars);
+
+    size_t len = scalars.Count() + slack;
+    void *region = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(region, MAP_FAILED);
+    std::memset(region, staleByte, len);
+    auto *bytes = static_cast<uint8_t *>(region);
+    bool ret = scalars.Encode(bytes, len);
+    std::vector<uint8_t> actual(bytes, bytes + expected.size());
+    std::vector<uint8_t> tail(bytes + expected.size(), bytes + len);
+    ::munmap(region, len);
+
+    ASSERT_TRUE(ret);
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(tail, std::vector<uint8_t>(slack, 0));
+}
+
+/**
+ * @tc.name: EncodeIntoRegionRoundTrips
+ * @tc.desc: A clip encoded into a region decodes back from the same region to the original bytes.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, EncodeIntoRegionRoundTrips, TestSize.Level0)
+{
+    FakeClip clip = MakeClip();
+    std::vector<uint8_t> region(clip.Count(), 0xFF);
+    ASSERT_TRUE(clip.Encode(region.data(), region.size()));
+    EXPECT_EQ(region, EncodeOrDie(clip));
+
+    FakeClip decoded;
+    ASSERT_TRUE(decoded.Decode(region.data(), region.size()));
+    EXPECT_EQ(decoded.records.size(), RECORD_COUNT);
+}
+
+/**
+ * @tc.name: EncodeIntoRegionRejectsBadRegion
+ * @tc.desc: A null region is refused, and a region shorter than Count fails without writing past its end.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, EncodeIntoRegionRejectsBadRegion, TestSize.Level0)
+{
+    constexpr uint8_t guardByte = 0x5C;
+    FakeScalars scalars = MakeScalars();
+    EXPECT_FALSE(scalars.Encode(nullptr, scalars.Count()));
+
+    size_t shortLen = scalars.Count() / 2;
+    std::vector<uint8_t> region(shortLen + 1, guardByte);
+    EXPECT_FALSE(scalars.Encode(region.data(), shortLen));
+    EXPECT_EQ(region.back(), guardByte);
+}
+
+/**
+ * @tc.name: EncodeSerializesMediaOnce
+ * @tc.desc: One Encode call serializes every PixelMap and Want exactly once, counting reuses the same bytes.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, EncodeSerializesMediaOnce, TestSize.Level0)
+{
+    FakeClip clip = MakeClip();
+    Media::PixelMap::encodeTlvCalls = 0;
+    AAFwk::Want::marshallingCalls = 0;
+    std::vector<uint8_t> encoded = EncodeOrDie(clip);
+    EXPECT_EQ(Media::PixelMap::encodeTlvCalls, RECORD_COUNT);
+    EXPECT_EQ(AAFwk::Want::marshallingCalls, RECORD_COUNT);
+
+    FakeClip decoded;
+    ASSERT_TRUE(decoded.Decode(encoded));
+    ASSERT_EQ(decoded.records.size(), RECORD_COUNT);
+    EXPECT_EQ(decoded.records.back()->pixelMap->blob, clip.records.back()->pixelMap->blob);
+    EXPECT_EQ(decoded.records.back()->want->flags, clip.records.back()->want->flags);
+}
+
+/**
+ * @tc.name: SerializedCacheSpansCountAndEncode
+ * @tc.desc: A scope held across Count and a presized Encode serializes once, without a scope both passes
+ *           serialize, and the cache is dropped when the scope ends.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, SerializedCacheSpansCountAndEncode, TestSize.Level0)
+{
+    FakeClip clip = MakeClip();
+    std::vector<uint8_t> expected = EncodeOrDie(clip);
+    std::vector<uint8_t> presized;
+
+    Media::PixelMap::encodeTlvCalls = 0;
+    AAFwk::Want::marshallingCalls = 0;
+    ASSERT_TRUE(clip.Encode(clip.Count(), presized));
+    EXPECT_EQ(Media::PixelMap::encodeTlvCalls, RECORD_COUNT * 2);
+    EXPECT_EQ(AAFwk::Want::marshallingCalls, RECORD_COUNT * 2);
+    EXPECT_EQ(presized, expected);
+
+    Media::PixelMap::encodeTlvCalls = 0;
+    AAFwk::Want::marshallingCalls = 0;
+    {
+        SerializedCache cacheScope;
+        ASSERT_TRUE(clip.Encode(clip.Count(), presized));
+    }
+    EXPECT_EQ(Media::PixelMap::encodeTlvCalls, RECORD_COUNT);
+    EXPECT_EQ(AAFwk::Want::marshallingCalls, RECORD_COUNT);
+    EXPECT_EQ(presized, expected);
+
+    clip.records.front()->pixelMap->blob.assign(1, 0);
+    FakeClip decoded;
+    ASSERT_TRUE(decoded.Decode(EncodeOrDie(clip)));
+    EXPECT_EQ(decoded.records.front()->pixelMap->blob, std::vector<uint8_t>(1, 0));
+}
+
+/**
+ * @tc.name: SerializedCacheSkipsFailedPixelMap
+ * @tc.desc: A pixel map that fails to encode is not cached: Count still accounts both heads and Encode fails.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, SerializedCacheSkipsFailedPixelMap, TestSize.Level0)
+{
+    auto pixelMap = std::make_shared<Media::PixelMap>();
+    pixelMap->encodeShouldFail = true;
+    SerializedCache cacheScope;
+    EXPECT_EQ(TLVCountable::Count(pixelMap), sizeof(TLVHead) * 2);
+    EXPECT_EQ(SerializedCache::PixelMap2Vector(pixelMap), nullptr);
+    EXPECT_EQ(SerializedCache::PixelMap2Vector(nullptr), nullptr);
+
+    FakeClip clip = MakeClip();
+    clip.records.front()->pixelMap = pixelMap;
+    std::vector<uint8_t> encoded;
+    EXPECT_FALSE(clip.Encode(encoded));
+}
+
+/**
+ * @tc.name: SerializedCacheNeverAliasesTemporaries
+ * @tc.desc: Temporaries serialized inside one scope (as remote encoding builds them) keep their own bytes, a
+ *           released object cannot hand its cache entry to a later object at the same address.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, SerializedCacheNeverAliasesTemporaries, TestSize.Level0)
+{
+    constexpr size_t rounds = 16;
+    SerializedCache cacheScope;
+    for (size_t i = 0; i < rounds; ++i) {
+        auto pixelMap = std::make_shared<Media::PixelMap>();
+        pixelMap->blob.assign(i + 1, static_cast<uint8_t>(i));
+        auto rawData = SerializedCache::PixelMap2Vector(pixelMap);
+        ASSERT_NE(rawData, nullptr);
+        EXPECT_EQ(*rawData, pixelMap->blob);
+
+        auto want = std::make_shared<AAFwk::Want>();
+        want->flags = WANT_FLAGS + static_cast<uint32_t>(i);
+        auto parsed = TLVUtils::Raw2Parcelable<AAFwk::Want>(SerializedCache::Parcelable2Raw(want));
+        ASSERT_NE(parsed, nullptr);
+        EXPECT_EQ(parsed->flags, want->flags);
+    }
+}
+
+/**
+ * @tc.name: SplicedRecordsMatchFullEncode
+ * @tc.desc: Splicing a cached record list under a per-reader envelope gives the bytes of a full encode without
+ *           serializing any record again, and a region too short for the spliced bytes is refused.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, SplicedRecordsMatchFullEncode, TestSize.Level0)
+{
+    FakeClip stored = MakeClip();
+    auto encodedRecords = std::make_shared<std::vector<uint8_t>>();
+    ASSERT_TRUE(FakeRecordsTLV(stored.records).Encode(*encodedRecords));
+
+    FakeClip reader = stored;
+    reader.tag = "reader-envelope";
+    reader.localOnly = false;
+    std::vector<uint8_t> expected = EncodeOrDie(reader);
+
+    reader.encodedRecords = encodedRecords;
+    Media::PixelMap::encodeTlvCalls = 0;
+    AAFwk::Want::marshallingCalls = 0;
+    EXPECT_EQ(reader.Count(), expected.size());
+    EXPECT_EQ(EncodeOrDie(reader), expected);
+    EXPECT_EQ(Media::PixelMap::encodeTlvCalls, 0u);
+    EXPECT_EQ(AAFwk::Want::marshallingCalls, 0u);
+
+    std::vector<uint8_t> region(expected.size() - 1);
+    EXPECT_FALSE(reader.Encode(region.data(), region.size()));
+}
+
+/**
+ * @tc.name: SealedRecordsWithEnvelopeDecodeAsOneClip
+ * @tc.desc: A record list written alone into a region, decoded before an envelope encoded with an empty
+ *           record splice, gives the clip a full encode gives: the reply shape of a sealed clip store.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, SealedRecordsWithEnvelopeDecodeAsOneClip, TestSize.Level0)
+{
+    FakeClip stored = MakeClip();
+    FakeRecordsTLV recordsTlv(stored.records);
+    std::vector<uint8_t> region(recordsTlv.Count());
+    ASSERT_TRUE(recordsTlv.Encode(region.data(), region.size()));
+
+    FakeClip reader = stored;
+    reader.tag = "sealed-envelope";
+    reader.timestamp = 42;
+    reader.localOnly = false;
+    FakeClip full;
+    ASSERT_TRUE(full.Decode(EncodeOrDie(reader)));
+
+    reader.encodedRecords = std::make_shared<std::vector<uint8_t>>();
+    std::vector<uint8_t> envelope = EncodeOrDie(reader);
+    EXPECT_EQ(envelope.size() + region.size(), EncodeOrDie(full).size());
+
+    FakeClip decoded;
+    ASSERT_TRUE(decoded.Decode(region.data(), region.size()));
+    ASSERT_TRUE(decoded.Decode(envelope));
+    EXPECT_EQ(EncodeOrDie(decoded), EncodeOrDie(full));
+    EXPECT_EQ(decoded.tag, "sealed-envelope");
+    EXPECT_EQ(decoded.records.size(), stored.records.size());
+}
+
+/**
+ * @tc.name: LazyListDecodesOnlyTakenItems
+ * @tc.desc: A record list read lazily locates every record without decoding one, decodes a record only when it
+ *           is taken, and keeps the element it read byte-for-byte while no record is taken.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, LazyListDecodesOnlyTakenItems, TestSize.Level0)
+{
+    FakeClip stored = MakeClip();
+    std::vector<uint8_t> element = EncodeElement(stored.records);
+
+    TLVLazyList list;
+    Media::PixelMap::decodeTlvCalls = 0;
+    ASSERT_TRUE(ReadLazy(element, list));
+    EXPECT_EQ(Media::PixelMap::decodeTlvCalls, 0u);
+    EXPECT_EQ(list.Size(), stored.records.size());
+    EXPECT_EQ(list.Pending(), stored.records.size());
+    EXPECT_TRUE(list.IsUntouched());
+    EXPECT_EQ(list.Encoded(), element);
+
+    const size_t index = 3;
+    std::shared_ptr<FakeRecord> record;
+    ASSERT_TRUE(list.Take(index, record));
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(Media::PixelMap::decodeTlvCalls, 1u);
+    EXPECT_EQ(EncodeOrDie(*record), EncodeOrDie(*stored.records[index]));
+    EXPECT_FALSE(list.IsPending(index));
+    EXPECT_TRUE(list.IsPending(index + 1));
+    EXPECT_EQ(list.Pending(), stored.records.size() - 1);
+    EXPECT_FALSE(list.IsUntouched());
+
+    // a record is taken once, and an index past the list is never pending
+    EXPECT_FALSE(list.Take(index, record));
+    EXPECT_FALSE(list.Take(stored.records.size(), record));
+    EXPECT_FALSE(list.IsPending(stored.records.size()));
+    EXPECT_EQ(Media::PixelMap::decodeTlvCalls, 1u);
+
+    for (size_t i = 0; i < stored.records.size(); ++i) {
+        if (i != index) {
+            ASSERT_TRUE(list.Take(i, record));
+            EXPECT_EQ(EncodeOrDie(*record), EncodeOrDie(*stored.records[i]));
+        }
+    }
+    EXPECT_EQ(list.Pending(), 0u);
+
+    TLVLazyList empty;
+    std::vector<uint8_t> emptyElement = EncodeElement({});
+    ASSERT_TRUE(ReadLazy(emptyElement, empty));
+    EXPECT_EQ(empty.Size(), 0u);
+    EXPECT_TRUE(empty.IsUntouched());
+}
+
+/**
+ * @tc.name: LazyListRejectsBrokenElements
+ * @tc.desc: Reading a list fails when the element runs past the buffer or an item head runs past the element,
+ *           and a record whose bytes do not decode fails only when it is taken.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, LazyListRejectsBrokenElements, TestSize.Level0)
+{
+    FakeClip stored = MakeClip();
+    std::vector<uint8_t> element = EncodeElement(stored.records);
+
+    // the element is cut short, its head claims more than the buffer holds
+    std::vector<uint8_t> truncated(element.begin(), element.end() - 1);
+    TLVLazyList list;
+    EXPECT_FALSE(ReadLazy(truncated, list));
+
+    // the element is whole but its last item head claims more than the element holds
+    std::vector<uint8_t> overrun = element;
+    auto *outer = reinterpret_cast<TLVHead *>(overrun.data());
+    outer->len = HostToNet(static_cast<uint32_t>(NetToHost(outer->len) - 1));
+    overrun.pop_back();
+    EXPECT_FALSE(ReadLazy(overrun, list));
+
+    // the first record carries a value head past its own end: found by its head, rejected when taken
+    std::vector<uint8_t> corrupt = element;
+    auto *first = reinterpret_cast<TLVHead *>(corrupt.data() + sizeof(TLVHead));
+    auto *value = reinterpret_cast<TLVHead *>(corrupt.data() + 2 * sizeof(TLVHead));
+    value->len = HostToNet(static_cast<uint32_t>(NetToHost(first->len)));
+    ASSERT_TRUE(ReadLazy(corrupt, list));
+    std::shared_ptr<FakeRecord> record;
+    EXPECT_FALSE(list.Take(0, record));
+    EXPECT_FALSE(list.IsPending(0));
+    EXPECT_TRUE(list.Take(1, record));
+}
+
+/**
+ * @tc.name: LazyPrimaryRecordCost
+ * @tc.desc: reports the time to reach the first record of a 512 record clip, decoding every record and
+ *           decoding only the first one from a lazily read list.
+ * @tc.type: PERF
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, LazyPrimaryRecordCost, TestSize.Level0)
+{
+    FakeClip stored = MakeWideClip();
+    std::vector<uint8_t> element = EncodeElement(stored.records);
+    std::vector<uint8_t> full = EncodeOrDie(stored);
+    auto time = [](const std::function<bool()> &reader) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < PERF_ROUNDS; ++i) {
+            if (!reader()) {
+                return -1.0;
+            }
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() /
+            PERF_ROUNDS;
+    };
+    double eager = time([&]() {
+        FakeClip clip;
+        return clip.Decode(full) && clip.records.size() == LAZY_RECORD_COUNT &&
+            clip.records.front()->mimeType == "text/plain";
+    });
+    double lazy = time([&]() {
+        TLVLazyList list;
+        std::shared_ptr<FakeRecord> record;
+        return ReadLazy(element, list) && list.Size() == LAZY_RECORD_COUNT && list.Take(0, record) &&
+            record->mimeType == "text/plain";
+    });
+    ASSERT_GT(eager, 0);
+    ASSERT_GT(lazy, 0);
+    std::printf("[PERF] first of %zu records: decode all %.1f us, lazy list %.1f us\n", LAZY_RECORD_COUNT,
+        eager, lazy);
+    EXPECT_LT(lazy, eager);
+}
+
+/**
+ * @tc.name: ParallelThreadsFollowLimits
+ * @tc.desc: the thread count stays within 1 and 4, small or short lists stay on the calling thread, and Run
+ *           calls the job once for every index whatever the number of threads.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, ParallelThreadsFollowLimits, TestSize.Level0)
+{
+    constexpr size_t minBytes = 1000;
+    ParallelLimits limits(0, minBytes);
+    EXPECT_EQ(TLVParallel::GetMaxThreads(), 1u);
+    EXPECT_EQ(TLVParallel::ThreadsFor(RECORD_COUNT, minBytes), 1u);
+    TLVParallel::SetMaxThreads(100);
+    EXPECT_EQ(TLVParallel::GetMaxThreads(), MAX_TEST_THREADS);
+    TLVParallel::SetMaxThreads(3);
+    EXPECT_EQ(TLVParallel::GetMinBytes(), minBytes);
+    EXPECT_EQ(TLVParallel::ThreadsFor(1, minBytes * 2), 1u);
+    EXPECT_EQ(TLVParallel::ThreadsFor(RECORD_COUNT, minBytes - 1), 1u);
+    EXPECT_EQ(TLVParallel::ThreadsFor(RECORD_COUNT, minBytes), 3u);
+    EXPECT_EQ(TLVParallel::ThreadsFor(2, minBytes), 2u);
+
+    for (size_t threads = 0; threads <= RECORD_COUNT + 1; ++threads) {
+        std::vector<std::atomic<uint32_t>> calls(RECORD_COUNT);
+        TLVParallel::Run(RECORD_COUNT, threads, [&calls](size_t index) {
+            calls[index]++;
+        });
+        for (auto &count : calls) {
+            EXPECT_EQ(count.load(), 1u);
+        }
+    }
+    TLVParallel::Run(0, 2, [](size_t) {
+        ADD_FAILURE();
+    });
+    TLVParallel::Run(RECORD_COUNT, 2, nullptr);
+}
+
+/**
+ * @tc.name: ParallelDepthAndCacheFollowTheList
+ * @tc.desc: a worker continues at the recursion depth of the thread that hands it an item and restores its own
+ *           when done, and a worker that joins the serialized cache of that thread shares its entries.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, ParallelDepthAndCacheFollowTheList, TestSize.Level0)
+{
+    constexpr uint32_t handedDepth = 9;
+    std::thread([handedDepth]() {
+        {
+            RecursiveGuard guard(handedDepth);
+            EXPECT_EQ(RecursiveGuard::GetDepth(), handedDepth);
+            RecursiveGuard nested;
+            EXPECT_TRUE(nested.IsValid());
+            RecursiveGuard tooDeep;
+            EXPECT_FALSE(tooDeep.IsValid());
+        }
+        EXPECT_EQ(RecursiveGuard::GetDepth(), 0u);
+    }).join();
+
+    auto pixelMap = std::make_shared<Media::PixelMap>();
+    pixelMap->blob.assign(PIXEL_BYTES, 1);
+    Media::PixelMap::encodeTlvCalls = 0;
+    EXPECT_EQ(SerializedCache::Current(), nullptr);
+    {
+        SerializedCache scope;
+        auto entries = SerializedCache::Current();
+        ASSERT_NE(entries, nullptr);
+        std::shared_ptr<const std::vector<uint8_t>> fromWorker;
+        std::thread([&entries, &pixelMap, &fromWorker]() {
+            SerializedCache join(entries);
+            EXPECT_EQ(SerializedCache::Current(), entries);
+            fromWorker = SerializedCache::PixelMap2Vector(pixelMap);
+        }).join();
+        EXPECT_EQ(SerializedCache::Current(), entries);
+        EXPECT_EQ(SerializedCache::PixelMap2Vector(pixelMap), fromWorker);
+        EXPECT_EQ(Media::PixelMap::encodeTlvCalls.load(), 1u);
+    }
+    EXPECT_EQ(SerializedCache::Current(), nullptr);
+}
+
+/**
+ * @tc.name: ParallelEncodeMatchesOneThread
+ * @tc.desc: a clip whose records are counted and written on 1 to 4 threads yields the bytes of the sequential
+ *           encode, into a vector and into a region holding stale bytes, and serializes each pixel map once.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, ParallelEncodeMatchesOneThread, TestSize.Level0)
+{
+    constexpr uint8_t staleByte = 0xA5;
+    FakeClip clip = MakeClip();
+    std::vector<uint8_t> expected = EncodeOrDie(clip);
+    size_t expectedCount = clip.Count();
+    clip.parallel = true;
+    for (size_t threads = 1; threads <= MAX_TEST_THREADS; ++threads) {
+        ParallelLimits limits(threads, 1);
+        EXPECT_EQ(clip.Count(), expectedCount) << "threads " << threads;
+        Media::PixelMap::encodeTlvCalls = 0;
+        AAFwk::Want::marshallingCalls = 0;
+        EXPECT_EQ(EncodeOrDie(clip), expected) << "threads " << threads;
+        EXPECT_EQ(Media::PixelMap::encodeTlvCalls.load(), RECORD_COUNT);
+        EXPECT_EQ(AAFwk::Want::marshallingCalls.load(), RECORD_COUNT);
+
+        std::vector<uint8_t> region(expectedCount, staleByte);
+        ASSERT_TRUE(clip.Encode(region.data(), region.size()));
+        EXPECT_EQ(region, expected) << "threads " << threads;
+    }
+}
+
+/**
+ * @tc.name: ParallelEncodeFallsBackToOnePass
+ * @tc.desc: a record list written into a region that holds it but not the slack Count reserves, or not even
+ *           that, is written in one pass to the same bytes, as is a list of one record.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, ParallelEncodeFallsBackToOnePass, TestSize.Level0)
+{
+    FakeClip clip = MakeClip();
+    std::vector<uint8_t> element = EncodeElement(clip.records);
+    ParallelLimits limits(MAX_TEST_THREADS, 1);
+    std::vector<uint8_t> region(element.size());
+    WriteOnlyBuffer exact(region.data(), region.size());
+    ASSERT_TRUE(exact.WriteParallel(TAG_CLIP_RECORDS, clip.records));
+    EXPECT_EQ(region, element);
+
+    // one byte short, the one pass decides the result and the bytes
+    std::vector<uint8_t> onePassRegion(region.size() - 1);
+    WriteOnlyBuffer onePass(onePassRegion.data(), onePassRegion.size());
+    bool onePassRet = onePass.Write(TAG_CLIP_RECORDS, clip.records);
+    std::vector<uint8_t> shortRegion(region.size() - 1);
+    WriteOnlyBuffer tooShort(shortRegion.data(), shortRegion.size());
+    EXPECT_EQ(tooShort.WriteParallel(TAG_CLIP_RECORDS, clip.records), onePassRet);
+    EXPECT_EQ(shortRegion, onePassRegion);
+
+    std::vector<std::shared_ptr<FakeRecord>> single(clip.records.begin(), clip.records.begin() + 1);
+    std::vector<uint8_t> singleRegion(FakeRecordsTLV(single).Count());
+    WriteOnlyBuffer one(singleRegion.data(), singleRegion.size());
+    ASSERT_TRUE(one.WriteParallel(TAG_CLIP_RECORDS, single));
+    EXPECT_EQ(singleRegion, EncodeOrDie(FakeRecordsTLV(single)));
+}
+
+/**
+ * @tc.name: ParallelDecodeMatchesOneThread
+ * @tc.desc: a clip whose records are decoded on 1 to 4 threads re-encodes to the bytes it was decoded from, and
+ *           decodes each pixel map once.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, ParallelDecodeMatchesOneThread, TestSize.Level0)
+{
+    std::vector<uint8_t> expected = EncodeOrDie(MakeClip());
+    for (size_t threads = 1; threads <= MAX_TEST_THREADS; ++threads) {
+        ParallelLimits limits(threads, 1);
+        FakeClip decoded;
+        decoded.parallel = true;
+        Media::PixelMap::decodeTlvCalls = 0;
+        ASSERT_TRUE(decoded.Decode(expected)) << "threads " << threads;
+        EXPECT_EQ(Media::PixelMap::decodeTlvCalls.load(), RECORD_COUNT);
+        ASSERT_EQ(decoded.records.size(), RECORD_COUNT);
+        decoded.parallel = false;
+        EXPECT_EQ(EncodeOrDie(decoded), expected) << "threads " << threads;
+    }
+}
+
+/**
+ * @tc.name: ParallelDecodeKeepsOnePassFailures
+ * @tc.desc: a record that fails to decode fails the parallel read after the records before it, as in the one
+ *           pass, and a list whose item heads overrun it is left to the one pass and refused.
+ * @tc.type: FUNC
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, ParallelDecodeKeepsOnePassFailures, TestSize.Level0)
+{
+    constexpr size_t brokenIndex = 5;
+    std::vector<uint8_t> corrupt = EncodeOrDie(MakeClip());
+    size_t itemOffset = RecordItemOffset(corrupt, brokenIndex);
+    auto *item = reinterpret_cast<TLVHead *>(corrupt.data() + itemOffset);
+    auto *value = reinterpret_cast<TLVHead *>(corrupt.data() + itemOffset + sizeof(TLVHead));
+    value->len = HostToNet(static_cast<uint32_t>(NetToHost(item->len)));
+
+    FakeClip sequential;
+    EXPECT_FALSE(sequential.Decode(corrupt));
+    EXPECT_EQ(sequential.records.size(), brokenIndex);
+    ParallelLimits limits(MAX_TEST_THREADS, 1);
+    FakeClip parallel;
+    parallel.parallel = true;
+    EXPECT_FALSE(parallel.Decode(corrupt));
+    EXPECT_EQ(parallel.records.size(), brokenIndex);
+
+    // the last item claims one byte past the list
+    std::vector<uint8_t> overrun = EncodeOrDie(MakeClip());
+    auto *last = reinterpret_cast<TLVHead *>(overrun.data() + RecordItemOffset(overrun, RECORD_COUNT - 1));
+    last->len = HostToNet(static_cast<uint32_t>(NetToHost(last->len) + 1));
+    FakeClip truncated;
+    truncated.parallel = true;
+    EXPECT_FALSE(truncated.Decode(overrun));
+    EXPECT_EQ(truncated.records.size(), RECORD_COUNT - 1);
+}
+
+/**
+ * @tc.name: ParallelRecordCodecCost
+ * @tc.desc: reports the time to encode and decode a clip of 16 records of 2 MiB each on one thread and on four;
+ *           the four thread run is only required to be faster on a host with more than one core.
+ * @tc.type: PERF
+ * @tc.require: issueI1671
+ * @tc.author:
+ */
+HWTEST_F(TlvCodecHostTest, ParallelRecordCodecCost, TestSize.Level0)
+{
+    FakeClip clip;
+    clip.parallel = true;
+    for (size_t i = 0; i < PARALLEL_RECORD_COUNT; ++i) {
+        auto record = std::make_shared<FakeRecord>();
+        record->html.assign(PARALLEL_RECORD_BYTES, static_cast<char>('a' + i));
+        record->pixelMap = std::make_shared<Media::PixelMap>();
+        record->pixelMap->blob.assign(PARALLEL_RECORD_BYTES, static_cast<uint8_t>(i));
+        clip.records.emplace_back(std::move(record));
+    }
+    std::vector<uint8_t> encoded = EncodeOrDie(clip);
+    auto time = [](const std::function<bool()> &codec) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < PERF_ROUNDS; ++i) {
+            if (!codec()) {
+                return -1.0;
+            }
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() /
+            PERF_ROUNDS;
+    };
+    auto encodeAndDecode = [&]() {
+        std::vector<uint8_t> buffer;
+        FakeClip decoded;
+        decoded.parallel = true;
+        return clip.Encode(buffer) && buffer == encoded && decoded.Decode(buffer) &&
+            decoded.records.size() == PARALLEL_RECORD_COUNT;
+    };
+    double single = 0;
+    double parallel = 0;
+    {
+        ParallelLimits limits(1, 0);
+        single = time(encodeAndDecode);
+    }
+    {
+        ParallelLimits limits(MAX_TEST_THREADS, 0);
+        parallel = time(encodeAndDecode);
+    }
+    ASSERT_GT(single, 0);
+    ASSERT_GT(parallel, 0);
+    std::printf("[PERF] %zu records of %zu KiB: 1 thread %.2f ms, %zu threads %.2f ms (%u cores)\n",
+        PARALLEL_RECORD_COUNT, 2 * PARALLEL_RECORD_BYTES / 1024, single, MAX_TEST_THREADS, parallel,
+        std::thread::hardware_concurrency());
+    if (std::thread::hardware_concurrency() > 1) {
+        EXPECT_LT(parallel, single);
+    }
+}
+} // namespace OHOS::MiscServices
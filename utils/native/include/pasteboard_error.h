@@ -97,7 +97,8 @@ enum class PasteboardError : int32_t {
     INVALID_DATA_SIZE,
     INVALID_TOKEN_ID,
     INVALID_URI_ERROR,
-    REMOTE_DATA_SIZE_EXCEEDED
+    REMOTE_DATA_SIZE_EXCEEDED,
+    SET_DATA_SUPERSEDED
 };
 
 const std::map<PasteboardError, const char *> PasteboardErrorMap = {
@@ -173,6 +174,7 @@ const std::map<PasteboardError, const char *> PasteboardErrorMap = {
     {PasteboardError::INVALID_TOKEN_ID, "INVALID_TOKEN_ID"},
     {PasteboardError::INVALID_URI_ERROR, "INVALID_URI_ERROR"},
     {PasteboardError::REMOTE_DATA_SIZE_EXCEEDED, "REMOTE_DATA_SIZE_EXCEEDED"},
+    {PasteboardError::SET_DATA_SUPERSEDED, "SET_DATA_SUPERSEDED"},
 };
 
 } // namespace MiscServices